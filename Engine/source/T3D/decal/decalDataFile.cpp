@@ -56,13 +56,19 @@ ResourceBase::Signature Resource<DecalDataFile>::signature()
 }
 
 
+//-----------------------------------------------------------------------------
+
+const F32 DecalDataFile::smCellSize = 64.0f;
+
 //-----------------------------------------------------------------------------
 
 DecalDataFile::DecalDataFile()
    : mIsDirty( false ),
-     mSphereWithLastInsertion( NULL )
+     mSphereWithLastInsertion( NULL ),
+     mMaxSphereRadius( 0.0f )
 {
    VECTOR_SET_ASSOCIATION( mSphereList );
+   VECTOR_SET_ASSOCIATION( mSphereQuery );
 }
 
 //-----------------------------------------------------------------------------
@@ -80,6 +86,8 @@ void DecalDataFile::clear()
       delete mSphereList[i];
 
    mSphereList.clear();
+   mSphereHash.clear();
+   mMaxSphereRadius = 0.0f;
    mSphereWithLastInsertion = NULL;
    mChunker.freeBlocks();
 
@@ -323,20 +331,31 @@ void DecalDataFile::_addDecalToSpheres( DecalInstance* inst )
    // guess as a good candidate.
 
    if( mSphereWithLastInsertion && mSphereWithLastInsertion->tryAddItem( inst ) )
+   {
+      _hashSphere( mSphereWithLastInsertion );
       return;
+   }
+
+   // Otherwise, look for an existing sphere that meets our tolerances.  Only
+   // spheres whose centers are within the distance tolerance can take the
+   // decal, so we only need to look at the cells around it.
+
+   const F32 reach = DecalSphere::smDistanceTolerance + inst->mSize / 2.f;
+   const Box3F searchBox( inst->mPosition - Point3F( reach ), inst->mPosition + Point3F( reach ) );
 
-   // Otherwise, go through the list and try to find an existing sphere that meets
-   // our tolerances.
+   mSphereQuery.clear();
+   findSpheres( searchBox, &mSphereQuery );
 
-   for( U32 i = 0; i < mSphereList.size(); i++ )
+   for( U32 i = 0; i < mSphereQuery.size(); i++ )
    {
-      DecalSphere* sphere = mSphereList[i];
+      DecalSphere* sphere = mSphereQuery[i];
       
       if( sphere == mSphereWithLastInsertion )
          continue;
 
       if( sphere->tryAddItem( inst ) )
       {
+         _hashSphere( sphere );
          mSphereWithLastInsertion = sphere;
          return;
       }
@@ -350,6 +369,12 @@ void DecalDataFile::_addDecalToSpheres( DecalInstance* inst )
    mSphereWithLastInsertion = sphere;
 
    sphere->mItems.push_back( inst );
+   inst->mSphere = sphere;
+
+   const Point2I cell = _getCell( sphere->mWorldSphere.center );
+   sphere->mCellKey = _getCellKey( cell.x, cell.y );
+   mSphereHash.insertEqual( sphere->mCellKey, sphere );
+   mMaxSphereRadius = getMax( mMaxSphereRadius, sphere->mWorldSphere.radius );
 }
 
 //-----------------------------------------------------------------------------
@@ -366,36 +391,99 @@ void DecalDataFile::removeDecal( DecalInstance *inst )
 
 bool DecalDataFile::_removeDecalFromSpheres( DecalInstance *inst )
 {
-   for( U32 i = 0; i < mSphereList.size(); i++ )
+   DecalSphere* sphere = inst->mSphere;
+   if( !sphere )
+      return false;
+
+   // Try to remove the instance from the list of its sphere.
+   // If that fails, the instance doesn't belong to this file.
+
+   Vector< DecalInstance* > &items = sphere->mItems;
+   if( !items.remove( inst ) )
+      return false;
+
+   inst->mSphere = NULL;
+
+   // If the sphere is now empty, remove it.  Otherwise, update
+   // it's bounds.
+
+   if( items.empty() )
    {
-      DecalSphere* sphere = mSphereList[ i ];
-      Vector< DecalInstance* > &items = sphere->mItems;
+      if( mSphereWithLastInsertion == sphere )
+         mSphereWithLastInsertion = NULL;
 
-      // Try to remove the instance from the list of this sphere.
-      // If that fails, the instance doesn't belong to this sphere
-      // so continue.
+      _unhashSphere( sphere );
+      mSphereList.erase_fast( mSphereList.find_next( sphere ) );
+      delete sphere;      
+   }
+   else
+   {
+      sphere->updateWorldSphere();
+      _hashSphere( sphere );
+   }
 
-      if( !items.remove( inst ) )
-         continue;
+   return true;
+}
 
-      // If the sphere is now empty, remove it.  Otherwise, update
-      // it's bounds.
+//-----------------------------------------------------------------------------
 
-      if( items.empty() )
-      {
-         if( mSphereWithLastInsertion == sphere )
-            mSphereWithLastInsertion = NULL;
+Point2I DecalDataFile::_getCell( const Point3F &pos )
+{
+   return Point2I( (S32)mFloor( pos.x / smCellSize ), (S32)mFloor( pos.y / smCellSize ) );
+}
 
-         delete sphere;      
-         mSphereList.erase( i );
-      }
-      else
-         sphere->updateWorldSphere();
+//-----------------------------------------------------------------------------
+
+void DecalDataFile::_hashSphere( DecalSphere *sphere )
+{
+   mMaxSphereRadius = getMax( mMaxSphereRadius, sphere->mWorldSphere.radius );
+
+   const Point2I cell = _getCell( sphere->mWorldSphere.center );
+   const U32 key = _getCellKey( cell.x, cell.y );
+   if( key == sphere->mCellKey )
+      return;
 
-      return true;
+   mSphereHash.erase( sphere->mCellKey, sphere );
+   sphere->mCellKey = key;
+   mSphereHash.insertEqual( key, sphere );
+}
+
+//-----------------------------------------------------------------------------
+
+void DecalDataFile::_unhashSphere( DecalSphere *sphere )
+{
+   mSphereHash.erase( sphere->mCellKey, sphere );
+}
+
+//-----------------------------------------------------------------------------
+
+void DecalDataFile::findSpheres( const Box3F &box, Vector< DecalSphere* > *outSpheres ) const
+{
+   // A sphere is filed under the cell of its center, so
+   // grow the box by the largest radius we might miss.
+
+   const Point3F reach( mMaxSphereRadius );
+   const Point2I minCell = _getCell( box.minExtents - reach );
+   const Point2I maxCell = _getCell( box.maxExtents + reach );
+
+   // Walking more cells than there are spheres is a waste.
+   const F64 numCells = F64( maxCell.x - minCell.x + 1 ) * F64( maxCell.y - minCell.y + 1 );
+   if( numCells > mSphereList.size() )
+   {
+      outSpheres->merge( mSphereList );
+      return;
    }
 
-   return false;
+   for( S32 y = minCell.y; y <= maxCell.y; y++ )
+   {
+      for( S32 x = minCell.x; x <= maxCell.x; x++ )
+      {
+         const U32 key = _getCellKey( x, y );
+         SphereHash::ConstIterator itr = mSphereHash.find( key );
+         for( ; itr != mSphereHash.end() && itr->key == key; ++itr )
+            outSpheres->push_back( itr->value );
+      }
+   }
 }
 
 //-----------------------------------------------------------------------------
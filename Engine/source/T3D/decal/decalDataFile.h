@@ -35,6 +35,14 @@
 #include "T3D/decal/decalSphere.h"
 #endif
 
+#ifndef _MBOX_H_
+#include "math/mBox.h"
+#endif
+
+#ifndef _TDICTIONARY_H_
+#include "core/util/tDictionary.h"
+#endif
+
 
 class Stream;
 class DecalData;
@@ -87,6 +95,37 @@ class DecalDataFile
       bool _removeDecalFromSpheres( DecalInstance *inst );
 
       /// @}
+
+      /// @name Spatial Hash
+      /// @{
+
+      typedef HashTable< U32, DecalSphere* > SphereHash;
+
+      /// The spheres in #mSphereList filed under the grid
+      /// cell their center falls into on the XY plane.
+      SphereHash mSphereHash;
+
+      /// The largest radius of any sphere since the last clear.  This
+      /// bounds how far a sphere reaches beyond its own cell.
+      F32 mMaxSphereRadius;
+
+      /// Scratch list for the sphere queries in _addDecalToSpheres().
+      Vector< DecalSphere* > mSphereQuery;
+
+      /// Return the hash key of the cell at @a x, @a y.
+      static U32 _getCellKey( S32 x, S32 y ) { return ( U32( U16( x ) ) << 16 ) | U16( y ); }
+
+      /// Return the cell coordinates of @a pos.
+      static Point2I _getCell( const Point3F &pos );
+
+      /// File the sphere under the cell of its current center.  Must
+      /// be called whenever the sphere bounds have changed.
+      void _hashSphere( DecalSphere *sphere );
+
+      /// Remove the sphere from the hash.
+      void _unhashSphere( DecalSphere *sphere );
+
+      /// @}
    
    public:
 
@@ -96,6 +135,17 @@ class DecalDataFile
       Vector< DecalSphere* >& getSphereList() { return mSphereList; }
       const Vector< DecalSphere* >& getSphereList() const { return mSphereList; }
 
+      /// Size of the spatial hash cells in meters.
+      static const F32 smCellSize;
+
+      /// Append the spheres which may overlap @a box to @a outSpheres.
+      ///
+      /// Only the hash cells around the box are visited unless there are
+      /// more of them than there are spheres, in which case the whole
+      /// sphere list is returned.  Either way the caller still has to
+      /// test the sphere bounds.
+      void findSpheres( const Box3F &box, Vector< DecalSphere* > *outSpheres ) const;
+
       /// Return true if the decal data has been modified since the last save or load.
       bool isDirty() const { return mIsDirty; }
 
@@ -39,6 +39,7 @@ DecalInstance::DecalInstance()
    mFlags(0),
    mRenderPriority(0),
    mId(-1),
+   mSphere(NULL),
    mCustomTex(NULL)
 {}
 void DecalInstance::getWorldMatrix( MatrixF *outMat, bool flip )
@@ -33,6 +33,7 @@
 
 struct DecalVertex;
 class SceneRenderState;
+class DecalSphere;
 
 /// DecalInstance represents a rendering decal in the scene.
 /// You should not allocate this yourself, add new decals to the scene
@@ -77,6 +78,9 @@ class DecalInstance
 
       S32 mId;
 
+      /// The DecalSphere this decal is binned in or NULL.
+      DecalSphere *mSphere;
+
       GFXTexHandle *mCustomTex;
 
       void getWorldMatrix( MatrixF *outMat, bool flip = false );
@@ -35,6 +35,7 @@
 #include "lighting/lightManager.h"
 #include "lighting/lightInfo.h"
 #include "gfx/gfxDrawUtil.h"
+#include "gfx/gfxTransientBufferPool.h"
 #include "gfx/sim/gfxStateBlockData.h"
 #include "materials/shaderData.h"
 #include "materials/matInstance.h"
@@ -48,6 +49,7 @@
 #include "core/module.h"
 #include "T3D/decal/decalData.h"
 #include "console/engineAPI.h"
+#include "platform/threads/threadPool.h"
 
 
 extern bool gEditingMission;
@@ -80,7 +82,7 @@ F32 gDecalBias = 0.0015f;
 bool      DecalManager::smDecalsOn = true;
 bool      DecalManager::smDebugRender = false;
 F32       DecalManager::smDecalLifeTimeScale = 1.0f;
-bool      DecalManager::smPoolBuffers = true;
+S32       DecalManager::smMaxClipsPerFrame = 64;
 const U32 DecalManager::smMaxVerts = 6000;
 const U32 DecalManager::smMaxIndices = 10000;
 
@@ -216,15 +218,14 @@ DecalManager::DecalManager()
    mTypeMask |= EnvironmentObjectType;
 
    mDirty = false;
-
-   GFXDevice::getDeviceEventSignal().notify(this, &DecalManager::_handleGFXEvent);
 }
 
 DecalManager::~DecalManager()
 {
-   GFXDevice::getDeviceEventSignal().remove(this, &DecalManager::_handleGFXEvent);
-
    clearData();
+
+   for ( U32 i = 0; i < mClipJobs.size(); i++ )
+      delete mClipJobs[i];
 }
 
 void DecalManager::consoleInit()
@@ -238,10 +239,10 @@ void DecalManager::consoleInit()
       "Deprecated. Use DecalData::lifeSpan instead.\n"
       "@ingroup Decals" );
 
-   Con::addVariable( "$Decals::poolBuffers", TypeBool, &smPoolBuffers,
-      "If true, will merge all PrimitiveBuffers and VertexBuffers into a pair "
-      "of pools before clearing them at the end of a frame.\n"
-      "If false, will just clear them at the end of a frame.\n"
+   Con::addVariable( "$Decals::maxClipsPerFrame", TypeS32, &smMaxClipsPerFrame,
+      "The maximum number of decals clipped against the scene each frame.  "
+      "Decals over the limit are clipped on the following frames.  Zero "
+      "or less disables the limit.\n\n"
       "@ingroup Decals" );
 
    Con::addVariable( "$Decals::debugRender", TypeBool, &smDebugRender,
@@ -259,48 +260,62 @@ void DecalManager::consoleInit()
       "@ingroup Decals" );
 }
 
-bool DecalManager::_handleGFXEvent(GFXDevice::GFXDeviceEventType event)
+bool DecalManager::clipDecal( DecalInstance *decal, Vector<Point3F> *edgeVerts, const Point2F *clipDepth )
 {
-   switch(event)
-   {
-   case GFXDevice::deEndOfFrame:
+   PROFILE_SCOPE( DecalManager_clipDecal );
 
-      // Return PrimitiveBuffers and VertexBuffers used this frame to the pool.
+   // Free old verts and indices.
+   _freeBuffers( decal );
 
-      if ( smPoolBuffers )
-      {
-         mPBPool.merge( mPBs );
-         mPBs.clear();
+   mClipJob.decal = decal;
+   _clipDecalPolys( &mClipJob, clipDepth );
 
-         mVBPool.merge( mVBs );
-         mVBs.clear();
-      }
-      else
-      {
-         _freePools();
-      }
+   if ( !_buildDecalGeometry( &mClipJob ) )
+      return false;
 
-      break;
-      
-   default: ;
+   _commitDecalGeometry( &mClipJob );
+
+   if ( !edgeVerts )
+      return true;
+
+   MatrixF projMat( true );
+   decal->getWorldMatrix( &projMat );
+   projMat.inverse();
+
+   Point3F tmpHullPt( 0, 0, 0 );
+   Vector<Point3F> tmpHullPts;
+
+   for ( U32 i = 0; i < mClipJob.clipper.mVertexList.size(); i++ )
+   {
+      const ClippedPolyList::Vertex &vert = mClipJob.clipper.mVertexList[i];
+      tmpHullPt = vert.point;
+      projMat.mulP( tmpHullPt );
+      tmpHullPts.push_back( tmpHullPt );
    }
 
+   edgeVerts->clear();
+   U32 verts = _generateConvexHull( tmpHullPts, edgeVerts );
+   edgeVerts->setSize( verts );
+
+   projMat.inverse();
+   for ( U32 i = 0; i < edgeVerts->size(); i++ )
+      projMat.mulP( (*edgeVerts)[i] );
+
    return true;
 }
 
-bool DecalManager::clipDecal( DecalInstance *decal, Vector<Point3F> *edgeVerts, const Point2F *clipDepth )
+void DecalManager::_clipDecalPolys( ClipJob *job, const Point2F *clipDepth )
 {
-   PROFILE_SCOPE( DecalManager_clipDecal );
+   PROFILE_SCOPE( DecalManager_clipDecalPolys );
 
-   // Free old verts and indices.
-   _freeBuffers( decal );
+   DecalInstance *decal = job->decal;
+   ClippedPolyList &clipper = job->clipper;
 
    F32 halfSize = decal->mSize * 0.5f;
    
    // Ugly hack for ProjectedShadow!
    F32 halfSizeZ = clipDepth ? clipDepth->x : halfSize;
    F32 negHalfSize = clipDepth ? clipDepth->y : halfSize;
-   Point3F decalHalfSize( halfSize, halfSize, halfSize );
    Point3F decalHalfSizeZ( halfSizeZ, halfSizeZ, halfSizeZ );
 
    MatrixF projMat( true );
@@ -313,39 +328,51 @@ bool DecalManager::clipDecal( DecalInstance *decal, Vector<Point3F> *edgeVerts,
    projMat.getColumn( 0, &newRight );
    projMat.getColumn( 1, &newFwd );   
 
-   VectorF objRight( 1.0f, 0, 0 );
-   VectorF objFwd( 0, 1.0f, 0 );
-   VectorF objUp( 0, 0, 1.0f );
-
    // See above re: decalHalfSizeZ hack.
-   mClipper.clear();
-   mClipper.mPlaneList.setSize(6);
-   mClipper.mPlaneList[0].set( ( decalPos + ( -newRight * halfSize ) ), -newRight );
-   mClipper.mPlaneList[1].set( ( decalPos + ( -newFwd * halfSize ) ), -newFwd );
-   mClipper.mPlaneList[2].set( ( decalPos + ( -crossVec * decalHalfSizeZ ) ), -crossVec );
-   mClipper.mPlaneList[3].set( ( decalPos + ( newRight * halfSize ) ), newRight );
-   mClipper.mPlaneList[4].set( ( decalPos + ( newFwd * halfSize ) ), newFwd );
-   mClipper.mPlaneList[5].set( ( decalPos + ( crossVec * negHalfSize ) ), crossVec );
+   clipper.clear();
+   clipper.mPlaneList.setSize(6);
+   clipper.mPlaneList[0].set( ( decalPos + ( -newRight * halfSize ) ), -newRight );
+   clipper.mPlaneList[1].set( ( decalPos + ( -newFwd * halfSize ) ), -newFwd );
+   clipper.mPlaneList[2].set( ( decalPos + ( -crossVec * decalHalfSizeZ ) ), -crossVec );
+   clipper.mPlaneList[3].set( ( decalPos + ( newRight * halfSize ) ), newRight );
+   clipper.mPlaneList[4].set( ( decalPos + ( newFwd * halfSize ) ), newFwd );
+   clipper.mPlaneList[5].set( ( decalPos + ( crossVec * negHalfSize ) ), crossVec );
 
-   mClipper.mNormal = decal->mNormal;
+   clipper.mNormal = decal->mNormal;
 
    const DecalData *decalData = decal->mDataBlock;
 
-   mClipper.mNormalTolCosineRadians = mCos( mDegToRad( decalData->clippingAngle ) );
+   clipper.mNormalTolCosineRadians = mCos( mDegToRad( decalData->clippingAngle ) );
 
    Box3F box( -decalHalfSizeZ, decalHalfSizeZ );
 
    projMat.mul( box );
 
    PROFILE_START( DecalManager_clipDecal_buildPolyList );
-   getContainer()->buildPolyList( PLC_Decal, box, decalData->clippingMasks, &mClipper );   
+   getContainer()->buildPolyList( PLC_Decal, box, decalData->clippingMasks, &clipper );   
    PROFILE_END();
 
-   mClipper.cullUnusedVerts();
-   mClipper.triangulate();
+#ifdef DECALMANAGER_DEBUG
+   mDebugPlanes.clear();
+   mDebugPlanes.merge( clipper.mPlaneList );
+#endif
+}
+
+bool DecalManager::_buildDecalGeometry( ClipJob *job )
+{
+   PROFILE_SCOPE( DecalManager_buildDecalGeometry );
+
+   DecalInstance *decal = job->decal;
+   ClippedPolyList &clipper = job->clipper;
+
+   job->verts.clear();
+   job->indices.clear();
+
+   clipper.cullUnusedVerts();
+   clipper.triangulate();
    
-   const U32 numVerts = mClipper.mVertexList.size();
-   const U32 numIndices = mClipper.mIndexList.size();
+   const U32 numVerts = clipper.mVertexList.size();
+   const U32 numIndices = clipper.mIndexList.size();
 
    if ( !numVerts || !numIndices )
       return false;
@@ -356,17 +383,15 @@ bool DecalManager::clipDecal( DecalInstance *decal, Vector<Point3F> *edgeVerts,
         numIndices > smMaxIndices )
       return false;
 
-   if ( !decalData->skipVertexNormals )
-      mClipper.generateNormals();
-   
-#ifdef DECALMANAGER_DEBUG
-   mDebugPlanes.clear();
-   mDebugPlanes.merge( mClipper.mPlaneList );
-#endif
+   if ( !decal->mDataBlock->skipVertexNormals )
+      clipper.generateNormals();
+
+   F32 halfSize = decal->mSize * 0.5f;
+   Point3F decalHalfSize( halfSize, halfSize, halfSize );
+
+   VectorF objRight( 1.0f, 0, 0 );
+   VectorF objFwd( 0, 1.0f, 0 );
 
-   decal->mVertCount = numVerts;
-   decal->mIndxCount = numIndices;
-   
    Vector<Point3F> tmpPoints;
 
    tmpPoints.push_back(( objFwd * decalHalfSize ) + ( objRight * decalHalfSize ));
@@ -375,6 +400,8 @@ bool DecalManager::clipDecal( DecalInstance *decal, Vector<Point3F> *edgeVerts,
    
    Point3F lowerLeft(( -objFwd * decalHalfSize ) + ( objRight * decalHalfSize ));
 
+   MatrixF projMat( true );
+   decal->getWorldMatrix( &projMat );
    projMat.inverse();
 
    _generateWindingOrder( lowerLeft, &tmpPoints );
@@ -387,18 +414,17 @@ bool DecalManager::clipDecal( DecalInstance *decal, Vector<Point3F> *edgeVerts,
    Point2F uv( 0, 0 );
    Point3F vecX(0.0f, 0.0f, 0.0f);
 
-   // Allocate memory for vert and index arrays
-   _allocBuffers( decal );  
+   job->verts.setSize( numVerts );
+   job->indices.setSize( numIndices );
+
+   const RectF &rect = decal->mDataBlock->texRect[decal->mTextureRectIdx];
 
-   // Mark this so that the color will be assigned on these verts the next
-   // time it renders, since we just threw away the previous verts.
-   decal->mLastAlpha = -1;
-   
    Point3F vertPoint( 0, 0, 0 );
 
-   for ( U32 i = 0; i < mClipper.mVertexList.size(); i++ )
+   for ( U32 i = 0; i < numVerts; i++ )
    {
-      const ClippedPolyList::Vertex &vert = mClipper.mVertexList[i];
+      const ClippedPolyList::Vertex &vert = clipper.mVertexList[i];
+      DecalVertex &outVert = job->verts[i];
       vertPoint = vert.point;
 
       // Transform this point to
@@ -413,71 +439,115 @@ bool DecalManager::clipDecal( DecalInstance *decal, Vector<Point3F> *edgeVerts,
       // Get our UV.
       uv = quadToSquare.transform( Point2F( vertPoint.x, vertPoint.y ) );
 
-      const RectF &rect = decal->mDataBlock->texRect[decal->mTextureRectIdx];
-
       uv *= rect.extent;
       uv += rect.point;      
 
       // Set the world space vertex position.
-      decal->mVerts[i].point = vert.point;
+      outVert.point = vert.point;
       
-      decal->mVerts[i].texCoord.set( uv.x, uv.y );
+      outVert.texCoord.set( uv.x, uv.y );
       
-      if ( mClipper.mNormalList.empty() )
+      if ( clipper.mNormalList.empty() )
          continue;
 
-      decal->mVerts[i].normal = mClipper.mNormalList[i];
-      decal->mVerts[i].normal.normalize();
+      outVert.normal = clipper.mNormalList[i];
+      outVert.normal.normalize();
 
-      if( mFabs( decal->mVerts[i].normal.z ) > 0.8f ) 
-         mCross( decal->mVerts[i].normal, Point3F( 1.0f, 0.0f, 0.0f ), &vecX );
-      else if ( mFabs( decal->mVerts[i].normal.x ) > 0.8f )
-         mCross( decal->mVerts[i].normal, Point3F( 0.0f, 1.0f, 0.0f ), &vecX );
-      else if ( mFabs( decal->mVerts[i].normal.y ) > 0.8f )
-         mCross( decal->mVerts[i].normal, Point3F( 0.0f, 0.0f, 1.0f ), &vecX );
+      if( mFabs( outVert.normal.z ) > 0.8f ) 
+         mCross( outVert.normal, Point3F( 1.0f, 0.0f, 0.0f ), &vecX );
+      else if ( mFabs( outVert.normal.x ) > 0.8f )
+         mCross( outVert.normal, Point3F( 0.0f, 1.0f, 0.0f ), &vecX );
+      else if ( mFabs( outVert.normal.y ) > 0.8f )
+         mCross( outVert.normal, Point3F( 0.0f, 0.0f, 1.0f ), &vecX );
    
-      decal->mVerts[i].tangent = mCross( decal->mVerts[i].normal, vecX );
+      outVert.tangent = mCross( outVert.normal, vecX );
    }
 
    U32 curIdx = 0;
-   for ( U32 j = 0; j < mClipper.mPolyList.size(); j++ )
+   for ( U32 j = 0; j < clipper.mPolyList.size(); j++ )
    {
       // Write indices for each Poly
-      ClippedPolyList::Poly *poly = &mClipper.mPolyList[j];                  
+      ClippedPolyList::Poly *poly = &clipper.mPolyList[j];                  
 
       AssertFatal( poly->vertexCount == 3, "Got non-triangle poly!" );
 
-      decal->mIndices[curIdx] = mClipper.mIndexList[poly->vertexStart];         
-      curIdx++;
-      decal->mIndices[curIdx] = mClipper.mIndexList[poly->vertexStart + 1];            
-      curIdx++;
-      decal->mIndices[curIdx] = mClipper.mIndexList[poly->vertexStart + 2];                
-      curIdx++;
+      job->indices[curIdx++] = clipper.mIndexList[poly->vertexStart];         
+      job->indices[curIdx++] = clipper.mIndexList[poly->vertexStart + 1];            
+      job->indices[curIdx++] = clipper.mIndexList[poly->vertexStart + 2];                
    } 
 
-   if ( !edgeVerts )
-      return true;
+   return true;
+}
 
-   Point3F tmpHullPt( 0, 0, 0 );
-   Vector<Point3F> tmpHullPts;
+void DecalManager::_commitDecalGeometry( ClipJob *job )
+{
+   DecalInstance *decal = job->decal;
+
+   decal->mVertCount = job->verts.size();
+   decal->mIndxCount = job->indices.size();
+
+   // Allocate memory for vert and index arrays
+   _allocBuffers( decal );  
+
+   dMemcpy( decal->mVerts, job->verts.address(), sizeof( DecalVertex ) * decal->mVertCount );
+   dMemcpy( decal->mIndices, job->indices.address(), sizeof( U16 ) * decal->mIndxCount );
+
+   // Mark this so that the color will be assigned on these verts the next
+   // time it renders, since we just threw away the previous verts.
+   decal->mLastAlpha = -1;
+}
 
-   for ( U32 i = 0; i < mClipper.mVertexList.size(); i++ )
+U32 DecalManager::_clipQueuedDecals()
+{
+   PROFILE_SCOPE( DecalManager_clipQueuedDecals );
+
+   const U32 count = mClipQueue.size();
+   while ( mClipJobs.size() < count )
+      mClipJobs.push_back( new ClipJob );
+
+   // Gathering the scene geometry has to happen here on the main
+   // thread as the container is not safe to query from the workers.
+   for ( U32 i = 0; i < count; i++ )
    {
-      const ClippedPolyList::Vertex &vert = mClipper.mVertexList[i];
-      tmpHullPt = vert.point;
-      projMat.mulP( tmpHullPt );
-      tmpHullPts.push_back( tmpHullPt );
+      DecalInstance *dinst = mClipQueue[i];
+
+      // Turn off the flag so we don't continually try to clip
+      // if it fails.
+      dinst->mFlags = dinst->mFlags & ~ClipDecal;
+
+      // Free old verts and indices.
+      _freeBuffers( dinst );
+
+      mClipJobs[i]->decal = dinst;
+      _clipDecalPolys( mClipJobs[i], NULL );
    }
 
-   edgeVerts->clear();
-   U32 verts = _generateConvexHull( tmpHullPts, edgeVerts );
-   edgeVerts->setSize( verts );
+   // Triangulating, generating normals and building the vertices
+   // only touches the job, so the decals can be done in parallel.
+   struct BuildGeometry
+   {
+      DecalManager *manager;
+      ClipJob **jobs;
 
-   projMat.inverse();
-   for ( U32 i = 0; i < edgeVerts->size(); i++ )
-      projMat.mulP( (*edgeVerts)[i] );
+      void operator()( U32 i )
+      {
+         manager->_buildDecalGeometry( jobs[i] );
+      }
+   };
 
-   return true;
+   BuildGeometry build = { this, mClipJobs.address() };
+   ThreadPool::GLOBAL().parallelFor( count, build );
+
+   U32 numFailed = 0;
+   for ( U32 i = 0; i < count; i++ )
+   {
+      if ( mClipJobs[i]->verts.empty() )
+         numFailed++;
+      else
+         _commitDecalGeometry( mClipJobs[i] );
+   }
+
+   return numFailed;
 }
 
 DecalInstance* DecalManager::addDecal( const Point3F &pos,
@@ -566,17 +636,18 @@ DecalInstance* DecalManager::getClosestDecal( const Point3F &pos )
    if ( !mData )
       return NULL;
 
-   const Vector<DecalSphere*> &grid = mData->getSphereList();
-
    DecalInstance *inst = NULL;
    SphereF worldPickSphere( pos, 0.5f );
    SphereF worldInstSphere( Point3F( 0, 0, 0 ), 1.0f );
 
+   mSphereQuery.clear();
+   mData->findSpheres( Box3F( pos - Point3F( worldPickSphere.radius ), pos + Point3F( worldPickSphere.radius ) ), &mSphereQuery );
+
    Vector<DecalInstance*> collectedInsts;
 
-   for ( U32 i = 0; i < grid.size(); i++ )
+   for ( U32 i = 0; i < mSphereQuery.size(); i++ )
    {
-      DecalSphere *decalSphere = grid[i];
+      DecalSphere *decalSphere = mSphereQuery[i];
       const SphereF &worldSphere = decalSphere->mWorldSphere;
       if (  !worldSphere.isIntersecting( worldPickSphere ) && 
             !worldSphere.isContained( pos ) )
@@ -629,16 +700,26 @@ DecalInstance* DecalManager::raycast( const Point3F &start, const Point3F &end,
    if ( !mData )
       return NULL;
 
-   const Vector<DecalSphere*> &grid = mData->getSphereList();
-
    DecalInstance *inst = NULL;
    SphereF worldSphere( Point3F( 0, 0, 0 ), 1.0f );
 
+   Box3F rayBox( start, start );
+   rayBox.extend( end );
+
+   mSphereQuery.clear();
+   mData->findSpheres( rayBox, &mSphereQuery );
+
+   // The scene ray is the same for every decal so only cast
+   // it once we have a decal whose bounds it passes through.
+   RayInfo ri;
+   bool castRay = false;
+   bool rayHit = false;
+
    Vector<DecalInstance*> hitDecals;
 
-   for ( U32 i = 0; i < grid.size(); i++ )
+   for ( U32 i = 0; i < mSphereQuery.size(); i++ )
    {
-      DecalSphere *decalSphere = grid[i];
+      DecalSphere *decalSphere = mSphereQuery[i];
       if ( !decalSphere->mWorldSphere.intersectsRay( start, end ) )
          continue;
 
@@ -658,9 +739,14 @@ DecalInstance* DecalManager::raycast( const Point3F &start, const Point3F &end,
          if ( !worldSphere.intersectsRay( start, end ) )
             continue;
          
-         RayInfo ri;
+         if ( !castRay )
+         {
+            rayHit = gServerContainer.castRayRendered( start, end, STATIC_COLLISION_TYPEMASK, &ri );
+            castRay = true;
+         }
+
          bool containsPoint = false;
-         if ( gServerContainer.castRayRendered( start, end, STATIC_COLLISION_TYPEMASK, &ri ) )
+         if ( rayHit )
          {        
             Point2F poly[4];
             poly[0].set( inst->mPosition.x - (inst->mSize / 2), inst->mPosition.y + (inst->mSize / 2));
@@ -916,31 +1002,39 @@ void DecalManager::_freeBuffers( DecalInstance *inst )
    }   
 }
 
-void DecalManager::_freePools()
+void DecalManager::_updateDecalAlpha( DecalInstance *dinst, F32 pixelSize )
 {
-   while ( !mVBPool.empty() )
-   {
-      delete mVBPool.last();
-      mVBPool.pop_back();
-   }
+   PROFILE_SCOPE( DecalManager_RenderDecals_Update_SetAlpha );
 
-   while ( !mVBs.empty() )
-   {
-      delete mVBs.last();
-      mVBs.pop_back();
-   }
+   const DecalData *ddata = dinst->mDataBlock;
 
-   while ( !mPBPool.empty() )
-   {
-      delete mPBPool.last();
-      mPBPool.pop_back();
-   }
+   F32 alpha = 1.0f;
 
-   while ( !mPBs.empty() )
+   // Only necessary for decals which fade over time or distance.
+   if ( !( dinst->mFlags & PermanentDecal ) || ddata->fadeStartPixelSize >= 0.0f )
    {
-      delete mPBs.last();
-      mPBs.pop_back();
+      if ( pixelSize < ddata->fadeStartPixelSize )
+      {
+         const F32 range = ddata->fadeStartPixelSize - ddata->fadeEndPixelSize;
+         alpha = 1.0f - mClampF( ( ddata->fadeStartPixelSize - pixelSize ) / range, 0.0f, 1.0f );
+      }
+
+      alpha *= dinst->mVisibility;
    }
+      
+   // If the alpha value has not changed since last render avoid
+   // looping through all the verts!
+   if ( alpha != dinst->mLastAlpha )
+   {
+      // calculate the swizzles color once, outside the loop.
+      GFXVertexColor color;
+      color.set( 255, 255, 255, (U8)(alpha * 255.0f) );
+
+      for ( U32 v = 0; v < dinst->mVertCount; v++ )
+         dinst->mVerts[v].color = color;
+
+      dinst->mLastAlpha = alpha;
+   }      
 }
 
 void DecalManager::prepRenderImage( SceneRenderState* state )
@@ -967,13 +1061,16 @@ void DecalManager::prepRenderImage( SceneRenderState* state )
    SceneManager* sceneManager = state->getSceneManager();
    SceneZoneSpaceManager* zoneManager = sceneManager->getZoneManager();
    AssertFatal( zoneManager, "DecalManager::prepRenderImage - No zone manager!" );
-   const Vector<DecalSphere*> &grid = mData->getSphereList();
    const bool haveOnlyOutdoorZone = ( zoneManager->getNumActiveZones() == 1 );
+
+   // Only look at the spheres around the frustum.
+   mSphereQuery.clear();
+   mData->findSpheres( rootFrustum.getBounds(), &mSphereQuery );
    
    mDecalQueue.clear();
-   for ( U32 i = 0; i < grid.size(); i++ )
+   for ( U32 i = 0; i < mSphereQuery.size(); i++ )
    {
-      DecalSphere* decalSphere = grid[i];
+      DecalSphere* decalSphere = mSphereQuery[i];
       const SphereF& worldSphere = decalSphere->mWorldSphere;
 
       // See if this decal sphere can be culled.
@@ -1017,7 +1114,7 @@ void DecalManager::prepRenderImage( SceneRenderState* state )
 
    // Loop through DecalQueue once for preRendering work.
    // 1. Update DecalInstance fade (over time)
-   // 2. Clip geometry if flagged to do so.
+   // 2. Queue geometry clipping if flagged to do so.
    // 3. Calculate lod - if decal is far enough away it will not render.
    for ( U32 i = 0; i < mDecalQueue.size(); i++ )
    {
@@ -1057,33 +1154,20 @@ void DecalManager::prepRenderImage( SceneRenderState* state )
          }
       }
 
-      // Build clipped geometry for this decal if needed.
+      // Queue the decal for clipping if needed.  The decals are
+      // clipped all at once below so they can be done in parallel.
       if ( dinst->mFlags & ClipDecal && !( dinst->mFlags & CustomDecal ) )
       {  
-         // Turn off the flag so we don't continually try to clip
-         // if it fails.
-         dinst->mFlags = dinst->mFlags & ~ClipDecal;
-
-         if ( !(dinst->mFlags & CustomDecal) && !clipDecal( dinst ) )
+         // If we're over budget leave it for a later frame.
+         if ( smMaxClipsPerFrame > 0 && mClipQueue.size() >= (U32)smMaxClipsPerFrame )
          {
-            // Clipping failed to get any geometry...
-
-            // Remove it from the render queue.
             mDecalQueue.erase_fast( i );
             i--;
-
-            // If the decal is one placed at run-time (not the editor)
-            // then we should also permanently delete the decal instance.
-            if ( !(dinst->mFlags & SaveDecal) )
-            {
-               removeDecal( dinst );
-            }
-
-            // If this is a decal placed by the editor it will be
-            // flagged to attempt clipping again the next time it is
-            // modified. For now we just skip rendering it.      
             continue;
-         }         
+         }
+
+         mClipQueue.push_back( dinst );
+         continue;
       }
 
       // If we get here and the decal still does not have any geometry
@@ -1095,40 +1179,47 @@ void DecalManager::prepRenderImage( SceneRenderState* state )
          i--;
          continue;
       }
-            
-      // Calculate the alpha value for this decal and apply it to the verts.            
-      {
-         PROFILE_START( DecalManager_RenderDecals_Update_SetAlpha );
 
-         F32 alpha = 1.0f;
+      _updateDecalAlpha( dinst, pixelSize );
+   }
 
-         // Only necessary for decals which fade over time or distance.
-         if ( !( dinst->mFlags & PermanentDecal ) || dinst->mDataBlock->fadeStartPixelSize >= 0.0f )
-         {
-            if ( pixelSize < ddata->fadeStartPixelSize )
-            {
-               const F32 range = ddata->fadeStartPixelSize - ddata->fadeEndPixelSize;
-               alpha = 1.0f - mClampF( ( ddata->fadeStartPixelSize - pixelSize ) / range, 0.0f, 1.0f );
-            }
+   PROFILE_END();      
 
-            alpha *= dinst->mVisibility;
-         }
-            
-         // If the alpha value has not changed since last render avoid
-         // looping through all the verts!
-         if ( alpha != dinst->mLastAlpha )
-         {
-            // calculate the swizzles color once, outside the loop.
-            GFXVertexColor color;
-            color.set( 255, 255, 255, (U8)(alpha * 255.0f) );
+   if ( !mClipQueue.empty() )
+   {
+      const U32 numFailed = _clipQueuedDecals();
+
+      for ( U32 i = 0; i < mClipQueue.size(); i++ )
+      {
+         dinst = mClipQueue[i];
+         if ( dinst->mVerts )
+            _updateDecalAlpha( dinst, dinst->calcPixelSize( state->getViewport().extent.y, state->getCameraPosition(), state->getWorldToScreenScale().y ) );
+      }
 
-            for ( U32 v = 0; v < dinst->mVertCount; v++ )
-               dinst->mVerts[v].color = color;
+      mClipQueue.clear();
 
-            dinst->mLastAlpha = alpha;
-         }      
+      // Clipping failed to get any geometry for some decals...
+      if ( numFailed > 0 )
+      {
+         for ( U32 i = 0; i < mDecalQueue.size(); i++ )
+         {
+            dinst = mDecalQueue[i];
+            if ( dinst->mVerts )
+               continue;
+
+            // Remove it from the render queue.
+            mDecalQueue.erase_fast( i );
+            i--;
 
-         PROFILE_END();
+            // If the decal is one placed at run-time (not the editor)
+            // then we should also permanently delete the decal instance.
+            //
+            // If this is a decal placed by the editor it will be
+            // flagged to attempt clipping again the next time it is
+            // modified. For now we just skip rendering it.      
+            if ( !(dinst->mFlags & SaveDecal) )
+               removeDecal( dinst );
+         }
       }
    }
 
@@ -1241,14 +1332,6 @@ void DecalManager::prepRenderImage( SceneRenderState* state )
       currentBatch->vCount += decal->mVertCount;
    }
    
-   // Make sure our primitive and vertex buffer handle storage is
-   // big enough to take all batches.  Doing this now avoids reallocation
-   // later on which would invalidate all the pointers we already had
-   // passed into render instances.
-   
-   //mPBs.reserve( batches.size() );
-   //mVBs.reserve( batches.size() );
-
    // System memory array of verts and indices so we can fill them incrementally
    // and then memcpy to the graphics device buffers in one call.
    static DecalVertex vertData[smMaxVerts];
@@ -1299,45 +1382,20 @@ void DecalManager::prepRenderImage( SceneRenderState* state )
 
       AssertFatal( ioffset == currentBatch->iCount, "bad" );
       AssertFatal( voffset == currentBatch->vCount, "bad" );
-        
-      // Get handles to video memory buffers we will be filling...
 
-      GFXVertexBufferHandle<DecalVertex> *vb = NULL;
-      
-      if ( mVBPool.empty() )
-      {
-         // If the Pool is empty allocate a new one.
-         vb = new GFXVertexBufferHandle<DecalVertex>;
-         vb->set( GFX, smMaxVerts, GFXBufferTypeDynamic );                  
-      }      
-      else 
-      {
-         // Otherwise grab from the pool.
-         vb = mVBPool.last();
-         mVBPool.pop_back();
-      }
+      // Nothing was clipped for these decals yet.
+      if ( currentBatch->iCount == 0 || currentBatch->vCount == 0 )
+         continue;
 
-      // Push into our vector of 'in use' buffers.
-      mVBs.push_back( vb );
-      
-      // Ready to start filling.
-      vpPtr = vb->lock();
+      // Get video memory buffers we will be filling from the device
+      // pool, they stay valid until the end of the frame.
+      GFXTransientBufferPool *bufferPool = GFX->getTransientBufferPool();
 
-      // Same deal as above...      
-      GFXPrimitiveBufferHandle *pb = NULL;
-      if ( mPBPool.empty() )
-      {
-         pb = new GFXPrimitiveBufferHandle;
-         pb->set( GFX, smMaxIndices, 0, GFXBufferTypeDynamic );   
-      }
-      else
-      {
-         pb = mPBPool.last();
-         mPBPool.pop_back();
-      }
-      mPBs.push_back( pb );
-      
-      pb->lock( &pbPtr );
+      GFXTransientVertexBuffer *vb = bufferPool->allocVertexBuffer<DecalVertex>( currentBatch->vCount );
+      vpPtr = vb->lock<DecalVertex>( 0, currentBatch->vCount );
+
+      GFXPrimitiveBufferHandle *pb = bufferPool->allocPrimitiveBuffer( currentBatch->iCount );
+      pb->lock( &pbPtr, NULL, 0, currentBatch->iCount );
 
       // Memcpy from system to video memory.
       const U32 vpCount = sizeof( DecalVertex ) * currentBatch->vCount;
@@ -1348,11 +1406,6 @@ void DecalManager::prepRenderImage( SceneRenderState* state )
       pb->unlock();
       vb->unlock();
 
-      // DecalManager must hold handles to these buffers so they remain valid,
-      // we don't actually use them elsewhere.
-      //mPBs.push_back( pb );
-      //mVBs.push_back( vb );
-
       // Get the best lights for the current camera position
       // if the materail is forward lit and we haven't got them yet.
       if ( currentBatch->matInst->isForwardLit() && !baseRenderInst.lights[0] )
@@ -1397,7 +1450,7 @@ void DecalManager::prepRenderImage( SceneRenderState* state )
 
 #ifdef TORQUE_GATHER_METRICS
    Con::setIntVariable( "$Decal::Batches", batches.size() );
-   Con::setIntVariable( "$Decal::Buffers", mPBs.size() + mPBPool.size() );
+   Con::setIntVariable( "$Decal::Buffers", batches.size() * 2 );
    Con::setIntVariable( "$Decal::DecalsRendered", mDecalQueue.size() );
 #endif
 
@@ -1532,8 +1585,6 @@ void DecalManager::clearData()
    
    mData = NULL;
    mDecalInstanceVec.clear();
-
-   _freePools();   
 }
 
 bool DecalManager::onSceneAdd()
@@ -93,22 +93,36 @@ class DecalManager : public SceneObject
 
    protected:
       
-      /// The clipper we keep around between decal updates
-      /// to avoid excessive memory allocations.
-      ClippedPolyList mClipper;
+      /// The scene geometry clipped to a decal and the render
+      /// geometry built from it.
+      struct ClipJob
+      {
+         DecalInstance *decal;
+         ClippedPolyList clipper;
+         Vector<DecalVertex> verts;
+         Vector<U16> indices;
+      };
+
+      /// The job used by clipDecal() which we keep around between
+      /// decal updates to avoid excessive memory allocations.
+      ClipJob mClipJob;
+
+      /// The jobs for the decals clipped in prepRenderImage(), kept
+      /// around for the same reason.
+      Vector<ClipJob*> mClipJobs;
+
+      /// The decals waiting to be clipped this frame.
+      Vector<DecalInstance*> mClipQueue;
 
       Vector<DecalInstance*> mDecalQueue;
 
+      /// Scratch list for the decal sphere queries.
+      Vector<DecalSphere*> mSphereQuery;
+
       StringTableEntry mDataFileName;
       Resource<DecalDataFile> mData;
       
       Signal< void() > mClearDataSignal;
-      
-      Vector< GFXVertexBufferHandle<DecalVertex>* > mVBs;
-      Vector< GFXPrimitiveBufferHandle* > mPBs;
-
-      Vector< GFXVertexBufferHandle<DecalVertex>* > mVBPool;
-      Vector< GFXPrimitiveBufferHandle* > mPBPool;
 
       DecalInstance::DecalDataChunker mChunkers;
 
@@ -135,7 +149,7 @@ class DecalManager : public SceneObject
 
       static bool smDecalsOn;
       static F32 smDecalLifeTimeScale;   
-      static bool smPoolBuffers;
+      static S32 smMaxClipsPerFrame;
       static const U32 smMaxVerts;
       static const U32 smMaxIndices;
 
@@ -156,6 +170,35 @@ class DecalManager : public SceneObject
 
       U32 _generateConvexHull( const Vector<Point3F> &points, Vector<Point3F> *outPoints );
 
+      /// @name Clipping
+      /// @{
+
+      /// Gather the scene geometry within the decal volume into the job
+      /// clipper.  This goes through the scene container so it must be
+      /// done on the main thread.
+      void _clipDecalPolys( ClipJob *job, const Point2F *clipDepth );
+
+      /// Triangulate the clipped polys and build the decal vertices and
+      /// indices into the job.  This only touches the job and the decal
+      /// data so it is safe to run on a worker thread.
+      ///
+      /// @return False if the clipped geometry is empty or too big to render.
+      bool _buildDecalGeometry( ClipJob *job );
+
+      /// Copy the geometry built in the job into the decal buffers.
+      void _commitDecalGeometry( ClipJob *job );
+
+      /// Clip all the decals in #mClipQueue, spreading the geometry
+      /// building over the thread pool.
+      ///
+      /// @return The number of decals that failed to clip.
+      U32 _clipQueuedDecals();
+
+      /// @}
+
+      /// Set the vertex colors of the decal for its fade.
+      void _updateDecalAlpha( DecalInstance *dinst, F32 pixelSize );
+
       // Rendering
       void prepRenderImage( SceneRenderState *state ) override;
       
@@ -165,12 +208,6 @@ class DecalManager : public SceneObject
       // held by DecalInstance.
       void _allocBuffers( DecalInstance *inst );
       void _freeBuffers( DecalInstance *inst );
-      void _freePools();
-
-      // Hide this from Doxygen
-      /// @cond
-      bool _handleGFXEvent(GFXDevice::GFXDeviceEventType event);
-      /// @endcond
 
       void _renderDecalSpheres( ObjectRenderInst* inst, SceneRenderState* state, BaseMatInstance* overrideMat );
 
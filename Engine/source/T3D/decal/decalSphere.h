@@ -47,11 +47,13 @@ class DecalSphere
       static F32 smRadiusTolerance;
 
       DecalSphere()
+         : mCellKey( 0 )
       {
          VECTOR_SET_ASSOCIATION( mItems );
          VECTOR_SET_ASSOCIATION( mZones );
       }
       DecalSphere( const Point3F &position, F32 radius )
+         : mCellKey( 0 )
       {
          VECTOR_SET_ASSOCIATION( mItems );
          VECTOR_SET_ASSOCIATION( mZones );
@@ -76,6 +78,9 @@ class DecalSphere
       /// World-space sphere corresponding to this DecalSphere.
       SphereF mWorldSphere;
 
+      /// The DecalDataFile spatial hash cell this sphere is filed under.
+      U32 mCellKey;
+
       ///
       bool tryAddItem( DecalInstance* inst );
 };
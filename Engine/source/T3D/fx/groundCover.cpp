@@ -51,6 +51,7 @@
 #include "console/engineAPI.h"
 #include "T3D/assets/MaterialAsset.h"
 #include "T3D/assets/TerrainMaterialAsset.h"
+#include "platform/threads/threadPool.h"
 
 /// This is used for rendering ground cover billboards.
 GFXImplementVertexFormat( GCVertex )
@@ -105,6 +106,7 @@ class GroundCoverCell
 protected:
 
    friend class GroundCover;
+   friend class GroundCoverCellJob;
 
    struct Placement
    {
@@ -121,6 +123,9 @@ protected:
    /// This is the x,y index for this cell.
    Point2I mIndex;
 
+   /// The x,y index of this cell in the world.
+   Point2I mWorldIndex;
+
    /// The worldspace bounding box this cell.
    Box3F mBounds;
 
@@ -141,16 +146,30 @@ protected:
    /// prepared billboards for this cell.
    VBHandleVector mVBs;
 
+   /// The billboard vertices packed along with the placement
+   /// and released once they are copied into mVBs.
+   Vector<GCVertex> mVerts;
+
    /// Used to mark the cell dirty and in need
    /// of a rebuild.
    bool mDirty;
 
-   /// Repacks the billboards into the vertex buffer.
+   /// Set while the cover is being placed on a worker thread.
+   volatile U32 mPending;
+
+   /// Set when the terrain changed under a cached cell
+   /// so that it gets thrown away instead of reused.
+   bool mStale;
+
+   /// Packs the billboards into mVerts.
+   void _buildVerts();
+
+   /// Copies the packed billboards into the vertex buffer.
    void _rebuildVB();
 
 public:
 
-   GroundCoverCell() : mDirty(false) {}
+   GroundCoverCell() : mDirty(false), mPending(0), mStale(false) {}
 
    ~GroundCoverCell() 
    {
@@ -158,6 +177,16 @@ public:
    }
 
    const Point2I& shiftIndex( const Point2I& shift ) { return mIndex += shift; }
+
+   /// Returns true while the cover is being placed on a worker
+   /// thread.  Nothing else in the cell may be touched until then.
+   bool isPending() { return dAtomicRead( mPending ) != 0; }
+
+   /// Returns the approximate memory used by the cell.
+   U32 getMemorySize() const;
+
+   /// Frees the placements and vertex buffers.
+   void releaseMemory();
    
    /// The worldspace bounding box this cell.
    const Box3F& getBounds() const { return mBounds; }
@@ -179,6 +208,68 @@ public:
                         TSShapeInstance** shapes );
 };
 
+void GroundCoverCell::_buildVerts()
+{
+   PROFILE_SCOPE(GroundCover_BuildVerts);
+
+   mVerts.setSize( mBillboards.size() * 4 );
+   GCVertex* vertPtr = mVerts.address();
+
+   GFXVertexColor color;
+
+   Vector<Placement>::const_iterator iter = mBillboards.begin();
+   for ( ; iter != mBillboards.end(); iter++ )
+   {
+      const Point3F &position = (*iter).point;
+      const Point3F &normal = (*iter).normal;
+      const S32 &type = (*iter).type;
+      const Point3F &size = (*iter).size;
+      const F32 &windAmplitude = (*iter).windAmplitude;
+      color = LinearColorF((*iter).lmColor).toColorI();
+      U8 *col = (U8 *)const_cast<U32 *>( (const U32 *)color );
+
+      vertPtr->point = position;
+      vertPtr->normal = normal;
+      vertPtr->params.x = size.x;
+      vertPtr->params.y = size.y;
+      vertPtr->params.z = type;
+      vertPtr->params.w = 0;
+      col[3] = 0;
+      vertPtr->ambient = color;
+      ++vertPtr;
+
+      vertPtr->point = position;
+      vertPtr->normal = normal;
+      vertPtr->params.x = size.x;
+      vertPtr->params.y = size.y;
+      vertPtr->params.z = type;
+      vertPtr->params.w = 0;
+      col[3] = 1;
+      vertPtr->ambient = color;
+      ++vertPtr;
+
+      vertPtr->point = position;
+      vertPtr->normal = normal;
+      vertPtr->params.x = size.x;
+      vertPtr->params.y = size.y;
+      vertPtr->params.z = type;
+      vertPtr->params.w = windAmplitude;
+      col[3] = 2;
+      vertPtr->ambient = color;
+      ++vertPtr;
+
+      vertPtr->point = position;
+      vertPtr->normal = normal;
+      vertPtr->params.x = size.x;
+      vertPtr->params.y = size.y;
+      vertPtr->params.z = type;
+      vertPtr->params.w = windAmplitude;
+      col[3] = 3;
+      vertPtr->ambient = color;
+      ++vertPtr;
+   }
+}
+
 void GroundCoverCell::_rebuildVB()
 {
    if ( mBillboards.empty() )
@@ -186,6 +277,11 @@ void GroundCoverCell::_rebuildVB()
 
    PROFILE_SCOPE(GroundCover_RebuildVB);
 
+   // The vertices are normally packed on the
+   // worker thread which placed the cover.
+   if ( mVerts.size() != mBillboards.size() * 4 )
+      _buildVerts();
+
    // The maximum verts we can put in one vertex buffer batch.
    const U32 MAX_BILLBOARDS = 0xFFFF / 4;
 
@@ -202,8 +298,8 @@ void GroundCoverCell::_rebuildVB()
    // the list... those are freed.
    mVBs.setSize( batches ); 
 
-   // Get the iter to the first billboard.
-   Vector<Placement>::const_iterator iter = mBillboards.begin();
+   // The batches take the billboards in order.
+   const GCVertex *srcPtr = mVerts.address();
 
    // Prepare each batch.
    U32 bb, remaining = mBillboards.size();
@@ -230,65 +326,78 @@ void GroundCoverCell::_rebuildVB()
 
       // Fill this puppy!
       GCVertex* vertPtr = vb.lock( 0, verts );
-      
-      GFXVertexColor color;
+      dMemcpy( vertPtr, srcPtr, verts * sizeof( GCVertex ) );
+      srcPtr += verts;
+      vb.unlock();
+   }
 
-      Vector<Placement>::const_iterator last = iter + bb;
-      for ( ; iter != last; iter++ )
-      {
-         const Point3F &position = (*iter).point;
-         const Point3F &normal = (*iter).normal;
-         const S32 &type = (*iter).type;
-         const Point3F &size = (*iter).size;
-         const F32 &windAmplitude = (*iter).windAmplitude;
-         color = LinearColorF((*iter).lmColor).toColorI();
-         U8 *col = (U8 *)const_cast<U32 *>( (const U32 *)color );
-
-         vertPtr->point = position;
-         vertPtr->normal = normal;
-         vertPtr->params.x = size.x;
-         vertPtr->params.y = size.y;
-         vertPtr->params.z = type;
-         vertPtr->params.w = 0;
-         col[3] = 0;
-         vertPtr->ambient = color;
-         ++vertPtr;
-
-         vertPtr->point = position;
-         vertPtr->normal = normal;
-         vertPtr->params.x = size.x;
-         vertPtr->params.y = size.y;
-         vertPtr->params.z = type;
-         vertPtr->params.w = 0;
-         col[3] = 1;
-         vertPtr->ambient = color;
-         ++vertPtr;
-
-         vertPtr->point = position;
-         vertPtr->normal = normal;
-         vertPtr->params.x = size.x;
-         vertPtr->params.y = size.y;
-         vertPtr->params.z = type;
-         vertPtr->params.w = windAmplitude;
-         col[3] = 2;
-         vertPtr->ambient = color;
-         ++vertPtr;
-
-         vertPtr->point = position;
-         vertPtr->normal = normal;
-         vertPtr->params.x = size.x;
-         vertPtr->params.y = size.y;
-         vertPtr->params.z = type;
-         vertPtr->params.w = windAmplitude;
-         col[3] = 3;
-         vertPtr->ambient = color;
-         ++vertPtr;
-      }
+   // The VBs hold the vertices now.
+   mVerts.clear();
+   mVerts.compact();
+}
 
-      vb.unlock();
+U32 GroundCoverCell::getMemorySize() const
+{
+   U32 size = sizeof( GroundCoverCell ) + mBillboards.memSize() + mShapes.memSize() + mVerts.memSize();
+   for ( U32 i = 0; i < mVBs.size(); i++ )
+   {
+      if ( !mVBs[i].isNull() )
+         size += mVBs[i]->mNumVerts * sizeof( GCVertex );
    }
+
+   return size;
 }
 
+void GroundCoverCell::releaseMemory()
+{
+   mBillboards.clear();
+   mBillboards.compact();
+   mShapes.clear();
+   mShapes.compact();
+   mVerts.clear();
+   mVerts.compact();
+   mVBs.clear();
+   mDirty = false;
+}
+
+/// Places the cover for a cell on a worker thread.
+class GroundCoverCellJob : public ThreadPool::WorkItem
+{
+public:
+
+   typedef ThreadPool::WorkItem Parent;
+
+   GroundCoverCellJob( GroundCover *cover, GroundCoverCell *cell, const Vector<SceneObject*> &terrains )
+      : mCover( cover ),
+        mCell( cell ),
+        mTerrains( terrains )
+   {
+   }
+
+protected:
+
+   /// The GroundCover waits for all its jobs
+   /// before it changes or goes away.
+   GroundCover *mCover;
+
+   GroundCoverCell *mCell;
+
+   /// The terrains at the time the job was queued.  The
+   /// GroundCover waits for us before any are deleted.
+   Vector<SceneObject*> mTerrains;
+
+   void execute() override
+   {
+      mCover->_placeCell( mCell, mTerrains );
+
+      dCompareAndSwap( mCell->mPending, 1, 0 );
+
+      // The cover may be deleted as soon as this is
+      // released, so it must be the last thing we touch.
+      mCover->mCellsDone.release();
+   }
+};
+
 U32 GroundCoverCell::renderShapes(  const TSRenderState &rdata,
                                     Frustum *culler, 
                                     TSShapeInstance** shapes )
@@ -424,6 +533,9 @@ U32 GroundCover::smStatRenderedCells = 0;
 U32 GroundCover::smStatRenderedBillboards = 0;
 U32 GroundCover::smStatRenderedBatches = 0;
 U32 GroundCover::smStatRenderedShapes = 0;
+U32 GroundCover::smStatCachedCells = 0;
+S32 GroundCover::smCellCacheBudget = 16;
+F32 GroundCover::smPrefetchTime = 1.0f;
 F32 GroundCover::smDensityScale = 1.0f;
 F32 GroundCover::smFadeScale = 1.0f;
 
@@ -433,6 +545,7 @@ ConsoleDocClass( GroundCover,
 );
 
 GroundCover::GroundCover()
+   : mCellsDone( 0 )
 {
    mTypeMask |= StaticObjectType | StaticShapeObjectType;
    mNetFlags.set( Ghostable | ScopeAlways );
@@ -453,6 +566,11 @@ GroundCover::GroundCover()
    mMaxPlacement = 1000;
    mLastPlacementCount = 0;
 
+   mPendingCells = 0;
+   mLastCameraPos.zero();
+   mLastCameraTime = 0;
+   mCameraVelocity.zero();
+
    mDebugRenderCells = false;
    mDebugNoBillboards = false;
    mDebugNoShapes = false;
@@ -646,6 +764,15 @@ void GroundCover::consoleInit()
 	   "@ingroup Foliage\n");
    Con::addVariable( "$GroundCover::renderedShapes", TypeS32, &smStatRenderedShapes, "Stat for number of rendered shapes.\n"
 	   "@ingroup Foliage\n");
+   Con::addVariable( "$GroundCover::cachedCells", TypeS32, &smStatCachedCells, "Stat for number of cells kept outside of the grid.\n"
+	   "@ingroup Foliage\n");
+
+   Con::addVariable( "$pref::GroundCover::cacheBudget", TypeS32, &smCellCacheBudget, "Megabytes of generated cells outside of the grid, including those "
+      "generated ahead of the camera, to keep for reuse.\n"
+	   "@ingroup Foliage\n");
+   Con::addVariable( "$pref::GroundCover::prefetchTime", TypeF32, &smPrefetchTime, "How many seconds ahead along the camera motion to generate cells "
+      "on worker threads.  Zero disables prefetching.\n"
+	   "@ingroup Foliage\n");
 
    Parent::consoleInit();
 }
@@ -691,6 +818,16 @@ void GroundCover::onRemove()
    removeFromScene();
 }
 
+void GroundCover::onDeleteNotify( SimObject *object )
+{
+   // The cells are generated from this terrain, so make
+   // sure no worker is still reading from it.
+   if ( mNotifyTerrains.remove( object ) )
+      _freeCells();
+
+   Parent::onDeleteNotify( object );
+}
+
 void GroundCover::inspectPostApply()
 {
    Parent::inspectPostApply();
@@ -786,6 +923,9 @@ void GroundCover::unpackUpdate( NetConnection *connection, BitStream *stream )
 
    if (stream->readFlag())
    {
+      // The workers read these fields while placing cover.
+      _waitForPendingCells();
+
       UNPACK_ASSET(connection, Material);
 
       stream->read( &mRadius );
@@ -909,6 +1049,8 @@ void GroundCover::_deleteShapes()
 
 void GroundCover::_deleteCells()
 {
+   _waitForPendingCells();
+
    // Delete the allocation list.
    for ( S32 i=0; i < mAllocCellList.size(); i++ )
       delete mAllocCellList[i];
@@ -920,9 +1062,13 @@ void GroundCover::_deleteCells()
 
 void GroundCover::_freeCells()
 {
-   // Zero the grid and scratch space.
+   _waitForPendingCells();
+
+   // Zero the grid, cache, and scratch space.
    mCellGrid.clear();
    mScratchGrid.clear();
+   mCellCache.clear();
+   smStatCachedCells = 0;
 
    // Compact things... remove excess allocated cells.
    const U32 maxCells = mGridSize * mGridSize;
@@ -946,6 +1092,88 @@ void GroundCover::_recycleCell( GroundCoverCell* cell )
    mFreeCellList.push_back( cell );
 }
 
+void GroundCover::_waitForPendingCells()
+{
+   PROFILE_SCOPE( GroundCover_WaitForPendingCells );
+
+   for ( ; mPendingCells > 0; mPendingCells-- )
+      mCellsDone.acquire();
+}
+
+void GroundCover::_collectDoneCells()
+{
+   while ( mPendingCells > 0 && mCellsDone.acquire( false ) )
+      mPendingCells--;
+}
+
+GroundCoverCell* GroundCover::_takeCachedCell( const Point2I &worldIndex )
+{
+   for ( U32 i = 0; i < mCellCache.size(); i++ )
+   {
+      GroundCoverCell *cell = mCellCache[i];
+      if ( cell->mWorldIndex != worldIndex )
+         continue;
+
+      mCellCache.erase( i );
+      return cell;
+   }
+
+   return NULL;
+}
+
+bool GroundCover::_isCellCached( const Point2I &worldIndex ) const
+{
+   for ( U32 i = 0; i < mCellCache.size(); i++ )
+   {
+      if ( mCellCache[i]->mWorldIndex == worldIndex )
+         return true;
+   }
+
+   return false;
+}
+
+void GroundCover::_trimCellCache()
+{
+   PROFILE_SCOPE( GroundCover_TrimCellCache );
+
+   // The worker owns the placements of pending cells
+   // so they are left out until they are done.
+   U64 cacheSize = 0;
+   for ( U32 i = 0; i < mCellCache.size(); i++ )
+   {
+      if ( !mCellCache[i]->isPending() )
+         cacheSize += mCellCache[i]->getMemorySize();
+   }
+
+   const U64 budget = U64( getMax( smCellCacheBudget, 0 ) ) << 20;
+
+   for ( U32 i = 0; i < mCellCache.size(); )
+   {
+      GroundCoverCell *cell = mCellCache[i];
+
+      // We can't touch the cell until the worker is done.
+      if ( cell->isPending() || ( cacheSize <= budget && !cell->mStale ) )
+      {
+         i++;
+         continue;
+      }
+
+      // Free the least recently used cells first and
+      // release their memory so the budget holds.
+      cacheSize -= cell->getMemorySize();
+      mCellCache.erase( i );
+      cell->releaseMemory();
+      _recycleCell( cell );
+   }
+
+   smStatCachedCells = mCellCache.size();
+}
+
+bool GroundCover::_isCellPending( GroundCoverCell *cell )
+{
+   return cell->isPending();
+}
+
 void GroundCover::_initialize( U32 cellCount, U32 cellPlacementCount )
 {
    // Cleanup everything... we're starting over.
@@ -1050,17 +1278,8 @@ void GroundCover::_initialize( U32 cellCount, U32 cellPlacementCount )
    }
 }
 
-GroundCoverCell* GroundCover::_generateCell( const Point2I& index, 
-                                             const Box3F& bounds, 
-                                             U32 placementCount,
-                                             S32 randSeed )
+GroundCoverCell* GroundCover::_allocCell( const Point2I &worldIndex, const Box3F &bounds )
 {
-   PROFILE_SCOPE(GroundCover_GenerateCell);
-
-   const Vector<SceneObject*> terrainBlocks = getContainer()->getTerrains();
-   if ( terrainBlocks.empty() )
-      return NULL;
-
    // Grab a free cell or allocate a new one.
    GroundCoverCell* cell;
    if ( mFreeCellList.empty() )
@@ -1075,9 +1294,29 @@ GroundCoverCell* GroundCover::_generateCell( const Point2I& index,
    }
 
    cell->mDirty = true;
-   cell->mIndex = index;
+   cell->mStale = false;
+   cell->mWorldIndex = worldIndex;
    cell->mBounds = bounds;
 
+   return cell;
+}
+
+void GroundCover::_queueCell( GroundCoverCell *cell, const Vector<SceneObject*> &terrains )
+{
+   cell->mPending = 1;
+   mPendingCells++;
+
+   ThreadPool::GLOBAL().queueWorkItem( new GroundCoverCellJob( this, cell, terrains ) );
+}
+
+void GroundCover::_placeCell( GroundCoverCell *cell, const Vector<SceneObject*> &terrainBlocks ) const
+{
+   PROFILE_SCOPE(GroundCover_PlaceCell);
+
+   const Box3F bounds = cell->mBounds;
+   const U32 placementCount = mLastPlacementCount;
+   const S32 randSeed = mRandomSeed + mAbs( cell->mWorldIndex.x ) + mAbs( cell->mWorldIndex.y );
+
    Point3F pos( 0, 0, 0 );
 
    Box3F renderBounds = bounds;
@@ -1373,7 +1612,7 @@ GroundCoverCell* GroundCover::_generateCell( const Point2I& index,
    cell->mBounds.minExtents.z = renderBounds.minExtents.z;
    cell->mBounds.maxExtents.z = renderBounds.maxExtents.z;
 
-   return cell;
+   cell->_buildVerts();
 }
 
 void GroundCover::onTerrainUpdated( U32 flags, TerrainBlock *tblock, const Point2I& min, const Point2I& max )
@@ -1396,6 +1635,10 @@ void GroundCover::onTerrainUpdated( U32 flags, TerrainBlock *tblock, const Point
          flags & TerrainBlock::LayersUpdate ||
          flags & TerrainBlock::EmptyUpdate )
    {
+      // The workers may be reading the terrain and write the
+      // cell bounds, so let them finish before we look at them.
+      _waitForPendingCells();
+
       // Convert the min and max into world space.
       const F32 size = tblock->getSquareSize();
       const Point3F pos = tblock->getPosition();
@@ -1411,14 +1654,25 @@ void GroundCover::onTerrainUpdated( U32 flags, TerrainBlock *tblock, const Point
          if ( !cell )
             continue;
 
+         const Box3F& bounds = cell->getBounds();
+         dirty.minExtents.z = bounds.minExtents.z;
+         dirty.maxExtents.z = bounds.maxExtents.z;
+         if ( !bounds.isOverlapped( dirty ) )
+            continue;
+
+         mCellGrid[ i ] = NULL;
+         _recycleCell( cell );
+      }
+
+      // The cached cells get freed on the next trim.
+      for ( S32 i = 0; i < mCellCache.size(); i++ )
+      {
+         GroundCoverCell* cell = mCellCache[ i ];
          const Box3F& bounds = cell->getBounds();
          dirty.minExtents.z = bounds.minExtents.z;
          dirty.maxExtents.z = bounds.maxExtents.z;
          if ( bounds.isOverlapped( dirty ) )
-         {
-            mCellGrid[ i ] = NULL;
-            _recycleCell( cell );
-         }
+            cell->mStale = true;
       }
    }
 }
@@ -1427,6 +1681,8 @@ void GroundCover::_updateCoverGrid( const Frustum &culler )
 {
    PROFILE_SCOPE( GroundCover_UpdateCoverGrid );
    
+   _collectDoneCells();
+
    mGridSize = getMax( mGridSize, (U32)2 );
 
    // How many cells in the grid?
@@ -1456,8 +1712,9 @@ void GroundCover::_updateCoverGrid( const Frustum &culler )
    const F32 cellSize = ( mRadius * 2.0f ) / (F32)(mGridSize - 1);
 
    // Figure out the root index of the new grid based on the camera position.
-   Point2I index( (S32)mFloor( ( culler.getPosition().x - mRadius ) / cellSize  ),
-                  (S32)mFloor( ( culler.getPosition().y - mRadius ) / cellSize ) );
+   const Point3F &cameraPos = culler.getPosition();
+   Point2I index( (S32)mFloor( ( cameraPos.x - mRadius ) / cellSize  ),
+                  (S32)mFloor( ( cameraPos.y - mRadius ) / cellSize ) );
 
    // Figure out the cell shift between the old and new grid positions.
    Point2I shift = mGridIndex - index;
@@ -1466,6 +1723,18 @@ void GroundCover::_updateCoverGrid( const Frustum &culler )
    bool didWarp = shift.x > 1 || shift.x < -1 || 
                   shift.y > 1 || shift.y < -1 ? true : false;
 
+   // Track the camera velocity for prefetching.
+   const U32 cameraTime = Platform::getRealMilliseconds();
+   if ( didWarp || mLastCameraTime == 0 )
+      mCameraVelocity.zero();
+   else if ( cameraTime > mLastCameraTime )
+   {
+      const VectorF velocity = ( cameraPos - mLastCameraPos ) / ( F32( cameraTime - mLastCameraTime ) * 0.001f );
+      mCameraVelocity = ( mCameraVelocity + velocity ) * 0.5f;
+   }
+   mLastCameraPos = cameraPos;
+   mLastCameraTime = cameraTime;
+
    // Go thru the grid shifting each cell we find and
    // placing them in the scratch grid.
    for ( S32 i = 0; i < mCellGrid.size(); i++ )
@@ -1477,11 +1746,12 @@ void GroundCover::_updateCoverGrid( const Frustum &culler )
       // Whats our new index?
       Point2I newIndex = cell->shiftIndex( shift );
 
-      // Is this cell outside of the new grid?
+      // Is this cell outside of the new grid?  Then keep
+      // it around in case the camera comes back.
       if (  newIndex.x < 0 || newIndex.x >= mGridSize ||
             newIndex.y < 0 || newIndex.y >= mGridSize )
       {
-         _recycleCell( cell );
+         mCellCache.push_back( cell );
          continue;
       }
 
@@ -1493,21 +1763,29 @@ void GroundCover::_updateCoverGrid( const Frustum &culler )
    F32   terrainMinHeight = -5000.0f, 
          terrainMaxHeight = 5000.0f;
 
+   // The cover is placed on the terrains, so we need to
+   // know before any of them go away.
+   const Vector<SceneObject*> &terrains = getContainer()->getTerrains();
+   for ( U32 i = 0; i < terrains.size(); i++ )
+   {
+      if ( mNotifyTerrains.contains( terrains[i] ) )
+         continue;
+
+      deleteNotify( terrains[i] );
+      mNotifyTerrains.push_back( terrains[i] );
+   }
+
    // Go thru the scratch grid copying each cell back to the
    // cell grid and creating new cells as needed.
    //
-   // By limiting ourselves to only one new cell generation per
-   // update we're lowering the performance hiccup during movement
-   // without getting into the complexity of threading.  The delay
-   // in generation is rarely noticeable in normal play.
-   //
-   // The only caveat is that we need to generate the entire visible
-   // grid when we warp.
-   U32 cellsGenerated = 0;
+   // New cells are generated on the thread pool and show up 
+   // once they are done, unless we warped in which case we 
+   // generate the entire visible grid before continuing.
+   Vector<GroundCoverCell*> warpCells;
    for ( S32 i = 0; i < mScratchGrid.size(); i++ )
    {
       GroundCoverCell* cell = mScratchGrid[ i ];
-      if ( !cell && ( cellsGenerated == 0 || didWarp ) )
+      if ( !cell && !terrains.empty() )
       {
          // Get the index point of this new cell.
          S32 y = i / mGridSize;
@@ -1525,36 +1803,88 @@ void GroundCover::_updateCoverGrid( const Frustum &culler )
             continue;
          }
 
-         // We need to allocate a new cell.
-         //
-         // TODO: This is the expensive call and where we should optimize. In
-         // particular the next best optimization would be to take advantage of
-         // multiple cores so that we can generate all the cells in one update.
-         //
-         // Instead of generating the cell here we would allocate a cell and stick
-         // it into a thread safe queue (maybe lockless) as well as the mCellGrid.
-         // Once all were allocated we would do something like this...
-         //
-         // TorqueParallelProcess( cellsToGenerateQueue, _generateCell );
-         //
-         // Internally this function would pass the queue to some global pre-allocated
-         // worker threads which are locked to a particular core.  While the main 
-         // thread waits for the worker threads to finish it will process cells itself.
-         // 
-
-         cell = _generateCell(   newIndex - index, 
-                                 bounds, 
-                                 placementCount, 
-                                 mRandomSeed + mAbs( newIndex.x ) + mAbs( newIndex.y ) );
-
-         // Increment our generation count.
-         if ( cell )
-            ++cellsGenerated;
+         // Use the cached or prefetched cell if we have it.
+         cell = _takeCachedCell( newIndex );
+         if ( cell && cell->mStale && !cell->isPending() )
+         {
+            _recycleCell( cell );
+            cell = NULL;
+         }
+
+         if ( !cell )
+         {
+            cell = _allocCell( newIndex, bounds );
+            if ( didWarp )
+               warpCells.push_back( cell );
+            else
+               _queueCell( cell, terrains );
+         }
+
+         cell->mIndex.set( x, y );
       }
 
       mCellGrid[ i ] = cell;
    }
 
+   if ( !warpCells.empty() )
+   {
+      struct PlaceCells
+      {
+         const GroundCover *cover;
+         GroundCoverCell *const *cells;
+         const Vector<SceneObject*> *terrains;
+
+         void operator()( U32 i ) { cover->_placeCell( cells[i], *terrains ); }
+      };
+
+      PlaceCells place = { this, warpCells.address(), &terrains };
+      ThreadPool::GLOBAL().parallelFor( warpCells.size(), place );
+   }
+
+   // Queue up the cells of the grid the camera is heading 
+   // towards so they are ready by the time we get there.
+   if ( smPrefetchTime > 0.0f && !didWarp && !terrains.empty() )
+   {
+      PROFILE_SCOPE( GroundCover_Prefetch );
+
+      const Point3F aheadPos = cameraPos + mCameraVelocity * smPrefetchTime;
+      const Point2I aheadIndex(  (S32)mFloor( ( aheadPos.x - mRadius ) / cellSize  ),
+                                 (S32)mFloor( ( aheadPos.y - mRadius ) / cellSize ) );
+
+      // Don't flood the thread pool when moving very fast.
+      const U32 maxPending = mGridSize * 2;
+
+      for ( S32 y = 0; y < mGridSize && aheadIndex != index; y++ )
+      {
+         for ( S32 x = 0; x < mGridSize; x++ )
+         {
+            if ( mPendingCells >= maxPending )
+               break;
+
+            const Point2I newIndex = aheadIndex + Point2I( x, y );
+
+            // Skip the cells in the current grid.
+            const Point2I gridIndex = newIndex - index;
+            if (  gridIndex.x >= 0 && gridIndex.x < mGridSize &&
+                  gridIndex.y >= 0 && gridIndex.y < mGridSize )
+               continue;
+
+            if ( _isCellCached( newIndex ) )
+               continue;
+
+            Box3F bounds;
+            bounds.minExtents.set( newIndex.x * cellSize, newIndex.y * cellSize, terrainMinHeight );
+            bounds.maxExtents.set( bounds.minExtents.x + cellSize, bounds.minExtents.y + cellSize, terrainMaxHeight );
+
+            GroundCoverCell *cell = _allocCell( newIndex, bounds );
+            _queueCell( cell, terrains );
+            mCellCache.push_back( cell );
+         }
+      }
+   }
+
+   _trimCellCache();
+
    // Store the new grid index.
    mGridIndex = index;
 }
@@ -1668,7 +1998,7 @@ void GroundCover::prepRenderImage( SceneRenderState *state )
       for ( S32 i = 0; i < mCellGrid.size(); i++ )
       {
          GroundCoverCell* cell = mCellGrid[ i ];
-         if ( !cell )
+         if ( !cell || cell->isPending() )
             continue;
 
          if ( mCuller.isCulled( cell->getRenderBounds() ) )
@@ -1700,7 +2030,7 @@ void GroundCover::prepRenderImage( SceneRenderState *state )
       for ( S32 i = 0; i < mCellGrid.size(); i++ )
       {
          GroundCoverCell* cell = mCellGrid[ i ];
-         if ( !cell || mDebugNoShapes )
+         if ( !cell || cell->isPending() || mDebugNoShapes )
             continue;
 
          const Box3F &renderBounds = cell->getRenderBounds();
@@ -1748,7 +2078,7 @@ void GroundCover::_debugRender( ObjectRenderInst *ri, SceneRenderState *state, B
    for ( S32 i = 0; i < mCellGrid.size(); i++ )
    {
       GroundCoverCell* cell = mCellGrid[ i ];
-      if ( !cell || ( cell->mBillboards.size() + cell->mShapes.size() ) == 0 )
+      if ( !cell || cell->isPending() || ( cell->mBillboards.size() + cell->mShapes.size() ) == 0 )
          continue;
 
       if ( mCuller.isCulled( cell->getRenderBounds() ) )
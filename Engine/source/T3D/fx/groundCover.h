@@ -47,6 +47,10 @@
 
 #include "T3D/assets/ShapeAsset.h"
 
+#ifndef _PLATFORM_THREAD_SEMAPHORE_H_
+#include "platform/threads/semaphore.h"
+#endif
+
 class TerrainBlock;
 class GroundCoverCell;
 class TSShapeInstance;
@@ -86,6 +90,7 @@ struct GroundCoverShaderConstData
 };
 
 class GroundCover;
+class GroundCoverCellJob;
 
 class GroundCoverShaderConstHandles : public ShaderFeatureConstHandles
 {
@@ -115,6 +120,7 @@ class GroundCover : public SceneObject
 {
    friend class GroundCoverShaderConstHandles;
    friend class GroundCoverCell;
+   friend class GroundCoverCellJob;
    typedef SceneObject Parent;
 
 public:
@@ -131,6 +137,7 @@ public:
    bool onAdd() override;
    void onRemove() override;
    void inspectPostApply() override;
+   void onDeleteNotify( SimObject *object ) override;
 
    // Network
    U32 packUpdate( NetConnection *, U32 mask, BitStream *stream ) override;
@@ -220,6 +227,30 @@ protected:
    /// the cell grid.
    CellVector mScratchGrid;
 
+   /// Cells outside of the grid which are kept for when
+   /// the camera comes back, including the prefetched ones,
+   /// ordered from least to most recently used.
+   CellVector mCellCache;
+
+   /// The number of cells queued on worker threads whose
+   /// completion has not been collected from mCellsDone.
+   U32 mPendingCells;
+
+   /// Released by a worker each time it finishes a cell.
+   Semaphore mCellsDone;
+
+   /// The terrains we have asked to be notified about
+   /// being deleted as cell generation reads from them.
+   Vector<SimObject*> mNotifyTerrains;
+
+   /// The camera position and time of the last grid update
+   /// used to estimate the camera velocity for prefetching.
+   Point3F mLastCameraPos;
+   U32 mLastCameraTime;
+
+   /// The smoothed camera velocity in meters per second.
+   VectorF mCameraVelocity;
+
    /// This is the index to the first grid cell.
    Point2I mGridIndex;
 
@@ -260,6 +291,16 @@ protected:
    /// Stat for number of rendered shapes.
    static U32 smStatRenderedShapes;
 
+   /// Stat for number of cells in the cache.
+   static U32 smStatCachedCells;
+
+   /// The memory in megabytes the cell cache may use.
+   static S32 smCellCacheBudget;
+
+   /// How many seconds ahead of the camera motion
+   /// to generate cells.  Zero disables prefetching.
+   static F32 smPrefetchTime;
+
    /// The global ground cover LOD scalar which controls
    /// the percentage of the maximum amount of cover to put
    /// down.  It scales both rendering cost and placement
@@ -402,11 +443,37 @@ protected:
    /// Returns a cell to the free list.
    void _recycleCell( GroundCoverCell* cell );
 
-   /// Generates a new cell using the recycle list when possible.
-   GroundCoverCell* _generateCell(  const Point2I& index,
-                                    const Box3F& bounds, 
-                                    U32 placementCount,
-                                    S32 randSeed );
+   /// Blocks until all the cells being generated are done.
+   void _waitForPendingCells();
+
+   /// Collects the cells the workers have finished without blocking.
+   void _collectDoneCells();
+
+   /// Returns the cached cell at the world grid index
+   /// removing it from the cache, or NULL if none.
+   GroundCoverCell* _takeCachedCell( const Point2I &worldIndex );
+
+   /// Returns true if the world grid index is cached.
+   bool _isCellCached( const Point2I &worldIndex ) const;
+
+   /// Frees the least recently used cached cells
+   /// until the cache fits the memory budget.
+   void _trimCellCache();
+
+   /// Returns true while the cell is being placed on a worker thread.
+   static bool _isCellPending( GroundCoverCell *cell );
+
+   /// Grabs a free cell or allocates a new one for
+   /// the world grid index.
+   GroundCoverCell* _allocCell( const Point2I &worldIndex, const Box3F &bounds );
+
+   /// Places the cover for the cell on a worker thread.
+   void _queueCell( GroundCoverCell *cell, const Vector<SceneObject*> &terrains );
+
+   /// Places the cover elements in a cell.  This only reads
+   /// from the GroundCover and terrains so it can be run
+   /// on a worker thread.
+   void _placeCell( GroundCoverCell *cell, const Vector<SceneObject*> &terrains ) const;
 
    void _debugRender( ObjectRenderInst *ri, SceneRenderState *state, BaseMatInstance *overrideMat );
 };
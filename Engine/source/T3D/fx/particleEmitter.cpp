@@ -37,6 +37,7 @@
 #include "math/mRandom.h"
 #include "gfx/gfxDevice.h"
 #include "gfx/primBuilder.h"
+#include "gfx/gfxTransientBufferPool.h"
 #include "gfx/gfxStringEnumTranslate.h"
 #include "renderInstance/renderPassManager.h"
 #include "T3D/gameBase/gameProcess.h"
@@ -993,7 +994,7 @@ ParticleEmitter::ParticleEmitter()
    mThetaOld = 0;
    mPhiOld = 0;
 
-   mCurBuffSize = 0;
+   mVertBuff = NULL;
 
    mDead = false;
    mDataBlock = NULL;
@@ -1189,12 +1190,12 @@ void ParticleEmitter::prepRenderImage(SceneRenderState* state)
    const Point3F &camPos = state->getCameraPosition();
    copyToVB( camPos, state->getAmbientLightColor() );
 
-   if (!mVertBuff.isValid())
+   if ( !mVertBuff )
       return;
 
    ParticleRenderInst *ri = renderManager->allocInst<ParticleRenderInst>();
 
-   ri->vertBuff = &mVertBuff;
+   ri->vertBuff = mVertBuff;
    ri->primBuff = &getDataBlock()->primBuff;
    ri->translucentSort = true;
    ri->type = RenderPassManager::RIT_Particle;
@@ -2059,16 +2060,12 @@ void ParticleEmitter::copyToVB( const Point3F &camPos, const LinearColorF &ambie
    }
 
    PROFILE_START(ParticleEmitter_copyToVB_LockCopy);
-   // create new VB if emitter size grows
-   if( !mVertBuff || n_parts > mCurBuffSize )
-   {
-      mCurBuffSize = n_parts;
-      mVertBuff.set( GFX, n_parts * 4, GFXBufferTypeDynamic );
-   }
+   // get a VB for this frame from the device pool
+   mVertBuff = GFX->getTransientBufferPool()->allocVertexBuffer<ParticleVertexType>( n_parts * 4 );
    // lock and copy tempBuff to video RAM
-   ParticleVertexType *verts = mVertBuff.lock();
+   ParticleVertexType *verts = mVertBuff->lock<ParticleVertexType>( 0, n_parts * 4 );
    dMemcpy( verts, tempBuff.address(), n_parts * 4 * sizeof(ParticleVertexType) );
-   mVertBuff.unlock();
+   mVertBuff->unlock();
    PROFILE_END();
 
    PROFILE_END();
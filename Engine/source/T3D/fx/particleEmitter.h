@@ -45,6 +45,7 @@
 #endif
 
 class RenderPassManager;
+class GFXTransientVertexBuffer;
 class ParticleData;
 
 #ifdef TORQUE_AFX_ENABLED
@@ -314,7 +315,9 @@ private:
    F32       sizes[ ParticleData::PDC_NUM_KEYS ];
    LinearColorF    colors[ ParticleData::PDC_NUM_KEYS ];
 
-   GFXVertexBufferHandle<ParticleVertexType> mVertBuff;
+   /// The vertices filled by copyToVB, only valid for the current frame.
+   /// @see GFXTransientBufferPool
+   GFXTransientVertexBuffer *mVertBuff;
 
 protected:
    //   These members are for implementing a link-list of the active emitter 
@@ -327,9 +330,6 @@ protected:
    Particle   part_list_head;
    S32        n_part_capacity;
    S32        n_parts;
-private:    
-   S32       mCurBuffSize;
-
   protected:
    F32 fade_amt;
    bool forced_bbox;
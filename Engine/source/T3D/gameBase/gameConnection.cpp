@@ -64,7 +64,7 @@
 
 #define ControlRequestTime 5000
 
-const U32 GameConnection::CurrentProtocolVersion = 12;
+const U32 GameConnection::CurrentProtocolVersion = 14;
 const U32 GameConnection::MinRequiredProtocolVersion = 12;
 
 //----------------------------------------------------------------------------
@@ -430,6 +430,7 @@ bool GameConnection::readConnectAccept(BitStream *stream, const char **errorStri
       *errorString = "CHR_PROTOCOL"; // this should never happen unless someone is faking us out.
       return false;
    }
+   setProtocolVersion(protocolVersion);
    return true;
 }
 
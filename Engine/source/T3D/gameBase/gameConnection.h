@@ -130,6 +130,10 @@ public:
    ///
    /// Torque SDK 1.1 uses protocol = 2
    /// Torque SDK 1.4 uses protocol = 12
+   ///
+   /// Protocol 13 adds ghost delta compression, see NetConnection::isGhostDeltaSupported().
+   ///
+   /// Protocol 14 adds compressed and resumable file downloads, see NetConnection::isFileBlockSupported().
    /// @{
    static const U32 CurrentProtocolVersion;
    static const U32 MinRequiredProtocolVersion;
@@ -75,6 +75,7 @@ public:
    bool      buildPolyList( PolyListContext context, AbstractPolyList* polyList, const Box3F& box, const SphereF& sphere ) override;
    void      inspectPostApply() override;
    void      setTransform( const MatrixF &mat ) override;
+   bool      isStaticGeometry() const override { return true; }
    void      setScale( const Point3F& scale ) override;
 
    static void       initPersistFields();
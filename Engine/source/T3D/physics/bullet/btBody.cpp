@@ -52,6 +52,7 @@ void BtBody::_releaseActor()
 {
    if ( mActor )
    {
+      mWorld->waitForStep();
       mWorld->getDynamicsWorld()->removeRigidBody( mActor );
       mActor->setUserPointer( NULL );
       SAFE_DELETE( mActor );
@@ -146,6 +147,7 @@ bool BtBody::init(   PhysicsCollision *shape,
 
    mActor->setCollisionFlags( btFlags );
 
+   mWorld->waitForStep();
    mWorld->getDynamicsWorld()->addRigidBody( mActor );
    mIsEnabled = true;
 
@@ -161,6 +163,7 @@ void BtBody::setMaterial(  F32 restitution,
                            F32 staticFriction )
 {
    AssertFatal( mActor, "BtBody::setMaterial - The actor is null!" );
+   mWorld->waitForStep();
 
    mActor->setRestitution( restitution );
 
@@ -180,18 +183,23 @@ void BtBody::setMaterial(  F32 restitution,
 void BtBody::setSleepThreshold( F32 linear, F32 angular )
 {
    AssertFatal( mActor, "BtBody::setSleepThreshold - The actor is null!" );
+   mWorld->waitForStep();
+
    mActor->setSleepingThresholds( linear, angular );
 }
 
 void BtBody::setDamping( F32 linear, F32 angular )
 {
    AssertFatal( mActor, "BtBody::setDamping - The actor is null!" );
+   mWorld->waitForStep();
+
    mActor->setDamping( linear, angular );
 }
 
 void BtBody::getState( PhysicsState *outState )
 {
    AssertFatal( isDynamic(), "BtBody::getState - This call is only for dynamics!" );
+   mWorld->waitForStep();
 
    // TODO: Fix this to do what we intended... to return
    // false so that the caller can early out of the state
@@ -216,6 +224,8 @@ void BtBody::getState( PhysicsState *outState )
 Point3F BtBody::getCMassPosition() const
 {
    AssertFatal( mActor, "BtBody::getCMassPosition - The actor is null!" );
+   mWorld->waitForStep();
+
    return btCast<Point3F>( mActor->getCenterOfMassTransform().getOrigin() );
 }
 
@@ -223,6 +233,7 @@ void BtBody::setLinVelocity( const Point3F &vel )
 {
    AssertFatal( mActor, "BtBody::setLinVelocity - The actor is null!" );
    AssertFatal( isDynamic(), "BtBody::setLinVelocity - This call is only for dynamics!" );
+   mWorld->waitForStep();
 
    mActor->setLinearVelocity( btCast<btVector3>( vel ) );
 }
@@ -231,6 +242,7 @@ void BtBody::setAngVelocity( const Point3F &vel )
 {
    AssertFatal( mActor, "BtBody::setAngVelocity - The actor is null!" );
    AssertFatal( isDynamic(), "BtBody::setAngVelocity - This call is only for dynamics!" );
+   mWorld->waitForStep();
 
    mActor->setAngularVelocity( btCast<btVector3>( vel ) );
 }
@@ -239,6 +251,7 @@ Point3F BtBody::getLinVelocity() const
 {
    AssertFatal( mActor, "BtBody::getLinVelocity - The actor is null!" );
    AssertFatal( isDynamic(), "BtBody::getLinVelocity - This call is only for dynamics!" );
+   mWorld->waitForStep();
 
    return btCast<Point3F>( mActor->getLinearVelocity() );
 }
@@ -247,6 +260,7 @@ Point3F BtBody::getAngVelocity() const
 {
    AssertFatal( mActor, "BtBody::getAngVelocity - The actor is null!" );
    AssertFatal( isDynamic(), "BtBody::getAngVelocity - This call is only for dynamics!" );
+   mWorld->waitForStep();
 
    return btCast<Point3F>( mActor->getAngularVelocity() );
 }
@@ -255,6 +269,7 @@ void BtBody::setSleeping( bool sleeping )
 {
    AssertFatal( mActor, "BtBody::setSleeping - The actor is null!" );
    AssertFatal( isDynamic(), "BtBody::setSleeping - This call is only for dynamics!" );
+   mWorld->waitForStep();
 
    if ( sleeping )
    {
@@ -282,6 +297,7 @@ PhysicsCollision* BtBody::getColShape()
 MatrixF& BtBody::getTransform( MatrixF *outMatrix )
 {
    AssertFatal( mActor, "BtBody::getTransform - The actor is null!" );
+   mWorld->waitForStep();
 
    if ( mInvCenterOfMass )
       outMatrix->mul( *mInvCenterOfMass, btCast<MatrixF>( mActor->getCenterOfMassTransform() ) );
@@ -294,6 +310,7 @@ MatrixF& BtBody::getTransform( MatrixF *outMatrix )
 void BtBody::setTransform( const MatrixF &transform )
 {
    AssertFatal( mActor, "BtBody::setTransform - The actor is null!" );
+   mWorld->waitForStep();
 
    if ( mCenterOfMass )
    {
@@ -319,6 +336,7 @@ void BtBody::applyCorrection( const MatrixF &transform )
 {
    AssertFatal( mActor, "BtBody::applyCorrection - The actor is null!" );
    AssertFatal( isDynamic(), "BtBody::applyCorrection - This call is only for dynamics!" );
+   mWorld->waitForStep();
 
    if ( mCenterOfMass )
    {
@@ -334,6 +352,7 @@ void BtBody::applyImpulse( const Point3F &origin, const Point3F &force )
 {
    AssertFatal( mActor, "BtBody::applyImpulse - The actor is null!" );
    AssertFatal( isDynamic(), "BtBody::applyImpulse - This call is only for dynamics!" );
+   mWorld->waitForStep();
 
    // Convert the world position to local
    MatrixF trans = btCast<MatrixF>( mActor->getCenterOfMassTransform() );
@@ -360,6 +379,7 @@ void BtBody::applyTorque( const Point3F &torque )
 {
    AssertFatal(mActor, "BtBody::applyTorque - The actor is null!");
    AssertFatal(isDynamic(), "BtBody::applyTorque - This call is only for dynamics!");
+   mWorld->waitForStep();
 
    mActor->applyTorque( btCast<btVector3>(torque) );
 
@@ -371,6 +391,7 @@ void BtBody::applyForce( const Point3F &force )
 {
    AssertFatal(mActor, "BtBody::applyForce - The actor is null!");
    AssertFatal(isDynamic(), "BtBody::applyForce - This call is only for dynamics!");
+   mWorld->waitForStep();
 
    if (mCenterOfMass)
    {
@@ -387,6 +408,8 @@ void BtBody::applyForce( const Point3F &force )
 
 Box3F BtBody::getWorldBounds()
 {   
+   mWorld->waitForStep();
+
    btVector3 min, max;
    mActor->getAabb( min, max );
 
@@ -400,6 +423,8 @@ void BtBody::setSimulationEnabled( bool enabled )
    if ( mIsEnabled == enabled )
       return;
 
+   mWorld->waitForStep();
+
    if ( !enabled )
       mWorld->getDynamicsWorld()->removeRigidBody( mActor );
    else
@@ -417,6 +442,7 @@ void BtBody::findContact(SceneObject **contactObject,
 void BtBody::moveKinematicTo(const MatrixF &transform)
 {
    AssertFatal(mActor, "BtBody::moveKinematicTo - The actor is null!");
+   mWorld->waitForStep();
 
    U32 bodyflags = mActor->getCollisionFlags();
    const bool isKinematic = bodyflags & BF_KINEMATIC;
@@ -48,6 +48,7 @@ void BtPlayer::_releaseController()
    if ( !mGhostObject )
       return;
 
+   mWorld->waitForStep();
    mWorld->getDynamicsWorld()->removeCollisionObject( mGhostObject );
 
    SAFE_DELETE( mGhostObject );
@@ -91,6 +92,7 @@ void BtPlayer::init( const char *type,
    mGhostObject = new btPairCachingGhostObject();
    mGhostObject->setCollisionShape( mColShape );
    mGhostObject->setCollisionFlags( btCollisionObject::CF_CHARACTER_OBJECT );
+   mWorld->waitForStep();
    mWorld->getDynamicsWorld()->addCollisionObject( mGhostObject,
                                                    btBroadphaseProxy::CharacterFilter, 
                                                    btBroadphaseProxy::StaticFilter | btBroadphaseProxy::DefaultFilter );
@@ -102,6 +104,7 @@ void BtPlayer::init( const char *type,
 Point3F BtPlayer::move( const VectorF &disp, CollisionList &outCol )
 {
    AssertFatal( mGhostObject, "BtPlayer::move - The controller is null!" );
+   mWorld->waitForStep();
 
    if (!mWorld->isEnabled())
    {
@@ -419,6 +422,7 @@ void BtPlayer::findContact(   SceneObject **contactObject,
                               Vector<SceneObject*> *outOverlapObjects ) const
 {
    AssertFatal( mGhostObject, "BtPlayer::findContact - The controller is null!" );
+   mWorld->waitForStep();
 
    VectorF normal;
    F32 maxDot = -1.0f;
@@ -497,6 +501,7 @@ PhysicsWorld* BtPlayer::getWorld()
 void BtPlayer::setTransform( const MatrixF &transform )
 {
    AssertFatal( mGhostObject, "BtPlayer::setTransform - The ghost object is null!" );
+   mWorld->waitForStep();
 
    btTransform xfm = btCast<btTransform>( transform );
    xfm.getOrigin()[2] += mOriginOffset;
@@ -507,6 +512,7 @@ void BtPlayer::setTransform( const MatrixF &transform )
 MatrixF& BtPlayer::getTransform( MatrixF *outMatrix )
 {
    AssertFatal( mGhostObject, "BtPlayer::getTransform - The ghost object is null!" );
+   mWorld->waitForStep();
 
    *outMatrix = btCast<MatrixF>( mGhostObject->getWorldTransform() );
    *outMatrix[11] -= mOriginOffset;
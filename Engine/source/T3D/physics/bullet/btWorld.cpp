@@ -33,6 +33,36 @@
 #include "console/consoleTypes.h"
 #include "scene/sceneRenderState.h"
 #include "T3D/gameBase/gameProcess.h"
+#include "T3D/physics/physicsPlugin.h"
+#include "platform/threads/threadPool.h"
+
+
+/// Steps a BtWorld on a worker thread.
+class BtStepWorkItem : public ThreadPool::WorkItem
+{
+public:
+
+   BtStepWorkItem( BtWorld *world, F32 elapsedSec )
+      :  mWorld( world ),
+         mElapsedSec( elapsedSec )
+   {
+   }
+
+protected:
+
+   /// The world waits for us before it is
+   /// changed or destroyed.
+   BtWorld *mWorld;
+
+   F32 mElapsedSec;
+
+   void execute() override
+   {
+      mWorld->_stepSimulation( mElapsedSec );
+      mWorld->mStepDone.release();
+   }
+};
+
 
 BtWorld::BtWorld() :
    mProcessList( NULL ),
@@ -41,7 +71,9 @@ BtWorld::BtWorld() :
    mTickCount( 0 ),
    mIsEnabled( false ),
    mEditorTimeScale( 1.0f ),
-   mDynamicsWorld( NULL )
+   mDynamicsWorld( NULL ),
+   mStepPending( false ),
+   mStepDone( 0 )
 {
 } 
 
@@ -87,6 +119,8 @@ bool BtWorld::initWorld( bool isServer, ProcessList *processList )
 
 void BtWorld::_destroy()
 {
+   waitForStep();
+
    // Release the tick processing signals.
    if ( mProcessList )
    {
@@ -123,14 +157,42 @@ void BtWorld::tickPhysics( U32 elapsedMs )
    // Convert it to seconds.
    const F32 elapsedSec = (F32)elapsedMs * 0.001f;
 
-   // Simulate
-   mDynamicsWorld->stepSimulation( elapsedSec * mEditorTimeScale, smPhysicsMaxSubSteps, smPhysicsStepTime);
-
    mIsSimulating = true;
 
+   // Unless async stepping is enabled we step right here as we
+   // always have.  Otherwise the step runs on a worker and overlaps
+   // the rest of the tick up to getPhysicsResults(), so the client
+   // and server worlds each get their own core.
+   if ( !PhysicsPlugin::isAsyncStep() )
+   {
+      _stepSimulation( elapsedSec * mEditorTimeScale );
+      return;
+   }
+
+   mStepPending = true;
+   ThreadPool::GLOBAL().queueWorkItem( new BtStepWorkItem( this, elapsedSec * mEditorTimeScale ) );
+
    //Con::printf( "%s BtWorld::tickPhysics!", this == smClientWorld ? "Client" : "Server" );
 }
 
+void BtWorld::_stepSimulation( F32 elapsedSec )
+{
+   PROFILE_SCOPE(BtWorld_StepSimulation);
+
+   mDynamicsWorld->stepSimulation( elapsedSec, smPhysicsMaxSubSteps, smPhysicsStepTime );
+}
+
+void BtWorld::waitForStep()
+{
+   if ( !mStepPending )
+      return;
+
+   PROFILE_SCOPE(BtWorld_WaitForStep);
+
+   mStepDone.acquire();
+   mStepPending = false;
+}
+
 void BtWorld::getPhysicsResults()
 {
    if ( !mDynamicsWorld || !mIsSimulating ) 
@@ -138,6 +200,8 @@ void BtWorld::getPhysicsResults()
 
    PROFILE_SCOPE(BtWorld_GetPhysicsResults);
 
+   waitForStep();
+
    // Get results from scene.
   // mScene->fetchResults( NX_RIGID_BODY_FINISHED, true );
    mIsSimulating = false;
@@ -159,6 +223,8 @@ void BtWorld::destroyWorld()
 
 bool BtWorld::castRay( const Point3F &startPnt, const Point3F &endPnt, RayInfo *ri, const Point3F &impulse )
 {
+   waitForStep();
+
    btCollisionWorld::ClosestRayResultCallback result( btCast<btVector3>( startPnt ), btCast<btVector3>( endPnt ) );
    mDynamicsWorld->rayTest( btCast<btVector3>( startPnt ), btCast<btVector3>( endPnt ), result );
 
@@ -200,6 +266,8 @@ bool BtWorld::castRay( const Point3F &startPnt, const Point3F &endPnt, RayInfo *
 
 PhysicsBody* BtWorld::castRay( const Point3F &start, const Point3F &end, U32 bodyTypes )
 {
+   waitForStep();
+
    btVector3 startPt = btCast<btVector3>( start );
    btVector3 endPt = btCast<btVector3>( end );
 
@@ -253,6 +321,8 @@ void BtWorld::explosion( const Point3F &pos, F32 radius, F32 forceMagnitude )
 
 void BtWorld::onDebugDraw( const SceneRenderState *state )
 {
+   waitForStep();
+
    mDebugDraw.setCuller( &state->getCullingFrustum() );
 
    mDynamicsWorld->setDebugDrawer( &mDebugDraw );
@@ -267,6 +337,8 @@ void BtWorld::reset()
    if ( !mDynamicsWorld )
       return;
 
+   waitForStep();
+
     ///create a copy of the array, not a reference!
     btCollisionObjectArray copyArray = mDynamicsWorld->getCollisionObjectArray();
 
@@ -35,13 +35,19 @@
 #ifndef _TVECTOR_H_
 #include "core/util/tVector.h"
 #endif
+#ifndef _PLATFORM_THREAD_SEMAPHORE_H_
+#include "platform/threads/semaphore.h"
+#endif
 
 class ProcessList;
 class PhysicsBody;
+class BtStepWorkItem;
 
 
 class BtWorld : public PhysicsWorld
 {
+   friend class BtStepWorkItem;
+
 protected:
 
    BtDebugDraw mDebugDraw;
@@ -64,8 +70,17 @@ protected:
 
    ProcessList *mProcessList;
 
+   /// Set while a step is running on a worker thread.
+   bool mStepPending;
+
+   /// Released by the worker thread when the step is done.
+   Semaphore mStepDone;
+
    void _destroy();
 
+   /// Steps the dynamics world.
+   void _stepSimulation( F32 elapsedSec );
+
 public:
 
    BtWorld();
@@ -85,6 +100,14 @@ public:
 
    void tickPhysics( U32 elapsedMs );
    void getPhysicsResults();
+
+   /// Blocks until the step running on a worker thread is done.
+   ///
+   /// When $pref::Physics::asyncStep is enabled the step runs
+   /// from tickPhysics() till getPhysicsResults() on a worker thread.
+   /// Anything which touches the Bullet world or its bodies in that
+   /// time must call this first.
+   void waitForStep();
    bool isWritable() const { return !mIsSimulating; }
 
    void setEnabled( bool enabled );
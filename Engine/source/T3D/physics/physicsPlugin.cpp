@@ -39,6 +39,7 @@ PhysicsPlugin* PhysicsPlugin::smSingleton = NULL;
 PhysicsResetSignal PhysicsPlugin::smPhysicsResetSignal;
 bool PhysicsPlugin::smSinglePlayer = false;
 U32 PhysicsPlugin::smThreadCount = 2;
+bool PhysicsPlugin::smAsyncStep = false;
 bool PhysicsPlugin::smGpuAccelerationAllowed = false;
 
 String PhysicsPlugin::smServerWorldName( "server" );
@@ -58,6 +59,12 @@ AFTER_MODULE_INIT( Sim )
       "@brief Number of threads to use in a single pass of the physics engine.\n\n"
       "Defaults to 2 if not set.\n\n"
 	   "@ingroup Physics\n");
+   Con::addVariable( "$pref::Physics::asyncStep", TypeBool, &PhysicsPlugin::smAsyncStep, 
+      "@brief If true the physics worlds are stepped on a worker thread between ticks.\n\n"
+      "The step overlaps the rest of the tick so the client and server worlds can "
+      "run on separate cores.  Not all physics implementations support it.\n\n"
+      "Defaults to false.\n\n"
+	   "@ingroup Physics\n");
 }
 
 bool PhysicsPlugin::activate( const char *library )
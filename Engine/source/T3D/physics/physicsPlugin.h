@@ -92,6 +92,10 @@ public:
    static U32 smThreadCount;
    static U32 getThreadCount() { return smThreadCount; }
 
+   /// If true the worlds step on a worker thread if supported by the plugin.
+   static bool smAsyncStep;
+   static bool isAsyncStep() { return smAsyncStep; }
+
    /// Returns the active physics plugin.
    /// @see PHYSICSPLUGIN
    static PhysicsPlugin* getSingleton() { return smSingleton; }
@@ -1025,6 +1025,11 @@ void TSStatic::unpackUpdate(NetConnection* con, BitStream* stream)
 {
    Parent::unpackUpdate(con, stream);
 
+   // Scale and shape changes don't go thru setTransform, so
+   // tell anyone caching our geometry about them ourselves.
+   const Box3F oldWorldBox = mWorldBox;
+   bool geometryChanged = false;
+
    if (stream->readFlag()) // TransformMask
    {
       MatrixF mat;
@@ -1043,6 +1048,8 @@ void TSStatic::unpackUpdate(NetConnection* con, BitStream* stream)
       }
       else
          setScale(Point3F::One);
+
+      geometryChanged = true;
    }
 
    if (stream->readFlag()) // UpdateCollisionMask
@@ -1096,6 +1103,7 @@ void TSStatic::unpackUpdate(NetConnection* con, BitStream* stream)
 
       //update our shape, figuring that it likely changed
       _createShape();
+      geometryChanged = true;
    }
 
    mUseAlphaFade = stream->readFlag();
@@ -1148,6 +1156,9 @@ void TSStatic::unpackUpdate(NetConnection* con, BitStream* stream)
 
    if (isProperlyAdded())
       _updateShouldTick();
+
+   if (geometryChanged && isProperlyAdded())
+      smStaticObjectMoved.trigger(this, oldWorldBox);
    set_special_typing();
 }
 
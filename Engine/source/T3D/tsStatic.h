@@ -279,6 +279,9 @@ public:
    void updateMaterials();
 
    bool isAnimated() { return mPlayAmbient; }
+
+   /// Only shapes which aren't playing an ambient animation are static.
+   bool isStaticGeometry() const override { return !mPlayAmbient || !mAmbientThread; }
    bool hasNode(const char* nodeName);
    void getNodeTransform(const char *nodeName, const MatrixF &xfm, MatrixF *outMat);
 
@@ -47,6 +47,7 @@
 #include "console/engineAPI.h"
 
 #include "gfx/bitmap/gBitmap.h"
+#include "gfx/bitmap/bitmapUtils.h"
 #include "gfx/gFont.h"
 #include "gfx/video/videoCapture.h"
 #include "gfx/gfxTextureManager.h"
@@ -258,6 +259,7 @@ void StandardMainLoop::init()
 
    Processor::init();
    Math::init();
+   bitmapInstallLibrary( Platform::SystemInfo.processor.properties );
    Platform::init();    // platform specific initialization
    RedBook::init();
    Platform::initConsole();
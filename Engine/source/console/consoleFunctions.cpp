@@ -2348,6 +2348,32 @@ DefineEngineFunction( compile, bool, ( const char* fileName, bool overrideNoDSO
 
 //-----------------------------------------------------------------------------
 
+DefineEngineFunction( compileFiles, S32, ( const char* fileNames, bool overrideNoDSO ), ( false ),
+   "Compile a list of files to bytecode in parallel.\n\n"
+   "This works like compile() for each of the files but spreads the work over the worker threads.  The "
+   "resulting .dso files are identical to the ones compile() writes.\n"
+   "@param fileNames A tab or newline separated list of paths to the files to compile.\n"
+   "@param overrideNoDSO If true, force generation of DSOs even if the engine is compiled to not "
+      "generate write compiled code to DSO files.\n\n"
+   "@return The number of files which were successfully compiled.\n\n"
+   "@see compile\n"
+   "@ingroup Scripting" )
+{
+   Vector<String> fileList;
+
+   const U32 count = StringUnit::getUnitCount( fileNames, "\t\n" );
+   for( U32 i = 0; i < count; i++ )
+   {
+      const char* fileName = StringUnit::getUnit( fileNames, i, "\t\n" );
+      if( fileName[ 0 ] )
+         fileList.push_back( fileName );
+   }
+
+   return TorqueScript::getRuntime()->compileFiles( fileList, overrideNoDSO );
+}
+
+//-----------------------------------------------------------------------------
+
 DefineEngineFunction( exec, bool, ( const char* fileName, bool noCalls, bool journalScript ), ( false, false ),
    "Execute the given script file.\n"
    "@param fileName Path to the file to execute\n"
@@ -1304,7 +1304,7 @@ YY_RULE_SETUP
 { 
    yycolumn = 1;
    lines.push_back(String::ToString("%s", yytext+1));
-   if (lines.size() > Con::getIntVariable("$scriptErrorLineCount", 10))
+   if (lines.size() > Compiler::getErrorLineCount())
       lines.erase(lines.begin());
 
    yyless(1);
@@ -2683,9 +2683,11 @@ void yyfree (void * ptr )
 #line 235 "CMDscan.l"
 
 
-static const char *scanBuffer;
-static const char *fileName;
-static int scanIndex;
+// The scan buffer is per thread so that code generation on
+// other threads still reports the correct file.
+static thread_local const char *scanBuffer;
+static thread_local const char *fileName;
+static thread_local int scanIndex;
 extern YYLTYPE CMDlloc;
 
 const char * CMDGetCurrentFile()
@@ -2715,26 +2717,8 @@ void CMDerror(const char *format, ...)
 #endif
    va_end(args);
 
-   if(fileName)
-   {
-      Con::errorf(ConsoleLogEntry::Script, "%s Line: %d - %s", fileName, yylineno, tempBuf);
-      // Update the script-visible error buffer.
-      const char *prevStr = Con::getVariable("$ScriptError");
-      if (prevStr[0])
-         dSprintf(tempBuf, sizeof(tempBuf), "%s\n%s Line: %d - Syntax error.", prevStr, fileName, yylineno);
-      else
-         dSprintf(tempBuf, sizeof(tempBuf), "%s Line: %d - Syntax error.", fileName, yylineno);
-      Con::setVariable("$ScriptError", tempBuf);
-
-      // We also need to mark that we came up with a new error.
-      static S32 sScriptErrorHash=1000;
-      Con::setIntVariable("$ScriptErrorHash", sScriptErrorHash++);
-
-   }
-   else
-   {
-      Con::errorf(ConsoleLogEntry::Script, tempBuf);
-   }
+   // This also updates $ScriptError, or queues it when compiling off the main thread.
+   Compiler::syntaxError(fileName, yylineno, tempBuf);
 }
 
 void CMDSetScanBuffer(const char *sb, const char *fn)
@@ -597,7 +597,7 @@ namespace Script
 {
    inline ExprEvalState gEvalState;
 
-   inline StmtNode *gStatementList;
+   inline thread_local StmtNode *gStatementList;
    inline StmtNode *gAnonFunctionList;
    inline U32 gAnonFunctionID = 0;
 }
@@ -51,15 +51,16 @@ namespace Compiler
 
 using namespace Compiler;
 
-FuncVars gEvalFuncVars;
-FuncVars gGlobalScopeFuncVars;
-FuncVars* gFuncVars = NULL;
+thread_local FuncVars gEvalFuncVars;
+thread_local FuncVars gGlobalScopeFuncVars;
+thread_local FuncVars* gFuncVars = NULL;
 
 inline FuncVars* getFuncVars(S32 lineNumber)
 {
    if (gFuncVars == &gGlobalScopeFuncVars)
    {
-      const char* str = avar("Attemping to use local variable in global scope. File: %s Line: %d", CodeBlock::smCurrentParser->getCurrentFile(), lineNumber);
+      char str[1024];
+      dSprintf(str, sizeof(str), "Attemping to use local variable in global scope. File: %s Line: %d", CodeBlock::smCurrentParser->getCurrentFile(), lineNumber);
       scriptErrorHandler(str);
    }
    return gFuncVars;
@@ -114,7 +115,7 @@ U32 BreakStmtNode::compileStmt(CodeStream& codeStream, U32 ip)
    }
    else
    {
-      Con::warnf(ConsoleLogEntry::General, "%s (%d): break outside of loop... ignoring.", dbgFileName, dbgLineNumber);
+      diagnosticf(ConsoleLogEntry::Warning, ConsoleLogEntry::General, "%s (%d): break outside of loop... ignoring.", dbgFileName, dbgLineNumber);
    }
    return codeStream.tell();
 }
@@ -131,7 +132,7 @@ U32 ContinueStmtNode::compileStmt(CodeStream& codeStream, U32 ip)
    }
    else
    {
-      Con::warnf(ConsoleLogEntry::General, "%s (%d): continue outside of loop... ignoring.", dbgFileName, dbgLineNumber);
+      diagnosticf(ConsoleLogEntry::Warning, ConsoleLogEntry::General, "%s (%d): continue outside of loop... ignoring.", dbgFileName, dbgLineNumber);
    }
    return codeStream.tell();
 }
@@ -593,7 +594,7 @@ U32 CommaCatExprNode::compile(CodeStream& codeStream, U32 ip, TypeReq type)
 
    // But we're paranoid, so accept (but whine) if we get an oddity...
    if (type == TypeReqUInt || type == TypeReqFloat)
-      Con::warnf(ConsoleLogEntry::General, "%s (%d): converting comma string to a number... probably wrong.", dbgFileName, dbgLineNumber);
+      diagnosticf(ConsoleLogEntry::Warning, ConsoleLogEntry::General, "%s (%d): converting comma string to a number... probably wrong.", dbgFileName, dbgLineNumber);
 
    return codeStream.tell();
 }
@@ -30,16 +30,17 @@
 #include "core/strings/stringFunctions.h"
 #include "core/stringTable.h"
 #include "core/stream/fileStream.h"
+#include "platform/threads/mutex.h"
 
 using namespace Compiler;
 
-bool           CodeBlock::smInFunction = false;
+thread_local bool CodeBlock::smInFunction = false;
 CodeBlock *    CodeBlock::smCodeBlockList = NULL;
-TorqueScriptParser *CodeBlock::smCurrentParser = NULL;
+thread_local TorqueScriptParser *CodeBlock::smCurrentParser = NULL;
 
-extern FuncVars gEvalFuncVars;
-extern FuncVars gGlobalScopeFuncVars;
-extern FuncVars* gFuncVars;
+extern thread_local FuncVars gEvalFuncVars;
+extern thread_local FuncVars gGlobalScopeFuncVars;
+extern thread_local FuncVars* gFuncVars;
 
 //-------------------------------------------------------------------------
 
@@ -460,7 +461,8 @@ bool CodeBlock::read(StringTableEntry fileName, Stream &st)
 
 bool CodeBlock::compile(const char *codeFileName, StringTableEntry fileName, const char *inScript, bool overrideNoDso)
 {
-   AssertFatal(Con::isMainThread(), "Compiling code on a secondary thread");
+   // Other threads may compile as long as they queue the diagnostics for the main thread.
+   AssertFatal(Con::isMainThread() || gDiagnosticQueue, "Compiling code on a secondary thread without a Compiler::DiagnosticQueue");
 
    // This will return true, but return value is ignored
    char *script;
@@ -480,10 +482,16 @@ bool CodeBlock::compile(const char *codeFileName, StringTableEntry fileName, con
    smCurrentParser = new TorqueScriptParser();
    AssertISV(smCurrentParser, avar("CodeBlock::compile - no parser available for '%s'!", fileName));
 
-   // Now do some parsing.
-   smCurrentParser->setScanBuffer(script, fileName);
-   smCurrentParser->restart(NULL);
-   smCurrentParser->parse();
+   // Now do some parsing.  The rest of the compile only touches
+   // per thread state so it can overlap with other threads.
+   {
+      MutexHandle parserLock;
+      parserLock.lock(&getParserMutex(), true);
+
+      smCurrentParser->setScanBuffer(script, fileName);
+      smCurrentParser->restart(NULL);
+      smCurrentParser->parse();
+   }
 
    if (gSyntaxError)
    {
@@ -535,7 +543,7 @@ bool CodeBlock::compile(const char *codeFileName, StringTableEntry fileName, con
    getFunctionVariableMappingTable().write(st);
 
    if (lastIp != codeSize)
-      Con::errorf(ConsoleLogEntry::General, "CodeBlock::compile - precompile size mismatch, a precompile/compile function pair is probably mismatched.");
+      diagnosticf(ConsoleLogEntry::Error, ConsoleLogEntry::General, "CodeBlock::compile - precompile size mismatch, a precompile/compile function pair is probably mismatched.");
 
    U32 totSize = codeSize + codeStream.getNumLineBreaks() * 2;
    st.write(codeSize);
@@ -617,9 +625,14 @@ Con::EvalResult CodeBlock::compileExec(StringTableEntry fileName, const char *in
    AssertISV(smCurrentParser, avar("CodeBlock::compile - no parser available for '%s'!", fileName));
 
    // Now do some parsing.
-   smCurrentParser->setScanBuffer(string, fileName);
-   smCurrentParser->restart(NULL);
-   smCurrentParser->parse();
+   {
+      MutexHandle parserLock;
+      parserLock.lock(&getParserMutex(), true);
+
+      smCurrentParser->setScanBuffer(string, fileName);
+      smCurrentParser->restart(NULL);
+      smCurrentParser->parse();
+   }
 
    if (!Script::gStatementList)
    {
@@ -59,8 +59,8 @@ private:
    static CodeBlock* smCodeBlockList;
 
 public:
-   static bool                      smInFunction;
-   static TorqueScriptParser * smCurrentParser;
+   static thread_local bool                      smInFunction;
+   static thread_local TorqueScriptParser * smCurrentParser;
 
    static CodeBlock *getCodeBlockList()
    {
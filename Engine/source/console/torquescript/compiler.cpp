@@ -20,15 +20,18 @@
 // IN THE SOFTWARE.
 //-----------------------------------------------------------------------------
 
+#include <algorithm>
+
 #include "platform/platform.h"
 #include "console/console.h"
 
 #include "compiler.h"
 #include "console/simBase.h"
+#include "platform/threads/mutex.h"
 
-extern FuncVars gEvalFuncVars;
-extern FuncVars gGlobalScopeFuncVars;
-extern FuncVars *gFuncVars;
+extern thread_local FuncVars gEvalFuncVars;
+extern thread_local FuncVars gGlobalScopeFuncVars;
+extern thread_local FuncVars *gFuncVars;
 
 namespace Con
 {
@@ -49,7 +52,7 @@ namespace Compiler
          return 0;
       else if (file)
       {
-         Con::warnf(ConsoleLogEntry::General, "%s (%d): string always evaluates to 0.", file, line);
+         diagnosticf(ConsoleLogEntry::Warning, ConsoleLogEntry::General, "%s (%d): string always evaluates to 0.", file, line);
          return 0;
       }
       return 0;
@@ -57,11 +60,13 @@ namespace Compiler
 
    //------------------------------------------------------------
 
-   CompilerStringTable *gCurrentStringTable, gGlobalStringTable, gFunctionStringTable;
-   CompilerFloatTable  *gCurrentFloatTable, gGlobalFloatTable, gFunctionFloatTable;
-   DataChunker          gConsoleAllocator;
-   CompilerIdentTable   gIdentTable;
-   CompilerLocalVariableToRegisterMappingTable gFunctionVariableMappingTable;
+   // The compiler state is per thread so that scripts
+   // can be compiled to DSOs on multiple threads.
+   thread_local CompilerStringTable *gCurrentStringTable, gGlobalStringTable, gFunctionStringTable;
+   thread_local CompilerFloatTable  *gCurrentFloatTable, gGlobalFloatTable, gFunctionFloatTable;
+   thread_local DataChunker          gConsoleAllocator;
+   thread_local CompilerIdentTable   gIdentTable;
+   thread_local CompilerLocalVariableToRegisterMappingTable gFunctionVariableMappingTable;
 
    //------------------------------------------------------------
 
@@ -82,12 +87,18 @@ namespace Compiler
       *(ptr + 1) = 0;
    }
 
-   void(*STEtoCode)(StringTableEntry ste, U32 ip, U32 *ptr) = evalSTEtoCode;
+   thread_local void(*STEtoCode)(StringTableEntry ste, U32 ip, U32 *ptr) = evalSTEtoCode;
 
    //------------------------------------------------------------
 
-   bool gSyntaxError = false;
-   bool gIsEvalCompile = false;
+   thread_local bool gSyntaxError = false;
+   thread_local bool gIsEvalCompile = false;
+
+   Mutex& getParserMutex()
+   {
+      static Mutex sParserMutex;
+      return sParserMutex;
+   }
 
    //------------------------------------------------------------
 
@@ -138,8 +149,105 @@ namespace Compiler
       }
       else
       {
-         Con::warnf(ConsoleLogEntry::Type::Script, "%s", str);
+         diagnosticf(ConsoleLogEntry::Warning, ConsoleLogEntry::Script, "%s", str);
+      }
+   }
+
+   //------------------------------------------------------------
+
+   thread_local DiagnosticQueue* gDiagnosticQueue = NULL;
+
+   static void printDiagnostic(const Diagnostic& diagnostic)
+   {
+      switch (diagnostic.level)
+      {
+      case ConsoleLogEntry::Error:
+         Con::errorf(diagnostic.type, "%s", diagnostic.message.c_str());
+         break;
+      case ConsoleLogEntry::Warning:
+         Con::warnf(diagnostic.type, "%s", diagnostic.message.c_str());
+         break;
+      default:
+         Con::printf("%s", diagnostic.message.c_str());
+         break;
+      }
+
+      if (diagnostic.scriptError.isEmpty())
+         return;
+
+      // Update the script-visible error buffer.
+      const char *prevStr = Con::getVariable("$ScriptError");
+      if (prevStr[0])
+         Con::setVariable("$ScriptError", String::ToString("%s\n%s", prevStr, diagnostic.scriptError.c_str()));
+      else
+         Con::setVariable("$ScriptError", diagnostic.scriptError);
+
+      // We also need to mark that we came up with a new error.
+      static S32 sScriptErrorHash = 1000;
+      Con::setIntVariable("$ScriptErrorHash", sScriptErrorHash++);
+   }
+
+   DiagnosticQueue::DiagnosticQueue()
+      : errorLineCount(Con::getIntVariable("$scriptErrorLineCount", 10))
+   {
+      AssertFatal(Con::isMainThread(), "Compiler::DiagnosticQueue - Must be created on the main thread!");
+   }
+
+   void DiagnosticQueue::print()
+   {
+      AssertFatal(Con::isMainThread(), "Compiler::DiagnosticQueue::print - Must be called from the main thread!");
+
+      for (U32 i = 0; i < diagnostics.size(); i++)
+         printDiagnostic(diagnostics[i]);
+
+      diagnostics.clear();
+   }
+
+   static void queueOrPrint(Diagnostic& diagnostic)
+   {
+      if (gDiagnosticQueue)
+         gDiagnosticQueue->diagnostics.push_back(diagnostic);
+      else
+         printDiagnostic(diagnostic);
+   }
+
+   void diagnosticf(ConsoleLogEntry::Level level, ConsoleLogEntry::Type type, const char* fmt, ...)
+   {
+      Diagnostic diagnostic;
+      diagnostic.level = level;
+      diagnostic.type = type;
+
+      va_list args;
+      va_start(args, fmt);
+      diagnostic.message = String::VToString(fmt, args);
+      va_end(args);
+
+      queueOrPrint(diagnostic);
+   }
+
+   void syntaxError(const char* fileName, S32 line, const char* message)
+   {
+      Diagnostic diagnostic;
+      diagnostic.level = ConsoleLogEntry::Error;
+      diagnostic.type = ConsoleLogEntry::Script;
+
+      if (fileName)
+      {
+         diagnostic.message = String::ToString("%s Line: %d - %s", fileName, line, message);
+         diagnostic.scriptError = String::ToString("%s Line: %d - Syntax error.", fileName, line);
       }
+      else
+         diagnostic.message = message;
+
+      queueOrPrint(diagnostic);
+   }
+
+   S32 getErrorLineCount()
+   {
+      if (gDiagnosticQueue)
+         return gDiagnosticQueue->errorLineCount;
+
+      return Con::getIntVariable("$scriptErrorLineCount", 10);
    }
 }
 
@@ -160,7 +268,8 @@ S32 FuncVars::assign(StringTableEntry var, TypeReq currentType, S32 lineNumber,
 
       if (found->second.isConstant)
       {
-         const char* str = avar("Script Warning: Reassigning variable %s when it is a constant. File: %s Line : %d", var, CodeBlock::smCurrentParser->getCurrentFile(), lineNumber);
+         char str[1024];
+         dSprintf(str, sizeof(str), "Script Warning: Reassigning variable %s when it is a constant. File: %s Line : %d", var, CodeBlock::smCurrentParser->getCurrentFile(), lineNumber);
          scriptErrorHandler(str);
       }
       return found->second.reg;
@@ -179,7 +288,8 @@ S32 FuncVars::lookup(StringTableEntry var, S32 lineNumber)
 
    if (found == vars.end())
    {
-      const char* str = avar("Script Warning: Variable %s referenced before used when compiling script. File: %s Line: %d", var, CodeBlock::smCurrentParser->getCurrentFile(), lineNumber);
+      char str[1024];
+      dSprintf(str, sizeof(str), "Script Warning: Variable %s referenced before used when compiling script. File: %s Line: %d", var, CodeBlock::smCurrentParser->getCurrentFile(), lineNumber);
       scriptErrorHandler(str);
 
       return assign(var, TypeReqString, lineNumber, false);
@@ -194,7 +304,8 @@ TypeReq FuncVars::lookupType(StringTableEntry var, S32 lineNumber)
 
    if (found == vars.end())
    {
-      const char* str = avar("Script Warning: Variable %s referenced before used when compiling script. File: %s Line: %d", var, CodeBlock::smCurrentParser->getCurrentFile(), lineNumber);
+      char str[1024];
+      dSprintf(str, sizeof(str), "Script Warning: Variable %s referenced before used when compiling script. File: %s Line: %d", var, CodeBlock::smCurrentParser->getCurrentFile(), lineNumber);
       scriptErrorHandler(str);
 
       assign(var, TypeReqString, lineNumber, false);
@@ -291,16 +402,27 @@ void CompilerStringTable::write(Stream &st)
 
 //------------------------------------------------------------
 
+static StringTableEntry getFuncLookupTableName(StringTableEntry namespaceName, StringTableEntry functionName)
+{
+   char buffer[1024];
+   dSprintf(buffer, sizeof(buffer), "%s::%s", namespaceName, functionName);
+
+   // The StringTable is shared with threads that are parsing.
+   MutexHandle handle;
+   handle.lock(&getParserMutex(), true);
+   return StringTable->insert(buffer);
+}
+
 void CompilerLocalVariableToRegisterMappingTable::add(StringTableEntry functionName, StringTableEntry namespaceName, StringTableEntry varName)
 {
-   StringTableEntry funcLookupTableName = StringTable->insert(avar("%s::%s", namespaceName, functionName));
+   StringTableEntry funcLookupTableName = getFuncLookupTableName(namespaceName, functionName);
 
    localVarToRegister[funcLookupTableName].varList.push_back(varName);;
 }
 
 S32 CompilerLocalVariableToRegisterMappingTable::lookup(StringTableEntry namespaceName, StringTableEntry functionName, StringTableEntry varName)
 {
-   StringTableEntry funcLookupTableName = StringTable->insert(avar("%s::%s", namespaceName, functionName));
+   StringTableEntry funcLookupTableName = getFuncLookupTableName(namespaceName, functionName);
 
    auto functionPosition = localVarToRegister.find(funcLookupTableName);
    if (functionPosition != localVarToRegister.end())
@@ -313,7 +435,7 @@ S32 CompilerLocalVariableToRegisterMappingTable::lookup(StringTableEntry namespa
       }
    }
 
-   Con::errorf("Unable to find local variable %s in function name %s", varName, funcLookupTableName);
+   diagnosticf(ConsoleLogEntry::Error, ConsoleLogEntry::General, "Unable to find local variable %s in function name %s", varName, funcLookupTableName);
    return -1;
 }
 
@@ -334,9 +456,18 @@ void CompilerLocalVariableToRegisterMappingTable::write(Stream& stream)
 {
    stream.write((U32)localVarToRegister.size());
 
+   // Write the functions sorted by name so that the output does not
+   // depend on the StringTable addresses, which differ when scripts
+   // are compiled in a different order or on multiple threads.
+   std::vector<StringTableEntry> functionNames;
+   functionNames.reserve(localVarToRegister.size());
    for (const auto& pair : localVarToRegister)
+      functionNames.push_back(pair.first);
+
+   std::sort(functionNames.begin(), functionNames.end(), [](StringTableEntry a, StringTableEntry b) { return dStrcmp(a, b) < 0; });
+
+   for (StringTableEntry functionName : functionNames)
    {
-      StringTableEntry functionName = pair.first;
       stream.writeString(functionName);
 
       const auto& localVariableTableForFunction = localVarToRegister[functionName].varList;
@@ -37,6 +37,7 @@ class CodeStream;
 struct StmtNode;
 class Stream;
 class DataChunker;
+class Mutex;
 
 #include "platform/platform.h"
 #include "ast.h"
@@ -45,6 +46,9 @@ class DataChunker;
 #ifndef _TVECTOR_H_
 #include "core/util/tVector.h"
 #endif
+#ifndef _CONSOLE_H_
+#include "console/console.h"
+#endif
 
 //------------------------------------------------------------
 
@@ -249,7 +253,7 @@ namespace Compiler
 #endif
    }
 
-   extern void(*STEtoCode)(StringTableEntry ste, U32 ip, U32 *ptr);
+   extern thread_local void(*STEtoCode)(StringTableEntry ste, U32 ip, U32 *ptr);
 
    void evalSTEtoCode(StringTableEntry ste, U32 ip, U32 *ptr);
    void compileSTEtoCode(StringTableEntry ste, U32 ip, U32 *ptr);
@@ -280,8 +284,54 @@ namespace Compiler
 
    void scriptErrorHandler(const char* str);
 
-   extern bool gSyntaxError;
-   extern bool gIsEvalCompile;
+   /// A warning or error found while compiling.
+   struct Diagnostic
+   {
+      ConsoleLogEntry::Level level;
+      ConsoleLogEntry::Type type;
+      String message;
+
+      /// The summary appended to $ScriptError for syntax errors.
+      String scriptError;
+   };
+
+   /// Collects the diagnostics of compiles running off the main thread.
+   ///
+   /// The console is not thread safe, so while one of these is installed
+   /// the compiler queues its diagnostics here instead of printing them.
+   /// Call print() on the main thread once the compile is done.
+   struct DiagnosticQueue
+   {
+      Vector<Diagnostic> diagnostics;
+
+      /// $scriptErrorLineCount read on the main thread.
+      S32 errorLineCount;
+
+      DiagnosticQueue();
+
+      /// Prints the diagnostics to the console and clears the queue.
+      void print();
+   };
+
+   /// The queue of the current thread or NULL to print directly.
+   extern thread_local DiagnosticQueue* gDiagnosticQueue;
+
+   /// Prints a compiler diagnostic or queues it if the thread has a DiagnosticQueue.
+   void diagnosticf(ConsoleLogEntry::Level level, ConsoleLogEntry::Type type, const char* fmt, ...);
+
+   /// Reports a syntax error and updates $ScriptError and $ScriptErrorHash.
+   void syntaxError(const char* fileName, S32 line, const char* message);
+
+   /// Returns the number of script lines to keep for syntax error reports.
+   S32 getErrorLineCount();
+
+   extern thread_local bool gSyntaxError;
+   extern thread_local bool gIsEvalCompile;
+
+   /// The scanner and parser keep their state in globals and share
+   /// the StringTable with code generation.  Parsing, and inserting
+   /// into the StringTable while compiling, must hold this lock.
+   Mutex& getParserMutex();
 };
 
 class FuncVars
@@ -6,6 +6,8 @@
 #include "core/volume.h"
 #include "core/stream/fileStream.h"
 #include "core/util/timeClass.h"
+#include "platform/threads/threadPool.h"
+#include "platform/threads/semaphore.h"
 
 
 namespace TorqueScript
@@ -421,18 +423,16 @@ namespace TorqueScript
       return ret;
    }
 
-   bool TorqueScriptRuntime::compile(const char* fileName, bool overrideNoDso)
+   bool TorqueScriptRuntime::_getDSOFileName(const char* scriptFileName, char* outBuffer, U32 bufferSize)
    {
-      Con::expandScriptFilename( scriptFilenameBuffer, sizeof( scriptFilenameBuffer ), fileName );
-
       // Figure out where to put DSOs
-      StringTableEntry dsoPath = Con::getDSOPath(scriptFilenameBuffer);
+      StringTableEntry dsoPath = Con::getDSOPath(scriptFileName);
       if(dsoPath && *dsoPath == 0)
          return false;
 
       // If the script file extention is '.ed.tscript' then compile it to a different compiled extention
       bool isEditorScript = false;
-      const char *ext = dStrrchr( scriptFilenameBuffer, '.' );
+      const char *ext = dStrrchr( scriptFileName, '.' );
       if( ext && ( dStricmp( ext, "." TORQUE_SCRIPT_EXTENSION) == 0 ) )
       {
          const char* ext2 = ext - 3;
@@ -446,18 +446,27 @@ namespace TorqueScript
             isEditorScript = true;
       }
 
-      const char *filenameOnly = dStrrchr(scriptFilenameBuffer, '/');
+      const char *filenameOnly = dStrrchr(scriptFileName, '/');
       if(filenameOnly)
          ++filenameOnly;
       else
-         filenameOnly = scriptFilenameBuffer;
-
-      char nameBuffer[512];
+         filenameOnly = scriptFileName;
 
       if( isEditorScript )
-         dStrcpyl(nameBuffer, sizeof(nameBuffer), dsoPath, "/", filenameOnly, ".edso", NULL);
+         dStrcpyl(outBuffer, bufferSize, dsoPath, "/", filenameOnly, ".edso", NULL);
       else
-         dStrcpyl(nameBuffer, sizeof(nameBuffer), dsoPath, "/", filenameOnly, ".dso", NULL);
+         dStrcpyl(outBuffer, bufferSize, dsoPath, "/", filenameOnly, ".dso", NULL);
+
+      return true;
+   }
+
+   bool TorqueScriptRuntime::compile(const char* fileName, bool overrideNoDso)
+   {
+      Con::expandScriptFilename( scriptFilenameBuffer, sizeof( scriptFilenameBuffer ), fileName );
+
+      char nameBuffer[512];
+      if(!_getDSOFileName(scriptFilenameBuffer, nameBuffer, sizeof(nameBuffer)))
+         return false;
 
       void *data = NULL;
       U32 dataSize = 0;
@@ -482,4 +491,109 @@ namespace TorqueScript
       return true;
    }
 
+   /// Reads a script file and compiles it to a DSO on a ThreadPool thread.
+   struct CompileDSOWorkItem : public ThreadPool::WorkItem
+   {
+      StringTableEntry mScriptFileName;
+      String mDSOFileName;
+      bool mOverrideNoDso;
+      bool mSucceeded;
+
+      /// The compiler output, printed by the main thread when all files are done.
+      Compiler::DiagnosticQueue mDiagnostics;
+
+      /// Released once for each item of the batch when it is done.
+      Semaphore *mBatchDone;
+
+      CompileDSOWorkItem(StringTableEntry scriptFileName, const String& dsoFileName, bool overrideNoDso, Semaphore *batchDone)
+         :  mScriptFileName(scriptFileName),
+            mDSOFileName(dsoFileName),
+            mOverrideNoDso(overrideNoDso),
+            mSucceeded(false),
+            mBatchDone(batchDone)
+      {
+      }
+
+   protected:
+      void execute() override
+      {
+         _compile();
+         mBatchDone->release();
+      }
+
+      void _compile()
+      {
+         void *data = NULL;
+         U32 dataSize = 0;
+         Torque::FS::ReadFile(mScriptFileName, data, dataSize, true);
+         if(data == NULL)
+         {
+            Compiler::Diagnostic diagnostic;
+            diagnostic.level = ConsoleLogEntry::Error;
+            diagnostic.type = ConsoleLogEntry::Script;
+            diagnostic.message = String::ToString("compileFiles: invalid script file %s.", mScriptFileName);
+            mDiagnostics.diagnostics.push_back(diagnostic);
+            return;
+         }
+
+         const char *script = static_cast<const char *>(data);
+
+         Compiler::gDiagnosticQueue = &mDiagnostics;
+
+         CodeBlock *code = new CodeBlock();
+         mSucceeded = code->compile(mDSOFileName.c_str(), mScriptFileName, script, mOverrideNoDso);
+         delete code;
+         delete[] script;
+
+         Compiler::gDiagnosticQueue = NULL;
+      }
+   };
+
+   U32 TorqueScriptRuntime::compileFiles(const Vector<String>& fileNames, bool overrideNoDso)
+   {
+      AssertFatal(Con::isMainThread(), "TorqueScriptRuntime::compileFiles - Must be called from the main thread!");
+
+      // Resolve all the paths up front as that needs the console
+      // and StringTable which are only safe on the main thread.
+      Semaphore batchDone(0);
+      Vector< ThreadSafeRef<CompileDSOWorkItem> > items;
+      items.reserve(fileNames.size());
+
+      for (U32 i = 0; i < fileNames.size(); i++)
+      {
+         Con::expandScriptFilename( scriptFilenameBuffer, sizeof( scriptFilenameBuffer ), fileNames[i] );
+
+         char nameBuffer[512];
+         if(!_getDSOFileName(scriptFilenameBuffer, nameBuffer, sizeof(nameBuffer)))
+            continue;
+
+#ifdef TORQUE_DEBUG
+         Con::printf("Compiling %s...", scriptFilenameBuffer);
+#endif
+
+         items.push_back(new CompileDSOWorkItem(StringTable->insert(scriptFilenameBuffer), nameBuffer, overrideNoDso, &batchDone));
+      }
+
+      // The script console stays blocked until all the work items are
+      // done so that nothing else touches the StringTable meanwhile.
+      // Only wait on our own items as the pool may be busy with
+      // unrelated work like resource loads.
+      ThreadPool* pool = &ThreadPool::GLOBAL();
+      for (U32 i = 0; i < items.size(); i++)
+         pool->queueWorkItem(items[i]);
+
+      for (U32 i = 0; i < items.size(); i++)
+         batchDone.acquire();
+
+      U32 numCompiled = 0;
+      for (U32 i = 0; i < items.size(); i++)
+      {
+         items[i]->mDiagnostics.print();
+
+         if (items[i]->mSucceeded)
+            numCompiled++;
+      }
+
+      return numCompiled;
+   }
 }
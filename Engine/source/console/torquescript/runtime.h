@@ -18,6 +18,17 @@ namespace TorqueScript
       Con::EvalResult evaluatef(const char* string, ...) override;
       bool executeFile(const char* fileName, bool noCalls, bool journalScript) override;
       bool compile(const char* fileName, bool overrideNoDso);
+
+      /// Compiles a list of script files to DSOs in parallel on the
+      /// global ThreadPool.  The DSOs are identical to the ones written
+      /// by compile().
+      ///
+      /// @return The number of files which compiled successfully.
+      U32 compileFiles(const Vector<String>& fileNames, bool overrideNoDso);
+
+   private:
+      /// Builds the DSO file name for an expanded script file name.
+      bool _getDSOFileName(const char* scriptFileName, char* outBuffer, U32 bufferSize);
    };
 
    inline TorqueScriptRuntime* gRuntime = new TorqueScriptRuntime();
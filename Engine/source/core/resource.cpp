@@ -24,9 +24,13 @@
 #include "core/volume.h"
 
 #include "console/console.h"
+#include "platform/platformIntrinsics.h"
+#include "platform/threads/thread.h"
+#include "platform/threads/threadPool.h"
 
 
 FreeListChunker<ResourceHolderBase> ResourceHolderBase::smHolderFactory;
+Mutex ResourceHolderBase::smHolderMutex;
 
 ResourceBase::Header ResourceBase::smBlank;
 
@@ -44,6 +48,55 @@ U32   ResourceBase::Header::getChecksum() const
    return fileRef->getChecksum();
 }
 
+void* ResourceHolderBase::allocHolder()
+{
+   MutexHandle handle;
+   handle.lock( &smHolderMutex, true );
+   return smHolderFactory.alloc();
+}
+
+void ResourceHolderBase::freeHolder( ResourceHolderBase* holder )
+{
+   MutexHandle handle;
+   handle.lock( &smHolderMutex, true );
+   smHolderFactory.free( holder );
+}
+
+bool ResourceBase::Header::isLoaded() const
+{
+   return dAtomicRead( const_cast< volatile U32& >( mLoaded ) ) != 0;
+}
+
+void ResourceBase::Header::incRefCount()
+{
+   dFetchAndAdd( mRefCount, 1 );
+}
+
+void ResourceBase::Header::decRefCount()
+{
+   // Drop the reference without locking unless it may be the last one; the
+   // final release is serialized against lookups by the ResourceManager.
+   for ( ;; )
+   {
+      const U32 count = dAtomicRead( mRefCount );
+      AssertFatal( count > 0, "ResourceBase::Header::decRefCount - reference count underflow" );
+
+      if ( count == 1 )
+         break;
+
+      if ( dCompareAndSwap( mRefCount, count, count - 1 ) )
+         return;
+   }
+
+   if ( this == &smBlank )
+   {
+      dFetchAndAdd( mRefCount, ( U32 ) -1 );
+      return;
+   }
+
+   ResourceManager::get()._releaseHeader( this );
+}
+
 void ResourceBase::Header::destroySelf()
 {
    if (this == &smBlank)
@@ -55,10 +108,12 @@ void ResourceBase::Header::destroySelf()
    if ( mResource != NULL )
    {
       mResource->~ResourceHolderBase();
-      ResourceHolderBase::smHolderFactory.free( mResource );
+      ResourceHolderBase::freeHolder( mResource );
+      mResource = NULL;
+
+      ResourceManager::get()._onResourceUnloaded( this );
    }
 
-   ResourceManager::get().remove( this );
    delete this;
 }
 
@@ -69,6 +124,18 @@ void  ResourceBase::assign(const ResourceBase &inResource, void* resource)
    if ( mResourceHeader == NULL || mResourceHeader.getPointer() == &(ResourceBase::smBlank) )
       return;
 
+   if ( mResourceHeader->isLoaded() )
+   {
+      AssertFatal(inResource.mResourceHeader->getSignature() == getSignature(),"Resource::assign: mis-matching signature");
+      return;
+   }
+
+   // Only one thread creates the resource; any other thread asking for
+   // the same path blocks here until that load has finished and then
+   // shares the result.
+   MutexHandle loadLock;
+   loadLock.lock( &mResourceHeader->mLoadMutex, true );
+
    if (mResourceHeader->getSignature())
    {
       AssertFatal(inResource.mResourceHeader->getSignature() == getSignature(),"Resource::assign: mis-matching signature");
@@ -83,9 +150,7 @@ void  ResourceBase::assign(const ResourceBase &inResource, void* resource)
       {
          if ( !getStaticLoadSignal().trigger(path, &resource) && (resource != NULL) )
          {
-            mResourceHeader->mResource = createHolder(resource);
-            mResourceHeader->mNotifyUnload = _getNotifyUnloadFn();
-            _triggerPostLoadSignal();
+            _setLoaded( resource );
             return;
          }
 
@@ -94,9 +159,7 @@ void  ResourceBase::assign(const ResourceBase &inResource, void* resource)
 
       if (resource)
       {
-         mResourceHeader->mResource = createHolder(resource);
-         mResourceHeader->mNotifyUnload = _getNotifyUnloadFn();
-         _triggerPostLoadSignal();
+         _setLoaded( resource );
       }
       else
       {
@@ -108,3 +171,47 @@ void  ResourceBase::assign(const ResourceBase &inResource, void* resource)
    }
 }
 
+namespace
+{
+   /// Fires the post load signal of a resource loaded
+   /// on another thread from the main thread.
+   struct PostLoadWorkItem : public ThreadPool::WorkItem
+   {
+      typedef void ( *PostLoadFn )( const ResourceBase& resource );
+
+      ResourceBase mResource;
+      PostLoadFn mPostLoad;
+
+      PostLoadWorkItem( const ResourceBase &resource, PostLoadFn postLoad )
+         :  mResource( resource ),
+            mPostLoad( postLoad )
+      {
+      }
+
+   protected:
+      void execute() override { mPostLoad( mResource ); }
+   };
+}
+
+void ResourceBase::_setLoaded( void* resource )
+{
+   mResourceHeader->mResource = createHolder(resource);
+   mResourceHeader->mNotifyUnload = _getNotifyUnloadFn();
+
+   ResourceManager::get()._onResourceLoaded( mResourceHeader );
+
+   // The listeners expect the main thread, so loads from
+   // other threads have theirs signaled from the main loop.
+   if ( ThreadManager::isMainThread() )
+   {
+      _triggerPostLoadSignal();
+      dCompareAndSwap( mResourceHeader->mLoaded, 0, 1 );
+      return;
+   }
+
+   dCompareAndSwap( mResourceHeader->mLoaded, 0, 1 );
+
+   PostLoadFn postLoad = _getPostLoadFn();
+   if ( postLoad )
+      ThreadPool::queueWorkItemOnMainThread( new PostLoadWorkItem( *this, postLoad ) );
+}
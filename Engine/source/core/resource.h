@@ -47,6 +47,10 @@
 #include "platform/platformAssert.h"
 #endif
 
+#ifndef _PLATFORM_THREADS_MUTEX_H_
+#include "platform/threads/mutex.h"
+#endif
+
 #include <memory>
 
 class ResourceManager;
@@ -64,6 +68,11 @@ class ResourceHolderBase
 public:
    static FreeListChunker<ResourceHolderBase> smHolderFactory;
 
+   /// Resources may be created on loader threads so access to the
+   /// holder factory goes through these.
+   static void* allocHolder();
+   static void freeHolder(ResourceHolderBase* holder);
+
    ResourceHolderBase() = default; // Default constructor
    virtual ~ResourceHolderBase() {}
 
@@ -71,6 +80,8 @@ public:
    void* getResource() const { return mRes.get(); }
 
 protected:
+   static Mutex smHolderMutex;
+
    // Construct a resource holder pointing at 'p'.
    template<typename T>
    ResourceHolderBase(T* p) : mRes(p, [](void*) {}) {}
@@ -114,14 +125,23 @@ public:
 protected:
 
    typedef void ( *NotifyUnloadFn )( const Torque::Path& path, void* resource );
+   typedef void ( *PostLoadFn )( const ResourceBase& resource );
 
-   class Header : public StrongRefBase
+   class Header
    {
    public:
       Header()
-      : mSignature(0),
+      : mRefCount(0),
+         mSignature(0),
+         mLoaded(0),
          mResource(NULL),
-         mNotifyUnload( NULL )
+         mNotifyUnload( NULL ),
+         mShard(0),
+         mSize(0),
+         mCached(false),
+         mEvicting(false),
+         mCachePrev(NULL),
+         mCacheNext(NULL)
       {
       }
 
@@ -131,27 +151,102 @@ protected:
       void *getResource() const { return (mResource ? mResource->getResource() : NULL); }
       U32   getChecksum() const;
 
-      void destroySelf() override;
+      U32   getRefCount() const { return mRefCount; }
+
+      /// Estimated number of bytes held by the loaded resource.
+      U32   getSize() const { return mSize; }
+
+      bool  isLoaded() const;
+
+      void  incRefCount();
+      void  decRefCount();
 
    private:
 
       friend class ResourceBase;
       friend class ResourceManager;
 
+      /// Frees the resource and the header.  The header must already be
+      /// unreachable through the ResourceManager.
+      void destroySelf();
+
+      /// Reference count.  Only ever raised from zero while holding the
+      /// shard lock in the ResourceManager so that a resource cannot be
+      /// resurrected while it is being released.
+      volatile U32         mRefCount;
+
       Signature            mSignature;
+
+      /// Set once mResource is valid.  Readers on other threads test
+      /// this before looking at the resource.
+      volatile U32         mLoaded;
+
       ResourceHolderBase*  mResource;
       Torque::Path         mPath;
       NotifyUnloadFn       mNotifyUnload;
+
+      /// Held while the resource is created so that concurrent requests
+      /// for the same path wait on the one load in flight.
+      Mutex                mLoadMutex;
+
+      /// The ResourceManager shard this header lives in.
+      U32                  mShard;
+
+      U32                  mSize;
+
+      /// Set while an unreferenced header is retained in the
+      /// ResourceManager cache.
+      bool                 mCached;
+      bool                 mEvicting;
+      Header*              mCachePrev;
+      Header*              mCacheNext;
+   };
+
+   /// A strong reference to a Header.  This is StrongRefPtr with an
+   /// atomic count so resources can be handed between threads.
+   class HeaderRef
+   {
+   public:
+      HeaderRef() : mHeader(NULL) {}
+      HeaderRef(Header *header) : mHeader(header) { if (mHeader) mHeader->incRefCount(); }
+      HeaderRef(const HeaderRef &ref) : mHeader(ref.mHeader) { if (mHeader) mHeader->incRefCount(); }
+      ~HeaderRef() { if (mHeader) mHeader->decRefCount(); }
+
+      HeaderRef &operator=(const HeaderRef &ref) { set(ref.mHeader); return *this; }
+      HeaderRef &operator=(Header *header) { set(header); return *this; }
+
+      Header *operator->() const { return mHeader; }
+      operator Header*() const { return mHeader; }
+      Header *getPointer() const { return mHeader; }
+
+   private:
+      void set(Header *header)
+      {
+         if (header)
+            header->incRefCount();
+         Header *old = mHeader;
+         mHeader = header;
+         if (old)
+            old->decRefCount();
+      }
+
+      Header *mHeader;
    };
 
 protected:
    static Header  smBlank;
    ResourceBase() : mResourceHeader(&smBlank) {}
 
-   StrongRefPtr<Header> mResourceHeader;
+   HeaderRef mResourceHeader;
 
    void assign(const ResourceBase &inResource, void* resource = NULL);
 
+   /// Installs a freshly created resource in the header and publishes it
+   /// to other threads.  The post load signal is fired on the main thread,
+   /// which is later on in the main loop for resources loaded on other
+   /// threads.
+   void _setLoaded(void* resource);
+
    // The following functions are virtual, but cannot be pure-virtual
    // because we need to be able to instantiate this class.
 
@@ -187,6 +282,7 @@ protected:
    }
 
    virtual void _triggerPostLoadSignal() {}
+   virtual PostLoadFn _getPostLoadFn() { return ( PostLoadFn ) NULL; }
    virtual NotifyUnloadFn _getNotifyUnloadFn() { return ( NotifyUnloadFn ) NULL; }
 };
 
@@ -272,7 +368,10 @@ private:
 
    static void _notifyUnload( const Torque::Path& path, void* resource ) { getUnloadSignal().trigger( path, ( T* ) resource ); }
 
+   static void _postLoad( const ResourceBase& resource ) { Resource< T > res( resource ); getPostLoadSignal().trigger( res ); }
+
    void _triggerPostLoadSignal() override { getPostLoadSignal().trigger( *this ); }
+   PostLoadFn _getPostLoadFn() override { return ( PostLoadFn ) &_postLoad; }
    NotifyUnloadFn _getNotifyUnloadFn() override { return ( NotifyUnloadFn ) &_notifyUnload; }
 
    // These are to be define by instantiated resources
@@ -285,7 +384,7 @@ private:
 
 template<class T> inline ResourceHolderBase *Resource<T>::createHolder(void *ptr)
 {
-   ResourceHolder<T> *resHolder = (ResourceHolder<T>*)(ResourceHolderBase::smHolderFactory.alloc());
+   ResourceHolder<T> *resHolder = (ResourceHolder<T>*)(ResourceHolderBase::allocHolder());
 
    resHolder = constructInPlace(resHolder,(T*)ptr);
 
@@ -26,15 +26,57 @@
 #include "core/volume.h"
 #include "console/console.h"
 #include "core/util/autoPtr.h"
+#include "core/module.h"
+#include "platform/platformIntrinsics.h"
 
 #include "console/engineAPI.h"
 
 using namespace Torque;
 
-static AutoPtr< ResourceManager > smInstance;
+/// Loader threads may be the first to ask for the manager
+/// so it is published with a compare and swap.
+static ResourceManager* volatile smInstance = NULL;
+
+/// Deletes the manager on shutdown.
+static AutoPtr< ResourceManager > smInstanceOwner;
+
+S32 ResourceManager::smMemoryBudget = 0;
+S32 ResourceManager::smHits = 0;
+S32 ResourceManager::smMisses = 0;
+S32 ResourceManager::smEvictions = 0;
+S32 ResourceManager::smResidentKB = 0;
+S32 ResourceManager::smCachedKB = 0;
+
+AFTER_MODULE_INIT( Sim )
+{
+   Con::addVariable( "$pref::ResourceManager::memoryBudget", TypeS32, &ResourceManager::smMemoryBudget,
+      "Megabytes of unreferenced resources to keep loaded for reuse.  Zero frees "
+      "resources as soon as they are no longer referenced.\n"
+      "@ingroup Debugging" );
+   Con::addVariable( "$ResourceManager::hits", TypeS32, &ResourceManager::smHits,
+      "Number of resource loads satisfied by an already managed resource.\n"
+      "@ingroup Debugging" );
+   Con::addVariable( "$ResourceManager::misses", TypeS32, &ResourceManager::smMisses,
+      "Number of resource loads which had to create a new resource.\n"
+      "@ingroup Debugging" );
+   Con::addVariable( "$ResourceManager::evictions", TypeS32, &ResourceManager::smEvictions,
+      "Number of unreferenced resources freed to stay within the memory budget.\n"
+      "@ingroup Debugging" );
+   Con::addVariable( "$ResourceManager::residentKB", TypeS32, &ResourceManager::smResidentKB,
+      "Estimated kilobytes of loaded resources, based on their file size.\n"
+      "@ingroup Debugging" );
+   Con::addVariable( "$ResourceManager::cachedKB", TypeS32, &ResourceManager::smCachedKB,
+      "Estimated kilobytes of unreferenced resources kept under the memory budget.\n"
+      "@ingroup Debugging" );
+}
 
 ResourceManager::ResourceManager()
-:  mIterSigFilter( U32_MAX )
+:  mCacheHead( NULL ),
+   mCacheTail( NULL ),
+   mBytesResident( 0 ),
+   mBytesCached( 0 ),
+   mIterIndex( 0 ),
+   mIterSigFilter( U32_MAX )
 {
 }
 
@@ -45,24 +87,49 @@ ResourceManager::~ResourceManager()
 
 ResourceManager &ResourceManager::get()
 {
-   if ( smInstance.isNull() )
-      smInstance = new ResourceManager;
+   if ( smInstance == NULL )
+   {
+      // Whoever loses the race drops their copy.
+      ResourceManager *manager = new ResourceManager;
+      if ( dCompareAndSwap( smInstance, ( ResourceManager* ) NULL, manager ) )
+         smInstanceOwner = manager;
+      else
+         delete manager;
+   }
+
    return *smInstance;
 }
 
+U32 ResourceManager::_getShardIndex( const String &fullPath )
+{
+   // The HashTable inside each shard buckets on the low bits.
+   return ( fullPath.getHashCaseInsensitive() >> 24 ) % NumShards;
+}
+
 ResourceBase ResourceManager::load(const Torque::Path &path)
 {
 #ifdef TORQUE_DEBUG_RES_MANAGER
    Con::printf( "ResourceManager::load : [%s]", path.getFullPath().c_str() );
 #endif
 
-   ResourceHeaderMap::Iterator iter = mResourceHeaderMap.findOrInsert( path.getFullPath() );
+   const String fullPath = path.getFullPath();
+   const U32 shardIndex = _getShardIndex( fullPath );
+   Shard &shard = mShards[ shardIndex ];
+
+   MutexHandle handle;
+   handle.lock( &shard.mMutex, true );
+
+   ResourceHeaderMap::Iterator iter = shard.mResourceHeaderMap.findOrInsert( fullPath );
 
    ResourceHeaderMap::Pair &pair = *iter;
 
    if ( pair.value == NULL )
    {
       pair.value = new ResourceBase::Header;
+      pair.value->mPath = path;
+      pair.value->mShard = shardIndex;
+
+      dFetchAndAdd( smMisses, 1 );
 
       // TODO: This can fail if the file doesn't exist 
       // at all which is possible.
@@ -74,13 +141,17 @@ ResourceBase ResourceManager::load(const Torque::Path &path)
       // IMO the resource manager is overly templateized and
       // we should refactor it so that its not so.
       //
+      MutexHandle notifyHandle;
+      notifyHandle.lock( &mNotifyMutex, true );
       FS::AddChangeNotification( path, this, &ResourceManager::notifiedFileChanged );
    }
+   else
+      dFetchAndAdd( smHits, 1 );
 
    ResourceBase::Header *header = pair.value;
 
-   if (header->getSignature() == 0)
-     header->mPath = path;
+   if ( header->mCached )
+      _uncacheHeader( header );
 
    return ResourceBase( header );
 }
@@ -91,22 +162,37 @@ ResourceBase ResourceManager::find(const Torque::Path &path)
    Con::printf( "ResourceManager::find : [%s]", path.getFullPath().c_str() );
 #endif
 
-   ResourceHeaderMap::Iterator iter = mResourceHeaderMap.find( path.getFullPath() );
+   const String fullPath = path.getFullPath();
+   Shard &shard = mShards[ _getShardIndex( fullPath ) ];
+
+   MutexHandle handle;
+   handle.lock( &shard.mMutex, true );
 
-   if ( iter == mResourceHeaderMap.end() )
+   ResourceHeaderMap::Iterator iter = shard.mResourceHeaderMap.find( fullPath );
+
+   if ( iter == shard.mResourceHeaderMap.end() )
       return ResourceBase();
 
    ResourceHeaderMap::Pair &pair = *iter;
 
    ResourceBase::Header	*header = pair.value;
 
+   if ( header->mCached )
+      _uncacheHeader( header );
+
    return ResourceBase(header);
 }
 
 #ifdef TORQUE_DEBUG
 void ResourceManager::dumpToConsole()
 {
-   const U32   numResources = mResourceHeaderMap.size();
+   U32 numResources = 0;
+   for ( U32 i = 0; i < NumShards; i++ )
+   {
+      MutexHandle handle;
+      handle.lock( &mShards[i].mMutex, true );
+      numResources += mShards[i].mResourceHeaderMap.size();
+   }
 
    if ( numResources == 0 )
    {
@@ -115,55 +201,231 @@ void ResourceManager::dumpToConsole()
    }
 
    Con::printf( "ResourceManager is managing %d resources:", numResources );
-   Con::printf( " [ref count/signature/path]" );
-
-   ResourceHeaderMap::Iterator iter;
+   Con::printf( " [ref count/signature/size/path]" );
 
-   for( iter = mResourceHeaderMap.begin(); iter != mResourceHeaderMap.end(); ++iter )
+   for ( U32 i = 0; i < NumShards; i++ )
    {
-      ResourceBase::Header	*header = (*iter).value;
-            
-      char fourCC[ 5 ];
-      *( ( U32* ) fourCC ) = header->getSignature();
-      fourCC[ 4 ] = 0;
+      Shard &shard = mShards[i];
 
-      Con::printf( " %3d %s [%s] ", header->getRefCount(), fourCC, (*iter).key.c_str() );
+      MutexHandle handle;
+      handle.lock( &shard.mMutex, true );
+
+      ResourceHeaderMap::Iterator iter;
+
+      for( iter = shard.mResourceHeaderMap.begin(); iter != shard.mResourceHeaderMap.end(); ++iter )
+      {
+         ResourceBase::Header	*header = (*iter).value;
+               
+         char fourCC[ 5 ];
+         *( ( U32* ) fourCC ) = header->getSignature();
+         fourCC[ 4 ] = 0;
+
+         Con::printf( " %3d %s %8d%s [%s] ", header->getRefCount(), fourCC, header->getSize(),
+            header->mCached ? " cached" : "", (*iter).key.c_str() );
+      }
    }
+
+   Con::printf( " hits: %d misses: %d evictions: %d resident: %dKB cached: %dKB",
+      smHits, smMisses, smEvictions, smResidentKB, smCachedKB );
 }
 #endif
 
-bool ResourceManager::remove( ResourceBase::Header* header )
+bool ResourceManager::_removeHeader( Shard &shard, ResourceBase::Header* header )
 {
    const Path &path = header->getPath();
+   const String fullPath = path.getFullPath();
 
 #ifdef TORQUE_DEBUG_RES_MANAGER
-   Con::printf( "ResourceManager::remove : [%s]", path.getFullPath().c_str() );
+   Con::printf( "ResourceManager::remove : [%s]", fullPath.c_str() );
 #endif
 
-   ResourceHeaderMap::Iterator iter = mResourceHeaderMap.find( path.getFullPath() );
-   if ( iter != mResourceHeaderMap.end() && iter->value == header )
+   AssertISV( header->getRefCount() == 0, "ResourceManager error: trying to remove resource which is still in use." );
+
+   ResourceHeaderMap::Iterator iter = shard.mResourceHeaderMap.find( fullPath );
+   if ( iter != shard.mResourceHeaderMap.end() && iter->value == header )
    {
-      AssertISV( header && (header->getRefCount() == 0), "ResourceManager error: trying to remove resource which is still in use." );
-      mResourceHeaderMap.erase( iter );
+      shard.mResourceHeaderMap.erase( iter );
    }
    else
    {
-      iter = mPrevResourceHeaderMap.find( path.getFullPath() );
-      if ( iter == mPrevResourceHeaderMap.end() || iter->value != header )
+      iter = shard.mPrevResourceHeaderMap.find( fullPath );
+      if ( iter == shard.mPrevResourceHeaderMap.end() || iter->value != header )
       {
-         Con::errorf( "ResourceManager::remove : Trying to remove non-existent resource [%s]", path.getFullPath().c_str() );
+         Con::errorf( "ResourceManager::remove : Trying to remove non-existent resource [%s]", fullPath.c_str() );
          return false;
       }
 
-      AssertISV( header && (header->getRefCount() == 0), "ResourceManager error: trying to remove resource which is still in use." );
-      mPrevResourceHeaderMap.erase( iter );
+      shard.mPrevResourceHeaderMap.erase( iter );
    }
 
+   MutexHandle notifyHandle;
+   notifyHandle.lock( &mNotifyMutex, true );
    FS::RemoveChangeNotification( path, this, &ResourceManager::notifiedFileChanged );
 
    return true;
 }
 
+void ResourceManager::_releaseHeader( ResourceBase::Header* header )
+{
+   Shard &shard = mShards[ header->mShard ];
+
+   MutexHandle handle;
+   handle.lock( &shard.mMutex, true );
+
+   // A count only rises from zero under this lock, so if we take it to
+   // zero here nobody else can be holding or resurrecting the header.
+   U32 count;
+   do
+   {
+      count = dAtomicRead( header->mRefCount );
+   }
+   while ( !dCompareAndSwap( header->mRefCount, count, count - 1 ) );
+
+   if ( count != 1 )
+      return;
+
+   ResourceHeaderMap::Iterator iter = shard.mResourceHeaderMap.find( header->getPath().getFullPath() );
+   const bool isCurrent = iter != shard.mResourceHeaderMap.end() && iter->value == header;
+
+   if ( isCurrent && _cacheHeader( header ) )
+   {
+      handle.unlock();
+      _trimCache( _getBudgetBytes() );
+      return;
+   }
+
+   _removeHeader( shard, header );
+   handle.unlock();
+
+   header->destroySelf();
+}
+
+U64 ResourceManager::_getBudgetBytes()
+{
+   return smMemoryBudget > 0 ? U64( smMemoryBudget ) << 20 : 0;
+}
+
+bool ResourceManager::_cacheHeader( ResourceBase::Header* header )
+{
+   MutexHandle handle;
+   handle.lock( &mCacheMutex, true );
+
+   // _trimCache() has already claimed it and will free it.
+   if ( header->mEvicting )
+      return true;
+
+   const U64 budget = _getBudgetBytes();
+   if ( budget == 0 || !header->isLoaded() || header->mSize == 0 || header->mSize > budget )
+      return false;
+
+   header->mCached = true;
+   header->mCachePrev = mCacheTail;
+   header->mCacheNext = NULL;
+   if ( mCacheTail )
+      mCacheTail->mCacheNext = header;
+   else
+      mCacheHead = header;
+   mCacheTail = header;
+
+   mBytesCached += header->mSize;
+   smCachedKB = S32( mBytesCached >> 10 );
+
+   return true;
+}
+
+void ResourceManager::_uncacheHeader( ResourceBase::Header* header )
+{
+   MutexHandle handle;
+   handle.lock( &mCacheMutex, true );
+
+   if ( !header->mCached )
+      return;
+
+   if ( header->mCachePrev )
+      header->mCachePrev->mCacheNext = header->mCacheNext;
+   else
+      mCacheHead = header->mCacheNext;
+
+   if ( header->mCacheNext )
+      header->mCacheNext->mCachePrev = header->mCachePrev;
+   else
+      mCacheTail = header->mCachePrev;
+
+   header->mCachePrev = NULL;
+   header->mCacheNext = NULL;
+   header->mCached = false;
+
+   mBytesCached -= header->mSize;
+   smCachedKB = S32( mBytesCached >> 10 );
+}
+
+void ResourceManager::_trimCache( U64 budget )
+{
+   for ( ;; )
+   {
+      ResourceBase::Header *victim;
+      {
+         MutexHandle handle;
+         handle.lock( &mCacheMutex, true );
+
+         if ( mCacheHead == NULL || mBytesCached <= budget )
+            return;
+
+         // Claim the oldest entry.  We cannot take its shard lock while
+         // holding the cache lock so pull it off the list and mark it as
+         // being evicted instead.
+         victim = mCacheHead;
+         _uncacheHeader( victim );
+         victim->mEvicting = true;
+      }
+
+      Shard &shard = mShards[ victim->mShard ];
+
+      MutexHandle shardHandle;
+      shardHandle.lock( &shard.mMutex, true );
+
+      {
+         MutexHandle handle;
+         handle.lock( &mCacheMutex, true );
+         victim->mEvicting = false;
+      }
+
+      // Someone picked it back up while we were waiting on the lock.
+      if ( victim->getRefCount() != 0 )
+         continue;
+
+      _removeHeader( shard, victim );
+      shardHandle.unlock();
+
+      dFetchAndAdd( smEvictions, 1 );
+      victim->destroySelf();
+   }
+}
+
+void ResourceManager::purgeCache()
+{
+   _trimCache( 0 );
+}
+
+void ResourceManager::_onResourceLoaded( ResourceBase::Header* header )
+{
+   FS::FileNodeRef fileRef = FS::GetFileNode( header->getPath() );
+   header->mSize = fileRef != NULL ? U32( fileRef->getSize() ) : 0;
+
+   MutexHandle handle;
+   handle.lock( &mCacheMutex, true );
+   mBytesResident += header->mSize;
+   smResidentKB = S32( mBytesResident >> 10 );
+}
+
+void ResourceManager::_onResourceUnloaded( ResourceBase::Header* header )
+{
+   MutexHandle handle;
+   handle.lock( &mCacheMutex, true );
+   mBytesResident -= header->mSize;
+   smResidentKB = S32( mBytesResident >> 10 );
+}
+
 void ResourceManager::notifiedFileChanged( const Torque::Path &path )
 {
    reloadResource( path, true );
@@ -174,16 +436,43 @@ void ResourceManager::reloadResource( const Torque::Path &path, bool showMessage
    if ( showMessage )
       Con::warnf( "[ResourceManager::notifiedFileChanged] : File changed [%s]", path.getFullPath().c_str() );
 
-   ResourceHeaderMap::Iterator iter = mResourceHeaderMap.find( path.getFullPath() );
-   if ( iter != mResourceHeaderMap.end() )
+   const String fullPath = path.getFullPath();
+   Shard &shard = mShards[ _getShardIndex( fullPath ) ];
+
+   ResourceBase::Header *unreferenced = NULL;
    {
-      ResourceBase::Header	*header = (*iter).value;
-      mResourceHeaderMap.erase( iter );
+      MutexHandle handle;
+      handle.lock( &shard.mMutex, true );
 
-      // Move the resource into the previous resource map.
-      iter = mPrevResourceHeaderMap.findOrInsert( path );
-      iter->value = header;
+      ResourceHeaderMap::Iterator iter = shard.mResourceHeaderMap.find( fullPath );
+      if ( iter != shard.mResourceHeaderMap.end() )
+      {
+         ResourceBase::Header	*header = (*iter).value;
+         shard.mResourceHeaderMap.erase( iter );
+
+         // Move the resource into the previous resource map.
+         iter = shard.mPrevResourceHeaderMap.findOrInsert( fullPath );
+         iter->value = header;
+
+         // Nothing is using a cached resource so just let it go.
+         bool isCached;
+         {
+            MutexHandle cacheHandle;
+            cacheHandle.lock( &mCacheMutex, true );
+            isCached = header->mCached;
+            _uncacheHeader( header );
+         }
+
+         if ( isCached )
+         {
+            _removeHeader( shard, header );
+            unreferenced = header;
+         }
+      }
    }
+
+   if ( unreferenced )
+      unreferenced->destroySelf();
 	
    // Now notify users of the resource change so they 
    // can release and reload.
@@ -192,7 +481,30 @@ void ResourceManager::reloadResource( const Torque::Path &path, bool showMessage
 
 ResourceBase ResourceManager::startResourceList( ResourceBase::Signature inSignature )
 {
-   mIter = mResourceHeaderMap.begin();
+   mIterList.clear();
+   mIterIndex = 0;
+
+   for ( U32 i = 0; i < NumShards; i++ )
+   {
+      Shard &shard = mShards[i];
+
+      MutexHandle handle;
+      handle.lock( &shard.mMutex, true );
+
+      ResourceHeaderMap::Iterator iter;
+      for ( iter = shard.mResourceHeaderMap.begin(); iter != shard.mResourceHeaderMap.end(); ++iter )
+      {
+         ResourceBase::Header *header = (*iter).value;
+
+         if ( inSignature != U32_MAX && header->getSignature() != inSignature )
+            continue;
+
+         if ( header->mCached )
+            _uncacheHeader( header );
+
+         mIterList.push_back( ResourceBase::HeaderRef( header ) );
+      }
+   }
 
    mIterSigFilter = inSignature;
 
@@ -201,21 +513,17 @@ ResourceBase ResourceManager::startResourceList( ResourceBase::Signature inSigna
 
 ResourceBase ResourceManager::nextResource()
 {
-   ResourceBase::Header	*header = NULL;
-
-   while( mIter != mResourceHeaderMap.end() )
+   while ( mIterIndex < mIterList.size() )
    {
-      header = (*mIter).value;
+      ResourceBase::Header *header = mIterList[ mIterIndex++ ];
 
-      ++mIter;
+      if ( mIterSigFilter == U32_MAX || header->getSignature() == mIterSigFilter )
+         return ResourceBase( header );
+   }
 
-      if ( mIterSigFilter == U32_MAX )
-         return ResourceBase(header);
+   mIterList.clear();
+   mIterIndex = 0;
 
-      if ( header->getSignature() == mIterSigFilter )
-         return ResourceBase(header);
-   }
-   
    return ResourceBase();
 }
 
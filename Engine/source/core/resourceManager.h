@@ -31,6 +31,22 @@
 #include "core/util/tDictionary.h"
 #endif
 
+#ifndef _TVECTOR_H_
+#include "core/util/tVector.h"
+#endif
+
+#ifndef _PLATFORM_THREADS_MUTEX_H_
+#include "platform/threads/mutex.h"
+#endif
+
+/// The ResourceManager may be used from any thread.  Resources are kept in
+/// a set of shards, each guarded by its own lock, and concurrent loads of
+/// the same path share a single create() call.
+///
+/// Unreferenced resources are normally freed right away.  When
+/// $pref::ResourceManager::memoryBudget is non-zero they are instead kept
+/// in a least recently released list, sized by their file size, and only
+/// freed once the retained total exceeds the budget.
 class ResourceManager
 {
 public:
@@ -40,6 +56,8 @@ public:
    ResourceBase load(const Torque::Path &path);
    ResourceBase find(const Torque::Path &path);
 
+   /// Iterates a snapshot of the managed resources.  The snapshot holds a
+   /// reference to each resource until the end of the list is reached.
    ResourceBase startResourceList( ResourceBase::Signature inSignature = U32_MAX );
    ResourceBase nextResource();
 
@@ -54,32 +72,87 @@ public:
    /// The signal passes the Resource's signature so the callee may filter these.
    ChangedSignal &getChangedSignal() { return mChangeSignal; }
 
+   /// Frees every unreferenced resource retained under the memory budget.
+   void purgeCache();
+
 #ifdef TORQUE_DEBUG
    void  dumpToConsole();
 #endif
 
    ~ResourceManager();
 
+   /// Memory budget in megabytes for unreferenced resources, zero
+   /// frees them immediately.
+   static S32 smMemoryBudget;
+
+   /// @name Statistics
+   /// @{
+   static S32 smHits;
+   static S32 smMisses;
+   static S32 smEvictions;
+   static S32 smResidentKB;
+   static S32 smCachedKB;
+   /// @}
+
 protected:
 
+   friend class ResourceBase;
    friend class ResourceBase::Header;
 
    ResourceManager();
 
-   bool remove( ResourceBase::Header* header );
+   enum { NumShards = 16 };
+
+   typedef HashTable<String,ResourceBase::Header*> ResourceHeaderMap;
+
+   struct Shard
+   {
+      Mutex mMutex;
+
+      /// The map of resources.
+      ResourceHeaderMap mResourceHeaderMap;
+
+      /// The map of old resources which have been replaced by
+      /// new resources from a file change notification.
+      ResourceHeaderMap mPrevResourceHeaderMap;
+   };
+
+   static U32 _getShardIndex( const String &fullPath );
+
+   /// Removes the header from its shard.  The shard lock must be held.
+   bool _removeHeader( Shard &shard, ResourceBase::Header* header );
+
+   /// Called when the last reference to a header may be going away.
+   void _releaseHeader( ResourceBase::Header* header );
+
+   /// @name Unreferenced resource cache
+   /// The cache list and byte counts are guarded by mCacheMutex which is
+   /// always taken after a shard lock.
+   /// @{
+   bool _cacheHeader( ResourceBase::Header* header );
+   void _uncacheHeader( ResourceBase::Header* header );
+   void _trimCache( U64 budget );
+   static U64 _getBudgetBytes();
+   /// @}
+
+   void _onResourceLoaded( ResourceBase::Header* header );
+   void _onResourceUnloaded( ResourceBase::Header* header );
 
    void  notifiedFileChanged( const Torque::Path &path );
 
-   typedef HashTable<String,ResourceBase::Header*> ResourceHeaderMap;
+   Shard mShards[NumShards];
 
-   /// The map of resources.
-   ResourceHeaderMap mResourceHeaderMap;
+   Mutex mCacheMutex;
+   ResourceBase::Header* mCacheHead;
+   ResourceBase::Header* mCacheTail;
+   U64 mBytesResident;
+   U64 mBytesCached;
 
-   /// The map of old resources which have been replaced by
-   /// new resources from a file change notification.
-   ResourceHeaderMap mPrevResourceHeaderMap;
+   /// Guards the file change notification registry.
+   Mutex mNotifyMutex;
 
-   ResourceHeaderMap::Iterator mIter;
+   Vector<ResourceBase::HeaderRef> mIterList;
+   U32 mIterIndex;
 
    U32 mIterSigFilter;
 
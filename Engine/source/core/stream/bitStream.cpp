@@ -63,6 +63,36 @@ void BitStream::sendPacketStream(const NetAddress *addr)
    Net::sendto(addr, gPacketStream.getBuffer(), gPacketStream.getPosition());
 }
 
+/// Loads up to 8 little endian bytes into the low bits of a word.
+static inline U64 loadLEBytes(const U8 *ptr, U32 count)
+{
+   if(count == 8)
+   {
+      U64 word;
+      dMemcpy(&word, ptr, sizeof(word));
+      return convertLEndianToHost(word);
+   }
+
+   U64 word = 0;
+   for(U32 i = 0; i < count; i++)
+      word |= U64(ptr[i]) << (i << 3);
+   return word;
+}
+
+/// Stores the low count bytes of a word in little endian order.
+static inline void storeLEBytes(U8 *ptr, U64 word, U32 count)
+{
+   if(count == 8)
+   {
+      word = convertHostToLEndian(word);
+      dMemcpy(ptr, &word, sizeof(word));
+      return;
+   }
+
+   for(U32 i = 0; i < count; i++)
+      ptr[i] = U8(word >> (i << 3));
+}
+
 // CodeReview WTF is this additional IsEqual? - BJG, 3/29/07
 
 inline bool IsEqual(F32 a, F32 b) { return a == b; }
@@ -235,18 +265,69 @@ void BitStream::writeBits(S32 bitCount, const void *bitPtr)
       return;
    }
 
-   // [tom, 8/17/2006] This is probably a lot lamer then it needs to be. However,
-   // at least it doesnt clobber data or overrun the buffer like the old code did.
-   const U8 *ptr = (U8 *)bitPtr;
+   // Only the bytes holding the written bits are touched and any bits in
+   // them outside the write are preserved.
+   const U8 *src = (const U8 *)bitPtr;
+   U8 *dst = mDataPtr + (bitNum >> 3);
+   const U32 shift = bitNum & 0x7;
+   bitNum += bitCount;
 
-   for(S32 srcBitNum = 0;srcBitNum < bitCount;srcBitNum++)
+   // Small writes fit within a single 64 bit window of the stream.
+   if(shift + bitCount <= 64)
    {
-      if((*(ptr + (srcBitNum >> 3)) & (1 << (srcBitNum & 0x7))) != 0)
-         *(mDataPtr + (bitNum >> 3)) |= (1 << (bitNum & 0x7));
-      else
-         *(mDataPtr + (bitNum >> 3)) &= ~(1 << (bitNum & 0x7));
-      bitNum++;
+      const U32 dstBytes = (shift + bitCount + 7) >> 3;
+      const U64 valueMask = bitCount == 64 ? ~U64(0) : ((U64(1) << bitCount) - 1);
+      const U64 value = loadLEBytes(src, (bitCount + 7) >> 3) & valueMask;
+      const U64 window = loadLEBytes(dst, dstBytes);
+      storeLEBytes(dst, (window & ~(valueMask << shift)) | (value << shift), dstBytes);
+      return;
    }
+
+   // Byte aligned writes are a straight copy.
+   if(shift == 0)
+   {
+      const U32 wholeBytes = bitCount >> 3;
+      dMemcpy(dst, src, wholeBytes);
+
+      const U32 tailBits = bitCount & 0x7;
+      if(tailBits)
+      {
+         const U8 mask = U8((1 << tailBits) - 1);
+         dst[wholeBytes] = (dst[wholeBytes] & ~mask) | (src[wholeBytes] & mask);
+      }
+      return;
+   }
+
+   // Otherwise shift the source through a 64 bit accumulator a word at
+   // a time, carrying the top bits of each word into the next.
+   U64 carry = dst[0] & ((1 << shift) - 1);
+   U32 remaining = bitCount;
+
+   while(remaining >= 64)
+   {
+      const U64 word = loadLEBytes(src, 8);
+      storeLEBytes(dst, carry | (word << shift), 8);
+      carry = word >> (64 - shift);
+      src += 8;
+      dst += 8;
+      remaining -= 64;
+   }
+
+   while(remaining >= 8)
+   {
+      const U32 byte = *src++;
+      *dst++ = U8(carry | (byte << shift));
+      carry = byte >> (8 - shift);
+      remaining -= 8;
+   }
+
+   // Merge the carried bits and any partial source byte into the stream.
+   const U32 pendingBits = shift + remaining;
+   const U32 pendingBytes = (pendingBits + 7) >> 3;
+   const U64 pendingMask = (U64(1) << pendingBits) - 1;
+   const U64 pending = carry | (remaining ? (U64(*src & ((1 << remaining) - 1)) << shift) : 0);
+   const U64 window = loadLEBytes(dst, pendingBytes);
+   storeLEBytes(dst, (window & ~pendingMask) | pending, pendingBytes);
 }
 
 void BitStream::setBit(S32 bitCount, bool set)
@@ -289,25 +370,42 @@ void BitStream::readBits(S32 bitCount, void *bitPtr)
       AssertWarn(false, "Out of range read");
       return;
    }
-   U8 *stPtr = mDataPtr + (bitNum >> 3);
-   S32 byteCount = (bitCount + 7) >> 3;
+   const U8 *stPtr = mDataPtr + (bitNum >> 3);
+   U32 byteCount = (bitCount + 7) >> 3;
 
    U8 *ptr = (U8 *) bitPtr;
 
-   S32 downShift = bitNum & 0x7;
-   S32 upShift = 8 - downShift;
-
-   U8 curB = *stPtr;
+   const U32 downShift = bitNum & 0x7;
    const U8 *stEnd = mDataPtr + bufSize;
-   while(byteCount--)
+
+   bitNum += bitCount;
+
+   // Each output byte is made of the top bits of one stream byte and the
+   // low bits of the next, so the last byte also picks up the bits that
+   // follow the read.  Bytes past the end of the buffer read as zero.
+   if(downShift == 0)
    {
-      stPtr++;
-      U8 nextB = stPtr < stEnd ? *stPtr : 0;
-      *ptr++ = (curB >> downShift) | (nextB << upShift);
-      curB = nextB;
+      const U32 avail = getMin(U32(stEnd - stPtr), byteCount);
+      dMemcpy(ptr, stPtr, avail);
+      if(avail < byteCount)
+         dMemset(ptr + avail, 0, byteCount - avail);
+      return;
    }
 
-   bitNum += bitCount;
+   while(byteCount >= 8 && stPtr + 9 <= stEnd)
+   {
+      const U64 word = (loadLEBytes(stPtr, 8) >> downShift) | (U64(stPtr[8]) << (64 - downShift));
+      storeLEBytes(ptr, word, 8);
+      ptr += 8;
+      stPtr += 8;
+      byteCount -= 8;
+   }
+
+   if(byteCount)
+   {
+      const U32 avail = getMin(U32(stEnd - stPtr), byteCount + 1);
+      storeLEBytes(ptr, loadLEBytes(stPtr, avail) >> downShift, byteCount);
+   }
 }
 
 bool BitStream::_read(U32 size, void *dataPtr)
@@ -261,6 +261,11 @@ void Forest::setTransform( const MatrixF &mat )
    Parent::setTransform( mat );
 }
 
+bool Forest::isStaticGeometry() const
+{
+   return ForestWindEmitter::getEmitters().empty();
+}
+
 void Forest::_onZoningChanged( SceneZoneSpaceManager *zoneManager )
 {
    const SceneManager* sm = getSceneManager();
@@ -164,6 +164,10 @@ public:
    /// client side position of the forest.
    void setTransform( const MatrixF &mat ) override;
 
+   /// Returns false while wind is blowing the trees around.  Item
+   /// edits are reported thru ForestData::getItemsChangedSignal().
+   bool isStaticGeometry() const override;
+
    void prepRenderImage( SceneRenderState *state ) override;
 
    bool isTreeInRange( const Point2F& point, F32 radius ) const;
@@ -185,6 +189,21 @@ public:
    void applyRadialImpulse( const Point3F &origin, F32 radius, F32 magnitude ) override;
 
    bool castRayBase( const Point3F &start, const Point3F &end, RayInfo *outInfo, bool rendered );
+
+   /// Casts a batch of rays against the forest, returning the number of
+   /// rays which hit.  The results match calling castRayBase() for each
+   /// ray, but rays which are near each other in the batch are cast thru
+   /// the cells together so keeping the batch coherent is faster.
+   ///
+   /// @param starts The start of each ray in object space.
+   /// @param ends The end of each ray in object space.
+   /// @param count The number of rays.
+   /// @param outInfos The result for each ray.  The userData of each is
+   ///                 used just like castRay() uses it.
+   /// @param outHits Set to true for each ray that hit.
+   /// @param rendered Cast against the rendered geometry.
+   ///
+   U32 castRayBatch( const Point3F *starts, const Point3F *ends, U32 count, RayInfo *outInfos, bool *outHits, bool rendered );
      
    const Resource<ForestData>& getData() const { return mData; }
 
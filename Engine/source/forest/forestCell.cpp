@@ -103,6 +103,23 @@ void ForestCell::buildBatches()
    }
 }
 
+bool ForestCell::hasDirtyBatches() const
+{
+   for ( U32 i=0; i < mBatches.size(); i++ )
+   {
+      if ( mBatches[i]->isDirty() )
+         return true;
+   }
+
+   return false;
+}
+
+void ForestCell::buildBatchData()
+{
+   for ( U32 i=0; i < mBatches.size(); i++ )
+      mBatches[i]->buildData();
+}
+
 S32 ForestCell::renderBatches( SceneRenderState *state, Frustum *culler )
 {
    PROFILE_SCOPE( ForestCell_renderBatches );
@@ -296,6 +313,8 @@ const ForestItem& ForestCell::insertItem( ForestItemKey key,
       // Clean up.
       mItems.clear();
       mItems.compact();
+      mItemBounds.clear();
+      mItemBounds.compact();
    }
 
    // Do we have children?
@@ -344,6 +363,8 @@ const ForestItem& ForestCell::insertItem( ForestItemKey key,
    if ( !found )
       item.setKey( key );
 
+   _updateItemBounds();
+
    return item;
 }
 
@@ -389,6 +410,7 @@ bool ForestCell::removeItem( ForestItemKey key, const Point3F &keyPos, bool dele
 
       // Erase it.
       mItems.erase( index );
+      _updateItemBounds();
    }
 
    // Do a full bounds update on the next request.
@@ -429,71 +451,85 @@ void ForestCell::getItems( Vector<ForestItem> *outItems ) const
    }
 }
 
-void ForestCell::buildPhysicsRep( Forest *forest )
-{   
-   AssertFatal( isLeaf(), "ForestCell::buildPhysicsRep() - This shouldn't be called on non-leaf cells!" );
-
-   bool isServer = forest->isServerObject();
+bool ForestCell::needsPhysicsRep( Forest *forest ) const
+{
+   AssertFatal( isLeaf(), "ForestCell::needsPhysicsRep() - This shouldn't be called on non-leaf cells!" );
 
    // Already has a PhysicsBody, if it needed to be rebuilt it would
    // already be null.
-   if ( mPhysicsRep[ isServer ] )
-      return;   
+   return PHYSICSMGR && !mPhysicsRep[ forest->isServerObject() ];
+}
 
-   if ( !PHYSICSMGR )
-      return;
+void ForestCell::buildCollisionPolys( ConcretePolyList *polyList ) const
+{
+   // We must pass a sphere to buildPolyList but it is not used.
+   const static SphereF dummySphere( Point3F::Zero, 0 );       
 
-   PhysicsCollision *colShape = NULL;
+   // Step thru them and build collision data.
+   ForestItemVector::const_iterator itemItr = mItems.begin();
+   for ( ; itemItr != mItems.end(); itemItr++ )
+   {
+      const ForestItem &item = *itemItr;
+      const ForestItemData *itemData = item.getData();
+      
+      // If not collidable don't need to build anything.
+      if ( !itemData->mCollidable )
+         continue;
+
+      // TODO: When we add breakable tree support this is where
+      // we would need to store their collision data seperately.
+
+      item.buildPolyList( polyList, item.getWorldBox(), dummySphere );
+
+      // TODO: Need to support multiple collision shapes
+      // for really big forests at some point in the future.
+   }
+}
+
+void ForestCell::buildPhysicsRep( Forest *forest )
+{   
+   if ( !needsPhysicsRep( forest ) )
+      return;   
 
    // If we can steal the collision shape from the server-side cell   
    // then do so as it saves us alot of cpu time and memory.
-   if ( mPhysicsRep[ 1 ] )
+   if ( canShareCollision() )
    {      
-      colShape = mPhysicsRep[ 1 ]->getColShape();
+      _createPhysicsRep( forest, mPhysicsRep[ 1 ]->getColShape() );
+      return;
    }
-   else
-   {
-      // We must pass a sphere to buildPolyList but it is not used.
-      const static SphereF dummySphere( Point3F::Zero, 0 );       
 
-      // Step thru them and build collision data.
-      ForestItemVector::iterator itemItr = mItems.begin();
-      ConcretePolyList polyList;
-      for ( ; itemItr != mItems.end(); itemItr++ )
-      {
-         const ForestItem &item = *itemItr;
-         const ForestItemData *itemData = item.getData();
-         
-         // If not collidable don't need to build anything.
-         if ( !itemData->mCollidable )
-            continue;
-
-         // TODO: When we add breakable tree support this is where
-         // we would need to store their collision data seperately.
+   ConcretePolyList polyList;
+   buildCollisionPolys( &polyList );
+   buildPhysicsRep( forest, polyList );
+}
 
-         item.buildPolyList( &polyList, item.getWorldBox(), dummySphere );
+void ForestCell::buildPhysicsRep( Forest *forest, const ConcretePolyList &polyList )
+{
+   if ( !needsPhysicsRep( forest ) )
+      return;
 
-         // TODO: Need to support multiple collision shapes
-         // for really big forests at some point in the future.
-      }
+   // We might not have any trees.
+   if ( polyList.isEmpty() )
+      return;
 
-      if ( !polyList.isEmpty() )
-      {
-         colShape = PHYSICSMGR->createCollision();
-         if ( !colShape->addTriangleMesh( polyList.mVertexList.address(),
-                                          polyList.mVertexList.size(),
-                                          polyList.mIndexList.address(),
-                                          polyList.mIndexList.size() / 3,
-                                          MatrixF::Identity ) )
-         {
-            SAFE_DELETE( colShape );
-         }
-      }
+   PhysicsCollision *colShape = PHYSICSMGR->createCollision();
+   if ( !colShape->addTriangleMesh( polyList.mVertexList.address(),
+                                    polyList.mVertexList.size(),
+                                    polyList.mIndexList.address(),
+                                    polyList.mIndexList.size() / 3,
+                                    MatrixF::Identity ) )
+   {
+      SAFE_DELETE( colShape );
+      return;
    }
 
-   // We might not have any trees.
-   if ( !colShape )
-      return;
+   _createPhysicsRep( forest, colShape );
+}
+
+void ForestCell::_createPhysicsRep( Forest *forest, PhysicsCollision *colShape )
+{
+   bool isServer = forest->isServerObject();
 
    PhysicsWorld *world = PHYSICSMGR->getWorld( isServer ? "server" : "client" );
    mPhysicsRep[ isServer ] = PHYSICSMGR->createBody();
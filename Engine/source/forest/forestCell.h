@@ -38,6 +38,9 @@ class SceneRenderState;
 class Frustum;
 class IForestCellCollision;
 class PhysicsBody;
+struct ForestRayPacket;
+class PhysicsCollision;
+class ConcretePolyList;
 //class ForestRayInfo;
 
 
@@ -85,6 +88,12 @@ protected:
    /// Whether this cell is fully contained inside interior zones.
    bool mIsInteriorOnly;
 
+   /// The world boxes of the items for the packet ray casts.  Each
+   /// group of four items is stored as the min x, y, z lanes followed
+   /// by the max x, y, z lanes.  It is rebuilt as items are inserted
+   /// and removed so the ray casts never have to.
+   Vector<F32> mItemBounds;
+
    ///
    inline U32 _getSubCell( F32 x, F32 y ) const 
    {
@@ -114,6 +123,12 @@ protected:
 
    void _updateBounds();
 
+   /// Rebuilds mItemBounds from the items.
+   void _updateItemBounds();
+
+   /// Creates the PhysicsBody for this cell from the collision shape.
+   void _createPhysicsRep( Forest *forest, PhysicsCollision *colShape );
+
    ///
    void _updateZoning( const SceneZoneSpaceManager *zoneManager );
 
@@ -154,10 +169,28 @@ public:
    ///
    bool castRay( const Point3F &start, const Point3F &end, RayInfo *outInfo, bool rendered ) const;
 
+   /// Casts the rays in the mask thru this cell and its children,
+   /// keeping the closest hit of each ray in the packet.  The cells
+   /// and items are visited in the same order as castRay() so the
+   /// results match casting each ray by itself.
+   void castRayPacket( ForestRayPacket *packet, U32 rayMask ) const;
+
+   /// Returns a bit for each of four boxes stored in the mItemBounds
+   /// layout which the segment may touch.  The test is conservative,
+   /// it never misses a box that Box3F::collideLine() would hit.
+   static U32 testItemBounds( const F32 *bounds, const Point3F &start, const Point3F &invDir );
+
    bool hasBatches() const { return !mBatches.empty(); }
 
    void buildBatches();
 
+   /// Returns true if any of the batches need to be rebuilt.
+   bool hasDirtyBatches() const;
+
+   /// Builds the CPU side data of the dirty batches.  Different
+   /// cells can do this from multiple threads at once.
+   void buildBatchData();
+
    void freeBatches();
 
    S32 renderBatches( SceneRenderState *state, Frustum *culler );
@@ -205,6 +238,26 @@ public:
 
    void clearPhysicsRep( Forest *forest );
    void buildPhysicsRep( Forest *forest );
+
+   /// Returns true if buildPhysicsRep() has work to do for the forest.
+   bool needsPhysicsRep( Forest *forest ) const;
+
+   /// Returns true if the physics rep can reuse the collision
+   /// shape of the server side cell instead of building one.
+   bool canShareCollision() const { return mPhysicsRep[1] != NULL; }
+
+   /// Gathers the collision triangles of the collidable items.
+   ///
+   /// This only reads the items and is safe to call from multiple
+   /// threads at once as long as the shape instances of the item
+   /// datablocks have already been created.
+   ///
+   /// @see ForestData::buildPhysicsRep
+   void buildCollisionPolys( ConcretePolyList *polyList ) const;
+
+   /// Finishes the physics rep from the triangles returned
+   /// by buildCollisionPolys().  Must be called from the main thread.
+   void buildPhysicsRep( Forest *forest, const ConcretePolyList &polyList );
 };
 
 
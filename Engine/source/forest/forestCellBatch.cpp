@@ -28,6 +28,7 @@
 
 ForestCellBatch::ForestCellBatch()
    :  mDirty( false ),
+      mDataBuilt( false ),
       mBounds( Box3F::Invalid )
 {
 }
@@ -52,6 +53,7 @@ bool ForestCellBatch::add( const ForestItem &item )
    // Add it to our list and we'll populate the VB at render time.
    mItems.push_back( item );
    mDirty = true;
+   mDataBuilt = false;
 
    // Expand out bounds.
    const Box3F &box = item.getWorldBox();
@@ -59,12 +61,23 @@ bool ForestCellBatch::add( const ForestItem &item )
    return true;
 }
 
+void ForestCellBatch::buildData()
+{
+   if ( !mDirty || mDataBuilt )
+      return;
+
+   _buildBatchData();
+   mDataBuilt = true;
+}
+
 void ForestCellBatch::render( SceneRenderState *state )
 {
    if ( mDirty )
    {
+      buildData();
       _rebuildBatch();
       mDirty = false;
+      mDataBuilt = false;
    }
 
    _render( state );
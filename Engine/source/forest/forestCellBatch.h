@@ -36,6 +36,10 @@ protected:
    /// objects need to be repacked.
    bool mDirty; 
 
+   /// Set once the CPU side batch data has been built
+   /// for the current items.
+   bool mDataBuilt;
+
    /// The items in the batch.
    Vector<ForestItem> mItems;
 
@@ -43,6 +47,13 @@ protected:
    Box3F mBounds;
 
    virtual bool _prepBatch( const ForestItem &item ) = 0;
+
+   /// Builds the CPU side data for the batch which is later
+   /// copied into the GFX resources by _rebuildBatch().
+   /// @note This may be called from a worker thread so it must
+   /// not touch the GFX device or any shared state.
+   virtual void _buildBatchData() {}
+
    virtual void _rebuildBatch() = 0;
    virtual void _render( const SceneRenderState *state ) = 0;
 
@@ -54,6 +65,14 @@ public:
    bool add( const ForestItem &item );
    S32 getItemCount() const { return mItems.size(); }
 
+   /// Returns true if the batch needs to be rebuilt before rendering.
+   bool isDirty() const { return mDirty; }
+
+   /// Builds the CPU side data of a dirty batch ahead of the
+   /// render.  It is safe to call this on different batches
+   /// from multiple threads at once.
+   void buildData();
+
    void render( SceneRenderState *state );
    const Box3F& getWorldBox() const { return mBounds; }
 };
@@ -33,6 +33,11 @@
 #include "collision/concretePolyList.h"
 #include "platform/profiler.h"
 
+#if (defined( TORQUE_CPU_X86 ) || defined( TORQUE_CPU_X64 ))
+#define FOREST_RAY_SSE
+#include <xmmintrin.h>
+#endif
+
 
 /*
 bool Forest::castRay( const Point3F &start, const Point3F &end, RayInfo* info )
@@ -335,6 +340,64 @@ bool Forest::castRayBase( const Point3F &start, const Point3F &end, RayInfo *out
    return false;
 }
 
+U32 Forest::castRayBatch( const Point3F *starts, const Point3F *ends, U32 count, RayInfo *outInfos, bool *outHits, bool rendered )
+{
+   PROFILE_SCOPE( Forest_castRayBatch );
+
+   // Find the rays which touch the forest at all.
+   Vector<U32> indices;
+   for ( U32 i=0; i < count; i++ )
+   {
+      outHits[i] = false;
+      if ( getObjBox().collideLine( starts[i], ends[i] ) )
+         indices.push_back( i );
+   }
+
+   if ( indices.empty() )
+      return 0;
+
+   U32 hits;
+
+   if ( indices.size() == count )
+      hits = mData->castRayBatch( starts, ends, count, outInfos, outHits, rendered );
+   else
+   {
+      // Cast the rays which passed and copy back the results.  The
+      // others are left untouched like castRayBase() does.
+      Vector<Point3F> rayStarts;
+      Vector<Point3F> rayEnds;
+      Vector<RayInfo> infos;
+      Vector<bool> rayHits;
+      rayStarts.setSize( indices.size() );
+      rayEnds.setSize( indices.size() );
+      infos.setSize( indices.size() );
+      rayHits.setSize( indices.size() );
+
+      for ( U32 i=0; i < indices.size(); i++ )
+      {
+         rayStarts[i] = starts[ indices[i] ];
+         rayEnds[i] = ends[ indices[i] ];
+         infos[i] = outInfos[ indices[i] ];
+      }
+
+      hits = mData->castRayBatch( rayStarts.address(), rayEnds.address(), indices.size(), infos.address(), rayHits.address(), rendered );
+
+      for ( U32 i=0; i < indices.size(); i++ )
+      {
+         outInfos[ indices[i] ] = infos[i];
+         outHits[ indices[i] ] = rayHits[i];
+      }
+   }
+
+   for ( U32 i=0; i < count; i++ )
+   {
+      if ( outHits[i] )
+         outInfos[i].object = this;
+   }
+
+   return hits;
+}
+
 void Forest::updateCollision()
 {
    if ( !mData )
@@ -409,6 +472,206 @@ bool ForestCell::castRay( const Point3F &start, const Point3F &end, RayInfo *out
    return ( outInfo->t < F32_MAX );
 }
 
+U32 ForestData::castRayBatch( const Point3F *starts, const Point3F *ends, U32 count, RayInfo *outInfos, bool *outHits, bool rendered ) const
+{
+   PROFILE_SCOPE( ForestData_castRayBatch );
+
+   ForestRayPacket packet;
+   packet.rendered = rendered;
+
+   U32 hits = 0;
+
+   for ( U32 first=0; first < count; first += ForestRayPacket::MaxRays )
+   {
+      packet.count = getMin( count - first, (U32)ForestRayPacket::MaxRays );
+      packet.outInfo = outInfos + first;
+
+      for ( U32 i=0; i < packet.count; i++ )
+         packet.setRay( i, starts[ first + i ], ends[ first + i ] );
+
+      const U32 rayMask = ( 1 << packet.count ) - 1;
+
+      BucketTable::ConstIterator iter = mBuckets.begin();
+      for (; iter != mBuckets.end(); ++iter)
+         iter->value->castRayPacket( &packet, rayMask );
+
+      for ( U32 i=0; i < packet.count; i++ )
+      {
+         outHits[ first + i ] = packet.outInfo[i].t < F32_MAX;
+         if ( outHits[ first + i ] )
+            hits++;
+      }
+   }
+
+   return hits;
+}
+
+void ForestRayPacket::setRay( U32 index, const Point3F &rayStart, const Point3F &rayEnd )
+{
+   start[index] = rayStart;
+   end[index] = rayEnd;
+
+   // Rays which are parallel to an axis get a large but finite
+   // inverse so that the bounds tests never produce NaNs.
+   const Point3F dir = rayEnd - rayStart;
+   for ( U32 i=0; i < 3; i++ )
+      invDir[index][i] = mFabs( dir[i] ) > 1e-20f ? 1.0f / dir[i] : 1e20f;
+
+   // Reset the result the same way ForestData::castRay() does.
+   void *userData = outInfo[index].userData;
+   outInfo[index] = RayInfo();
+   outInfo[index].userData = userData;
+   outInfo[index].t = F32_MAX;
+
+   work[index] = outInfo[index];
+}
+
+void ForestCell::_updateItemBounds()
+{
+   const U32 numGroups = ( mItems.size() + 3 ) / 4;
+   mItemBounds.setSize( numGroups * 24 );
+
+   for ( U32 i=0; i < numGroups * 4; i++ )
+   {
+      F32 *group = mItemBounds.address() + ( i / 4 ) * 24;
+      const U32 lane = i % 4;
+
+      Point3F minPt, maxPt;
+      if ( i >= mItems.size() )
+      {
+         // Pad out the last group with a box no ray can reach.
+         minPt.set( F32_MAX, F32_MAX, F32_MAX );
+         maxPt = minPt;
+      }
+      else
+      {
+         const Box3F &box = mItems[i].getWorldBox();
+         minPt = box.minExtents;
+         maxPt = box.maxExtents;
+
+         for ( U32 axis=0; axis < 3; axis++ )
+         {
+            if ( minPt[axis] <= maxPt[axis] )
+            {
+               // Pad the box to cover any rounding differences with
+               // the exact test in Box3F::collideLine().
+               const F32 pad = 0.01f + getMax( mFabs( minPt[axis] ), mFabs( maxPt[axis] ) ) * 1e-5f;
+               minPt[axis] -= pad;
+               maxPt[axis] += pad;
+            }
+            else
+            {
+               // Let the exact test deal with bad boxes.
+               minPt[axis] = -F32_MAX;
+               maxPt[axis] = F32_MAX;
+            }
+         }
+      }
+
+      for ( U32 axis=0; axis < 3; axis++ )
+      {
+         group[ axis * 4 + lane ] = minPt[axis];
+         group[ 12 + axis * 4 + lane ] = maxPt[axis];
+      }
+   }
+}
+
+U32 ForestCell::testItemBounds( const F32 *bounds, const Point3F &start, const Point3F &invDir )
+{
+#ifdef FOREST_RAY_SSE
+
+   __m128 nearT = _mm_setzero_ps();
+   __m128 farT = _mm_set1_ps( 1.0f );
+
+   for ( U32 axis=0; axis < 3; axis++ )
+   {
+      const __m128 s = _mm_set1_ps( start[axis] );
+      const __m128 inv = _mm_set1_ps( invDir[axis] );
+      const __m128 t0 = _mm_mul_ps( _mm_sub_ps( _mm_loadu_ps( bounds + axis * 4 ), s ), inv );
+      const __m128 t1 = _mm_mul_ps( _mm_sub_ps( _mm_loadu_ps( bounds + 12 + axis * 4 ), s ), inv );
+      nearT = _mm_max_ps( nearT, _mm_min_ps( t0, t1 ) );
+      farT = _mm_min_ps( farT, _mm_max_ps( t0, t1 ) );
+   }
+
+   return _mm_movemask_ps( _mm_cmple_ps( nearT, farT ) );
+
+#else
+
+   U32 mask = 0;
+
+   for ( U32 lane=0; lane < 4; lane++ )
+   {
+      F32 nearT = 0.0f;
+      F32 farT = 1.0f;
+
+      for ( U32 axis=0; axis < 3; axis++ )
+      {
+         const F32 t0 = ( bounds[ axis * 4 + lane ] - start[axis] ) * invDir[axis];
+         const F32 t1 = ( bounds[ 12 + axis * 4 + lane ] - start[axis] ) * invDir[axis];
+         nearT = getMax( nearT, getMin( t0, t1 ) );
+         farT = getMin( farT, getMax( t0, t1 ) );
+      }
+
+      if ( nearT <= farT )
+         mask |= 1 << lane;
+   }
+
+   return mask;
+
+#endif
+}
+
+void ForestCell::castRayPacket( ForestRayPacket *packet, U32 rayMask ) const
+{
+   // Use the same test as castRay() so that we
+   // visit exactly the same cells.
+   U32 mask = 0;
+   for ( U32 i=0; i < packet->count; i++ )
+   {
+      if ( ( rayMask & ( 1 << i ) ) && mBounds.collideLine( packet->start[i], packet->end[i] ) )
+         mask |= 1 << i;
+   }
+
+   if ( !mask )
+      return;
+
+   if ( !isLeaf() )
+   {
+      for ( U32 i=0; i < 4; i++ )
+         mSubCells[i]->castRayPacket( packet, mask );
+
+      return;
+   }
+
+   const U32 numGroups = mItemBounds.size() / 24;
+
+   for ( U32 i=0; i < packet->count; i++ )
+   {
+      if ( !( mask & ( 1 << i ) ) )
+         continue;
+
+      RayInfo &work = packet->work[i];
+      RayInfo &shortest = packet->outInfo[i];
+
+      for ( U32 group=0; group < numGroups; group++ )
+      {
+         U32 hits = testItemBounds( mItemBounds.address() + group * 24, packet->start[i], packet->invDir[i] );
+
+         // Do the exact tests in item order so that 
+         // ties resolve the same as castRay().
+         for ( U32 lane=0; hits; lane++, hits >>= 1 )
+         {
+            if ( !( hits & 1 ) || group * 4 + lane >= mItems.size() )
+               continue;
+
+            const ForestItem &item = mItems[ group * 4 + lane ];
+            if ( item.castRay( packet->start[i], packet->end[i], &work, packet->rendered ) && work.t < shortest.t )
+               shortest = work;
+         }
+      }
+   }
+}
+
 bool ForestItem::castRay( const Point3F &start, const Point3F &end, RayInfo *outInfo, bool rendered ) const
 {
    if ( !mWorldBox.collideLine( start, end ) )
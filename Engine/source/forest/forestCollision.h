@@ -89,4 +89,33 @@ protected:
 };
 
 
+/// A group of rays which are cast thru the forest cells together.
+/// @see ForestData::castRayBatch
+struct ForestRayPacket
+{
+   enum { MaxRays = 16 };
+
+   /// The number of rays in the packet.
+   U32 count;
+
+   /// Cast against the rendered geometry instead of the LOS details.
+   bool rendered;
+
+   Point3F start[MaxRays];
+   Point3F end[MaxRays];
+
+   /// The inverse ray direction used for the item bounds tests.
+   Point3F invDir[MaxRays];
+
+   /// The info passed to the items while casting.
+   RayInfo work[MaxRays];
+
+   /// The closest hit for each ray.
+   RayInfo *outInfo;
+
+   /// Sets up the ray and resets its result in outInfo.
+   void setRay( U32 index, const Point3F &rayStart, const Point3F &rayEnd );
+};
+
+
 #endif // _FORESTCOLLISION_H_
@@ -25,12 +25,17 @@
 
 #include "forest/forest.h"
 #include "forest/forestCell.h"
+#include "forest/ts/tsForestItemData.h"
+#include "T3D/physics/physicsPlugin.h"
 #include "T3D/physics/physicsBody.h"
+#include "collision/concretePolyList.h"
+#include "platform/threads/threadPool.h"
 #include "core/stream/fileStream.h"
 #include "core/resource.h"
 #include "math/mathIO.h"
 #include "math/mPoint2.h"
 #include "platform/profiler.h"
+#include "core/util/endian.h"
 
 
 template<> ResourceBase::Signature Resource<ForestData>::signature()
@@ -83,6 +88,101 @@ void ForestData::clear()
    mIsDirty = true;
 }
 
+void ForestData::_convertFileItem( FileItem *item )
+{
+#ifdef TORQUE_BIG_ENDIAN
+   for ( U32 i=0; i < 3; i++ )
+      item->position[i] = convertLEndianToHost( item->position[i] );
+
+   item->rotation.x = convertLEndianToHost( item->rotation.x );
+   item->rotation.y = convertLEndianToHost( item->rotation.y );
+   item->rotation.z = convertLEndianToHost( item->rotation.z );
+   item->rotation.w = convertLEndianToHost( item->rotation.w );
+   item->scale = convertLEndianToHost( item->scale );
+   item->dataIndex = convertLEndianToHost( item->dataIndex );
+#endif
+}
+
+/// Used to sort the items into file order.
+struct ForestItemSortKey
+{
+   U64 key;
+   U32 index;
+};
+
+static S32 QSORT_CALLBACK _cmpItemSortKey( const void *a, const void *b )
+{
+   const U64 keyA = ((const ForestItemSortKey*)a)->key;
+   const U64 keyB = ((const ForestItemSortKey*)b)->key;
+
+   if ( keyA < keyB )
+      return -1;
+
+   return keyA > keyB ? 1 : 0;
+}
+
+U64 ForestData::_getSortKey( const Point3F &pos )
+{
+   const Point2I bucket = _getBucketKey( pos );
+
+   // Quantize the position within the bucket.
+   const U32 qx = mClamp( (S32)( ( pos.x - bucket.x ) / BUCKET_DIM * 65536.0f ), 0, 65535 );
+   const U32 qy = mClamp( (S32)( ( pos.y - bucket.y ) / BUCKET_DIM * 65536.0f ), 0, 65535 );
+
+   // Interleave the bits with x above y which matches
+   // the child order of ForestCell::_getSubCell().
+   U32 morton = 0;
+   for ( U32 i=0; i < 16; i++ )
+   {
+      morton |= ( ( qy >> i ) & 1 ) << ( i * 2 );
+      morton |= ( ( qx >> i ) & 1 ) << ( i * 2 + 1 );
+   }
+
+   // The bucket grid index sorts first.
+   const U64 bx = (U16)( bucket.x / (S32)BUCKET_DIM + 0x8000 );
+   const U64 by = (U16)( bucket.y / (S32)BUCKET_DIM + 0x8000 );
+
+   return ( bx << 48 ) | ( by << 32 ) | morton;
+}
+
+U32 ForestData::_readItemsV1( Stream &stream, const Vector<ForestItemData*> &allDatablocks )
+{
+   U8 dataIndex;
+   Point3F pos;
+   QuatF rot;
+   F32 scale;
+   ForestItemData* data;
+   MatrixF xfm;
+
+   U32 skippedItems = 0;
+
+   // Read in the items.
+   U32 count;
+   stream.read( &count );
+   for ( U32 i=0; i < count; i++ )
+   {
+      stream.read( &dataIndex );
+      mathRead( stream, &pos );
+      mathRead( stream, &rot );
+      stream.read( &scale );
+
+      data = dataIndex < allDatablocks.size() ? allDatablocks[ dataIndex ] : NULL;
+      if ( data )
+      {
+         rot.setMatrix( &xfm );
+         xfm.setPosition( pos );
+
+         addItem( smNextItemId++, data, xfm, scale );
+      }
+      else
+      {
+         skippedItems++;
+      }
+   }
+
+   return skippedItems;
+}
+
 bool ForestData::read( Stream &stream )
 {
    // Read our identifier... so we know we're 
@@ -129,35 +229,40 @@ bool ForestData::read( Stream &stream )
       allDatablocks[ i ] = data;
    }
 
-   U8 dataIndex;
-   Point3F pos;
-   QuatF rot;
-   F32 scale;
-   ForestItemData* data;
-   MatrixF xfm;
-
    U32 skippedItems = 0;
 
-   // Read in the items.
-   stream.read( &count );
-   for ( U32 i=0; i < count; i++ )
+   if ( version < 2 )
+      skippedItems = _readItemsV1( stream, allDatablocks );
+   else
    {
-      stream.read( &dataIndex );
-      mathRead( stream, &pos );
-      mathRead( stream, &rot );
-      stream.read( &scale );
+      // The items are stored as one packed array.
+      stream.read( &count );
 
-      data = allDatablocks[ dataIndex ];
-      if ( data )
+      Vector<FileItem> items;
+      items.setSize( count );
+      if ( count > 0 && !stream.read( count * sizeof( FileItem ), items.address() ) )
       {
-         rot.setMatrix( &xfm );
-         xfm.setPosition( pos );
-
-         addItem( smNextItemId++, data, xfm, scale );
+         Con::errorf( "ForestDataFile::read() - Failed reading the forest items!" );
+         return false;
       }
-      else
+
+      MatrixF xfm;
+      for ( U32 i=0; i < count; i++ )
       {
-         skippedItems++;
+         FileItem &item = items[i];
+         _convertFileItem( &item );
+
+         ForestItemData *data = item.dataIndex < allDatablocks.size() ? allDatablocks[ item.dataIndex ] : NULL;
+         if ( !data )
+         {
+            skippedItems++;
+            continue;
+         }
+
+         item.rotation.setMatrix( &xfm );
+         xfm.setPosition( item.position );
+
+         addItem( smNextItemId++, data, xfm, item.scale );
       }
    }
 
@@ -180,6 +285,13 @@ bool ForestData::write( const char *path )
       return false;
    }
 
+   return write( stream );
+}
+
+bool ForestData::write( Stream &stream )
+{
+   PROFILE_SCOPE( ForestData_write );
+
    // Write our identifier... so we have a better
    // idea if we're reading pure garbage.
    stream.write( 4, "FKDF" );
@@ -206,26 +318,37 @@ bool ForestData::write( const char *path )
    Vector<ForestItem> items;
    getItems( &items );
 
-   // Save the item count.
-   stream.write( (U32)items.size() );
-
-   // Save the items.
-   Vector<ForestItem>::const_iterator iter = items.begin();
-   for ( ; iter != items.end(); iter++ )
+   // Sort them into bucket and quad tree order.
+   Vector<ForestItemSortKey> order;
+   order.setSize( items.size() );
+   for ( U32 i=0; i < items.size(); i++ )
    {
-      U8 dataIndex = T3D::find( allDatablocks.begin(), allDatablocks.end(), iter->getData() ) - allDatablocks.begin();
-
-      stream.write( dataIndex );
+      order[i].key = _getSortKey( items[i].getPosition() );
+      order[i].index = i;
+   }
+   dQsort( order.address(), order.size(), sizeof( ForestItemSortKey ), _cmpItemSortKey );
 
-      mathWrite( stream, iter->getPosition() );
+   // Pack the items.
+   Vector<FileItem> fileItems;
+   fileItems.setSize( items.size() );
+   for ( U32 i=0; i < order.size(); i++ )
+   {
+      const ForestItem &item = items[ order[i].index ];
+      FileItem &fileItem = fileItems[i];
 
-      QuatF quat;       
-      quat.set( iter->getTransform() );
-      mathWrite( stream, quat );
+      fileItem.position = item.getPosition();
+      fileItem.rotation.set( item.getTransform() );
+      fileItem.scale = item.getScale();
+      fileItem.dataIndex = T3D::find( allDatablocks.begin(), allDatablocks.end(), item.getData() ) - allDatablocks.begin();
 
-      stream.write( iter->getScale() );
+      _convertFileItem( &fileItem );
    }
 
+   // Save the item count and the items.
+   stream.write( (U32)fileItems.size() );
+   if ( !fileItems.empty() )
+      stream.write( fileItems.size() * sizeof( FileItem ), fileItems.address() );
+
    // Clear the dirty flag.
    mIsDirty = false;
 
@@ -300,6 +423,8 @@ void ForestData::_onItemReload()
 
       pCell->getChildren( &stack );
    }
+
+   getItemsChangedSignal().trigger( Box3F::Max );
 }
 
 const ForestItem& ForestData::addItem( ForestItemData *data,
@@ -325,7 +450,9 @@ const ForestItem& ForestData::addItem( ForestItemKey key,
    
    mIsDirty = true;
 
-   return bucket->insertItem( key, data, xfm, scale );
+   const ForestItem &item = bucket->insertItem( key, data, xfm, scale );
+   getItemsChangedSignal().trigger( item.getWorldBox() );
+   return item;
 }
 
 const ForestItem& ForestData::updateItem( ForestItemKey key,
@@ -338,9 +465,13 @@ const ForestItem& ForestData::updateItem( ForestItemKey key,
 
    ForestCell *bucket = _findBucket( bucketKey );
 
+   const Box3F oldWorldBox = findItem( key, keyPosition ).getWorldBox();
+
    if ( !bucket || !bucket->removeItem( key, keyPosition, true ) )
       return ForestItem::Invalid;
 
+   getItemsChangedSignal().trigger( oldWorldBox );
+
    if ( bucket->isEmpty() )
    {
       delete bucket;
@@ -365,9 +496,13 @@ bool ForestData::removeItem( ForestItemKey key, const Point3F &keyPosition )
 
    ForestCell *bucket = _findBucket( keyPosition );
 
+   const Box3F oldWorldBox = findItem( key, keyPosition ).getWorldBox();
+
    if ( !bucket || !bucket->removeItem( key, keyPosition, true ) )
       return false;
 
+   getItemsChangedSignal().trigger( oldWorldBox );
+
    if ( bucket->isEmpty() )
    {
       delete bucket;
@@ -809,12 +944,31 @@ void ForestData::clearPhysicsRep( Forest *forest )
 
 void ForestData::buildPhysicsRep( Forest *forest )
 {
+   PROFILE_SCOPE( ForestData_buildPhysicsRep );
+
+   if ( !PHYSICSMGR )
+      return;
+
+   // The shape instances are created on first use which isn't
+   // thread safe, so make sure they all exist before we start.
+   Vector<ForestItemData*> datablocks;
+   getDatablocks( &datablocks );
+   for ( U32 i=0; i < datablocks.size(); i++ )
+   {
+      TSForestItemData *data = dynamic_cast<TSForestItemData*>( datablocks[i] );
+      if ( data && data->mCollidable )
+         data->getShapeInstance();
+   }
+
    Vector<ForestCell*> stack;
 
    BucketTable::Iterator iter = mBuckets.begin();
    for (; iter != mBuckets.end(); ++iter)
       stack.push_back( iter->value );
 
+   // Gather the leaf cells which need to build collision.
+   Vector<ForestCell*> cells;
+
    // Now loop till we run out of cells.
    while ( !stack.empty() )
    {
@@ -829,6 +983,40 @@ void ForestData::buildPhysicsRep( Forest *forest )
          continue;
       }
 
-      cell->buildPhysicsRep( forest );      
+      if ( !cell->needsPhysicsRep( forest ) )
+         continue;
+
+      // Cells that can share the server collision
+      // shape have nothing expensive to do.
+      if ( cell->canShareCollision() )
+         cell->buildPhysicsRep( forest );
+      else
+         cells.push_back( cell );
    }   
-}
\ No newline at end of file
+
+   if ( cells.empty() )
+      return;
+
+   // Gather the collision triangles of each cell in parallel.
+   Vector<ConcretePolyList> polyLists;
+   polyLists.setSize( cells.size() );
+
+   struct BuildPolys
+   {
+      Vector<ForestCell*> *cells;
+      Vector<ConcretePolyList> *polyLists;
+
+      void operator()( U32 i )
+      {
+         (*cells)[i]->buildCollisionPolys( &(*polyLists)[i] );
+      }
+   };
+
+   BuildPolys build = { &cells, &polyLists };
+   ThreadPool::GLOBAL().parallelFor( cells.size(), build );
+
+   // The physics plugins do not allow creating shapes and
+   // bodies from multiple threads, so finish up serially.
+   for ( U32 i=0; i < cells.size(); i++ )
+      cells[i]->buildPhysicsRep( forest, polyLists[i] );
+}
@@ -26,6 +26,9 @@
 #ifndef _FORESTITEM_H_
 #include "forest/forestItem.h"
 #endif
+#ifndef _MQUAT_H_
+#include "math/mQuat.h"
+#endif
 #ifndef _TDICTIONARY_H_
 #include "core/util/tDictionary.h"
 #endif
@@ -40,7 +43,22 @@ class ForestData
 {
    protected:
 
-      enum { FILE_VERSION = 1 };
+      /// Version 1 stored each item field by field.
+      /// Version 2 stores a packed FileItem array.
+      enum { FILE_VERSION = 2 };
+
+      /// The on disk layout of an item in version 2 files.
+      ///
+      /// Items are written sorted by bucket and then in quad tree
+      /// order within the bucket so that the whole array can be
+      /// loaded with a single read and inserted with good locality.
+      struct FileItem
+      {
+         Point3F position;
+         QuatF rotation;
+         F32 scale;
+         U32 dataIndex;
+      };
 
       /// Set the bucket dimensions to 2km x 2km.
       static const U32 BUCKET_DIM = 2000;
@@ -75,6 +93,16 @@ class ForestData
       ForestCell* _findOrCreateBucket( const Point3F &pos );
 
       void _onItemReload();
+
+      /// Swaps a FileItem between the host and file byte order.
+      static void _convertFileItem( FileItem *item );
+
+      /// Returns the key used to sort items in the file.
+      static U64 _getSortKey( const Point3F &pos );
+
+      /// Reads the items from a version 1 file returning
+      /// the count of items which were skipped.
+      U32 _readItemsV1( Stream &stream, const Vector<ForestItemData*> &allDatablocks );
       
 
    public:
@@ -82,6 +110,17 @@ class ForestData
       ForestData();
       virtual ~ForestData();
 
+      typedef Signal<void( const Box3F &worldBox )> ItemsChangedSignal;
+
+      /// Triggered with the world box of the area where items were
+      /// added, removed or moved in any forest, or with Box3F::Max
+      /// when every item may have changed.
+      static ItemsChangedSignal& getItemsChangedSignal()
+      {
+         static ItemsChangedSignal theSignal;
+         return theSignal;
+      }
+
       bool isDirty() const { return mIsDirty; }
 
       /// Deletes all the data and resets the 
@@ -94,9 +133,12 @@ class ForestData
       ///
       bool read( Stream &stream );
 
-      ///
+      /// Writes the forest to a new file at the path.
       bool write( const char *path );
 
+      /// Writes the forest to the stream.
+      bool write( Stream &stream );
+
       const ForestItem& addItem( ForestItemData *data,
                                  const Point3F &position,
                                  F32 rotation,
@@ -193,6 +235,11 @@ class ForestData
       ///
       bool castRay( const Point3F &start, const Point3F &end, RayInfo *outInfo, bool rendered ) const;
 
+      /// Casts the rays in packets thru the cells and returns the
+      /// number of rays which hit.
+      /// @see Forest::castRayBatch
+      U32 castRayBatch( const Point3F *starts, const Point3F *ends, U32 count, RayInfo *outInfos, bool *outHits, bool rendered ) const;
+
       ///
       void clearPhysicsRep( Forest *forest );
       void buildPhysicsRep( Forest *forest );
@@ -38,6 +38,7 @@
 #include "gfx/primBuilder.h"
 #include "gfx/gfxDrawUtil.h"
 #include "math/mathUtils.h"
+#include "platform/threads/threadPool.h"
 
 
 U32   Forest::smTotalCells = 0;
@@ -139,6 +140,11 @@ void Forest::prepRenderImage( SceneRenderState *state )
    Vector<ForestCell*> cellStack;
    mData->getCells( culler, &cellStack );
 
+   // The cells which are rendered as batches and if
+   // they were clipped by the frustum.
+   Vector<ForestCell*> batchCells;
+   Vector<bool> batchClipped;
+
    // Get the culling zone state.
    const BitVector &zoneState = state->getCullingState().getZoneVisibilityFlags();
 
@@ -201,24 +207,16 @@ void Forest::prepRenderImage( SceneRenderState *state )
          if( TSShapeInstance::smLastPixelSize < TSShapeInstance::smSmallestVisiblePixelSize )
             continue;
 
-         PROFILE_SCOPE(Forest_RenderBatches);
-
          // Keep track of how many cells were batched.
          ++smCellsBatched;
 
-         // Ok... everything in this cell should be batched.  First
-         // create the batches if we don't have any.
-         if ( !cell->hasBatches() )
-            cell->buildBatches();
-
          //if ( drawCells )
             //mCellRenderFlag[ cellIter - theCells.begin() ] = 1;
 
-         // TODO: Light queries for batches?
-
-         // Now render the batches... we pass the culler if the
-         // cell wasn't fully visible so that each batch can be culled.
-         smCellItemsBatched += cell->renderBatches( state, clipMask != 0 ? &culler : NULL );
+         // The batches are built and rendered together 
+         // once we know all the batched cells.
+         batchCells.push_back( cell );
+         batchClipped.push_back( clipMask != 0 );
          continue;
       }
 
@@ -247,6 +245,45 @@ void Forest::prepRenderImage( SceneRenderState *state )
       smCellItemsRendered += cell->render( &rdata, clipMask != 0 ? &culler : NULL );
    }
 
+   if ( !batchCells.empty() )
+   {
+      PROFILE_SCOPE(Forest_RenderBatches);
+
+      // Ok... everything in these cells should be batched.  First
+      // create the batches if we don't have any.  This stays on
+      // this thread as it can load the imposter for the item.
+      Vector<ForestCell*> dirtyCells;
+      for ( U32 i=0; i < batchCells.size(); i++ )
+      {
+         if ( !batchCells[i]->hasBatches() )
+            batchCells[i]->buildBatches();
+
+         if ( batchCells[i]->hasDirtyBatches() )
+            dirtyCells.push_back( batchCells[i] );
+      }
+
+      // Fill in the batch vertices of new cells in parallel.
+      struct BuildBatchData
+      {
+         Vector<ForestCell*> *cells;
+
+         void operator()( U32 i )
+         {
+            (*cells)[i]->buildBatchData();
+         }
+      };
+
+      BuildBatchData build = { &dirtyCells };
+      ThreadPool::GLOBAL().parallelFor( dirtyCells.size(), build );
+
+      // TODO: Light queries for batches?
+
+      // Now render the batches... we pass the culler if the
+      // cell wasn't fully visible so that each batch can be culled.
+      for ( U32 i=0; i < batchCells.size(); i++ )
+         smCellItemsBatched += batchCells[i]->renderBatches( state, batchClipped[i] ? &culler : NULL );
+   }
+
    // Keep track of the average items per cell.
    if ( cellsProcessed > 0 )
       smAverageItemsPerCell /= (F32)cellsProcessed;
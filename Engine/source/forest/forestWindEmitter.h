@@ -176,6 +176,9 @@ public:
 
    bool isEnabled() const { return mEnabled; }
 
+   /// Returns all the emitters on both the client and server.
+   static const ForestWindEmitterList& getEmitters() { return smEmitters; }
+
    ForestWind* getWind() { return mWind; }
 
    bool isLocalWind() const { return mWindRadius > 0.0f; }
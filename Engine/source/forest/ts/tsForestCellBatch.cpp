@@ -56,27 +56,10 @@ bool TSForestCellBatch::_prepBatch( const ForestItem &item )
    return true;
 }
 
-void TSForestCellBatch::_rebuildBatch()
+void TSForestCellBatch::_buildBatchData()
 {
-   // Clean up first.
-   mVB = NULL;
-   if ( mItems.empty() )
-      return;
-
-   // How big do we need to make this?
-   U32 verts = mItems.size() * 6;
-   mVB.set( GFX, verts, GFXBufferTypeStatic );
-   if ( !mVB.isValid() )
-   {
-      // If we failed it is probably because we requested
-      // a size bigger than a VB can be.  Warn the user.
-      AssertWarn( false, "TSForestCellBatch::_rebuildBatch: Batch too big... try reducing the forest cell size!" );
-      return;
-   }
-
-   // Fill this puppy!
-   ImposterState *vertPtr = mVB.lock();
-   if(!vertPtr) return;
+   mVertData.setSize( mItems.size() * 6 );
+   ImposterState *vertPtr = mVertData.address();
 
    Vector<ForestItem>::const_iterator item = mItems.begin();
 
@@ -115,8 +98,38 @@ void TSForestCellBatch::_rebuildBatch()
       vertPtr->corner = 0;
       ++vertPtr;
    }
+}
+
+void TSForestCellBatch::_rebuildBatch()
+{
+   // Clean up first.
+   mVB = NULL;
+   if ( mItems.empty() )
+      return;
+
+   // How big do we need to make this?
+   U32 verts = mItems.size() * 6;
+   AssertFatal( mVertData.size() == verts, "TSForestCellBatch::_rebuildBatch - The batch data was not built!" );
+   mVB.set( GFX, verts, GFXBufferTypeStatic );
+   if ( !mVB.isValid() )
+   {
+      // If we failed it is probably because we requested
+      // a size bigger than a VB can be.  Warn the user.
+      AssertWarn( false, "TSForestCellBatch::_rebuildBatch: Batch too big... try reducing the forest cell size!" );
+      return;
+   }
+
+   // Fill this puppy!
+   ImposterState *vertPtr = mVB.lock();
+   if(!vertPtr) return;
+
+   dMemcpy( vertPtr, mVertData.address(), verts * sizeof( ImposterState ) );
 
    mVB.unlock();
+
+   // The vertex buffer holds the only copy we need now.
+   mVertData.clear();
+   mVertData.compact();
 }
 
 void TSForestCellBatch::_render( const SceneRenderState *state )
@@ -49,10 +49,15 @@ protected:
    /// We use the same shader and vertex format as TSLastDetail.
    GFXVertexBufferHandle<ImposterState> mVB;
 
+   /// The imposter vertices built by _buildBatchData() and
+   /// waiting to be copied into the vertex buffer.
+   Vector<ImposterState> mVertData;
+
    TSLastDetail *mDetail;
 
    // ForestCellBatch
    bool _prepBatch( const ForestItem &item ) override;
+   void _buildBatchData() override;
    void _rebuildBatch() override;
    void _render( const SceneRenderState *state ) override;
 
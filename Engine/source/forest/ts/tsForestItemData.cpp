@@ -216,6 +216,12 @@ bool TSForestItemData::canBillboard( const SceneRenderState *state, const Forest
    if ( !mShape )
       return false;
 
+   // The cell batches draw the imposter atlas which isn't there
+   // until it is baked, so render the items as meshes till then.
+   TSLastDetail *lastDetail = getLastDetail();
+   if ( lastDetail && lastDetail->isBakePending() )
+      return false;
+
    // Use the shape instance to do the work it normally does.
    TSShapeInstance *shapeInstance = _getShapeInstance();
    const S32 dl = shapeInstance->setDetailFromDistance( state, distToCamera / item.getScale() );
@@ -267,6 +267,7 @@ void GFXD3D11ShaderConstBuffer::internalSet(GFXShaderConstHandle* handle, const
          case GFXSCT_Float4x3:
          case GFXSCT_Float4x4:
             setMatrix(constDesc, size, data, basePointer);
+            mBufferMap[bufDesc].dirty.add(constDesc.offset, size);
             return;
             break;
             // TODO add other AlignedVector here
@@ -281,6 +282,7 @@ void GFXD3D11ShaderConstBuffer::internalSet(GFXShaderConstHandle* handle, const
          if (dMemcmp(basePointer + constDesc.offset, data, size) != 0)
          {
             dMemcpy(basePointer + constDesc.offset, data, size);
+            mBufferMap[bufDesc].dirty.add(constDesc.offset, size);
          }
       }
    }
@@ -482,6 +484,8 @@ void GFXD3D11ShaderConstBuffer::addBuffer(const GFXShaderConstDesc desc)
    mBufferMap[bufKey].data = buf;
    mBufferMap[bufKey].size = desc.size;
    mBufferMap[bufKey].isDirty = true;
+   mBufferMap[bufKey].dirty.add(0, desc.size);
+   mBufferMap[bufKey].mirror = D3D11->getShaderConstMirror(desc);
 
    mBoundBuffers[(U32)shaderStageID][desc.bindPoint] = D3D11->getDeviceBuffer(desc);
 }
@@ -492,48 +496,27 @@ void GFXD3D11ShaderConstBuffer::activate( GFXD3D11ShaderConstBuffer *prevShaderB
 
    BufferRange bufRanges[6];
 
+   GFXDeviceStatistics* stats = D3D11->getDeviceStatistics();
+
    for (BufferMap::Iterator i = mBufferMap.begin(); i != mBufferMap.end(); ++i)
    {
       const BufferKey thisBufferDesc = i->key;
-      ConstantBuffer thisBuff = i->value;
+      ConstantBuffer& thisBuff = i->value;
 
-      if (prevShaderBuffer && prevShaderBuffer != this)
-      {
-         const ConstantBuffer prevBuffer = prevShaderBuffer->mBufferMap[i->key];
+      if (!thisBuff.data)
+         continue;
 
-         if (prevBuffer.data && !prevBuffer.isDirty)
-         {
-            if (prevBuffer.size != thisBuff.size)
-            {
-               thisBuff.isDirty = true;
-            }
-            else
-            {
-               if (dMemcmp(prevBuffer.data, thisBuff.data, thisBuff.size) != 0)
-               {
-                  thisBuff.isDirty = true;
-               }
-               else
-               {
-                  thisBuff.isDirty = false;
-               }
-            }
-         }
-         else
-         {
-            thisBuff.isDirty = true;
-         }
-      }
-      else
-      {
-         thisBuff.isDirty = true;
-      }
-
-      if (thisBuff.data && thisBuff.isDirty)
+      // The device buffer is shared with every other shader using
+      // it, so the mirror works out if it already has our content.
+      // Constant buffers can only be updated whole on D3D11.0.
+      U32 uploadStart, uploadEnd;
+      if (thisBuff.mirror->update(thisBuff.data, thisBuff.data, thisBuff.size, thisBuff.dirty, &uploadStart, &uploadEnd))
       {
          D3D11DEVICECONTEXT->UpdateSubresource(mBoundBuffers[thisBufferDesc.key2][thisBufferDesc.key1], 0, NULL, thisBuff.data, thisBuff.size, 0);
-         bufRanges[thisBufferDesc.key2].addSlot(thisBufferDesc.key1);
+         stats->mShaderConstBytes += thisBuff.size;
       }
+
+      bufRanges[thisBufferDesc.key2].addSlot(thisBufferDesc.key1);
    }
 
    if (mShader->mVertShader && bufRanges[0].isValid())
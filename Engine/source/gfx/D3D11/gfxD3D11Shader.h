@@ -28,6 +28,7 @@
 #include "core/util/path.h"
 #include "core/util/tDictionary.h"
 #include "gfx/gfxShader.h"
+#include "gfx/gfxShaderConstMirror.h"
 #include "gfx/gfxResource.h"
 #include "gfx/D3D11/gfxD3D11Device.h"
 
@@ -54,6 +55,12 @@ struct ConstantBuffer
    U8* data;
    U32 size;
    bool isDirty;
+
+   /// The range written since the last upload.
+   GFXShaderConstDirtyRange dirty;
+
+   /// The mirror of the shared device buffer.
+   GFXShaderConstMirror* mirror;
 };
 
 class GFXD3D11ShaderConstHandle : public GFXShaderConstHandle
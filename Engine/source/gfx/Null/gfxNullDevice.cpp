@@ -300,12 +300,14 @@ GFXDevice *GFXNullDevice::createInstance( U32 adapterIndex )
    return new GFXNullDevice();
 }
 
-GFXNullDevice::GFXNullDevice()
+GFXNullDevice::GFXNullDevice( bool global )
+   : GFXDevice( global )
 {
    clip.set(0, 0, 800, 800);
 
    mTextureManager = new GFXNullTextureManager();
-   gScreenShot = new ScreenShot();
+   if ( global )
+      gScreenShot = new ScreenShot();
    mCardProfiler = new GFXNullCardProfiler();
    mCardProfiler->init();
 }
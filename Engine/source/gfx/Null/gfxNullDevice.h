@@ -60,7 +60,7 @@ public:
 class GFXNullDevice : public GFXDevice
 {
 public:
-   GFXNullDevice();
+   GFXNullDevice( bool global = true );
    virtual ~GFXNullDevice();
 
    static GFXDevice *createInstance( U32 adapterIndex );
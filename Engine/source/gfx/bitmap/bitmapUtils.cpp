@@ -23,6 +23,7 @@
 #include "gfx/bitmap/bitmapUtils.h"
 
 #include "platform/platform.h"
+#include "math/mMathFn.h"
 
 
 void bitmapExtrude5551_c(const void *srcMip, void *mip, U32 srcHeight, U32 srcWidth)
@@ -119,7 +120,7 @@ void bitmapExtrudeRGB_c(const void *srcMip, void *mip, U32 srcHeight, U32 srcWid
          *dst++ = (U32(*src) + U32(src[stride]) + 1) >> 1;
          src++;
          *dst++ = (U32(*src) + U32(src[stride]) + 1) >> 1;
-         src += 4;
+         src++;
 
          src += stride;   // skip
       }
@@ -167,7 +168,7 @@ void bitmapExtrudeRGBA_c(const void *srcMip, void *mip, U32 srcHeight, U32 srcWi
          *dst++ = (U32(*src) + U32(src[stride]) + 1) >> 1;
          src++;
          *dst++ = (U32(*src) + U32(src[stride]) + 1) >> 1;
-         src += 5;
+         src++;
 
          src += stride;   // skip
       }
@@ -178,7 +179,7 @@ void bitmapExtrudeFPRGBA_c(const void *srcMip, void *mip, U32 srcHeight, U32 src
 {
    const U16 *src = (const U16 *)srcMip;
    U16 *dst = (U16 *)mip;
-   U32 stride = srcHeight != 1 ? (srcWidth) * 8 : 0;
+   U32 stride = srcHeight != 1 ? (srcWidth) * 4 : 0;
 
    U32 width = srcWidth >> 1;
    U32 height = srcHeight >> 1;
@@ -214,17 +215,98 @@ void bitmapExtrudeFPRGBA_c(const void *srcMip, void *mip, U32 srcHeight, U32 src
          *dst++ = (U32(*src) + U32(src[stride]) + 1) >> 1;
          src++;
          *dst++ = (U32(*src) + U32(src[stride]) + 1) >> 1;
-         src += 5;
+         src++;
 
          src += stride;   // skip
       }
    }
 }
 
+//--------------------------------------------------------------------------
+
+/// Tables for going between 8 bit sRGB and 16 bit linear values.
+struct SRGBTables
+{
+   U16 toLinear[256];
+   U8 toSRGB[65536];
+
+   SRGBTables()
+   {
+      for ( U32 i = 0; i < 256; i++ )
+      {
+         const F32 c = i / 255.0f;
+         const F32 linear = c <= 0.04045f ? c / 12.92f : mPow( ( c + 0.055f ) / 1.055f, 2.4f );
+         toLinear[i] = (U16)mRound( linear * 65535.0f );
+      }
+
+      for ( U32 i = 0; i < 65536; i++ )
+      {
+         const F32 linear = i / 65535.0f;
+         const F32 c = linear <= 0.0031308f ? linear * 12.92f : 1.055f * mPow( linear, 1.0f / 2.4f ) - 0.055f;
+         toSRGB[i] = (U8)mClamp( (S32)mRound( c * 255.0f ), 0, 255 );
+      }
+   }
+};
+
+static const SRGBTables& getSRGBTables()
+{
+   static SRGBTables sTables;
+   return sTables;
+}
+
+static void _extrudeSRGB(const void *srcMip, void *mip, U32 srcHeight, U32 srcWidth, U32 bytesPerPixel)
+{
+   const SRGBTables &tables = getSRGBTables();
+   const U8 *src = (const U8 *) srcMip;
+   U8 *dst = (U8 *) mip;
+
+   U32 width  = srcWidth  >> 1;
+   U32 height = srcHeight >> 1;
+   if (width  == 0) width  = 1;
+   if (height == 0) height = 1;
+
+   // Thin mips just sample the same row or column twice.
+   const U32 xStep = srcWidth != 1 ? bytesPerPixel : 0;
+   const U32 yStep = srcHeight != 1 ? srcWidth * bytesPerPixel : 0;
+
+   for (U32 y = 0; y < height; y++)
+   {
+      const U8 *row = src + y * 2 * srcWidth * bytesPerPixel;
+
+      for (U32 x = 0; x < width; x++)
+      {
+         const U8 *p = row + x * 2 * bytesPerPixel;
+
+         for (U32 c = 0; c < 3; c++)
+         {
+            const U32 sum =   tables.toLinear[p[c]] + tables.toLinear[p[c + xStep]] +
+                              tables.toLinear[p[c + yStep]] + tables.toLinear[p[c + xStep + yStep]];
+            *dst++ = tables.toSRGB[(sum + 2) >> 2];
+         }
+
+         // Alpha is always linear.
+         if (bytesPerPixel == 4)
+            *dst++ = (U32(p[3]) + U32(p[3 + xStep]) + U32(p[3 + yStep]) + U32(p[3 + xStep + yStep]) + 2) >> 2;
+      }
+   }
+}
+
+void bitmapExtrudeSRGB_c(const void *srcMip, void *mip, U32 srcHeight, U32 srcWidth)
+{
+   _extrudeSRGB(srcMip, mip, srcHeight, srcWidth, 3);
+}
+
+void bitmapExtrudeSRGBA_c(const void *srcMip, void *mip, U32 srcHeight, U32 srcWidth)
+{
+   _extrudeSRGB(srcMip, mip, srcHeight, srcWidth, 4);
+}
+
 void (*bitmapExtrude5551)(const void *srcMip, void *mip, U32 height, U32 width) = bitmapExtrude5551_c;
 void (*bitmapExtrudeRGB)(const void *srcMip, void *mip, U32 srcHeight, U32 srcWidth) = bitmapExtrudeRGB_c;
 void (*bitmapExtrudeRGBA)(const void *srcMip, void *mip, U32 srcHeight, U32 srcWidth) = bitmapExtrudeRGBA_c;
 void (*bitmapExtrudeFPRGBA)(const void *srcMip, void *mip, U32 srcHeight, U32 srcWidth) = bitmapExtrudeFPRGBA_c;
+void (*bitmapExtrudeSRGB)(const void *srcMip, void *mip, U32 srcHeight, U32 srcWidth) = bitmapExtrudeSRGB_c;
+void (*bitmapExtrudeSRGBA)(const void *srcMip, void *mip, U32 srcHeight, U32 srcWidth) = bitmapExtrudeSRGBA_c;
 
 
 //--------------------------------------------------------------------------
@@ -330,3 +412,13 @@ void bitmapConvertA8_to_RGBA_c( U8 **src, U32 pixels )
 }
 
 void (*bitmapConvertA8_to_RGBA)( U8 **src, U32 pixels ) = bitmapConvertA8_to_RGBA_c;
+
+//------------------------------------------------------------------------------
+
+void bitmapInstallLibrary( U32 properties )
+{
+#ifdef TORQUE_BITMAP_SSE2
+   if ( properties & CPU_PROP_SSE2 )
+      bitmapInstallLibrary_SSE2();
+#endif
+}
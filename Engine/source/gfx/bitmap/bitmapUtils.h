@@ -37,6 +37,37 @@ extern void (*bitmapConvertRGB_to_RGBX)( U8 **src, U32 pixels );
 extern void (*bitmapConvertRGBX_to_RGB)( U8 **src, U32 pixels );
 extern void (*bitmapConvertA8_to_RGBA)( U8 **src, U32 pixels );
 
+/// Gamma correct versions which average the texels in linear space.
+extern void (*bitmapExtrudeSRGB)(const void *srcMip, void *mip, U32 height, U32 width);
+extern void (*bitmapExtrudeSRGBA)(const void *srcMip, void *mip, U32 height, U32 width);
+
+/// Replaces the C bitmap functions above with the fastest
+/// versions the processor properties allow.
+///
+/// @see ProcessorProperties
+void bitmapInstallLibrary( U32 properties );
+
 void bitmapExtrudeRGB_c(const void *srcMip, void *mip, U32 height, U32 width);
+void bitmapExtrudeRGBA_c(const void *srcMip, void *mip, U32 height, U32 width);
+void bitmapExtrudeFPRGBA_c(const void *srcMip, void *mip, U32 height, U32 width);
+void bitmapConvertRGB_to_RGBX_c( U8 **src, U32 pixels );
+void bitmapConvertRGBX_to_RGB_c( U8 **src, U32 pixels );
+void bitmapConvertA8_to_RGBA_c( U8 **src, U32 pixels );
+
+#if defined( TORQUE_CPU_X64 ) || defined( __SSE2__ ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+
+   /// Defined when the SSE2 bitmap functions are compiled in.
+   #define TORQUE_BITMAP_SSE2
+
+   void bitmapExtrudeRGB_sse2(const void *srcMip, void *mip, U32 height, U32 width);
+   void bitmapExtrudeRGBA_sse2(const void *srcMip, void *mip, U32 height, U32 width);
+   void bitmapExtrudeFPRGBA_sse2(const void *srcMip, void *mip, U32 height, U32 width);
+   void bitmapConvertRGB_to_RGBX_sse2( U8 **src, U32 pixels );
+   void bitmapConvertRGBX_to_RGB_sse2( U8 **src, U32 pixels );
+   void bitmapConvertA8_to_RGBA_sse2( U8 **src, U32 pixels );
+
+   void bitmapInstallLibrary_SSE2();
+
+#endif
 
 #endif //_BITMAPUTILS_H_
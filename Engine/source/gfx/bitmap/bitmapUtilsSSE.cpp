@@ -0,0 +1,319 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026 tgemit contributors.
+// See AUTHORS file and git repository for contributor information.
+//
+// SPDX-License-Identifier: MIT
+//-----------------------------------------------------------------------------
+
+#include "gfx/bitmap/bitmapUtils.h"
+
+#include "platform/platform.h"
+
+#ifdef TORQUE_BITMAP_SSE2
+
+#include <emmintrin.h>
+
+// These all give the exact same results as the C versions.  The
+// small mips and the leftover pixels at the end of a row just
+// fall back to C since there is nothing to gain there.
+
+/// Averages the 2x2 blocks of the 4 RGBA pixels in each row
+/// and returns the 2 resulting pixels as 16 bit channels.
+static inline __m128i _averageRGBA( __m128i row0, __m128i row1 )
+{
+   const __m128i zero = _mm_setzero_si128();
+
+   // Sum the rows at 16 bits so we don't lose anything.
+   const __m128i p01 = _mm_add_epi16( _mm_unpacklo_epi8( row0, zero ), _mm_unpacklo_epi8( row1, zero ) );
+   const __m128i p23 = _mm_add_epi16( _mm_unpackhi_epi8( row0, zero ), _mm_unpackhi_epi8( row1, zero ) );
+
+   // Then add the neighbouring pixels and round.
+   const __m128i sum = _mm_add_epi16( _mm_unpacklo_epi64( p01, p23 ), _mm_unpackhi_epi64( p01, p23 ) );
+   return _mm_srli_epi16( _mm_add_epi16( sum, _mm_set1_epi16( 2 ) ), 2 );
+}
+
+/// Averages the 2x2 blocks of the 4 RGB pixels in bytes 0-11 of
+/// each row and returns the 2 resulting pixels as 16 bit channels
+/// in lanes 0-5.
+static inline __m128i _averageRGB( __m128i row0, __m128i row1 )
+{
+   const __m128i zero = _mm_setzero_si128();
+   const __m128i mask = _mm_setr_epi16( -1, -1, -1, 0, 0, 0, 0, 0 );
+
+   // Pixels 0 and 1 are in bytes 0-5 and pixels 2 and 3 in bytes 6-11.
+   const __m128i p01 = _mm_add_epi16( _mm_unpacklo_epi8( row0, zero ), _mm_unpacklo_epi8( row1, zero ) );
+   const __m128i p23 = _mm_add_epi16(  _mm_unpacklo_epi8( _mm_srli_si128( row0, 6 ), zero ),
+                                       _mm_unpacklo_epi8( _mm_srli_si128( row1, 6 ), zero ) );
+
+   const __m128i sum01 = _mm_and_si128( _mm_add_epi16( p01, _mm_srli_si128( p01, 6 ) ), mask );
+   const __m128i sum23 = _mm_and_si128( _mm_add_epi16( p23, _mm_srli_si128( p23, 6 ) ), mask );
+
+   const __m128i sum = _mm_or_si128( sum01, _mm_slli_si128( sum23, 6 ) );
+   return _mm_srli_epi16( _mm_add_epi16( sum, _mm_set1_epi16( 2 ) ), 2 );
+}
+
+/// Averages the 2x2 blocks of the 2 half float RGBA pixels in
+/// each row and returns the resulting pixel as 32 bit channels.
+static inline __m128i _averageFPRGBA( __m128i row0, __m128i row1 )
+{
+   const __m128i zero = _mm_setzero_si128();
+
+   const __m128i sum = _mm_add_epi32(  _mm_add_epi32( _mm_unpacklo_epi16( row0, zero ), _mm_unpackhi_epi16( row0, zero ) ),
+                                       _mm_add_epi32( _mm_unpacklo_epi16( row1, zero ), _mm_unpackhi_epi16( row1, zero ) ) );
+
+   return _mm_srli_epi32( _mm_add_epi32( sum, _mm_set1_epi32( 2 ) ), 2 );
+}
+
+//--------------------------------------------------------------------------
+void bitmapExtrudeRGB_sse2(const void *srcMip, void *mip, U32 srcHeight, U32 srcWidth)
+{
+   if ( srcWidth < 16 || srcHeight < 2 )
+   {
+      bitmapExtrudeRGB_c( srcMip, mip, srcHeight, srcWidth );
+      return;
+   }
+
+   const U32 width = srcWidth >> 1;
+   const U32 height = srcHeight >> 1;
+   const U32 stride = srcWidth * 3;
+
+   for ( U32 y = 0; y < height; y++ )
+   {
+      const U8 *row0 = (const U8 *)srcMip + y * 2 * stride;
+      const U8 *row1 = row0 + stride;
+      U8 *dst = (U8 *)mip + y * width * 3;
+
+      // We load 16 bytes for every 12 we use so stop
+      // before we would read past the end of the row.
+      U32 x = 0;
+      for ( ; x + 4 < width; x += 4 )
+      {
+         const U8 *s0 = row0 + x * 6;
+         const U8 *s1 = row1 + x * 6;
+
+         const __m128i a = _averageRGB( _mm_loadu_si128( (const __m128i *)s0 ), _mm_loadu_si128( (const __m128i *)s1 ) );
+         const __m128i b = _averageRGB( _mm_loadu_si128( (const __m128i *)( s0 + 12 ) ), _mm_loadu_si128( (const __m128i *)( s1 + 12 ) ) );
+
+         // Line the 12 channels up and write them out.
+         const __m128i packed = _mm_packus_epi16( _mm_or_si128( a, _mm_slli_si128( b, 12 ) ), _mm_srli_si128( b, 4 ) );
+         _mm_storel_epi64( (__m128i *)( dst + x * 3 ), packed );
+
+         const S32 last = _mm_cvtsi128_si32( _mm_srli_si128( packed, 8 ) );
+         dMemcpy( dst + x * 3 + 8, &last, 4 );
+      }
+
+      for ( ; x < width; x++ )
+      {
+         const U8 *s0 = row0 + x * 6;
+         const U8 *s1 = row1 + x * 6;
+         for ( U32 c = 0; c < 3; c++ )
+            dst[x * 3 + c] = ( U32( s0[c] ) + U32( s0[c + 3] ) + U32( s1[c] ) + U32( s1[c + 3] ) + 2 ) >> 2;
+      }
+   }
+}
+
+//--------------------------------------------------------------------------
+void bitmapExtrudeRGBA_sse2(const void *srcMip, void *mip, U32 srcHeight, U32 srcWidth)
+{
+   if ( srcWidth < 8 || srcHeight < 2 )
+   {
+      bitmapExtrudeRGBA_c( srcMip, mip, srcHeight, srcWidth );
+      return;
+   }
+
+   const U32 width = srcWidth >> 1;
+   const U32 height = srcHeight >> 1;
+   const U32 stride = srcWidth * 4;
+
+   for ( U32 y = 0; y < height; y++ )
+   {
+      const U8 *row0 = (const U8 *)srcMip + y * 2 * stride;
+      const U8 *row1 = row0 + stride;
+      U8 *dst = (U8 *)mip + y * width * 4;
+
+      U32 x = 0;
+      for ( ; x + 4 <= width; x += 4 )
+      {
+         const __m128i *s0 = (const __m128i *)( row0 + x * 8 );
+         const __m128i *s1 = (const __m128i *)( row1 + x * 8 );
+
+         const __m128i a = _averageRGBA( _mm_loadu_si128( s0 ), _mm_loadu_si128( s1 ) );
+         const __m128i b = _averageRGBA( _mm_loadu_si128( s0 + 1 ), _mm_loadu_si128( s1 + 1 ) );
+
+         _mm_storeu_si128( (__m128i *)( dst + x * 4 ), _mm_packus_epi16( a, b ) );
+      }
+
+      for ( ; x < width; x++ )
+      {
+         const U8 *s0 = row0 + x * 8;
+         const U8 *s1 = row1 + x * 8;
+         for ( U32 c = 0; c < 4; c++ )
+            dst[x * 4 + c] = ( U32( s0[c] ) + U32( s0[c + 4] ) + U32( s1[c] ) + U32( s1[c + 4] ) + 2 ) >> 2;
+      }
+   }
+}
+
+//--------------------------------------------------------------------------
+void bitmapExtrudeFPRGBA_sse2(const void *srcMip, void *mip, U32 srcHeight, U32 srcWidth)
+{
+   if ( srcWidth < 4 || srcHeight < 2 )
+   {
+      bitmapExtrudeFPRGBA_c( srcMip, mip, srcHeight, srcWidth );
+      return;
+   }
+
+   const U32 width = srcWidth >> 1;
+   const U32 height = srcHeight >> 1;
+   const U32 stride = srcWidth * 4;
+
+   // There is no unsigned 32 to 16 bit pack in SSE2 so we
+   // bias the values into the signed range and back.
+   const __m128i bias32 = _mm_set1_epi32( 0x8000 );
+   const __m128i bias16 = _mm_set1_epi16( (S16)0x8000 );
+
+   for ( U32 y = 0; y < height; y++ )
+   {
+      const U16 *row0 = (const U16 *)srcMip + y * 2 * stride;
+      const U16 *row1 = row0 + stride;
+      U16 *dst = (U16 *)mip + y * width * 4;
+
+      U32 x = 0;
+      for ( ; x + 2 <= width; x += 2 )
+      {
+         const __m128i *s0 = (const __m128i *)( row0 + x * 8 );
+         const __m128i *s1 = (const __m128i *)( row1 + x * 8 );
+
+         const __m128i a = _mm_sub_epi32( _averageFPRGBA( _mm_loadu_si128( s0 ), _mm_loadu_si128( s1 ) ), bias32 );
+         const __m128i b = _mm_sub_epi32( _averageFPRGBA( _mm_loadu_si128( s0 + 1 ), _mm_loadu_si128( s1 + 1 ) ), bias32 );
+
+         _mm_storeu_si128( (__m128i *)( dst + x * 4 ), _mm_xor_si128( _mm_packs_epi32( a, b ), bias16 ) );
+      }
+
+      for ( ; x < width; x++ )
+      {
+         const U16 *s0 = row0 + x * 8;
+         const U16 *s1 = row1 + x * 8;
+         for ( U32 c = 0; c < 4; c++ )
+            dst[x * 4 + c] = ( U32( s0[c] ) + U32( s0[c + 4] ) + U32( s1[c] ) + U32( s1[c + 4] ) + 2 ) >> 2;
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+
+void bitmapConvertRGB_to_RGBX_sse2( U8 **src, U32 pixels )
+{
+   const U8 *oldBits = *src;
+   U8 *newBits = new U8[pixels * 4];
+
+   const __m128i rgbMask = _mm_set1_epi32( 0x00FFFFFF );
+   const __m128i alpha = _mm_set1_epi32( 0xFF000000 );
+
+   // We load 16 bytes for every 12 we use so stop
+   // before we would read past the end of the bits.
+   U32 i = 0;
+   for ( ; i + 6 <= pixels; i += 4 )
+   {
+      const __m128i rgb = _mm_loadu_si128( (const __m128i *)( oldBits + i * 3 ) );
+
+      // Move each pixel to the bottom of its own 32 bit lane.
+      const __m128i p01 = _mm_unpacklo_epi32( rgb, _mm_srli_si128( rgb, 3 ) );
+      const __m128i p23 = _mm_unpacklo_epi32( _mm_srli_si128( rgb, 6 ), _mm_srli_si128( rgb, 9 ) );
+      const __m128i rgbx = _mm_or_si128( _mm_and_si128( _mm_unpacklo_epi64( p01, p23 ), rgbMask ), alpha );
+
+      _mm_storeu_si128( (__m128i *)( newBits + i * 4 ), rgbx );
+   }
+
+   for ( ; i < pixels; i++ )
+   {
+      dMemcpy( &newBits[i * 4], &oldBits[i * 3], sizeof(U8) * 3 );
+      newBits[i * 4 + 3] = 0xFF;
+   }
+
+   // Now hose the old bits
+   delete [] *src;
+   *src = newBits;
+}
+
+void bitmapConvertRGBX_to_RGB_sse2( U8 **src, U32 pixels )
+{
+   const U8 *oldBits = *src;
+   U8 *newBits = new U8[pixels * 3];
+
+   const __m128i mask0 = _mm_setr_epi32( 0x00FFFFFF, 0, 0, 0 );
+   const __m128i mask1 = _mm_setr_epi32( 0, 0x00FFFFFF, 0, 0 );
+   const __m128i mask2 = _mm_setr_epi32( 0, 0, 0x00FFFFFF, 0 );
+   const __m128i mask3 = _mm_setr_epi32( 0, 0, 0, 0x00FFFFFF );
+
+   U32 i = 0;
+   for ( ; i + 4 <= pixels; i += 4 )
+   {
+      const __m128i rgbx = _mm_loadu_si128( (const __m128i *)( oldBits + i * 4 ) );
+
+      // Slide each pixel down over the X of the one before.
+      const __m128i rgb = _mm_or_si128(   _mm_or_si128( _mm_and_si128( rgbx, mask0 ), _mm_srli_si128( _mm_and_si128( rgbx, mask1 ), 1 ) ),
+                                          _mm_or_si128( _mm_srli_si128( _mm_and_si128( rgbx, mask2 ), 2 ), _mm_srli_si128( _mm_and_si128( rgbx, mask3 ), 3 ) ) );
+
+      U8 *dst = newBits + i * 3;
+      _mm_storel_epi64( (__m128i *)dst, rgb );
+
+      const S32 last = _mm_cvtsi128_si32( _mm_srli_si128( rgb, 8 ) );
+      dMemcpy( dst + 8, &last, 4 );
+   }
+
+   for ( ; i < pixels; i++ )
+      dMemcpy( &newBits[i * 3], &oldBits[i * 4], sizeof(U8) * 3 );
+
+   // Now hose the old bits
+   delete [] *src;
+   *src = newBits;
+}
+
+void bitmapConvertA8_to_RGBA_sse2( U8 **src, U32 pixels )
+{
+   const U8 *oldBits = *src;
+   U8 *newBits = new U8[pixels * 4];
+
+   const __m128i zero = _mm_setzero_si128();
+
+   U32 i = 0;
+   for ( ; i + 16 <= pixels; i += 16 )
+   {
+      const __m128i a = _mm_loadu_si128( (const __m128i *)( oldBits + i ) );
+
+      // Interleave zeros in front of each alpha twice
+      // to move it to the top byte of a 32 bit pixel.
+      const __m128i lo = _mm_unpacklo_epi8( zero, a );
+      const __m128i hi = _mm_unpackhi_epi8( zero, a );
+
+      __m128i *dst = (__m128i *)( newBits + i * 4 );
+      _mm_storeu_si128( dst + 0, _mm_unpacklo_epi16( zero, lo ) );
+      _mm_storeu_si128( dst + 1, _mm_unpackhi_epi16( zero, lo ) );
+      _mm_storeu_si128( dst + 2, _mm_unpacklo_epi16( zero, hi ) );
+      _mm_storeu_si128( dst + 3, _mm_unpackhi_epi16( zero, hi ) );
+   }
+
+   for ( ; i < pixels; i++ )
+   {
+      dMemset( &newBits[i * 4], 0, 3 );
+      newBits[i * 4 + 3] = oldBits[i];
+   }
+
+   // Now hose the old bits
+   delete [] *src;
+   *src = newBits;
+}
+
+//------------------------------------------------------------------------------
+
+void bitmapInstallLibrary_SSE2()
+{
+   bitmapExtrudeRGB = bitmapExtrudeRGB_sse2;
+   bitmapExtrudeRGBA = bitmapExtrudeRGBA_sse2;
+   bitmapExtrudeFPRGBA = bitmapExtrudeFPRGBA_sse2;
+   bitmapConvertRGB_to_RGBX = bitmapConvertRGB_to_RGBX_sse2;
+   bitmapConvertRGBX_to_RGB = bitmapConvertRGBX_to_RGB_sse2;
+   bitmapConvertA8_to_RGBA = bitmapConvertA8_to_RGBA_sse2;
+}
+
+#endif // TORQUE_BITMAP_SSE2
@@ -462,6 +462,20 @@ void GBitmap::extrudeMipLevels(bool clearBorders)
             bitmapExtrudeFPRGBA(getBits(i - 1), getWritableBits(i), getHeight(i - 1), getWidth(i - 1));
          break;
       }
+
+      case GFXFormatR8G8B8_SRGB:
+      {
+         for (U32 i = 1; i < mNumMipLevels; i++)
+            bitmapExtrudeSRGB(getBits(i - 1), getWritableBits(i), getHeight(i - 1), getWidth(i - 1));
+         break;
+      }
+
+      case GFXFormatR8G8B8A8_SRGB:
+      {
+         for (U32 i = 1; i < mNumMipLevels; i++)
+            bitmapExtrudeSRGBA(getBits(i - 1), getWritableBits(i), getHeight(i - 1), getWidth(i - 1));
+         break;
+      }
       
       default:
          break;
@@ -64,26 +64,52 @@ namespace ImageUtil
       }
    }
 
-   //Thread work job for compression
-   struct CompressJob : public ThreadPool::WorkItem
+   /// A band of block rows from one mip to compress.
+   struct CompressBand
    {
-      S32 width;
-      S32 height;
       const U8 *pSrc;
       U8 *pDst;
+      S32 width;
+      S32 height;
+   };
+
+   /// Compresses the bands on the thread pool.
+   struct CompressBands
+   {
+      const Vector<CompressBand> *bands;
       GFXFormat format;
       CompressQuality quality;
 
-      CompressJob(const U8 *srcRGBA, U8 *dst, const S32 w, const S32 h, const GFXFormat compressFormat, const CompressQuality compressQuality)
-         : pSrc(srcRGBA),pDst(dst), width(w), height(h), format(compressFormat),quality(compressQuality) {}
-
-   protected:
-      void execute() override
+      void operator()( U32 i )
       {
-         rawCompress(pSrc,pDst, width, height, format,quality);
+         const CompressBand &band = (*bands)[i];
+         rawCompress( band.pSrc, band.pDst, band.width, band.height, format, quality );
       }
    };
 
+   /// The height in pixels of the bands which a mip is split
+   /// into so that the big top mips spread over all the cores.
+   static const U32 sCompressBandHeight = 64;
+
+   /// Splits a mip into bands of block rows.  The blocks are
+   /// stored row by row so each band is a run of the output.
+   static void _addCompressBands( const DDSFile *dds, U32 mip, const U8 *src, U8 *dst, Vector<CompressBand> *outBands )
+   {
+      const U32 width = dds->getWidth( mip );
+      const U32 height = dds->getHeight( mip );
+      const U32 srcPitch = width * 4;
+      const U32 dstPitch = dds->getSurfaceSize( 4, width, 0 );
+
+      for ( U32 y = 0; y < height; y += sCompressBandHeight )
+      {
+         outBands->increment();
+         CompressBand &band = outBands->last();
+         band.pSrc = src + y * srcPitch;
+         band.pDst = dst + ( y / 4 ) * dstPitch;
+         band.width = width;
+         band.height = getMin( sCompressBandHeight, height - y );
+      }
+   }
 
    // compress raw pixel data, expects rgba format
    bool rawCompress(const U8 *srcRGBA, U8 *dst, const S32 width, const S32 height, const GFXFormat compressFormat, const CompressQuality compressQuality)
@@ -123,82 +149,37 @@ namespace ImageUtil
       srcDDS->mFormat = compressFormat;
       srcDDS->mFlags.set(DDSFile::CompressedData);
 
-      //grab global thread pool
-      ThreadPool* pThreadPool = &ThreadPool::GLOBAL();
+      // Allocate all the compressed mips and split them into bands
+      // which are compressed in one go on the thread pool.
+      const U32 numSurfaces = cubemap ? DDSFile::Cubemap_Surface_Count : 1;
+      Vector<U8*> dstMips;
+      dstMips.setSize( numSurfaces * mipCount );
+      Vector<CompressBand> bands;
 
-      if (cubemap)
+      for ( U32 surface = 0; surface < numSurfaces; surface++ )
       {
-         static U32 nCubeFaces = 6;
-         Vector<U8*> dstDataStore;
-         dstDataStore.setSize(nCubeFaces * mipCount);
-
-         for (S32 cubeFace = 0; cubeFace < nCubeFaces; cubeFace++)
+         // A flat texture only has its last surface.
+         DDSFile::SurfaceData *pSrcSurface = cubemap ? srcDDS->mSurfaces[surface] : srcDDS->mSurfaces.last();
+         for ( U32 currentMip = 0; currentMip < mipCount; currentMip++ )
          {
-            DDSFile::SurfaceData *srcSurface = srcDDS->mSurfaces[cubeFace];
-            for (U32 currentMip = 0; currentMip < mipCount; currentMip++)
-            {
-               const U32 dataIndex = cubeFace * mipCount + currentMip;
-               const U8 *srcBits = srcSurface->mMips[currentMip];
-               const U32 mipSz = srcDDS->getSurfaceSize(currentMip);
-               U8 *dstBits = new U8[mipSz];
-               dstDataStore[dataIndex] = dstBits;
-
-               ThreadSafeRef<CompressJob> item(new CompressJob(srcBits, dstBits, srcDDS->getWidth(currentMip), srcDDS->getHeight(currentMip), compressFormat, compressQuality));
-               pThreadPool->queueWorkItem(item);
-
-            }
+            U8 *pDstBits = new U8[ srcDDS->getSurfaceSize( currentMip ) ];
+            dstMips[ surface * mipCount + currentMip ] = pDstBits;
+            _addCompressBands( srcDDS, currentMip, pSrcSurface->mMips[currentMip], pDstBits, &bands );
          }
+      }
 
-         //wait for work items to finish
-         pThreadPool->waitForAllItems();
+      CompressBands compress = { &bands, compressFormat, compressQuality };
+      ThreadPool::GLOBAL().parallelFor( bands.size(), compress );
 
-         for (S32 cubeFace = 0; cubeFace < nCubeFaces; cubeFace++)
-         {
-            DDSFile::SurfaceData *pSrcSurface = srcDDS->mSurfaces[cubeFace];
-            for (U32 currentMip = 0; currentMip < mipCount; currentMip++)
-            {
-               const U32 dataIndex = cubeFace * mipCount + currentMip;
-               delete[] pSrcSurface->mMips[currentMip];
-               pSrcSurface->mMips[currentMip] = dstDataStore[dataIndex];
-            }
-         }
-      }
-      else
+      // Swap the compressed mips in.
+      for ( U32 surface = 0; surface < numSurfaces; surface++ )
       {
-         // The source surface is the original surface of the file
-         DDSFile::SurfaceData *pSrcSurface = srcDDS->mSurfaces.last();
-
-         // Create a new surface, this will be the DXT compressed surface. Once we
-         // are done, we can discard the old surface, and replace it with this one.
-         DDSFile::SurfaceData *pNewSurface = new DDSFile::SurfaceData();
-         //no point using threading if only 1 mip
-         const bool useThreading = bool(mipCount > 1);
-         for (U32 currentMip = 0; currentMip < mipCount; currentMip++)
+         DDSFile::SurfaceData *pSurface = cubemap ? srcDDS->mSurfaces[surface] : srcDDS->mSurfaces.last();
+         for ( U32 currentMip = 0; currentMip < mipCount; currentMip++ )
          {
-            const U8 *pSrcBits = pSrcSurface->mMips[currentMip];
-
-            const U32 mipSz = srcDDS->getSurfaceSize(currentMip);
-            U8 *pDstBits = new U8[mipSz];
-            pNewSurface->mMips.push_back(pDstBits);
-
-            if (useThreading)
-            {
-               // Create CompressJob item
-               ThreadSafeRef<CompressJob> item(new CompressJob(pSrcBits, pDstBits, srcDDS->getWidth(currentMip), srcDDS->getHeight(currentMip), compressFormat, compressQuality));
-               pThreadPool->queueWorkItem(item);
-            }
-            else
-               rawCompress(pSrcBits, pDstBits, srcDDS->getWidth(currentMip), srcDDS->getHeight(currentMip), compressFormat, compressQuality);
-
+            delete [] pSurface->mMips[currentMip];
+            pSurface->mMips[currentMip] = dstMips[ surface * mipCount + currentMip ];
          }
-         //block and wait for CompressJobs to finish
-         if(useThreading)
-            pThreadPool->waitForAllItems();
-
-         // Now delete the source surface and replace with new compressed surface
-         srcDDS->mSurfaces.pop_back();
-         delete pSrcSurface;
-         srcDDS->mSurfaces.push_back(pNewSurface);
       }
 
       return true;
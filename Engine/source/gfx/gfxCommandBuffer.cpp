@@ -0,0 +1,773 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026 tgemit contributors.
+// See AUTHORS file and git repository for contributor information.
+//
+// SPDX-License-Identifier: MIT
+//-----------------------------------------------------------------------------
+
+#include "platform/platform.h"
+#include "gfx/gfxCommandBuffer.h"
+
+#include "gfx/gfxStateBlock.h"
+#include "gfx/gfxShader.h"
+#include "gfx/gfxCubemap.h"
+#include "gfx/gfxTarget.h"
+#include "gfx/gfxVertexBuffer.h"
+#include "gfx/gfxPrimitiveBuffer.h"
+#include "platform/profiler.h"
+
+
+// The command payloads.  They are always copied in and out
+// of the stream so they need no special alignment.
+
+struct GFXCmdPointer
+{
+   void *ptr;
+};
+
+struct GFXCmdSetShader
+{
+   GFXShader *shader;
+   bool force;
+};
+
+struct GFXCmdSetShaderConst
+{
+   GFXShaderConstBuffer *buffer;
+   GFXShaderConstHandle *handle;
+   U32 type;
+   GFXShaderConstType matrixType;
+};
+
+struct GFXCmdSetTexture
+{
+   U32 stage;
+   void *texture;
+};
+
+struct GFXCmdSetVertexBuffer
+{
+   GFXVertexBuffer *buffer;
+   U32 stream;
+   U32 frequency;
+};
+
+struct GFXCmdSetRenderTarget
+{
+   GFXTarget *target;
+   bool updateViewport;
+};
+
+struct GFXCmdClear
+{
+   U32 flags;
+   LinearColorF color;
+   F32 z;
+   U32 stencil;
+};
+
+struct GFXCmdUpdateBuffer
+{
+   void *buffer;
+   U32 start;
+   U32 count;
+   U32 size;
+};
+
+struct GFXCmdDrawPrimitive
+{
+   GFXPrimitiveType primType;
+   U32 vertexStart;
+   U32 primitiveCount;
+};
+
+struct GFXCmdDrawIndexedPrimitive
+{
+   GFXPrimitiveType primType;
+   U32 startVertex;
+   U32 minIndex;
+   U32 numVerts;
+   U32 startIndex;
+   U32 primitiveCount;
+};
+
+
+GFXCommandBuffer::GFXCommandBuffer()
+   :  mCommandCount( 0 )
+{
+   dMemset( mCommandCounts, 0, sizeof( mCommandCounts ) );
+}
+
+GFXCommandBuffer::~GFXCommandBuffer()
+{
+}
+
+void GFXCommandBuffer::reset()
+{
+   // Keep the memory around... the next frame
+   // will likely need the same amount.
+   mData.clear();
+   mResources.clear();
+   mCommandCount = 0;
+   dMemset( mCommandCounts, 0, sizeof( mCommandCounts ) );
+}
+
+U8* GFXCommandBuffer::_alloc( Command cmd, U32 size )
+{
+   const U32 offset = mData.size();
+   mData.increment( sizeof( Header ) + size );
+
+   Header header;
+   header.cmd = cmd;
+   header.size = size;
+   dMemcpy( mData.address() + offset, &header, sizeof( Header ) );
+
+   mCommandCount++;
+   mCommandCounts[cmd]++;
+
+   return mData.address() + offset + sizeof( Header );
+}
+
+void GFXCommandBuffer::_addRef( StrongRefBase *resource )
+{
+   if ( resource )
+      mResources.push_back( resource );
+}
+
+void GFXCommandBuffer::setStateBlock( GFXStateBlock *block )
+{
+   _addRef( block );
+
+   GFXCmdPointer cmd = { block };
+   _write( SetStateBlock, cmd );
+}
+
+void GFXCommandBuffer::setShader( GFXShader *shader, bool force )
+{
+   _addRef( shader );
+
+   GFXCmdSetShader cmd = { shader, force };
+   _write( SetShader, cmd );
+}
+
+void GFXCommandBuffer::setShaderConstBuffer( GFXShaderConstBuffer *buffer )
+{
+   _addRef( buffer );
+
+   GFXCmdPointer cmd = { buffer };
+   _write( SetShaderConstBuffer, cmd );
+}
+
+void GFXCommandBuffer::_setShaderConst(   GFXShaderConstBuffer *buffer,
+                                          GFXShaderConstHandle *handle,
+                                          ConstType type,
+                                          const void *value,
+                                          U32 size,
+                                          GFXShaderConstType matrixType )
+{
+   // The buffer references the shader which owns the handle.
+   _addRef( buffer );
+
+   GFXCmdSetShaderConst cmd = { buffer, handle, (U32)type, matrixType };
+   U8 *payload = _alloc( SetShaderConst, sizeof( cmd ) + size );
+   dMemcpy( payload, &cmd, sizeof( cmd ) );
+   dMemcpy( payload + sizeof( cmd ), value, size );
+}
+
+void GFXCommandBuffer::setShaderConst( GFXShaderConstBuffer *buffer, GFXShaderConstHandle *handle, const F32 value )
+{
+   _setShaderConst( buffer, handle, ConstF32, &value, sizeof( value ) );
+}
+
+void GFXCommandBuffer::setShaderConst( GFXShaderConstBuffer *buffer, GFXShaderConstHandle *handle, const Point2F &value )
+{
+   _setShaderConst( buffer, handle, ConstPoint2F, &value, sizeof( value ) );
+}
+
+void GFXCommandBuffer::setShaderConst( GFXShaderConstBuffer *buffer, GFXShaderConstHandle *handle, const Point3F &value )
+{
+   _setShaderConst( buffer, handle, ConstPoint3F, &value, sizeof( value ) );
+}
+
+void GFXCommandBuffer::setShaderConst( GFXShaderConstBuffer *buffer, GFXShaderConstHandle *handle, const Point4F &value )
+{
+   _setShaderConst( buffer, handle, ConstPoint4F, &value, sizeof( value ) );
+}
+
+void GFXCommandBuffer::setShaderConst( GFXShaderConstBuffer *buffer, GFXShaderConstHandle *handle, const LinearColorF &value )
+{
+   _setShaderConst( buffer, handle, ConstLinearColorF, &value, sizeof( value ) );
+}
+
+void GFXCommandBuffer::setShaderConst( GFXShaderConstBuffer *buffer, GFXShaderConstHandle *handle, const S32 value )
+{
+   _setShaderConst( buffer, handle, ConstS32, &value, sizeof( value ) );
+}
+
+void GFXCommandBuffer::setShaderConst( GFXShaderConstBuffer *buffer, GFXShaderConstHandle *handle, const MatrixF &value, const GFXShaderConstType matrixType )
+{
+   _setShaderConst( buffer, handle, ConstMatrixF, &value, sizeof( value ), matrixType );
+}
+
+void GFXCommandBuffer::setTexture( U32 stage, GFXTextureObject *texture )
+{
+   _addRef( texture );
+
+   GFXCmdSetTexture cmd = { stage, texture };
+   _write( SetTexture, cmd );
+}
+
+void GFXCommandBuffer::setCubeTexture( U32 stage, GFXCubemap *cubemap )
+{
+   _addRef( cubemap );
+
+   GFXCmdSetTexture cmd = { stage, cubemap };
+   _write( SetCubeTexture, cmd );
+}
+
+void GFXCommandBuffer::setVertexBuffer( GFXVertexBuffer *buffer, U32 stream, U32 frequency )
+{
+   _addRef( buffer );
+
+   GFXCmdSetVertexBuffer cmd = { buffer, stream, frequency };
+   _write( SetVertexBuffer, cmd );
+}
+
+void GFXCommandBuffer::setVertexFormat( const GFXVertexFormat *vertexFormat )
+{
+   // Vertex formats are static and not reference counted.
+   GFXCmdPointer cmd = { (void*)vertexFormat };
+   _write( SetVertexFormat, cmd );
+}
+
+void GFXCommandBuffer::setPrimitiveBuffer( GFXPrimitiveBuffer *buffer )
+{
+   _addRef( buffer );
+
+   GFXCmdPointer cmd = { buffer };
+   _write( SetPrimitiveBuffer, cmd );
+}
+
+void GFXCommandBuffer::setViewport( const RectI &rect )
+{
+   _write( SetViewport, rect );
+}
+
+void GFXCommandBuffer::pushActiveRenderTarget()
+{
+   _alloc( PushRenderTarget, 0 );
+}
+
+void GFXCommandBuffer::setActiveRenderTarget( GFXTarget *target, bool updateViewport )
+{
+   _addRef( target );
+
+   GFXCmdSetRenderTarget cmd = { target, updateViewport };
+   _write( SetRenderTarget, cmd );
+}
+
+void GFXCommandBuffer::popActiveRenderTarget()
+{
+   _alloc( PopRenderTarget, 0 );
+}
+
+void GFXCommandBuffer::clear( U32 flags, const LinearColorF &color, F32 z, U32 stencil )
+{
+   GFXCmdClear cmd = { flags, color, z, stencil };
+   _write( Clear, cmd );
+}
+
+void GFXCommandBuffer::updateVertexBuffer( GFXVertexBuffer *buffer, U32 vertexStart, U32 numVerts, const void *vertices )
+{
+   AssertFatal( buffer, "GFXCommandBuffer::updateVertexBuffer - Got null buffer!" );
+   _addRef( buffer );
+
+   GFXCmdUpdateBuffer cmd = { buffer, vertexStart, numVerts, numVerts * buffer->mVertexSize };
+   U8 *payload = _alloc( UpdateVertexBuffer, sizeof( cmd ) + cmd.size );
+   dMemcpy( payload, &cmd, sizeof( cmd ) );
+   dMemcpy( payload + sizeof( cmd ), vertices, cmd.size );
+}
+
+void GFXCommandBuffer::updatePrimitiveBuffer( GFXPrimitiveBuffer *buffer, U32 indexStart, U32 numIndices, const U16 *indices )
+{
+   AssertFatal( buffer, "GFXCommandBuffer::updatePrimitiveBuffer - Got null buffer!" );
+   _addRef( buffer );
+
+   GFXCmdUpdateBuffer cmd = { buffer, indexStart, numIndices, numIndices * (U32)sizeof( U16 ) };
+   U8 *payload = _alloc( UpdatePrimitiveBuffer, sizeof( cmd ) + cmd.size );
+   dMemcpy( payload, &cmd, sizeof( cmd ) );
+   dMemcpy( payload + sizeof( cmd ), indices, cmd.size );
+}
+
+void GFXCommandBuffer::drawPrimitive( GFXPrimitiveType primType, U32 vertexStart, U32 primitiveCount )
+{
+   GFXCmdDrawPrimitive cmd = { primType, vertexStart, primitiveCount };
+   _write( DrawPrimitive, cmd );
+}
+
+void GFXCommandBuffer::drawIndexedPrimitive(  GFXPrimitiveType primType,
+                                             U32 startVertex,
+                                             U32 minIndex,
+                                             U32 numVerts,
+                                             U32 startIndex,
+                                             U32 primitiveCount )
+{
+   GFXCmdDrawIndexedPrimitive cmd = { primType, startVertex, minIndex, numVerts, startIndex, primitiveCount };
+   _write( DrawIndexedPrimitive, cmd );
+}
+
+U32 GFXCommandBuffer::getVertexCount( GFXPrimitiveType primType, U32 primitiveCount )
+{
+   if ( primitiveCount == 0 )
+      return 0;
+
+   switch ( primType )
+   {
+      case GFXPointList:      return primitiveCount;
+      case GFXLineList:       return primitiveCount * 2;
+      case GFXLineStrip:      return primitiveCount + 1;
+      case GFXTriangleList:   return primitiveCount * 3;
+      case GFXTriangleStrip:  return primitiveCount + 2;
+      default:                return 0;
+   }
+}
+
+void GFXCommandBuffer::replay( GFXDevice *device ) const
+{
+   PROFILE_SCOPE( GFXCommandBuffer_Replay );
+
+   const U8 *cursor = mData.address();
+   const U8 *end = cursor + mData.size();
+
+   while ( cursor < end )
+   {
+      Header header;
+      dMemcpy( &header, cursor, sizeof( Header ) );
+      const U8 *payload = cursor + sizeof( Header );
+      cursor = payload + header.size;
+
+      switch ( header.cmd )
+      {
+         case SetStateBlock:
+         {
+            GFXCmdPointer cmd;
+            dMemcpy( &cmd, payload, sizeof( cmd ) );
+            device->setStateBlock( (GFXStateBlock*)cmd.ptr );
+            break;
+         }
+
+         case SetShader:
+         {
+            GFXCmdSetShader cmd;
+            dMemcpy( &cmd, payload, sizeof( cmd ) );
+            device->setShader( cmd.shader, cmd.force );
+            break;
+         }
+
+         case SetShaderConstBuffer:
+         {
+            GFXCmdPointer cmd;
+            dMemcpy( &cmd, payload, sizeof( cmd ) );
+            device->setShaderConstBuffer( (GFXShaderConstBuffer*)cmd.ptr );
+            break;
+         }
+
+         case SetShaderConst:
+         {
+            GFXCmdSetShaderConst cmd;
+            dMemcpy( &cmd, payload, sizeof( cmd ) );
+            const U8 *value = payload + sizeof( cmd );
+
+            switch ( cmd.type )
+            {
+               case ConstF32:
+               {
+                  F32 v;
+                  dMemcpy( &v, value, sizeof( v ) );
+                  cmd.buffer->set( cmd.handle, v );
+                  break;
+               }
+               case ConstPoint2F:
+               {
+                  Point2F v;
+                  dMemcpy( &v, value, sizeof( v ) );
+                  cmd.buffer->set( cmd.handle, v );
+                  break;
+               }
+               case ConstPoint3F:
+               {
+                  Point3F v;
+                  dMemcpy( &v, value, sizeof( v ) );
+                  cmd.buffer->set( cmd.handle, v );
+                  break;
+               }
+               case ConstPoint4F:
+               {
+                  Point4F v;
+                  dMemcpy( &v, value, sizeof( v ) );
+                  cmd.buffer->set( cmd.handle, v );
+                  break;
+               }
+               case ConstLinearColorF:
+               {
+                  LinearColorF v;
+                  dMemcpy( &v, value, sizeof( v ) );
+                  cmd.buffer->set( cmd.handle, v );
+                  break;
+               }
+               case ConstS32:
+               {
+                  S32 v;
+                  dMemcpy( &v, value, sizeof( v ) );
+                  cmd.buffer->set( cmd.handle, v );
+                  break;
+               }
+               case ConstMatrixF:
+               {
+                  MatrixF v;
+                  dMemcpy( &v, value, sizeof( v ) );
+                  cmd.buffer->set( cmd.handle, v, cmd.matrixType );
+                  break;
+               }
+            }
+            break;
+         }
+
+         case SetTexture:
+         {
+            GFXCmdSetTexture cmd;
+            dMemcpy( &cmd, payload, sizeof( cmd ) );
+            device->setTexture( cmd.stage, (GFXTextureObject*)cmd.texture );
+            break;
+         }
+
+         case SetCubeTexture:
+         {
+            GFXCmdSetTexture cmd;
+            dMemcpy( &cmd, payload, sizeof( cmd ) );
+            device->setCubeTexture( cmd.stage, (GFXCubemap*)cmd.texture );
+            break;
+         }
+
+         case SetVertexBuffer:
+         {
+            GFXCmdSetVertexBuffer cmd;
+            dMemcpy( &cmd, payload, sizeof( cmd ) );
+            device->setVertexBuffer( cmd.buffer, cmd.stream, cmd.frequency );
+            break;
+         }
+
+         case SetVertexFormat:
+         {
+            GFXCmdPointer cmd;
+            dMemcpy( &cmd, payload, sizeof( cmd ) );
+            device->setVertexFormat( (const GFXVertexFormat*)cmd.ptr );
+            break;
+         }
+
+         case SetPrimitiveBuffer:
+         {
+            GFXCmdPointer cmd;
+            dMemcpy( &cmd, payload, sizeof( cmd ) );
+            device->setPrimitiveBuffer( (GFXPrimitiveBuffer*)cmd.ptr );
+            break;
+         }
+
+         case SetViewport:
+         {
+            RectI rect;
+            dMemcpy( &rect, payload, sizeof( rect ) );
+            device->setViewport( rect );
+            break;
+         }
+
+         case PushRenderTarget:
+            device->pushActiveRenderTarget();
+            break;
+
+         case SetRenderTarget:
+         {
+            GFXCmdSetRenderTarget cmd;
+            dMemcpy( &cmd, payload, sizeof( cmd ) );
+            device->setActiveRenderTarget( cmd.target, cmd.updateViewport );
+            break;
+         }
+
+         case PopRenderTarget:
+            device->popActiveRenderTarget();
+            break;
+
+         case Clear:
+         {
+            GFXCmdClear cmd;
+            dMemcpy( &cmd, payload, sizeof( cmd ) );
+            device->clear( cmd.flags, cmd.color, cmd.z, cmd.stencil );
+            break;
+         }
+
+         case UpdateVertexBuffer:
+         {
+            GFXCmdUpdateBuffer cmd;
+            dMemcpy( &cmd, payload, sizeof( cmd ) );
+
+            GFXVertexBuffer *vb = (GFXVertexBuffer*)cmd.buffer;
+            void *verts = NULL;
+            vb->lock( cmd.start, cmd.start + cmd.count, &verts );
+            if ( verts )
+               dMemcpy( verts, payload + sizeof( cmd ), cmd.size );
+            vb->unlock();
+            break;
+         }
+
+         case UpdatePrimitiveBuffer:
+         {
+            GFXCmdUpdateBuffer cmd;
+            dMemcpy( &cmd, payload, sizeof( cmd ) );
+
+            GFXPrimitiveBuffer *pb = (GFXPrimitiveBuffer*)cmd.buffer;
+            void *indices = NULL;
+            pb->lock( cmd.start, cmd.start + cmd.count, &indices );
+            if ( indices )
+               dMemcpy( indices, payload + sizeof( cmd ), cmd.size );
+            pb->unlock();
+            break;
+         }
+
+         case DrawPrimitive:
+         {
+            GFXCmdDrawPrimitive cmd;
+            dMemcpy( &cmd, payload, sizeof( cmd ) );
+            device->drawPrimitive( cmd.primType, cmd.vertexStart, cmd.primitiveCount );
+            break;
+         }
+
+         case DrawIndexedPrimitive:
+         {
+            GFXCmdDrawIndexedPrimitive cmd;
+            dMemcpy( &cmd, payload, sizeof( cmd ) );
+            device->drawIndexedPrimitive( cmd.primType, cmd.startVertex, cmd.minIndex, cmd.numVerts, cmd.startIndex, cmd.primitiveCount );
+            break;
+         }
+
+         default:
+            AssertFatal( false, "GFXCommandBuffer::replay - Unknown command!" );
+            return;
+      }
+   }
+}
+
+bool GFXCommandBuffer::validate( String *outError ) const
+{
+   // The state a device would have while replaying.
+   GFXVertexBuffer *vb = NULL;
+   GFXPrimitiveBuffer *pb = NULL;
+   S32 targetDepth = 0;
+
+   String error;
+   U32 index = 0;
+
+   const U8 *cursor = mData.address();
+   const U8 *end = cursor + mData.size();
+
+   while ( cursor < end )
+   {
+      Header header;
+      if ( end - cursor < (S32)sizeof( Header ) )
+      {
+         error = "truncated command header";
+         break;
+      }
+
+      dMemcpy( &header, cursor, sizeof( Header ) );
+      const U8 *payload = cursor + sizeof( Header );
+      if ( header.cmd >= NumCommands || header.size > U32( end - payload ) )
+      {
+         error = "corrupt command header";
+         break;
+      }
+
+      cursor = payload + header.size;
+
+      switch ( header.cmd )
+      {
+         case SetShaderConst:
+         {
+            GFXCmdSetShaderConst cmd;
+            dMemcpy( &cmd, payload, sizeof( cmd ) );
+            if ( !cmd.buffer || !cmd.handle )
+               error = "shader constant without a buffer or handle";
+            break;
+         }
+
+         case SetVertexBuffer:
+         {
+            GFXCmdSetVertexBuffer cmd;
+            dMemcpy( &cmd, payload, sizeof( cmd ) );
+            if ( cmd.stream == 0 )
+               vb = cmd.buffer;
+            break;
+         }
+
+         case SetPrimitiveBuffer:
+         {
+            GFXCmdPointer cmd;
+            dMemcpy( &cmd, payload, sizeof( cmd ) );
+            pb = (GFXPrimitiveBuffer*)cmd.ptr;
+            break;
+         }
+
+         case PushRenderTarget:
+            targetDepth++;
+            break;
+
+         case PopRenderTarget:
+            if ( --targetDepth < 0 )
+               error = "render target popped without a push";
+            break;
+
+         case UpdateVertexBuffer:
+         {
+            GFXCmdUpdateBuffer cmd;
+            dMemcpy( &cmd, payload, sizeof( cmd ) );
+            const GFXVertexBuffer *buffer = (GFXVertexBuffer*)cmd.buffer;
+            if (  buffer->mBufferType != GFXBufferTypeVolatile &&
+                  cmd.start + cmd.count > buffer->mNumVerts )
+               error = "vertex buffer update out of range";
+            break;
+         }
+
+         case UpdatePrimitiveBuffer:
+         {
+            GFXCmdUpdateBuffer cmd;
+            dMemcpy( &cmd, payload, sizeof( cmd ) );
+            const GFXPrimitiveBuffer *buffer = (GFXPrimitiveBuffer*)cmd.buffer;
+            if (  buffer->mBufferType != GFXBufferTypeVolatile &&
+                  cmd.start + cmd.count > buffer->mIndexCount )
+               error = "primitive buffer update out of range";
+            break;
+         }
+
+         case DrawPrimitive:
+         {
+            GFXCmdDrawPrimitive cmd;
+            dMemcpy( &cmd, payload, sizeof( cmd ) );
+
+            if ( !vb )
+               error = "draw without a vertex buffer";
+            else if (   vb->mBufferType != GFXBufferTypeVolatile &&
+                        cmd.vertexStart + getVertexCount( cmd.primType, cmd.primitiveCount ) > vb->mNumVerts )
+               error = "draw past the end of the vertex buffer";
+            break;
+         }
+
+         case DrawIndexedPrimitive:
+         {
+            GFXCmdDrawIndexedPrimitive cmd;
+            dMemcpy( &cmd, payload, sizeof( cmd ) );
+
+            if ( !vb )
+               error = "indexed draw without a vertex buffer";
+            else if ( !pb )
+               error = "indexed draw without a primitive buffer";
+            else if (   vb->mBufferType != GFXBufferTypeVolatile &&
+                        cmd.startVertex + cmd.minIndex + cmd.numVerts > vb->mNumVerts )
+               error = "indexed draw past the end of the vertex buffer";
+            else if (   pb->mBufferType != GFXBufferTypeVolatile &&
+                        cmd.startIndex + getVertexCount( cmd.primType, cmd.primitiveCount ) > pb->mIndexCount )
+               error = "indexed draw past the end of the primitive buffer";
+            break;
+         }
+
+         default:
+            break;
+      }
+
+      if ( !error.isEmpty() )
+         break;
+
+      index++;
+   }
+
+   if ( error.isEmpty() && targetDepth != 0 )
+   {
+      error = "unbalanced render target push";
+      index = mCommandCount;
+   }
+
+   if ( error.isEmpty() )
+      return true;
+
+   if ( outError )
+      *outError = String::ToString( "Command %d: %s", index, error.c_str() );
+
+   return false;
+}
+
+
+GFXCommandQueue::GFXCommandQueue()
+   :  mRecordIndex( 0 ),
+      mSubmittedIndex( 0 ),
+      mSubmitted( 0 ),
+      mReplayed( 1 ),
+      mShutdown( false ),
+      mReplayedFrames( 0 )
+{
+}
+
+void GFXCommandQueue::submit()
+{
+   PROFILE_SCOPE( GFXCommandQueue_Submit );
+
+   // Wait for the last frame to finish replaying which also
+   // frees up the buffer we're about to record into.
+   mReplayed.acquire();
+
+   mSubmittedIndex = mRecordIndex;
+   mRecordIndex ^= 1;
+   mBuffers[mRecordIndex].reset();
+
+   mSubmitted.release();
+}
+
+bool GFXCommandQueue::replaySubmitted( GFXDevice *device )
+{
+   mSubmitted.acquire();
+   if ( mShutdown )
+      return false;
+
+   mBuffers[mSubmittedIndex].replay( device );
+   mReplayedFrames++;
+
+   mReplayed.release();
+   return true;
+}
+
+void GFXCommandQueue::flush()
+{
+   mReplayed.acquire();
+   mReplayed.release();
+}
+
+void GFXCommandQueue::shutdown()
+{
+   // Let any frame in flight finish first.
+   flush();
+
+   mShutdown = true;
+   mSubmitted.release();
+}
+
+
+GFXRenderThread::GFXRenderThread( GFXCommandQueue *queue, GFXDevice *device )
+   :  mQueue( queue ),
+      mDevice( device )
+{
+}
+
+void GFXRenderThread::run( void *arg )
+{
+   _setName( "GFXRenderThread" );
+
+   while ( mQueue->replaySubmitted( mDevice ) )
+      ;
+}
@@ -0,0 +1,282 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026 tgemit contributors.
+// See AUTHORS file and git repository for contributor information.
+//
+// SPDX-License-Identifier: MIT
+//-----------------------------------------------------------------------------
+
+#ifndef _GFXCOMMANDBUFFER_H_
+#define _GFXCOMMANDBUFFER_H_
+
+#ifndef _GFXDEVICE_H_
+#include "gfx/gfxDevice.h"
+#endif
+#ifndef _PLATFORM_THREAD_SEMAPHORE_H_
+#include "platform/threads/semaphore.h"
+#endif
+#ifndef _PLATFORM_THREADS_THREAD_H_
+#include "platform/threads/thread.h"
+#endif
+
+
+/// A linear stream of device calls which is recorded on one
+/// thread and replayed in order against a GFXDevice later.
+///
+/// The recording methods mirror the GFXDevice front end.  Every
+/// resource passed in is referenced until the buffer is reset, and
+/// shader constants and buffer updates are copied when they are
+/// recorded, so the caller is free to change or release its own
+/// copies right away.
+///
+/// Replaying against the GFXNullDevice together with validate()
+/// lets us check command streams without a real device.
+///
+/// @see GFXCommandQueue
+class GFXCommandBuffer
+{
+public:
+
+   enum Command
+   {
+      SetStateBlock,
+      SetShader,
+      SetShaderConstBuffer,
+      SetShaderConst,
+      SetTexture,
+      SetCubeTexture,
+      SetVertexBuffer,
+      SetVertexFormat,
+      SetPrimitiveBuffer,
+      SetViewport,
+      PushRenderTarget,
+      SetRenderTarget,
+      PopRenderTarget,
+      Clear,
+      UpdateVertexBuffer,
+      UpdatePrimitiveBuffer,
+      DrawPrimitive,
+      DrawIndexedPrimitive,
+      NumCommands
+   };
+
+   GFXCommandBuffer();
+   ~GFXCommandBuffer();
+
+   /// @name Recording
+   /// @{
+
+   void setStateBlock( GFXStateBlock *block );
+   void setShader( GFXShader *shader, bool force = false );
+   void setShaderConstBuffer( GFXShaderConstBuffer *buffer );
+
+   /// Records a constant which is set on the buffer when
+   /// the command is replayed.
+   void setShaderConst( GFXShaderConstBuffer *buffer, GFXShaderConstHandle *handle, const F32 value );
+   void setShaderConst( GFXShaderConstBuffer *buffer, GFXShaderConstHandle *handle, const Point2F &value );
+   void setShaderConst( GFXShaderConstBuffer *buffer, GFXShaderConstHandle *handle, const Point3F &value );
+   void setShaderConst( GFXShaderConstBuffer *buffer, GFXShaderConstHandle *handle, const Point4F &value );
+   void setShaderConst( GFXShaderConstBuffer *buffer, GFXShaderConstHandle *handle, const LinearColorF &value );
+   void setShaderConst( GFXShaderConstBuffer *buffer, GFXShaderConstHandle *handle, const S32 value );
+   void setShaderConst( GFXShaderConstBuffer *buffer, GFXShaderConstHandle *handle, const MatrixF &value, const GFXShaderConstType matrixType = GFXSCT_Float4x4 );
+
+   void setTexture( U32 stage, GFXTextureObject *texture );
+   void setCubeTexture( U32 stage, GFXCubemap *cubemap );
+   void setVertexBuffer( GFXVertexBuffer *buffer, U32 stream = 0, U32 frequency = 0 );
+   void setVertexFormat( const GFXVertexFormat *vertexFormat );
+   void setPrimitiveBuffer( GFXPrimitiveBuffer *buffer );
+   void setViewport( const RectI &rect );
+
+   void pushActiveRenderTarget();
+   void setActiveRenderTarget( GFXTarget *target, bool updateViewport = true );
+   void popActiveRenderTarget();
+
+   void clear( U32 flags, const LinearColorF &color, F32 z, U32 stencil );
+
+   /// Copies the vertices into the stream.  At replay they
+   /// are written to the buffer with a lock/unlock.
+   void updateVertexBuffer( GFXVertexBuffer *buffer, U32 vertexStart, U32 numVerts, const void *vertices );
+
+   /// Copies the indices into the stream.  At replay they
+   /// are written to the buffer with a lock/unlock.
+   void updatePrimitiveBuffer( GFXPrimitiveBuffer *buffer, U32 indexStart, U32 numIndices, const U16 *indices );
+
+   void drawPrimitive( GFXPrimitiveType primType, U32 vertexStart, U32 primitiveCount );
+   void drawIndexedPrimitive( GFXPrimitiveType primType,
+                              U32 startVertex,
+                              U32 minIndex,
+                              U32 numVerts,
+                              U32 startIndex,
+                              U32 primitiveCount );
+
+   /// @}
+
+   /// Issues all the recorded commands in order on the device.
+   void replay( GFXDevice *device ) const;
+
+   /// Walks the stream checking for commands which would fail on a
+   /// real device... draws without buffers, ranges outside of the
+   /// bound buffers, and unbalanced render target pushes.
+   ///
+   /// @param outError If not NULL it gets a description of the first problem found.
+   /// @return Returns false if the stream is invalid.
+   bool validate( String *outError = NULL ) const;
+
+   /// Drops all the commands and resource references.
+   void reset();
+
+   bool isEmpty() const { return mData.empty(); }
+
+   /// Returns the number of recorded commands.
+   U32 getCommandCount() const { return mCommandCount; }
+
+   /// Returns the number of recorded commands of one type.
+   U32 getCommandCount( Command cmd ) const { return mCommandCounts[cmd]; }
+
+   /// Returns the size of the command stream in bytes.
+   U32 getSize() const { return mData.size(); }
+
+   /// Returns the number of vertices a primitive count uses.
+   static U32 getVertexCount( GFXPrimitiveType primType, U32 primitiveCount );
+
+protected:
+
+   /// The header in front of every command in the stream.
+   struct Header
+   {
+      U32 cmd;
+      U32 size;
+   };
+
+   /// The value types we can record for shader constants.
+   enum ConstType
+   {
+      ConstF32,
+      ConstPoint2F,
+      ConstPoint3F,
+      ConstPoint4F,
+      ConstLinearColorF,
+      ConstS32,
+      ConstMatrixF
+   };
+
+   /// The linear command stream.
+   Vector<U8> mData;
+
+   /// Keeps every resource referenced by the stream alive
+   /// until the buffer is reset.
+   Vector< StrongRefPtr<StrongRefBase> > mResources;
+
+   U32 mCommandCount;
+
+   U32 mCommandCounts[NumCommands];
+
+   /// Appends a command with room for the payload
+   /// and returns a pointer to the payload.
+   U8* _alloc( Command cmd, U32 size );
+
+   /// Appends a command with a POD payload.
+   template<class T>
+   void _write( Command cmd, const T &payload )
+   {
+      dMemcpy( _alloc( cmd, sizeof( T ) ), &payload, sizeof( T ) );
+   }
+
+   /// References a resource for the life of the stream.
+   void _addRef( StrongRefBase *resource );
+
+   void _setShaderConst( GFXShaderConstBuffer *buffer, GFXShaderConstHandle *handle, ConstType type, const void *value, U32 size, GFXShaderConstType matrixType = GFXSCT_Float4x4 );
+};
+
+
+/// Double buffers GFXCommandBuffers between a recording thread
+/// and a replaying thread so that one frame can be recorded while
+/// the previous one is being issued to the device.
+///
+/// Only one thread may record and only one may replay.  Buffers are
+/// reset on the recording thread in submit(), so the references a
+/// buffer holds are only ever taken and dropped there.  The device
+/// takes references of its own when it binds resources though, and
+/// GFX resource reference counts are not atomic.  So the replaying
+/// thread must own its device, and frames replayed on another thread
+/// must not reference resources the recording thread still uses.
+/// Today that limits threaded replay to a GFXNullDevice created with
+/// global set to false, which is what we use to exercise the queue.
+///
+/// @code
+///   // Main thread.
+///   GFXCommandBuffer *cmds = queue.getRecordBuffer();
+///   cmds->drawPrimitive( ... );
+///   queue.submit();
+///
+///   // Render thread.
+///   while ( queue.replaySubmitted( GFX ) ) {}
+/// @endcode
+class GFXCommandQueue
+{
+public:
+
+   GFXCommandQueue();
+
+   /// Returns the buffer the current frame is recorded into.
+   GFXCommandBuffer* getRecordBuffer() { return &mBuffers[mRecordIndex]; }
+
+   /// Hands the recorded frame to the replaying thread and starts
+   /// a new one.  This blocks while the previous frame is still
+   /// being replayed, so we never get more than a frame ahead.
+   void submit();
+
+   /// Blocks until a submitted frame is available and replays it.
+   /// @return Returns false once the queue is shut down.
+   bool replaySubmitted( GFXDevice *device );
+
+   /// Blocks until the last submitted frame has been replayed.
+   void flush();
+
+   /// Wakes up and releases the replaying thread.
+   void shutdown();
+
+   /// Returns the number of frames replayed so far.
+   U32 getReplayedFrames() const { return mReplayedFrames; }
+
+protected:
+
+   GFXCommandBuffer mBuffers[2];
+
+   U32 mRecordIndex;
+
+   U32 mSubmittedIndex;
+
+   /// Signaled when a frame is submitted.
+   Semaphore mSubmitted;
+
+   /// Signaled when a submitted frame has been replayed.
+   Semaphore mReplayed;
+
+   volatile bool mShutdown;
+
+   volatile U32 mReplayedFrames;
+};
+
+
+/// A thread which replays a GFXCommandQueue on a device
+/// until the queue is shut down.
+///
+/// The device must not be used by any other thread.
+/// @see GFXCommandQueue
+class GFXRenderThread : public Thread
+{
+public:
+
+   GFXRenderThread( GFXCommandQueue *queue, GFXDevice *device );
+
+   // Thread
+   void run( void *arg = 0 ) override;
+
+protected:
+
+   GFXCommandQueue *mQueue;
+
+   GFXDevice *mDevice;
+};
+
+#endif // _GFXCOMMANDBUFFER_H_
@@ -32,9 +32,11 @@
 #include "gfx/gfxPrimitiveBuffer.h"
 #include "gfx/gfxShader.h"
 #include "gfx/gfxStateBlock.h"
+#include "gfx/gfxShaderConstMirror.h"
 #include "gfx/screenshot.h"
 #include "gfx/gfxStringEnumTranslate.h"
 #include "gfx/gfxTextureManager.h"
+#include "gfx/gfxTransientBufferPool.h"
 
 #include "core/frameAllocator.h"
 #include "core/stream/fileStream.h"
@@ -89,7 +91,7 @@ GFXDevice::DeviceEventSignal& GFXDevice::getDeviceEventSignal()
    return theSignal;
 }
 
-GFXDevice::GFXDevice() 
+GFXDevice::GFXDevice( bool global ) 
 {    
    VECTOR_SET_ASSOCIATION( mVideoModes );
    VECTOR_SET_ASSOCIATION( mRTStack );
@@ -102,8 +104,11 @@ GFXDevice::GFXDevice()
    for( S32 i = 0; i < GFX_WORLD_STACK_MAX; i++ )
       mWorldMatrix[i].identity();
    
-   AssertFatal(smGFXDevice == NULL, "Already a GFXDevice created! Bad!");
-   smGFXDevice = this;
+   if ( global )
+   {
+      AssertFatal(smGFXDevice == NULL, "Already a GFXDevice created! Bad!");
+      smGFXDevice = this;
+   }
       
    // Vertex buffer cache
    mCurrVertexDecl = NULL;
@@ -162,6 +167,7 @@ GFXDevice::GFXDevice()
 
    // Initialize our drawing utility.
    mDrawer = NULL;
+   mTransientBuffers = NULL;
    mFrameTime = PlatformTimer::create();
    // Add a few system wide shader macros.
    GFXShader::addGlobalMacro( "TORQUE", "1" );
@@ -187,6 +193,15 @@ GFXDrawUtil* GFXDevice::getDrawUtil()
    return mDrawer;
 }
 
+GFXTransientBufferPool* GFXDevice::getTransientBufferPool()
+{
+   if (!mTransientBuffers)
+   {
+      mTransientBuffers = new GFXTransientBufferPool(this);
+   }
+   return mTransientBuffers;
+}
+
 void GFXDevice::deviceInited()
 {
    getDeviceEventSignal().trigger(deInit);
@@ -226,11 +241,16 @@ void GFXDevice::preDestroy()
 {
    // Delete draw util
    SAFE_DELETE( mDrawer );
+
+   // Release the per-frame buffers while the device can still free them.
+   SAFE_DELETE( mTransientBuffers );
 }
 
 GFXDevice::~GFXDevice()
 { 
-   smGFXDevice = NULL;
+   const bool global = smGFXDevice == this;
+   if ( global )
+      smGFXDevice = NULL;
 
    // Clean up our current buffers.
    mCurrentPrimitiveBuffer = NULL;
@@ -255,10 +275,13 @@ GFXDevice::~GFXDevice()
    // Release all the unreferenced textures in the cache.
    mTextureManager->cleanupCache();
 
-   // Check for resource leaks
+   // Check for resource leaks... the lists are shared by all devices.
 #ifdef TORQUE_DEBUG
-   AssertFatal( GFXTextureObject::dumpActiveTOs() == 0, "There is a texture object leak, check the log for more details." );
-   GFXPrimitiveBuffer::dumpActivePBs();
+   if ( global )
+   {
+      AssertFatal( GFXTextureObject::dumpActiveTOs() == 0, "There is a texture object leak, check the log for more details." );
+      GFXPrimitiveBuffer::dumpActivePBs();
+   }
 #endif
 
    SAFE_DELETE( mTextureManager );
@@ -270,6 +293,10 @@ GFXDevice::~GFXDevice()
    mCurrentStateBlock = NULL;
 
    mCurrentShaderConstBuffer = NULL;
+
+   for ( ShaderConstMirrorMap::Iterator iter = mShaderConstMirrors.begin(); iter != mShaderConstMirrors.end(); ++iter )
+      delete iter->value;
+   mShaderConstMirrors.clear();
    /// End Block above BTR
 
    // -- Clear out resource list
@@ -287,6 +314,20 @@ GFXDevice::~GFXDevice()
    }
 }
 
+GFXShaderConstMirror* GFXDevice::getShaderConstMirror( const GFXShaderConstDesc &desc )
+{
+   // Match the naming the devices use for their shared buffers.
+   const String name( desc.name + "_" + String::ToString( desc.size ) );
+
+   ShaderConstMirrorMap::Iterator iter = mShaderConstMirrors.find( name );
+   if ( iter != mShaderConstMirrors.end() )
+      return iter->value;
+
+   GFXShaderConstMirror *mirror = new GFXShaderConstMirror();
+   mShaderConstMirrors.insert( name, mirror );
+   return mirror;
+}
+
 GFXStateBlockRef GFXDevice::createStateBlock(const GFXStateBlockDesc& desc)
 {
    PROFILE_SCOPE( GFXDevice_CreateStateBlock );
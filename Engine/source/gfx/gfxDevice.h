@@ -70,6 +70,8 @@ class GFXShader;
 class GFXStateBlock;
 class GFXShaderConstBuffer;
 class GFXTextureManager;
+class GFXShaderConstMirror;
+class GFXTransientBufferPool;
 
 // Global macro
 #define GFX GFXDevice::get() 
@@ -322,7 +324,9 @@ protected:
    /// Notify GFXDevice that we are initialized
    virtual void deviceInited();
 public:
-   GFXDevice();
+   /// @param global If false the device doesn't become the global GFX
+   /// device.  This is only for a GFXNullDevice driven by its own thread.
+   GFXDevice( bool global = true );
    virtual ~GFXDevice();
 
    /// Initialize this GFXDevice, optionally specifying a platform window to
@@ -450,6 +454,12 @@ public:
 
    /// Returns the current GFXDeviceStatistics, stats are cleared every ::beginScene call.
    GFXDeviceStatistics* getDeviceStatistics() { return &mDeviceStatistics; }
+
+   /// Returns the mirror for the device constant buffer shared
+   /// by every shader declaring this buffer, creating it on first use.
+   /// @see GFXShaderConstMirror
+   GFXShaderConstMirror* getShaderConstMirror( const GFXShaderConstDesc &desc );
+
 protected:
    GFXDeviceStatistics mDeviceStatistics;
 
@@ -521,6 +531,10 @@ protected:
 
    GFXShaderConstBuffer *mCurrentShaderConstBuffer;
 
+   /// The mirrors of the device constant buffers by name.
+   typedef Map<String, GFXShaderConstMirror*> ShaderConstMirrorMap;
+   ShaderConstMirrorMap mShaderConstMirrors;
+
    /// A global forced wireframe mode.
    static bool smWireframe;
 
@@ -1042,6 +1056,10 @@ public:
    /// Get access to this device's drawing utility class.
    GFXDrawUtil *getDrawUtil();
 
+   /// Get access to this device's pool of per-frame dynamic buffers.
+   /// @see GFXTransientBufferPool
+   GFXTransientBufferPool *getTransientBufferPool();
+
 #ifndef TORQUE_SHIPPING
    /// This is a method designed for debugging. It will allow you to dump the states
    /// in the render manager out to a file so that it can be diffed and examined.
@@ -1051,6 +1069,7 @@ public:
 #endif
    protected:
       GFXDrawUtil *mDrawer;
+      GFXTransientBufferPool *mTransientBuffers;
 }; 
 
 //-----------------------------------------------------------------------------
@@ -36,6 +36,8 @@ void GFXDeviceStatistics::setPrefix(const String& prefix)
    vnPolyCount = prefix + "polyCount";
    vnDrawCalls = prefix + "drawCalls";
    vnRenderTargetChanges = prefix + "renderTargetChanges";
+   vnStateChangesAvoided = prefix + "stateChangesAvoided";
+   vnShaderConstBytes = prefix + "shaderConstBytes";
 }
 
 /// Clear stats
@@ -44,6 +46,8 @@ void GFXDeviceStatistics::clear()
    mPolyCount = 0;
    mDrawCalls = 0;
    mRenderTargetChanges = 0;
+   mStateChangesAvoided = 0;
+   mShaderConstBytes = 0;
 }
 
 /// Copy from source (should just be a memcpy, but that may change later) used in 
@@ -54,6 +58,8 @@ void GFXDeviceStatistics::start(GFXDeviceStatistics * source)
    mPolyCount = source->mPolyCount;
    mDrawCalls = source->mDrawCalls;
    mRenderTargetChanges = source->mRenderTargetChanges;
+   mStateChangesAvoided = source->mStateChangesAvoided;
+   mShaderConstBytes = source->mShaderConstBytes;
 }
 
 /// Used with start to get a subset of stats on a device.  Basically will do
@@ -63,6 +69,8 @@ void GFXDeviceStatistics::end(GFXDeviceStatistics * source)
    mPolyCount = source->mPolyCount - mPolyCount;
    mDrawCalls = source->mDrawCalls - mDrawCalls;
    mRenderTargetChanges = source->mRenderTargetChanges - mRenderTargetChanges;   
+   mStateChangesAvoided = source->mStateChangesAvoided - mStateChangesAvoided;
+   mShaderConstBytes = source->mShaderConstBytes - mShaderConstBytes;
 }
 
 /// Exports the stats to the console
@@ -71,4 +79,6 @@ void GFXDeviceStatistics::exportToConsole()
    Con::setIntVariable(vnPolyCount, mPolyCount);
    Con::setIntVariable(vnDrawCalls, mDrawCalls);
    Con::setIntVariable(vnRenderTargetChanges, mRenderTargetChanges);
+   Con::setIntVariable(vnStateChangesAvoided, mStateChangesAvoided);
+   Con::setIntVariable(vnShaderConstBytes, mShaderConstBytes);
 }
\ No newline at end of file
@@ -35,6 +35,13 @@ public:
    S32 mDrawCalls;
    S32 mRenderTargetChanges;
 
+   /// The number of render instances which were drawn without
+   /// a material or buffer change thanks to render bin sorting.
+   S32 mStateChangesAvoided;
+
+   /// The number of shader constant bytes sent to the device.
+   S32 mShaderConstBytes;
+
    GFXDeviceStatistics();
 
    void setPrefix(const String& prefix);
@@ -57,6 +64,8 @@ private:
    String vnPolyCount;
    String vnDrawCalls;
    String vnRenderTargetChanges;
+   String vnStateChangesAvoided;
+   String vnShaderConstBytes;
 };
 
 #endif
\ No newline at end of file
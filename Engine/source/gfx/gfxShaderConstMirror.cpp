@@ -0,0 +1,100 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026 tgemit contributors.
+// See AUTHORS file and git repository for contributor information.
+//
+// SPDX-License-Identifier: MIT
+//-----------------------------------------------------------------------------
+
+#include "platform/platform.h"
+#include "gfx/gfxShaderConstMirror.h"
+
+
+GFXShaderConstMirror::GFXShaderConstMirror()
+   :  mData( NULL ),
+      mSize( 0 ),
+      mSource( NULL )
+{
+}
+
+GFXShaderConstMirror::~GFXShaderConstMirror()
+{
+   delete [] mData;
+}
+
+void GFXShaderConstMirror::invalidate()
+{
+   delete [] mData;
+   mData = NULL;
+   mSize = 0;
+   mSource = NULL;
+}
+
+bool GFXShaderConstMirror::update(  const void *source,
+                                    const U8 *data,
+                                    U32 size,
+                                    GFXShaderConstDirtyRange &dirty,
+                                    U32 *outStart,
+                                    U32 *outEnd )
+{
+   U32 start, end;
+
+   if ( mSize != size )
+   {
+      // Nothing to compare against so send it all.
+      delete [] mData;
+      mData = new U8[size];
+      mSize = size;
+      start = 0;
+      end = size;
+   }
+   else
+   {
+      if ( mSource == source )
+      {
+         // We uploaded last, so only what we wrote
+         // since then can differ.
+         if ( dirty.isEmpty() )
+            return false;
+
+         start = dirty.start;
+         end = getMin( dirty.end, size );
+      }
+      else
+      {
+         start = 0;
+         end = size;
+      }
+
+      // Trim whole registers which didn't actually change.
+      start &= ~( RegisterSize - 1 );
+      end = getMin( ( end + RegisterSize - 1 ) & ~( RegisterSize - 1 ), size );
+
+      while ( start < end )
+      {
+         const U32 count = getMin( RegisterSize, end - start );
+         if ( dMemcmp( data + start, mData + start, count ) != 0 )
+            break;
+         start += count;
+      }
+
+      while ( end > start )
+      {
+         const U32 blockStart = getMax( ( end - 1 ) & ~( RegisterSize - 1 ), start );
+         if ( dMemcmp( data + blockStart, mData + blockStart, end - blockStart ) != 0 )
+            break;
+         end = blockStart;
+      }
+   }
+
+   dirty.clear();
+   mSource = source;
+
+   if ( start >= end )
+      return false;
+
+   dMemcpy( mData + start, data + start, end - start );
+
+   *outStart = start;
+   *outEnd = end;
+   return true;
+}
@@ -0,0 +1,102 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026 tgemit contributors.
+// See AUTHORS file and git repository for contributor information.
+//
+// SPDX-License-Identifier: MIT
+//-----------------------------------------------------------------------------
+
+#ifndef _GFXSHADERCONSTMIRROR_H_
+#define _GFXSHADERCONSTMIRROR_H_
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+
+
+/// The byte range of a constant buffer which was written
+/// since the buffer was last uploaded.
+struct GFXShaderConstDirtyRange
+{
+   U32 start;
+   U32 end;
+
+   GFXShaderConstDirtyRange() { clear(); }
+
+   inline void add( U32 offset, U32 size )
+   {
+      start = getMin( start, offset );
+      end = getMax( end, offset + size );
+   }
+
+   inline void clear()
+   {
+      start = U32_MAX;
+      end = 0;
+   }
+
+   inline bool isEmpty() const { return start >= end; }
+};
+
+
+/// A copy of the content of a device constant buffer.
+///
+/// Device constant buffers are shared by name between every
+/// shader which declares them, so the last upload may have come
+/// from any of the GFXShaderConstBuffers using it.  The mirror
+/// remembers which source uploaded last and what it uploaded, so
+/// that each activation only sends the bytes which differ.
+///
+/// This is backend agnostic... the device only has to upload
+/// the range update() returns.
+class GFXShaderConstMirror
+{
+public:
+
+   /// Uploads are trimmed to whole registers.
+   static const U32 RegisterSize = 16;
+
+   GFXShaderConstMirror();
+   ~GFXShaderConstMirror();
+
+   /// Works out what needs uploading for the device buffer to
+   /// match the source data and updates the mirror to match.
+   ///
+   /// When the source uploaded last only its dirty range is
+   /// compared, else the whole buffer is.  The dirty range is
+   /// cleared either way.
+   ///
+   /// @param source   An id for the source buffer, usually its data pointer.
+   ///                 Sources must start with everything marked dirty.
+   /// @param data     The source data.
+   /// @param size     The size of the data in bytes.
+   /// @param dirty    The dirty range of the source.
+   /// @param outStart The first byte to upload.
+   /// @param outEnd   One past the last byte to upload.
+   ///
+   /// @return Returns false if the device buffer already matches.
+   bool update(   const void *source,
+                  const U8 *data,
+                  U32 size,
+                  GFXShaderConstDirtyRange &dirty,
+                  U32 *outStart,
+                  U32 *outEnd );
+
+   /// Returns true if nothing was uploaded yet, in which
+   /// case update() will always return the whole buffer.
+   bool isEmpty() const { return mSize == 0; }
+
+   /// Forgets the device content, the next update
+   /// will upload the whole buffer.
+   void invalidate();
+
+protected:
+
+   U8 *mData;
+
+   U32 mSize;
+
+   /// The source which uploaded last.
+   const void *mSource;
+};
+
+#endif // _GFXSHADERCONSTMIRROR_H_
@@ -32,6 +32,8 @@
 #include "core/resourceManager.h"
 #include "core/volume.h"
 #include "core/util/dxt5nmSwizzle.h"
+#include "core/util/hashFunction.h"
+#include "core/stream/fileStream.h"
 #include "console/consoleTypes.h"
 #include "console/engineAPI.h"
 #include "renderInstance/renderProbeMgr.h"
@@ -42,6 +44,7 @@ using namespace Torque;
 
 
 S32 GFXTextureManager::smTextureReductionLevel = 0;
+String GFXTextureManager::smTextureCachePath;
 
 String GFXTextureManager::smMissingTexturePath(Con::getVariable("$Core::MissingTexturePath"));
 String GFXTextureManager::smUnavailableTexturePath(Con::getVariable("$Core::UnAvailableTexturePath"));
@@ -53,6 +56,12 @@ GFXTextureManager::EventSignal GFXTextureManager::smEventSignal;
 
 static const String  sDDSExt( "dds" );
 
+/// Tags the trailer we append to the DDS files in the texture cache.
+static const char sTextureCacheTag[4] = { 'T', 'Q', 'T', 'C' };
+
+/// Tags the key files which keep the source hashes in the texture cache.
+static const char sTextureCacheKeyTag[4] = { 'T', 'Q', 'T', 'K' };
+
 void GFXTextureManager::init()
 {
    Con::addVariable( "$pref::Video::textureReductionLevel", TypeS32, &smTextureReductionLevel,
@@ -61,6 +70,14 @@ void GFXTextureManager::init()
       "as not allowing down scaling.\n"
       "@ingroup GFX\n" );
 
+   Con::addVariable( "$pref::Video::textureCachePath", TypeRealString, &smTextureCachePath,
+      "@brief The folder where compressed copies of the loaded textures are stored.\n\n"
+      "Textures whose profile requests BC1 to BC3 compression are converted to DDS "
+      "once and loaded from here afterwards.  This is opt-in per profile as none of "
+      "the stock material profiles request compression.  An empty string disables "
+      "the cache.\n"
+      "@ingroup GFX\n" );
+
    Con::addVariable( "$pref::Video::missingTexturePath", TypeRealString, &smMissingTexturePath,
       "The file path of the texture to display when the requested texture is missing.\n"
       "@ingroup GFX\n" );
@@ -631,6 +648,257 @@ GFXTextureObject *GFXTextureManager::_createTexture(  DDSFile *dds,
    return ret;
 }
 
+bool GFXTextureManager::_canCacheTexture( GFXTextureProfile *profile ) const
+{
+   if ( smTextureCachePath.isEmpty() || !GFX )
+      return false;
+
+   // We only compress to the formats ddsCompress handles and
+   // leave mipless textures to the normal path.
+   const GFXTextureProfile::Compression compression = profile->getCompression();
+   if (  compression < GFXTextureProfile::BC1 || 
+         compression > GFXTextureProfile::BC3 ||
+         profile->noMip() )
+      return false;
+
+   // The blocks are the same for gamma correct textures, the cache
+   // stores the linear format and _validateTexParams() swaps it.
+   GFXFormat fmt = GFXFormat( GFXFormatBC1 + ( compression - GFXTextureProfile::BC1 ) );
+   if ( profile->isSRGB() )
+      fmt = ImageUtil::toSRGBFormat( fmt );
+
+   bool autoGenMips = false;
+   return GFX->getCardProfiler()->checkFormat( fmt, profile, autoGenMips );
+}
+
+bool GFXTextureManager::_getTextureSourceHash( const Torque::Path &source, U64 *outHash )
+{
+   Torque::FS::FileNodeRef node = Torque::FS::GetFileNode( source );
+   if ( node == NULL )
+      return false;
+
+   TextureCacheKey key;
+   key.size = node->getSize();
+   key.modified = node->getModifiedTime().getInternalRepresentation();
+   key.hash = 0;
+
+   // Reuse the hash while the file size and time are unchanged.
+   const String sourcePath = source.getFullPath();
+   Map<String, TextureCacheKey>::Iterator iter = mTextureCacheKeys.find( sourcePath );
+   if ( iter != mTextureCacheKeys.end() && iter->value.size == key.size && iter->value.modified == key.modified )
+   {
+      *outHash = iter->value.hash;
+      return true;
+   }
+
+   // Else look for the key file from an earlier run.
+   const Torque::Path keyFile = getTextureCacheKeyFile( source );
+
+   FileStream stream;
+   if ( stream.open( keyFile, Torque::FS::File::Read ) )
+   {
+      char tag[4];
+      U64 size = 0, modified = 0, hash = 0;
+      if (  stream.read( 4, tag ) && dMemcmp( tag, sTextureCacheKeyTag, 4 ) == 0 &&
+            stream.read( &size ) && stream.read( &modified ) && stream.read( &hash ) &&
+            size == key.size && S64( modified ) == key.modified )
+         key.hash = hash;
+
+      stream.close();
+   }
+
+   // Hash the contents so that edits to the source are picked up
+   // even if the file time is older than the cache file.
+   if ( key.hash == 0 )
+   {
+      PROFILE_SCOPE( GFXTextureManager_HashTextureSource );
+
+      void *data = NULL;
+      U32 size = 0;
+      if ( !Torque::FS::ReadFile( source, data, size ) )
+         return false;
+
+      key.hash = Torque::hash64( (const U8*)data, size, 0 );
+      delete [] (char*)data;
+
+      if ( stream.open( keyFile, Torque::FS::File::Write ) )
+      {
+         stream.write( 4, sTextureCacheKeyTag );
+         stream.write( key.size );
+         stream.write( U64( key.modified ) );
+         stream.write( key.hash );
+         stream.close();
+      }
+   }
+
+   mTextureCacheKeys[ sourcePath ] = key;
+   *outHash = key.hash;
+   return true;
+}
+
+Torque::Path GFXTextureManager::getTextureCacheKeyFile( const Torque::Path &source )
+{
+   // Hash the same path which keys the in memory hashes.
+   const String sourcePath = source.getFullPath();
+   const U64 pathHash = Torque::hash64( (const U8*)sourcePath.c_str(), sourcePath.length(), 0 );
+
+   return String::ToString( "%s/%s_%s_%08x%08x.key", 
+      smTextureCachePath.c_str(), 
+      source.getFileName().c_str(),
+      source.getExtension().c_str(),
+      (U32)( pathHash >> 32 ), (U32)pathHash );
+}
+
+Torque::Path GFXTextureManager::getTextureCacheFile( const Torque::Path &source, GFXTextureProfile *profile )
+{
+   U64 hash;
+   if ( !_getTextureSourceHash( source, &hash ) )
+      return Torque::Path();
+
+   return String::ToString( "%s/%s_%s_%08x%08x_%x.dds", 
+      smTextureCachePath.c_str(), 
+      source.getFileName().c_str(),
+      source.getExtension().c_str(),
+      (U32)( hash >> 32 ), (U32)hash,
+      profile->getCompression() | ( profile->getType() << 8 ) );
+}
+
+bool GFXTextureManager::writeTextureCacheTrailer( Stream &stream, bool hasTransparency )
+{
+   return stream.write( (U8)hasTransparency ) && stream.write( 4, sTextureCacheTag );
+}
+
+bool GFXTextureManager::readTextureCacheTrailer( Stream &stream, bool *outHasTransparency )
+{
+   const U32 size = stream.getStreamSize();
+   char tag[4];
+   U8 hasTransparency = 0;
+   if (  size < 5 ||
+         !stream.setPosition( size - 5 ) ||
+         !stream.read( &hasTransparency ) ||
+         !stream.read( 4, tag ) ||
+         dMemcmp( tag, sTextureCacheTag, 4 ) != 0 )
+      return false;
+
+   *outHasTransparency = hasTransparency != 0;
+   return true;
+}
+
+bool GFXTextureManager::_writeTextureCacheFile( const Torque::Path &source, const Torque::Path &cacheFile, GFXTextureProfile *profile )
+{
+   PROFILE_SCOPE( GFXTextureManager_WriteTextureCacheFile );
+
+   Resource<GBitmap> bitmap = GBitmap::load( source );
+   if ( bitmap == NULL )
+      return false;
+
+   if (  !isPow2( bitmap->getWidth() ) || !isPow2( bitmap->getHeight() ) ||
+         (  bitmap->getFormat() != GFXFormatR8G8B8 && 
+            bitmap->getFormat() != GFXFormatR8G8B8A8 && 
+            bitmap->getFormat() != GFXFormatR8G8B8X8 ) )
+      return false;
+
+   // The resource is shared so work on a copy.
+   GBitmap *bmp = new GBitmap( *bitmap );
+   if ( bmp->getNumMipLevels() == 1 )
+      bmp->extrudeMipLevels( false );
+
+   DDSFile *dds = DDSFile::createDDSFileFromGBitmap( bmp );
+   const bool hasTransparency = bmp->getHasTransparency();
+   delete bmp;
+
+   if ( !dds )
+      return false;
+
+   if ( profile->getType() == GFXTextureProfile::NormalMap )
+   {
+      static DXT5nmSwizzle sDXT5nmSwizzle;
+      ImageUtil::swizzleDDS( dds, sDXT5nmSwizzle );
+   }
+
+   const GFXFormat fmt = GFXFormat( GFXFormatBC1 + ( profile->getCompression() - GFXTextureProfile::BC1 ) );
+   if ( !ImageUtil::ddsCompress( dds, fmt ) )
+   {
+      delete dds;
+      return false;
+   }
+
+   FileStream stream;
+   if ( !stream.open( cacheFile, Torque::FS::File::Write ) )
+   {
+      Con::errorf( "GFXTextureManager - failed to open texture cache file '%s'.", cacheFile.getFullPath().c_str() );
+      delete dds;
+      return false;
+   }
+
+   // The DDS header has nowhere to keep the transparency
+   // flag for compressed formats so tack it on the end.
+   bool success = dds->write( stream );
+   success &= writeTextureCacheTrailer( stream, hasTransparency );
+   delete dds;
+
+   return success;
+}
+
+GFXTextureObject *GFXTextureManager::_createCachedTexture(  const Torque::Path &source,
+                                                            const String &resourceName,
+                                                            GFXTextureProfile *profile )
+{
+   if ( !_canCacheTexture( profile ) )
+      return NULL;
+
+   PROFILE_SCOPE( GFXTextureManager_CreateCachedTexture );
+
+   const Torque::Path cacheFile = getTextureCacheFile( source, profile );
+   if ( cacheFile.isEmpty() )
+      return NULL;
+
+   if ( !Torque::FS::IsFile( cacheFile ) && !_writeTextureCacheFile( source, cacheFile, profile ) )
+      return NULL;
+
+   FileStream stream;
+   if ( !stream.open( cacheFile, Torque::FS::File::Read ) )
+      return NULL;
+
+   // Pull the transparency flag from the trailer.
+   bool hasTransparency = false;
+   if ( !readTextureCacheTrailer( stream, &hasTransparency ) )
+   {
+      Con::warnf( "GFXTextureManager - ignoring bad texture cache file '%s'.", cacheFile.getFullPath().c_str() );
+      return NULL;
+   }
+
+   stream.setPosition( 0 );
+   DDSFile *dds = new DDSFile;
+   if ( !dds->read( stream, getTextureDownscalePower( profile ) ) )
+   {
+      delete dds;
+      return NULL;
+   }
+
+   dds->mSourcePath = source;
+   dds->mCacheString = resourceName;
+   dds->mHasTransparency = hasTransparency;
+
+   return _createTexture( dds, profile, true, NULL );
+}
+
+bool GFXTextureManager::buildTextureCache( const Torque::Path &path, GFXTextureProfile *profile )
+{
+   if ( !_canCacheTexture( profile ) )
+      return false;
+
+   Torque::Path source;
+   if ( !GBitmap::sFindFile( validatePath( path ), &source ) )
+      return false;
+
+   const Torque::Path cacheFile = getTextureCacheFile( source, profile );
+   if ( cacheFile.isEmpty() )
+      return false;
+
+   return Torque::FS::IsFile( cacheFile ) || _writeTextureCacheFile( source, cacheFile, profile );
+}
+
 GFXTextureObject *GFXTextureManager::createTexture( const Torque::Path &path, GFXTextureProfile *profile )
 {
    PROFILE_SCOPE( GFXTextureManager_createTexture );
@@ -672,11 +940,17 @@ GFXTextureObject *GFXTextureManager::createTexture( const Torque::Path &path, GF
       }
       else // Let GBitmap take care of it
       {
-         bitmap = GBitmap::load( correctPath );
-         if( bitmap != NULL )
+         retTexObj = _createCachedTexture( correctPath, pathNoExt, profile );
+         if( retTexObj )
+            realPath = correctPath;
+         else
          {
-            realPath = bitmap.getPath();
-            retTexObj = createTexture( bitmap, pathNoExt, profile, false );
+            bitmap = GBitmap::load( correctPath );
+            if( bitmap != NULL )
+            {
+               realPath = bitmap.getPath();
+               retTexObj = createTexture( bitmap, pathNoExt, profile, false );
+            }
          }
       }      
    }
@@ -709,6 +983,18 @@ GFXTextureObject *GFXTextureManager::createTexture( const Torque::Path &path, GF
 
    // If we still don't have a texture object yet, feed the correctPath to GBitmap and
    // it will try a bunch of extensions
+   if( retTexObj == NULL )
+   {
+      // Use the compressed copy in the texture cache if we can.
+      Torque::Path sourcePath;
+      if( _canCacheTexture( profile ) && GBitmap::sFindFile( correctPath, &sourcePath ) )
+      {
+         retTexObj = _createCachedTexture( sourcePath, pathNoExt, profile );
+         if( retTexObj )
+            realPath = sourcePath;
+      }
+   }
+
    if( retTexObj == NULL )
    {
       // Find and load the texture.
@@ -1612,6 +1898,28 @@ DefineEngineFunction( flushTextureCache, void, (),,
    TEXMGR->resurrect();
 }
 
+DefineEngineFunction( buildTextureCache, bool, ( const char *path, const char *profileName ),,
+   "@brief Compresses a texture into the texture cache folder.\n\n"
+   "Call it from a build step to fill $pref::Video::textureCachePath so that "
+   "the first load of the texture doesn't need to compress it.\n\n"
+   "@param path The source texture.\n"
+   "@param profileName The name of the texture profile it will be loaded with.\n"
+   "@return True if the cache file exists or was written.\n\n"
+   "@ingroup GFX\n" )
+{
+   if ( !GFX || !TEXMGR )
+      return false;
+
+   GFXTextureProfile *profile = GFXTextureProfile::find( profileName );
+   if ( !profile )
+   {
+      Con::errorf( "buildTextureCache - Unknown texture profile '%s'.", profileName );
+      return false;
+   }
+
+   return TEXMGR->buildTextureCache( path, profile );
+}
+
 DefineEngineFunction( cleanupTexturePool, void, (),,
    "Release the unused pooled textures in texture manager freeing up video memory.\n"
    "@ingroup GFX\n" )
@@ -49,6 +49,8 @@ namespace Torque
    class Path;
 }
 
+class Stream;
+
 class GFXCubemap;
 
 
@@ -194,6 +196,35 @@ public:
    void releaseCubemap( GFXCubemap *cubemap );
 
    void splitTerrainMaps(const Torque::Path& path);
+
+   /// Converts a source texture to a compressed DDS in the texture
+   /// cache folder so that later loads skip the compression step.
+   ///
+   /// @return True if the cache file exists or was written.
+   bool buildTextureCache( const Torque::Path &path, GFXTextureProfile *profile );
+
+   /// Returns the cache file for a source texture which is named
+   /// from a hash of the source data and the profile.
+   ///
+   /// The hash is only computed again when the size or modified time
+   /// of the source changes.  It is kept in memory and in a key file
+   /// next to the cache files so that it survives restarts.
+   Torque::Path getTextureCacheFile( const Torque::Path &source, GFXTextureProfile *profile );
+
+   /// Returns the key file which holds the hash of a source texture.
+   ///
+   /// It is named from a hash of the full source path so that
+   /// sources with the same name in different folders don't
+   /// share a key file.
+   static Torque::Path getTextureCacheKeyFile( const Torque::Path &source );
+
+   /// Appends the trailer which follows the DDS data in a cache file.
+   static bool writeTextureCacheTrailer( Stream &stream, bool hasTransparency );
+
+   /// Reads the trailer at the end of a cache file.
+   /// @return False if the stream doesn't end in a valid trailer.
+   static bool readTextureCacheTrailer( Stream &stream, bool *outHasTransparency );
+
 public:
    /// The amount of texture mipmaps to skip when loading a
    /// texture that allows downscaling.
@@ -204,6 +235,17 @@ public:
    /// 
    static S32 smTextureReductionLevel;
 
+   /// The folder where compressed copies of source textures are cached
+   /// or an empty string to disable the cache.
+   ///
+   /// The cache is opt-in per profile.  Only profiles which request
+   /// BC1 to BC3 compression and have mips use it, and none of the
+   /// stock material profiles do.
+   ///
+   /// Exposed to script via $pref::Video::textureCachePath.
+   ///
+   static String smTextureCachePath;
+
 protected:
 
    /// File path to the missing texture
@@ -275,6 +317,35 @@ protected:
                                        bool deleteDDS,
                                        GFXTextureObject *inObj );
 
+   /// Returns true if textures of this profile are
+   /// compressed and can be stored in the texture cache.
+   bool _canCacheTexture( GFXTextureProfile *profile ) const;
+
+   /// The hash of a source texture and the file
+   /// size and time it was computed for.
+   struct TextureCacheKey
+   {
+      U64 size;
+      S64 modified;
+      U64 hash;
+   };
+
+   /// The source texture hashes keyed by the source path.
+   Map<String, TextureCacheKey> mTextureCacheKeys;
+
+   /// Returns the hash of the source texture data.
+   bool _getTextureSourceHash( const Torque::Path &source, U64 *outHash );
+
+   /// Loads the source bitmap, generates the mips, compresses
+   /// it and writes the result to the cache file.
+   bool _writeTextureCacheFile( const Torque::Path &source, const Torque::Path &cacheFile, GFXTextureProfile *profile );
+
+   /// Creates the texture from the cached DDS of the source
+   /// texture, building the cache file first if needed.
+   GFXTextureObject *_createCachedTexture(   const Torque::Path &source,
+                                             const String &resourceName,
+                                             GFXTextureProfile *profile );
+
    /// Frees the API handles to the texture, for D3D this is a release call
    ///
    /// @note freeTexture MUST NOT DELETE THE TEXTURE OBJECT
@@ -0,0 +1,281 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026 tgemit contributors.
+// See AUTHORS file and git repository for contributor information.
+//
+// SPDX-License-Identifier: MIT
+//-----------------------------------------------------------------------------
+
+#include "platform/platform.h"
+#include "gfx/gfxTransientBufferPool.h"
+
+#include "gfx/gfxFence.h"
+#include "console/console.h"
+#include "platform/profiler.h"
+
+
+U32 GFXTransientBufferPool::smMaxIdleFrames = 300;
+
+
+GFXTransientBufferPool::GFXTransientBufferPool( GFXDevice *device )
+   :  mDevice( device ),
+      mUseFences( false ),
+      mFrame( 0 ),
+      mTotalBuffers( 0 ),
+      mTotalBytes( 0 )
+{
+   // Only use fences if we can poll them... the general
+   // fallback fence stalls every time it is issued.
+   GFXFence *fence = mDevice->createFence();
+   if ( fence && fence->getStatus() != GFXFence::Unsupported )
+   {
+      mUseFences = true;
+      mSlots[0].fence = fence;
+      for ( U32 i = 1; i < FramesInFlight; i++ )
+         mSlots[i].fence = mDevice->createFence();
+   }
+   else
+      delete fence;
+
+   GFXDevice::getDeviceEventSignal().notify( this, &GFXTransientBufferPool::_handleGFXEvent );
+}
+
+GFXTransientBufferPool::~GFXTransientBufferPool()
+{
+   GFXDevice::getDeviceEventSignal().remove( this, &GFXTransientBufferPool::_handleGFXEvent );
+
+   // The device is going away so there is nothing to wait on.
+   for ( U32 i = 0; i < FramesInFlight; i++ )
+   {
+      _retireSlot( mSlots[i], false );
+      SAFE_DELETE( mSlots[i].fence );
+   }
+
+   mFreeVBs.merge( mUsedVBs );
+   mUsedVBs.clear();
+   mFreePBs.merge( mUsedPBs );
+   mUsedPBs.clear();
+
+   _releaseIdle( true );
+}
+
+U32 GFXTransientBufferPool::getBucketSize( U32 count )
+{
+   return getMax( getNextPow2( count ), MinBucketSize );
+}
+
+GFXTransientVertexBuffer* GFXTransientBufferPool::allocVertexBuffer( U32 numVerts,
+                                                                     const GFXVertexFormat *vertexFormat,
+                                                                     U32 vertexSize )
+{
+   AssertFatal( numVerts > 0, "GFXTransientBufferPool::allocVertexBuffer - Got zero vertices!" );
+
+   const U32 size = getBucketSize( numVerts );
+
+   mStats.allocs++;
+   mStats.requestedBytes += numVerts * vertexSize;
+   mStats.allocatedBytes += size * vertexSize;
+
+   // Look for a free one of the same size and format
+   // starting with the most recently used.
+   VertexBufferEntry *entry = NULL;
+   for ( S32 i = mFreeVBs.size() - 1; i >= 0; i-- )
+   {
+      GFXVertexBuffer *vb = mFreeVBs[i]->handle.getPointer();
+      if (  mFreeVBs[i]->size == size &&
+            vb->mVertexSize == vertexSize &&
+            vb->mVertexFormat.isEqual( *vertexFormat ) )
+      {
+         entry = mFreeVBs[i];
+         mFreeVBs.erase_fast( i );
+         break;
+      }
+   }
+
+   if ( entry )
+      mStats.reused++;
+   else
+   {
+      entry = new VertexBufferEntry;
+      entry->size = size;
+      entry->handle.set( mDevice, size, vertexFormat, vertexSize, GFXBufferTypeDynamic );
+
+      mStats.created++;
+      mTotalBuffers++;
+      mTotalBytes += size * vertexSize;
+   }
+
+   entry->lastUsed = mFrame;
+   mUsedVBs.push_back( entry );
+   return &entry->handle;
+}
+
+GFXPrimitiveBufferHandle* GFXTransientBufferPool::allocPrimitiveBuffer( U32 numIndices )
+{
+   AssertFatal( numIndices > 0, "GFXTransientBufferPool::allocPrimitiveBuffer - Got zero indices!" );
+
+   const U32 size = getBucketSize( numIndices );
+
+   mStats.allocs++;
+   mStats.requestedBytes += numIndices * sizeof( U16 );
+   mStats.allocatedBytes += size * sizeof( U16 );
+
+   PrimitiveBufferEntry *entry = NULL;
+   for ( S32 i = mFreePBs.size() - 1; i >= 0; i-- )
+   {
+      if ( mFreePBs[i]->size == size )
+      {
+         entry = mFreePBs[i];
+         mFreePBs.erase_fast( i );
+         break;
+      }
+   }
+
+   if ( entry )
+      mStats.reused++;
+   else
+   {
+      entry = new PrimitiveBufferEntry;
+      entry->size = size;
+      entry->handle.set( mDevice, size, 0, GFXBufferTypeDynamic );
+
+      mStats.created++;
+      mTotalBuffers++;
+      mTotalBytes += size * sizeof( U16 );
+   }
+
+   entry->lastUsed = mFrame;
+   mUsedPBs.push_back( entry );
+   return &entry->handle;
+}
+
+void GFXTransientBufferPool::endFrame()
+{
+   PROFILE_SCOPE( GFXTransientBufferPool_endFrame );
+
+   // The slot for this frame was retired when it got
+   // FramesInFlight frames old at the end of the last frame.
+   FrameSlot &slot = mSlots[ mFrame % FramesInFlight ];
+   AssertFatal( slot.isEmpty(), "GFXTransientBufferPool::endFrame - The frame slot is still in use!" );
+
+   if ( !mUsedVBs.empty() || !mUsedPBs.empty() )
+   {
+      slot.vbs.merge( mUsedVBs );
+      mUsedVBs.clear();
+      slot.pbs.merge( mUsedPBs );
+      mUsedPBs.clear();
+      slot.frame = mFrame;
+
+      if ( mUseFences )
+      {
+         slot.fence->issue();
+         slot.fenced = true;
+      }
+   }
+
+   mFrame++;
+
+   // Return the buffers the GPU is done with.
+   for ( U32 i = 0; i < FramesInFlight; i++ )
+   {
+      FrameSlot &current = mSlots[i];
+      if ( current.isEmpty() )
+         continue;
+
+      if ( mFrame - current.frame >= FramesInFlight )
+         _retireSlot( current, true );
+      else if ( current.fenced && current.fence->getStatus() == GFXFence::Processed )
+         _retireSlot( current, false );
+   }
+
+   _releaseIdle( false );
+   _exportStats();
+}
+
+void GFXTransientBufferPool::_retireSlot( FrameSlot &slot, bool wait )
+{
+   if ( slot.fenced )
+   {
+      if ( wait && slot.fence->getStatus() == GFXFence::Pending )
+      {
+         PROFILE_SCOPE( GFXTransientBufferPool_waitOnFence );
+         slot.fence->block();
+         mStats.fenceWaits++;
+      }
+
+      slot.fenced = false;
+   }
+
+   mFreeVBs.merge( slot.vbs );
+   slot.vbs.clear();
+
+   mFreePBs.merge( slot.pbs );
+   slot.pbs.clear();
+}
+
+void GFXTransientBufferPool::releaseFree()
+{
+   for ( U32 i = 0; i < FramesInFlight; i++ )
+      _retireSlot( mSlots[i], true );
+
+   _releaseIdle( true );
+}
+
+void GFXTransientBufferPool::_releaseIdle( bool all )
+{
+   for ( S32 i = mFreeVBs.size() - 1; i >= 0; i-- )
+   {
+      VertexBufferEntry *entry = mFreeVBs[i];
+      if ( !all && mFrame - entry->lastUsed <= smMaxIdleFrames )
+         continue;
+
+      mTotalBuffers--;
+      mTotalBytes -= entry->size * entry->handle->mVertexSize;
+      mStats.released++;
+
+      mFreeVBs.erase_fast( i );
+      delete entry;
+   }
+
+   for ( S32 i = mFreePBs.size() - 1; i >= 0; i-- )
+   {
+      PrimitiveBufferEntry *entry = mFreePBs[i];
+      if ( !all && mFrame - entry->lastUsed <= smMaxIdleFrames )
+         continue;
+
+      mTotalBuffers--;
+      mTotalBytes -= entry->size * sizeof( U16 );
+      mStats.released++;
+
+      mFreePBs.erase_fast( i );
+      delete entry;
+   }
+}
+
+void GFXTransientBufferPool::_exportStats()
+{
+   mStats.totalBuffers = mTotalBuffers;
+   mStats.freeBuffers = mFreeVBs.size() + mFreePBs.size();
+   mStats.totalBytes = mTotalBytes;
+
+   mLastStats = mStats;
+   mStats.clear();
+
+   Con::setIntVariable( "$GFXTransientBuffers::allocs", mLastStats.allocs );
+   Con::setIntVariable( "$GFXTransientBuffers::created", mLastStats.created );
+   Con::setIntVariable( "$GFXTransientBuffers::reused", mLastStats.reused );
+   Con::setIntVariable( "$GFXTransientBuffers::released", mLastStats.released );
+   Con::setIntVariable( "$GFXTransientBuffers::fenceWaits", mLastStats.fenceWaits );
+   Con::setIntVariable( "$GFXTransientBuffers::requestedBytes", mLastStats.requestedBytes );
+   Con::setIntVariable( "$GFXTransientBuffers::allocatedBytes", mLastStats.allocatedBytes );
+   Con::setIntVariable( "$GFXTransientBuffers::totalBuffers", mLastStats.totalBuffers );
+   Con::setIntVariable( "$GFXTransientBuffers::freeBuffers", mLastStats.freeBuffers );
+   Con::setIntVariable( "$GFXTransientBuffers::totalBytes", mLastStats.totalBytes );
+}
+
+bool GFXTransientBufferPool::_handleGFXEvent( GFXDevice::GFXDeviceEventType event )
+{
+   if ( event == GFXDevice::deEndOfFrame )
+      endFrame();
+
+   return true;
+}
@@ -0,0 +1,205 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026 tgemit contributors.
+// See AUTHORS file and git repository for contributor information.
+//
+// SPDX-License-Identifier: MIT
+//-----------------------------------------------------------------------------
+
+#ifndef _GFXTRANSIENTBUFFERPOOL_H_
+#define _GFXTRANSIENTBUFFERPOOL_H_
+
+#ifndef _GFXDEVICE_H_
+#include "gfx/gfxDevice.h"
+#endif
+#ifndef _GFXVERTEXBUFFER_H_
+#include "gfx/gfxVertexBuffer.h"
+#endif
+#ifndef _GFXPRIMITIVEBUFFER_H_
+#include "gfx/gfxPrimitiveBuffer.h"
+#endif
+
+class GFXFence;
+
+
+/// A vertex buffer handle handed out by the GFXTransientBufferPool.
+///
+/// It is a plain GFXVertexBufferHandleBase so it can be passed into
+/// render instances, but allows locking without knowing the vertex type.
+class GFXTransientVertexBuffer : public GFXVertexBufferHandleBase
+{
+   friend class GFXTransientBufferPool;
+
+public:
+
+   /// Locks the vertices for writing.
+   template<class T>
+   T* lock( U32 vertexStart = 0, U32 vertexEnd = 0 )
+   {
+      AssertFatal( getPointer()->mVertexSize == sizeof( T ), "GFXTransientVertexBuffer::lock - Wrong vertex type!" );
+      return (T*)GFXVertexBufferHandleBase::lock( vertexStart, vertexEnd );
+   }
+
+   void unlock() { GFXVertexBufferHandleBase::unlock(); }
+};
+
+
+/// A pool of dynamic vertex and primitive buffers for geometry which
+/// is rebuilt every frame, like decal batches and particles.
+///
+/// Buffers are handed out for the rest of the frame only.  At the end
+/// of the frame they are held until the GPU is done with them and then
+/// go back to the pool to be reused by any system asking for the same
+/// vertex format and a similar size.  A fence is issued for each frame
+/// when the device supports querying them, else buffers are held for
+/// a fixed number of frames.
+///
+/// Sizes are rounded up to the next power of two so that requests which
+/// vary a little each frame keep hitting the same buffers.  Whole buffers
+/// are pooled rather than sub-allocated as locking a dynamic buffer
+/// discards its previous content on some devices.
+///
+/// The device owns one pool which you get from GFXDevice::getTransientBufferPool().
+class GFXTransientBufferPool
+{
+public:
+
+   /// The number of frames a buffer is held after use when
+   /// the device cannot tell us when the GPU is done with it.
+   static const U32 FramesInFlight = 3;
+
+   /// The smallest buffer size in vertices or indices.
+   static const U32 MinBucketSize = 64;
+
+   /// Free buffers not used for this many frames are released.
+   static U32 smMaxIdleFrames;
+
+   /// Utilization statistics for a frame.
+   struct Stats
+   {
+      /// The number of buffers handed out.
+      U32 allocs;
+
+      /// The number of allocations which had to create a new buffer.
+      U32 created;
+
+      /// The number of allocations which reused a pooled buffer.
+      U32 reused;
+
+      /// The number of free buffers released for being idle.
+      U32 released;
+
+      /// The number of times we had to wait on the GPU.
+      U32 fenceWaits;
+
+      /// The bytes asked for versus the bytes in the buffers handed out.
+      U32 requestedBytes;
+      U32 allocatedBytes;
+
+      /// The buffers held by the pool at the end of the frame.
+      U32 totalBuffers;
+      U32 freeBuffers;
+      U32 totalBytes;
+
+      Stats() { clear(); }
+      void clear() { dMemset( this, 0, sizeof( Stats ) ); }
+   };
+
+   GFXTransientBufferPool( GFXDevice *device );
+   ~GFXTransientBufferPool();
+
+   /// Returns a dynamic vertex buffer of at least numVerts vertices
+   /// which is valid until the end of the frame.
+   GFXTransientVertexBuffer* allocVertexBuffer( U32 numVerts,
+                                                const GFXVertexFormat *vertexFormat,
+                                                U32 vertexSize );
+
+   template<class T>
+   GFXTransientVertexBuffer* allocVertexBuffer( U32 numVerts )
+   {
+      return allocVertexBuffer( numVerts, getGFXVertexFormat<T>(), sizeof( T ) );
+   }
+
+   /// Returns a dynamic primitive buffer of at least numIndices
+   /// indices which is valid until the end of the frame.
+   GFXPrimitiveBufferHandle* allocPrimitiveBuffer( U32 numIndices );
+
+   /// Retires the buffers used this frame and returns the ones
+   /// the GPU is done with to the pool.
+   ///
+   /// This is called for you on GFXDevice::deEndOfFrame.
+   void endFrame();
+
+   /// Waits on the GPU and releases every buffer not in use this frame.
+   void releaseFree();
+
+   /// Returns the stats of the last completed frame.
+   const Stats& getStats() const { return mLastStats; }
+
+   /// Returns the number of frames completed.
+   U32 getFrame() const { return mFrame; }
+
+   /// Returns the size of the buffer used for the count.
+   static U32 getBucketSize( U32 count );
+
+protected:
+
+   struct VertexBufferEntry
+   {
+      GFXTransientVertexBuffer handle;
+      U32 size;
+      U32 lastUsed;
+   };
+
+   struct PrimitiveBufferEntry
+   {
+      GFXPrimitiveBufferHandle handle;
+      U32 size;
+      U32 lastUsed;
+   };
+
+   /// The buffers used in a frame the GPU may still be reading.
+   struct FrameSlot
+   {
+      Vector<VertexBufferEntry*> vbs;
+      Vector<PrimitiveBufferEntry*> pbs;
+      GFXFence *fence;
+      bool fenced;
+      U32 frame;
+
+      FrameSlot() : fence( NULL ), fenced( false ), frame( 0 ) {}
+      bool isEmpty() const { return vbs.empty() && pbs.empty(); }
+   };
+
+   GFXDevice *mDevice;
+
+   /// Is false if the device fences cannot be queried.
+   bool mUseFences;
+
+   U32 mFrame;
+
+   Vector<VertexBufferEntry*> mFreeVBs;
+   Vector<VertexBufferEntry*> mUsedVBs;
+
+   Vector<PrimitiveBufferEntry*> mFreePBs;
+   Vector<PrimitiveBufferEntry*> mUsedPBs;
+
+   FrameSlot mSlots[FramesInFlight];
+
+   U32 mTotalBuffers;
+   U32 mTotalBytes;
+
+   Stats mStats;
+   Stats mLastStats;
+
+   /// Returns the slot buffers to the pool waiting on the GPU if needed.
+   void _retireSlot( FrameSlot &slot, bool wait );
+
+   /// Releases free buffers idle for too long.
+   void _releaseIdle( bool all );
+
+   void _exportStats();
+
+   bool _handleGFXEvent( GFXDevice::GFXDeviceEventType event );
+};
+
+#endif // _GFXTRANSIENTBUFFERPOOL_H_
@@ -148,9 +148,19 @@ void GFXGLShaderConstBuffer::internalSet(GFXShaderConstHandle* handle, const Con
    U8* buf = basePointer + _glHandle->mDesc.offset;
 
    if (_glHandle->mInstancingConstant)
-      buf = mInstPtr + _glHandle->mDesc.offset;
+   {
+      dMemcpy(mInstPtr + _glHandle->mDesc.offset, &param, sizeof(ConstType));
+      return;
+   }
 
    dMemcpy(buf, &param, sizeof(ConstType));
+   _markDirty(_glHandle, sizeof(ConstType));
+}
+
+void GFXGLShaderConstBuffer::_markDirty(const GFXGLShaderConstHandle* handle, U32 size)
+{
+   const S32 bufferKey = handle->mUBOUniform ? handle->mDesc.bindPoint : -1;
+   mBufferMap[bufferKey].dirty.add(handle->mDesc.offset, size);
 }
 
 GFXShader* GFXGLShaderConstBuffer::getShader()
@@ -235,6 +245,8 @@ void GFXGLShaderConstBuffer::internalSet(GFXShaderConstHandle* handle, const Ali
       dMemcpy(basePointer + _glHandle->mDesc.offset + i * sizeof(ConstType), fvBuffer, sizeof(ConstType));
       fvBuffer += fv.getElementSize();
    }
+
+   _markDirty(_glHandle, fv.size() * sizeof(ConstType));
 }
 
 void GFXGLShaderConstBuffer::set(GFXShaderConstHandle* handle, const AlignedArray<F32>& fv)
@@ -334,8 +346,10 @@ void GFXGLShaderConstBuffer::set(GFXShaderConstHandle* handle, const MatrixF& ma
    }
    default:
       AssertFatal(false, "GFXGLShaderConstBuffer::set - Invalid matrix type");
-      break;
+      return;
    }
+
+   _markDirty(_glHandle, shaderConstTypeSize(matType));
 }
 
 void GFXGLShaderConstBuffer::set(GFXShaderConstHandle* handle, const MatrixF* mat, const U32 arraySize, const GFXShaderConstType matrixType)
@@ -364,9 +378,11 @@ void GFXGLShaderConstBuffer::set(GFXShaderConstHandle* handle, const MatrixF* ma
       {
          dMemcpy(basePointer + _glHandle->mDesc.offset + (i * (sizeof(F32) * 12)), (F32*)(mat + i), sizeof(F32) * 12);
       }
+      _markDirty(_glHandle, arraySize * sizeof(F32) * 12);
       break;
    case GFXSCT_Float4x4:
       dMemcpy(basePointer + _glHandle->mDesc.offset, (F32*)mat, _glHandle->getSize());
+      _markDirty(_glHandle, _glHandle->getSize());
       break;
    default:
       AssertFatal(false, "GFXGLShaderConstBuffer::set - setting array of non 4x4 matrices!");
@@ -378,57 +394,47 @@ void GFXGLShaderConstBuffer::activate(GFXGLShaderConstBuffer* prevShaderBuffer)
 {
    PROFILE_SCOPE(GFXGLShaderConstBuffer_activate);
 
+   GFXDeviceStatistics* stats = GFXGL->getDeviceStatistics();
+
    for (BufferMap::Iterator i = mBufferMap.begin(); i != mBufferMap.end(); ++i)
    {
       const S32 thisBufferDesc = i->key;
+      ConstantBuffer& thisBuff = i->value;
 
       // set the global buffer differently
       if (thisBufferDesc == -1)
       {
-         mShader->setConstantsFromBuffer(mBufferMap[-1].data);
+         // The program keeps its uniforms, so if we set them last
+         // only a write since then can have changed anything.
+         if (mShader->mGlobalConstSource != thisBuff.data || !thisBuff.dirty.isEmpty())
+         {
+            stats->mShaderConstBytes += mShader->setConstantsFromBuffer(thisBuff.data);
+            mShader->mGlobalConstSource = thisBuff.data;
+            thisBuff.dirty.clear();
+         }
          continue;
       }
 
-      ConstantBuffer thisBuff = i->value;
+      if (!thisBuff.data)
+         continue;
 
-      if (prevShaderBuffer && prevShaderBuffer != this)
+      // The device buffer is shared with every other shader using
+      // it, so the mirror works out what actually needs sending.
+      U32 uploadStart, uploadEnd;
+      if (thisBuff.mirror->update(thisBuff.data, thisBuff.data, thisBuff.size, thisBuff.dirty, &uploadStart, &uploadEnd))
       {
-         const ConstantBuffer prevBuffer = prevShaderBuffer->mBufferMap[i->key];
+         glBindBuffer(GL_UNIFORM_BUFFER, thisBuff.bufHandle);
 
-         if (prevBuffer.data && !prevBuffer.isDirty)
-         {
-            if (prevBuffer.size != thisBuff.size)
-            {
-               thisBuff.isDirty = true;
-            }
-            else
-            {
-               if (dMemcmp(prevBuffer.data, thisBuff.data, thisBuff.size) != 0)
-               {
-                  thisBuff.isDirty = true;
-               }
-               else
-               {
-                  thisBuff.isDirty = false;
-               }
-            }
-         }
+         // The first upload allocates the storage.
+         if (uploadStart == 0 && uploadEnd == thisBuff.size)
+            glBufferData(GL_UNIFORM_BUFFER, thisBuff.size, thisBuff.data, GL_DYNAMIC_DRAW);
          else
-         {
-            thisBuff.isDirty = true;
-         }
-      }
-      else
-      {
-         thisBuff.isDirty = true;
-      }
+            glBufferSubData(GL_UNIFORM_BUFFER, uploadStart, uploadEnd - uploadStart, thisBuff.data + uploadStart);
 
-      if (thisBuff.data && thisBuff.isDirty)
-      {
-         glBindBuffer(GL_UNIFORM_BUFFER, thisBuff.bufHandle);
-         glBufferData(GL_UNIFORM_BUFFER, thisBuff.size, thisBuff.data, GL_DYNAMIC_DRAW);
-         glBindBufferBase(GL_UNIFORM_BUFFER, thisBufferDesc, thisBuff.bufHandle);
+         stats->mShaderConstBytes += uploadEnd - uploadStart;
       }
+
+      glBindBufferBase(GL_UNIFORM_BUFFER, thisBufferDesc, thisBuff.bufHandle);
    }
 
    mWasLost = false;
@@ -445,6 +451,8 @@ void GFXGLShaderConstBuffer::addBuffer(const GFXShaderConstDesc desc)
       mBufferMap[-1].data = buf;
       mBufferMap[-1].size = desc.size;
       mBufferMap[-1].isDirty = true;
+      mBufferMap[-1].dirty.add(0, desc.size);
+      mBufferMap[-1].mirror = NULL;
    }
    else
    {
@@ -453,8 +461,10 @@ void GFXGLShaderConstBuffer::addBuffer(const GFXShaderConstDesc desc)
       mBufferMap[desc.bindPoint].data = buf;
       mBufferMap[desc.bindPoint].size = desc.size;
       mBufferMap[desc.bindPoint].isDirty = true;
+      mBufferMap[desc.bindPoint].dirty.add(0, desc.size);
 
       mBufferMap[desc.bindPoint].bufHandle = GFXGL->getDeviceBuffer(desc);
+      mBufferMap[desc.bindPoint].mirror = GFXGL->getShaderConstMirror(desc);
    }
 }
 
@@ -487,7 +497,8 @@ GFXGLShader::GFXGLShader(GFXGLDevice* device) :
    mGeometryShader(0),
    mProgram(0),
    mDevice(device),
-   mGlobalConstBuffer(NULL)
+   mGlobalConstBuffer(NULL),
+   mGlobalConstSource(NULL)
 {
 }
 
@@ -939,6 +950,8 @@ void GFXGLShader::initHandles()
 
    if (mGlobalConstBuffer)
       delete[] mGlobalConstBuffer;
+   mGlobalConstBuffer = NULL;
+   mGlobalConstSource = NULL;
 
    for (HandleMap::Iterator iter = mHandles.begin(); iter != mHandles.end(); ++iter)
    {
@@ -1077,8 +1090,10 @@ GFXShaderConstHandle* GFXGLShader::findShaderConstHandle(const String& name)
    }
 }
 
-void GFXGLShader::setConstantsFromBuffer(U8* buffer)
+U32 GFXGLShader::setConstantsFromBuffer(U8* buffer)
 {
+   U32 bytes = 0;
+
    for (HandleMap::Iterator i = mHandles.begin(); i != mHandles.end(); ++i)
    {
       GFXGLShaderConstHandle* handle = i->value;
@@ -1096,6 +1111,7 @@ void GFXGLShader::setConstantsFromBuffer(U8* buffer)
 
       // Copy new value into our const buffer and set in GL.
       dMemcpy(mGlobalConstBuffer + handle->mDesc.offset, buffer + handle->mDesc.offset, handle->getSize());
+      bytes += handle->getSize();
 
       switch (handle->mDesc.constType)
       {
@@ -1150,6 +1166,8 @@ void GFXGLShader::setConstantsFromBuffer(U8* buffer)
       }
 
    }
+
+   return bytes;
 }
 
 GFXShaderConstBufferRef GFXGLShader::allocConstBuffer()
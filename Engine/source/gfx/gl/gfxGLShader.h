@@ -28,6 +28,7 @@
 #include "gfx/gl/tGL/tGL.h"
 #include "core/util/tSignal.h"
 #include "core/util/tDictionary.h"
+#include "gfx/gfxShaderConstMirror.h"
 
 class FileStream;
 class GFXGLDevice;
@@ -53,6 +54,13 @@ struct ConstantBuffer
    U8* data;
    U32 size;
    bool isDirty;
+
+   /// The range written since the last upload.
+   GFXShaderConstDirtyRange dirty;
+
+   /// The mirror of the shared device buffer, NULL
+   /// for the global uniforms.
+   GFXShaderConstMirror* mirror;
 };
 
 class GFXGLShaderConstHandle : public GFXShaderConstHandle
@@ -156,6 +164,9 @@ private:
 
    template<typename ConstType>
    void internalSet(GFXShaderConstHandle* handle, const AlignedArray<ConstType>& fv);
+
+   /// Marks the bytes written for a constant as dirty.
+   void _markDirty(const GFXGLShaderConstHandle* handle, U32 size);
 };
 
 class GFXGLShader : public GFXShader
@@ -205,7 +216,10 @@ protected:
 
    void initConstantDescs();
    void initHandles();
-   void setConstantsFromBuffer(U8* buffer);
+
+   /// Sets the global uniforms which differ from the buffer.
+   /// @return The number of bytes set.
+   U32 setConstantsFromBuffer(U8* buffer);
 
    static char* _handleIncludes(const Torque::Path& path, FileStream* s);
 
@@ -224,6 +238,9 @@ protected:
 
    U8* mGlobalConstBuffer;
 
+   /// The buffer data which last set the global uniforms.
+   const U8* mGlobalConstSource;
+
    Vector<GFXShaderConstDesc> mShaderConsts;
 
    HandleMap mHandles;
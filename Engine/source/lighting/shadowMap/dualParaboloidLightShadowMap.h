@@ -35,6 +35,7 @@ public:
    DualParaboloidLightShadowMap( LightInfo *light );
 
    void _render( RenderPassManager* renderPass, const SceneRenderState *diffuseState ) override;
+   U32 _getBestTexSize() const override { return getBestTexSize( 2 ); }
 };
 
 #endif // _DUALPARABOLOIDLIGHTSHADOWMAP_H_
\ No newline at end of file
@@ -43,6 +43,7 @@
 #include "math/mathIO.h"
 #include "materials/shaderData.h"
 #include "core/module.h"
+#include "T3D/objectTypes.h"
 
 // Used for creation in ShadowMapParams::getOrCreateShadowMap()
 #include "lighting/shadowMap/singleLightShadowMap.h"
@@ -61,6 +62,7 @@ const GFXFormat LightShadowMap::ShadowMapFormat = GFXFormatR32F; // GFXFormatR8G
 
 bool LightShadowMap::smDebugRenderFrustums;
 F32 LightShadowMap::smShadowTexScalar = 1.0f;
+bool LightShadowMap::smCacheShadows = true;
 
 Vector<LightShadowMap*> LightShadowMap::smUsedShadowMaps;
 Vector<LightShadowMap*> LightShadowMap::smShadowMaps;
@@ -89,7 +91,9 @@ LightShadowMap::LightShadowMap( LightInfo *light )
       mIsViewDependent( false ),
       mLastCull( 0 ),
       mLastScreenSize( 0.0f ),
-      mLastPriority( 0.0f )
+      mLastPriority( 0.0f ),
+      mLastUpdateFrame( 0 ),
+      mDynamicCasters( 0 )
 {
    GFXTextureManager::addEventDelegate( this, &LightShadowMap::_onTextureEvent );
 
@@ -117,6 +121,18 @@ void LightShadowMap::releaseAllTextures()
       smShadowMaps[i]->releaseTextures();
 }
 
+void LightShadowMap::markStaticCastersDirty( const Box3F &box )
+{
+   PROFILE_SCOPE( LightShadowMap_MarkStaticCastersDirty );
+
+   for ( U32 i=0; i < smShadowMaps.size(); i++ )
+   {
+      LightShadowMap *lsm = smShadowMaps[i];
+      if ( lsm->mCache.isValid() && lsm->getLightBounds().isOverlapped( box ) )
+         lsm->mCache.invalidate();
+   }
+}
+
 U32 LightShadowMap::releaseUnusedTextures()
 {
    PROFILE_SCOPE( LightShadowMap_ReleaseUnusedTextures );
@@ -238,6 +254,7 @@ void LightShadowMap::calcLightMatrices( MatrixF &outLightMatrix, const Frustum &
 
 void LightShadowMap::releaseTextures()
 {
+   mCache.invalidate();
    mShadowMapTex = NULL;
    mDebugTarget.setTexture( NULL );
    smUsedShadowMaps.remove( this );
@@ -306,6 +323,13 @@ void LightShadowMap::render(RenderPassManager* renderPass, const SceneRenderStat
    _render( renderPass, diffuseState );
    mDebugTarget.setTexture( mShadowMapTex );
 
+   // Remember what we rendered with so that the
+   // next frame can reuse the map.
+   if ( smCacheShadows && !isViewDependent() && hasShadowTex() )
+      mCache.update( mLight, mTexSize, mDynamicCasters );
+   else
+      mCache.invalidate();
+
    // Add it to the used list unless we're been updated.
    //AssertFatal( !smUsedShadowMaps.contains( this ), "LightShadowMap::render - Used shadow map inserted twice!" );
    if(!smUsedShadowMaps.contains(this))
@@ -400,6 +424,147 @@ void LightShadowMap::updatePriority( const SceneRenderState *state, U32 currTime
    mLastPriority *= mLight->getPriority();
 }
 
+bool LightShadowMap::needsRender( const SceneRenderState *diffuseState )
+{
+   PROFILE_SCOPE( LightShadowMap_needsRender );
+
+   mDynamicCasters = 0;
+
+   if ( !smCacheShadows || isViewDependent() )
+   {
+      mCache.invalidate();
+      return true;
+   }
+
+   // Only the casters which can move or animate are culled
+   // each frame... the static ones dirty the cache thru
+   // markStaticCastersDirty() when they change.
+   SceneManager *sceneManager = diffuseState->getSceneManager();
+   if ( sceneManager )
+   {
+      Vector<SceneObject*> casters;
+      sceneManager->getContainer()->findObjectList( getLightBounds(), SHADOW_TYPEMASK, &casters );
+
+      for ( U32 i=0; i < casters.size(); i++ )
+      {
+         if ( !casters[i]->isStaticGeometry() )
+            mDynamicCasters++;
+      }
+   }
+
+   if ( !hasShadowTex() )
+      return true;
+
+   return mCache.needsUpdate( mLight, _getBestTexSize(), mDynamicCasters );
+}
+
+Box3F LightShadowMap::getLightBounds() const
+{
+   const Point3F lightPos = mLight->getPosition();
+   const F32 range = mLight->getRange().x;
+
+   switch ( mLight->getType() )
+   {
+   case LightInfo::Point:
+      return Box3F( lightPos - Point3F( range, range, range ), lightPos + Point3F( range, range, range ) );
+
+   case LightInfo::Spot:
+      {
+         Box3F bounds( lightPos - Point3F( range, range, range ), lightPos + Point3F( range, range, range ) );
+
+         // Narrow cones fit a box around the apex and
+         // the end cap better than the range sphere.
+         const F32 halfAngle = mDegToRad( mLight->getOuterConeAngle() * 0.5f );
+         if ( halfAngle < M_HALFPI_F * 0.5f )
+         {
+            const Point3F capPos = lightPos + mLight->getDirection() * range;
+            const F32 capRadius = range * mTan( halfAngle );
+
+            Box3F coneBox( lightPos, lightPos );
+            coneBox.extend( capPos - Point3F( capRadius, capRadius, capRadius ) );
+            coneBox.extend( capPos + Point3F( capRadius, capRadius, capRadius ) );
+            bounds.minExtents.setMax( coneBox.minExtents );
+            bounds.maxExtents.setMin( coneBox.maxExtents );
+         }
+
+         return bounds;
+      }
+
+   default:
+      return Box3F::Max;
+   }
+}
+
+void ShadowMapCacheState::invalidate()
+{
+   mValid = false;
+   mLightTransform.identity();
+   mRange.zero();
+   mConeAngle = 0.0f;
+   mLightType = LightInfo::Vector;
+   mTexSize = 0;
+   mDynamicCasters = 0;
+}
+
+bool ShadowMapCacheState::needsUpdate( const LightInfo *light, U32 texSize, U32 dynamicCasters ) const
+{
+   if ( !mValid || mTexSize != texSize )
+      return true;
+
+   // Dynamic casters need a redraw every frame and once
+   // more after the last one leaves the light.
+   if ( dynamicCasters > 0 || mDynamicCasters > 0 )
+      return true;
+
+   return hasLightChanged( light );
+}
+
+bool ShadowMapCacheState::hasLightChanged( const LightInfo *light ) const
+{
+   return   !mValid ||
+            light->getType() != mLightType ||
+            light->getRange() != mRange ||
+            light->getOuterConeAngle() != mConeAngle ||
+            dMemcmp( &light->getTransform(), &mLightTransform, sizeof( MatrixF ) ) != 0;
+}
+
+F32 ShadowMapCacheState::getMotionWeight( const LightInfo *light, U32 dynamicCasters ) const
+{
+   if ( hasLightChanged( light ) )
+      return 1.0f;
+
+   // We don't know if the casters actually moved, only that they
+   // can, so more of them means more of the map is likely wrong.
+   // The extra one covers the redraw after the last one leaves.
+   return getMin( F32( dynamicCasters + 1 ) / F32( FullMotionCasters + 1 ), 1.0f );
+}
+
+void ShadowMapCacheState::update( const LightInfo *light, U32 texSize, U32 dynamicCasters )
+{
+   mValid = true;
+   mLightTransform = light->getTransform();
+   mRange = light->getRange();
+   mConeAngle = light->getOuterConeAngle();
+   mLightType = light->getType();
+   mTexSize = texSize;
+   mDynamicCasters = dynamicCasters;
+}
+
+F32 LightShadowMap::getUpdateScore( U32 currFrame ) const
+{
+   if ( isViewDependent() )
+      return F32_MAX;
+
+   // Shadows grow more urgent the longer they wait so that
+   // small ones still get their turn under a tight budget.
+   const U32 waited = currFrame - mLastUpdateFrame;
+   const F32 score = mLastPriority * (F32)getMax( waited, 1U );
+
+   // A map with a few casters moving in a corner of it looks
+   // less wrong while it waits than one whose light moved.
+   return score * mCache.getMotionWeight( mLight, mDynamicCasters );
+}
+
 S32 QSORT_CALLBACK LightShadowMap::cmpPriority( LightShadowMap *const *lsm1, LightShadowMap *const *lsm2 )
 {
    F32 diff = (*lsm1)->getLastPriority() - (*lsm2)->getLastPriority(); 
@@ -134,6 +134,58 @@ struct LightingShaderConstants
 typedef Map<GFXShader*, LightingShaderConstants*> LightConstantMap;
 
 
+/// The light and caster state a cached shadow map was
+/// rendered with, used to decide if it must be redrawn.
+struct ShadowMapCacheState
+{
+   bool mValid;
+
+   MatrixF mLightTransform;
+
+   Point3F mRange;
+
+   F32 mConeAngle;
+
+   LightInfo::Type mLightType;
+
+   U32 mTexSize;
+
+   /// The number of non-static casters within the
+   /// light bounds when the map was rendered.
+   U32 mDynamicCasters;
+
+   ShadowMapCacheState() { invalidate(); }
+
+   void invalidate();
+
+   bool isValid() const { return mValid; }
+
+   /// Returns true if the shadow map must be rendered again
+   /// because the light changed or dynamic casters are or
+   /// were within its bounds.
+   bool needsUpdate( const LightInfo *light, U32 texSize, U32 dynamicCasters ) const;
+
+   /// Records the state the shadow map was just rendered with.
+   void update( const LightInfo *light, U32 texSize, U32 dynamicCasters );
+
+   /// Returns true if the light moved or changed shape since
+   /// the map was rendered or if there is no valid map.
+   bool hasLightChanged( const LightInfo *light ) const;
+
+   enum
+   {
+      /// The count of dynamic casters at which a shadow
+      /// map is weighed as if the whole map went stale.
+      FullMotionCasters = 4
+   };
+
+   /// Returns how much of the shadow map is likely stale from
+   /// zero to one.  A changed light stales all of it while
+   /// dynamic casters only stale the parts they shadow.
+   F32 getMotionWeight( const LightInfo *light, U32 dynamicCasters ) const;
+};
+
+
 /// This represents everything we need to render
 /// the shadowmap for one light.
 class LightShadowMap
@@ -149,6 +201,11 @@ public:
    /// rendering enabled.
    static bool smDebugRenderFrustums;
 
+   /// Whether shadow maps which are not view dependent are
+   /// kept between frames until the light or the casters
+   /// within its bounds change.
+   static bool smCacheShadows;
+
 public:
 
    LightShadowMap( LightInfo *light );
@@ -164,10 +221,33 @@ public:
 
    void updatePriority( const SceneRenderState *state, U32 currTimeMs );
 
+   /// Returns false if the cached shadow map is still valid
+   /// and rendering it this frame can be skipped.
+   bool needsRender( const SceneRenderState *diffuseState );
+
+   /// Forces the shadow map to be rendered on its next update.
+   void invalidateCache() { mCache.invalidate(); }
+
+   const ShadowMapCacheState& getCacheState() const { return mCache; }
+
+   /// Returns the world space bounds of the area the light can
+   /// shadow or the global bounds for directional lights.
+   Box3F getLightBounds() const;
+
    F32 getLastScreenSize() const { return mLastScreenSize; }
 
    F32 getLastPriority() const { return mLastPriority; }
 
+   /// Returns the update order score from the last priority, how
+   /// many frames the shadow has waited since its last update and
+   /// how much of it the light or caster motion made stale.
+   F32 getUpdateScore( U32 currFrame ) const;
+
+   /// The shadow pass frame this map was last rendered on.
+   U32 getLastUpdateFrame() const { return mLastUpdateFrame; }
+
+   void setLastUpdateFrame( U32 frame ) { mLastUpdateFrame = frame; }
+
    virtual bool hasShadowTex() const { return mShadowMapTex.isValid(); }
 
    virtual bool setTextureStage( U32 currTexFlag, LightingShaderConstants* lsc );
@@ -200,6 +280,10 @@ public:
 
    static void releaseAllTextures();
 
+   /// Invalidates the cached shadow maps whose light bounds
+   /// overlap static geometry which changed within the box.
+   static void markStaticCastersDirty( const Box3F &box );
+
    /// Releases any shadow maps that have not been culled
    /// in a while and returns the count of the remaing 
    /// shadow maps in use.
@@ -223,6 +307,9 @@ protected:
    virtual void _render(   RenderPassManager* renderPass,
                            const SceneRenderState *diffuseState ) = 0;
 
+   /// Returns the texture size the next render will use.
+   virtual U32 _getBestTexSize() const { return getBestTexSize(); }
+
    /// If there is a LightDebugInfo attached to the light that owns this map,
    /// then update its information from the given render state.
    ///
@@ -243,6 +330,9 @@ protected:
 
    F32 mLastPriority;
 
+   /// The shadow pass frame this was last rendered on.
+   U32 mLastUpdateFrame;
+
    MatrixF mWorldToLightProj;
 
    GFXTextureTargetRef mTarget;
@@ -253,6 +343,12 @@ protected:
    // The light we are rendering.
    LightInfo *mLight;   
 
+   /// The state the cached shadow map was rendered with.
+   ShadowMapCacheState mCache;
+
+   /// The count of dynamic casters found by needsRender().
+   U32 mDynamicCasters;
+
    // Used for blur
    GFXShader* mLastShader;
    GFXShaderConstHandle* mBlurBoundaries;
@@ -38,6 +38,7 @@
 #include "ts/tsShapeInstance.h"
 #include "console/consoleTypes.h"
 #include "math/mathUtils.h"
+#include "gfx/primBuilder.h"
 
 
 AFTER_MODULE_INIT( Sim )
@@ -56,23 +57,147 @@ AFTER_MODULE_INIT( Sim )
       "Use this to force culling of small objects which contribute little to the final shadow.\n"
       "@see $pref::TS::smallestVisiblePixelSize\n"
       "@ingroup AdvancedLighting" );
+
+   Con::addVariable( "$pref::PSSM::maxSplitUpdateInterval", 
+      TypeS32, &PSSMLightShadowMap::smMaxSplitUpdateInterval,
+      "@brief The most frames the far PSSM splits can go without being updated.\n"
+      "The nearest split is updated every frame and each split after it half as often "
+      "up to this limit.  Set to 1 to update every split every frame.\n"
+      "@ingroup AdvancedLighting" );
+
+   Con::addVariable( "$pref::PSSM::splitPadding", 
+      TypeF32, &PSSMLightShadowMap::smSplitPadding,
+      "@brief The fraction of its size added to each side of a PSSM split which isn't updated every frame.\n"
+      "More padding lets the camera move further before the split must be updated early "
+      "at the cost of shadow resolution.\n"
+      "@ingroup AdvancedLighting" );
 }
 
 F32 PSSMLightShadowMap::smDetailAdjustScale = 0.85f;
 F32 PSSMLightShadowMap::smSmallestVisiblePixelSize = 25.0f;
+U32 PSSMLightShadowMap::smMaxSplitUpdateInterval = 4;
+F32 PSSMLightShadowMap::smSplitPadding = 0.05f;
 
 
 PSSMLightShadowMap::PSSMLightShadowMap( LightInfo *light )
    :  LightShadowMap( light ),
       mNumSplits( 1 ),
-      mLogWeight(0.91f)
+      mLogWeight(0.91f),
+      mFrame( 0 ),
+      mStableLightValid( false ),
+      mStableLightMatrix( true ),
+      mStableCenter( Point3F::Zero ),
+      mStableDir( VectorF::Zero ),
+      mStableShadowDistance( 0.0f ),
+      mStableRadius( 0.0f )
 {
    for (U32 i = 0; i <= MAX_SPLITS; i++) //% depth distance
       mSplitDist[i] = mPow(F32(i/MAX_SPLITS),2.0f);
 
+   dMemset( mSplitValid, 0, sizeof( mSplitValid ) );
+
    mIsViewDependent = true;
 }
 
+void PSSMLightShadowMap::releaseTextures()
+{
+   Parent::releaseTextures();
+
+   dMemset( mSplitValid, 0, sizeof( mSplitValid ) );
+   mStableLightValid = false;
+}
+
+U32 PSSMLightShadowMap::getSplitUpdateInterval( U32 split )
+{
+   return mClamp( 1 << split, 1, getMax( smMaxSplitUpdateInterval, 1U ) );
+}
+
+bool PSSMLightShadowMap::isSplitDue( U32 split, U32 frame )
+{
+   return ( ( frame + split ) % getSplitUpdateInterval( split ) ) == 0;
+}
+
+bool PSSMLightShadowMap::splitCovers( const Box3F &renderedAABB, const Box3F &clipAABB )
+{
+   // The near plane is shared by all the splits so
+   // only the far plane needs to be checked.
+   return   clipAABB.minExtents.x >= renderedAABB.minExtents.x &&
+            clipAABB.minExtents.y >= renderedAABB.minExtents.y &&
+            clipAABB.maxExtents.x <= renderedAABB.maxExtents.x &&
+            clipAABB.maxExtents.y <= renderedAABB.maxExtents.y &&
+            clipAABB.maxExtents.z <= renderedAABB.maxExtents.z;
+}
+
+bool PSSMLightShadowMap::_calcStableLightMatrices( MatrixF &outLightMatrix, const Frustum &viewFrustum, F32 shadowDistance )
+{
+   // The shadowed area is the shadow distance box around the 
+   // camera which at any rotation fits within this sphere.
+   const F32 viewRadius = shadowDistance * mSqrt( 3.0f );
+   const Point3F camPos = viewFrustum.getPosition();
+   const VectorF lightDir = mLight->getDirection();
+
+   // Keep the projection while the sphere stays within the
+   // covered area and the light only turns a fraction of
+   // a degree, like the sun moving with the time of day.
+   const bool kept = mStableLightValid &&
+                     mStableShadowDistance == shadowDistance &&
+                     mDot( mStableDir, lightDir ) > 0.99999f &&
+                     ( camPos - mStableCenter ).len() + viewRadius <= mStableRadius;
+
+   if ( !kept )
+   {
+      // Cover a little more than we need so that the
+      // camera can move a bit before we rebuild it.
+      mStableLightValid = true;
+      mStableShadowDistance = shadowDistance;
+      mStableDir = lightDir;
+      mStableCenter = camPos;
+      mStableRadius = viewRadius * 1.1f;
+
+      mStableLightMatrix = MathUtils::createOrientFromDir( lightDir );
+      mStableLightMatrix.setPosition( camPos - lightDir * ( mStableRadius + 1.0f ) ); // -1 for the nearplane
+   }
+
+   outLightMatrix = mStableLightMatrix;
+
+   // Update light info
+   const F32 sceneDepth = mStableRadius * 2.0f;
+   mLight->setRange( sceneDepth );
+   mLight->setPosition( mStableLightMatrix.getPosition() );
+
+   GFX->setOrtho( -mStableRadius, mStableRadius, -mStableRadius, mStableRadius, 1.0f, sceneDepth, true );
+
+   return kept;
+}
+
+void PSSMLightShadowMap::_clearSplit( U32 split )
+{
+   if ( mClearSB.isNull() )
+   {
+      GFXStateBlockDesc desc;
+      desc.setCullMode( GFXCullNone );
+      desc.setZReadWrite( false, false );
+      mClearSB = GFX->createStateBlock( desc );
+   }
+
+   GFXTransformSaver saver;
+
+   GFX->setViewport( mViewports[split] );
+   GFX->setWorldMatrix( MatrixF::Identity );
+   GFX->setViewMatrix( MatrixF::Identity );
+   GFX->setProjectionMatrix( MatrixF::Identity );
+   GFX->setStateBlock( mClearSB );
+
+   // The far depth is what a full clear leaves.
+   PrimBuild::color4f( 1.0f, 1.0f, 1.0f, 1.0f );
+   PrimBuild::begin( GFXTriangleStrip, 4 );
+      PrimBuild::vertex3f( -1.0f, -1.0f, 0.0f );
+      PrimBuild::vertex3f( -1.0f, 1.0f, 0.0f );
+      PrimBuild::vertex3f( 1.0f, -1.0f, 0.0f );
+      PrimBuild::vertex3f( 1.0f, 1.0f, 0.0f );
+   PrimBuild::end();
+}
+
 void PSSMLightShadowMap::_setNumSplits( U32 numSplits, U32 texSize )
 {
    AssertFatal(numSplits > 0 && numSplits <= MAX_SPLITS,
@@ -219,7 +344,13 @@ void PSSMLightShadowMap::_render(   RenderPassManager* renderPass,
       _setNumSplits( params->numSplits, texSize );
       mShadowMapDepth = _getDepthTarget( mShadowMapTex->getWidth(), mShadowMapTex->getHeight() );   
    }
-   mLogWeight = params->logWeight;
+
+   // The split distances move with the log weight.
+   if ( mLogWeight != params->logWeight )
+   {
+      mLogWeight = params->logWeight;
+      dMemset( mSplitValid, 0, sizeof( mSplitValid ) );
+   }
 
    Frustum fullFrustum( diffuseState->getCameraFrustum() );
    fullFrustum.cropNearFar(fullFrustum.getNearDist(), params->shadowDistance);
@@ -227,16 +358,20 @@ void PSSMLightShadowMap::_render(   RenderPassManager* renderPass,
    GFXFrustumSaver frustSaver;
    GFXTransformSaver saver;
 
-   // Set our render target
-   GFX->pushActiveRenderTarget();
-   mTarget->attachTexture( GFXTextureTarget::Color0, mShadowMapTex );
-   mTarget->attachTexture( GFXTextureTarget::DepthStencil, mShadowMapDepth );
-   GFX->setActiveRenderTarget( mTarget );
-   GFX->clear( GFXClearStencil | GFXClearZBuffer | GFXClearTarget, ColorI(255,255,255), 0.0f, 0 );
-
-   // Calculate our standard light matrices
+   // Calculate our standard light matrices... when the far splits
+   // can be skipped they need a projection which doesn't follow
+   // the camera every frame.
    MatrixF lightMatrix;
-   calcLightMatrices( lightMatrix, diffuseState->getCameraFrustum() );
+   const bool staggerSplits = smMaxSplitUpdateInterval > 1 && mNumSplits > 1;
+   if ( !staggerSplits )
+   {
+      mStableLightValid = false;
+      calcLightMatrices( lightMatrix, diffuseState->getCameraFrustum() );
+      dMemset( mSplitValid, 0, sizeof( mSplitValid ) );
+   }
+   else if ( !_calcStableLightMatrices( lightMatrix, diffuseState->getCameraFrustum(), params->shadowDistance ) )
+      dMemset( mSplitValid, 0, sizeof( mSplitValid ) );
+
    lightMatrix.inverse();
    MatrixF tempProjMat = GFX->getProjectionMatrix();
    tempProjMat.reverseProjection();
@@ -255,6 +390,57 @@ void PSSMLightShadowMap::_render(   RenderPassManager* renderPass,
    
    mWorldToLightProj = tempProjMat * toLightSpace;
 
+   // Find the area each split needs this frame and pick the
+   // splits to update.  A split which isn't due keeps its old
+   // shadow as long as that still covers the area.
+   Box3F clipAABBs[MAX_SPLITS];
+   bool renderSplit[MAX_SPLITS];
+   U32 numRenderSplits = 0;
+
+   for (U32 i = 0; i < mNumSplits; i++)
+   {
+      Frustum subFrustum(fullFrustum);
+      subFrustum.cropNearFar(mSplitDist[i], mSplitDist[i+1]);
+      clipAABBs[i] = _calcClipSpaceAABB(subFrustum, lightViewProj, fullFrustum.getFarDist());
+
+      renderSplit[i] =  !staggerSplits || 
+                        !mSplitValid[i] || 
+                        isSplitDue( i, mFrame ) ||
+                        !splitCovers( mSplitClipAABB[i], clipAABBs[i] );
+
+      if ( renderSplit[i] )
+         numRenderSplits++;
+
+      // Pad the splits which may be skipped later.
+      if ( staggerSplits && getSplitUpdateInterval( i ) > 1 )
+      {
+         const Point3F pad = ( clipAABBs[i].maxExtents - clipAABBs[i].minExtents ) * smSplitPadding;
+         clipAABBs[i].minExtents.x -= pad.x;
+         clipAABBs[i].minExtents.y -= pad.y;
+         clipAABBs[i].maxExtents += pad;
+      }
+   }
+
+   mFrame++;
+
+   // Set our render target
+   GFX->pushActiveRenderTarget();
+   mTarget->attachTexture( GFXTextureTarget::Color0, mShadowMapTex );
+   mTarget->attachTexture( GFXTextureTarget::DepthStencil, mShadowMapDepth );
+   GFX->setActiveRenderTarget( mTarget );
+
+   if ( numRenderSplits == mNumSplits )
+      GFX->clear( GFXClearStencil | GFXClearZBuffer | GFXClearTarget, ColorI(255,255,255), 0.0f, 0 );
+   else
+   {
+      GFX->clear( GFXClearStencil | GFXClearZBuffer, ColorI(255,255,255), 0.0f, 0 );
+      for ( U32 i = 0; i < mNumSplits; i++ )
+      {
+         if ( renderSplit[i] )
+            _clearSplit( i );
+      }
+   }
+
    // Apply the PSSM 
    const F32 savedSmallestVisible = TSShapeInstance::smSmallestVisiblePixelSize;
    const F32 savedDetailAdjust = TSShapeInstance::smDetailAdjust;
@@ -266,14 +452,15 @@ void PSSMLightShadowMap::_render(   RenderPassManager* renderPass,
 
    for (U32 i = 0; i < mNumSplits; i++)
    {
-      GFXTransformSaver splitSaver;
+      if ( !renderSplit[i] )
+         continue;
 
-      // Calculate a sub-frustum
-      Frustum subFrustum(fullFrustum);
-      subFrustum.cropNearFar(mSplitDist[i], mSplitDist[i+1]);
+      GFXTransformSaver splitSaver;
 
       // Calculate our AABB in the light's clip space.
-      Box3F clipAABB = _calcClipSpaceAABB(subFrustum, lightViewProj, fullFrustum.getFarDist());
+      Box3F clipAABB = clipAABBs[i];
+      mSplitClipAABB[i] = clipAABB;
+      mSplitValid[i] = true;
  
       // Calculate our crop matrix
       Point3F scale;
@@ -28,6 +28,9 @@
 #ifndef _MATHUTIL_FRUSTUM_H_
 #include "math/util/frustum.h"
 #endif
+#ifndef _GFXSTATEBLOCK_H_
+#include "gfx/gfxStateBlock.h"
+#endif
 
 
 class PSSMLightShadowMap : public LightShadowMap
@@ -40,6 +43,19 @@ public:
    ShadowType getShadowType() const override { return ShadowType_PSSM; }
    void _render( RenderPassManager* renderPass, const SceneRenderState *diffuseState ) override;
    void setShaderParameters(GFXShaderConstBuffer* params, LightingShaderConstants* lsc) override;
+   void releaseTextures() override;
+
+   /// Returns the number of frames between updates of a split
+   /// when the camera stays within the area it covers.
+   static U32 getSplitUpdateInterval( U32 split );
+
+   /// Returns true if the split is scheduled to be updated on
+   /// the frame... splits with the same interval are staggered.
+   static bool isSplitDue( U32 split, U32 frame );
+
+   /// Returns true if the padded clip space box of a split which
+   /// was not updated still covers the box it needs this frame.
+   static bool splitCovers( const Box3F &renderedAABB, const Box3F &clipAABB );
 
    /// Used to scale TSShapeInstance::smDetailAdjust to have
    /// objects lod quicker when in the PSSM shadow.
@@ -51,6 +67,14 @@ public:
    /// @see TSShapeInstance::smSmallestVisiblePixelSize
    static F32 smSmallestVisiblePixelSize;
 
+   /// The most frames the far splits can go between updates. The
+   /// nearest split is always updated and 1 updates every split.
+   static U32 smMaxSplitUpdateInterval;
+
+   /// How much of its size is added to each side of a split which
+   /// isn't updated every frame so it still covers small camera moves.
+   static F32 smSplitPadding;
+
 protected:
 
    void _setNumSplits( U32 numSplits, U32 texSize );
@@ -59,6 +83,15 @@ protected:
    void _calcPlanesCullForShadowCasters(Vector< Vector<PlaneF> > &out, const Frustum &viewFrustum, const Point3F &_ligthDir);
    void _roundProjection(const MatrixF& lightMat, const MatrixF& cropMatrix, Point3F &offset, U32 splitNum);
    void _adjustScaleAndOffset(Box3F& clipAABB, Point3F& scale, Point3F& offset);
+
+   /// Sets up a light projection which stays the same until the
+   /// camera leaves the area it covers, so that splits which are
+   /// not updated can still be sampled.  Returns false if the
+   /// projection changed and every split must be updated.
+   bool _calcStableLightMatrices( MatrixF &outLightMatrix, const Frustum &viewFrustum, F32 shadowDistance );
+
+   /// Fills the viewport of a split with the far depth.
+   void _clearSplit( U32 split );
    static const S32 MAX_SPLITS = 4;
    U32 mNumSplits;
    F32 mSplitDist[MAX_SPLITS+1];   // +1 because we store a cap
@@ -67,6 +100,30 @@ protected:
    Point3F mOffsetProj[MAX_SPLITS];
    Point4F mFarPlaneScalePSSM;
    F32 mLogWeight;
+
+   /// @name Split Updates
+   /// @{
+
+   /// Incremented on every render.
+   U32 mFrame;
+
+   /// The splits which hold a valid shadow from a previous frame.
+   bool mSplitValid[MAX_SPLITS];
+
+   /// The padded clip space box each split was last rendered with.
+   Box3F mSplitClipAABB[MAX_SPLITS];
+
+   /// The light projection the splits were rendered with.
+   bool mStableLightValid;
+   MatrixF mStableLightMatrix;
+   Point3F mStableCenter;
+   VectorF mStableDir;
+   F32 mStableShadowDistance;
+   F32 mStableRadius;
+
+   GFXStateBlockRef mClearSB;
+
+   /// @}
 };
 
 #endif
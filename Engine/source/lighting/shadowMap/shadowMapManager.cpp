@@ -32,6 +32,9 @@
 #include "gfx/gfxTextureManager.h"
 #include "core/module.h"
 #include "console/consoleTypes.h"
+#include "scene/sceneObject.h"
+#include "terrain/terrData.h"
+#include "forest/forestDataFile.h"
 
 
 GFX_ImplementTextureProfile(ShadowMapTexProfile,
@@ -68,6 +71,15 @@ AFTER_MODULE_INIT( Sim )
    Con::NotifyDelegate callabck( &LightShadowMap::releaseAllTextures );
    Con::addVariableNotify( "$pref::Shadows::textureScalar", callabck );
 
+   Con::addVariable( "$pref::Shadows::cacheStaticShadows",
+      TypeBool, &LightShadowMap::smCacheShadows,
+      "@brief Keeps the shadow maps of point and spot lights between frames.\n"
+      "A cached map is only rendered again when its light changes, static geometry "
+      "within the light range changes, or dynamic casters are within its range.  Only "
+      "terrain, forests without wind, ground planes and TSStatics which don't play an "
+      "ambient animation count as static.\n"
+      "@ingroup AdvancedLighting\n" );
+
    Con::addVariable( "$pref::Shadows::disable", 
       TypeBool, &ShadowMapPass::smDisableShadowsPref,
       "Used to disable all shadow rendering.\n"
@@ -82,6 +94,24 @@ AFTER_MODULE_INIT( Sim )
    Con::addVariableNotify( "$pref::Shadows::disable", shadowCallback );
    Con::addVariableNotify( "$Shadows::disable", shadowCallback );
 
+   Con::addVariable( "$pref::Shadows::renderBudgetMs",
+      TypeS32, &ShadowMapPass::smRenderBudgetMs,
+      "@brief The milliseconds per frame which can be spent updating shadow maps.\n"
+      "Shadows which don't fit are updated on a later frame.\n"
+      "@ingroup AdvancedLighting\n" );
+
+   Con::addVariable( "$pref::Shadows::drawCallBudget",
+      TypeS32, &ShadowMapPass::smDrawCallBudget,
+      "@brief The most draw calls per frame which can be spent updating shadow maps or 0 for no limit.\n"
+      "Shadows which don't fit are updated on a later frame.\n"
+      "@ingroup AdvancedLighting\n" );
+
+   Con::addVariable( "$pref::Shadows::polyBudget",
+      TypeS32, &ShadowMapPass::smPolyBudget,
+      "@brief The most triangles per frame which can be spent updating shadow maps or 0 for no limit.\n"
+      "Shadows which don't fit are updated on a later frame.\n"
+      "@ingroup AdvancedLighting\n" );
+
    Con::addVariable("$pref::Shadows::teleportDist",
       TypeF32, &ShadowMapPass::smShadowsTeleportDist,
       "Minimum distance moved per frame to determine that we are teleporting.\n");
@@ -135,6 +165,12 @@ void ShadowMapManager::activate()
    getSceneManager()->getPreRenderSignal().notify( this, &ShadowMapManager::_onPreRender, 0.01f );
    GFXTextureManager::addEventDelegate( this, &ShadowMapManager::_onTextureEvent );
 
+   SceneObject::smSceneObjectAdd.notify( this, &ShadowMapManager::_onStaticObjectChanged );
+   SceneObject::smSceneObjectRemove.notify( this, &ShadowMapManager::_onStaticObjectChanged );
+   SceneObject::smStaticObjectMoved.notify( this, &ShadowMapManager::_onStaticObjectMoved );
+   TerrainBlock::smUpdateSignal.notify( this, &ShadowMapManager::_onTerrainUpdated );
+   ForestData::getItemsChangedSignal().notify( this, &ShadowMapManager::_onForestItemsChanged );
+
    mIsActive = true;
 }
 
@@ -143,6 +179,12 @@ void ShadowMapManager::deactivate()
    GFXTextureManager::removeEventDelegate( this, &ShadowMapManager::_onTextureEvent );
    getSceneManager()->getPreRenderSignal().remove( this, &ShadowMapManager::_onPreRender );
 
+   SceneObject::smSceneObjectAdd.remove( this, &ShadowMapManager::_onStaticObjectChanged );
+   SceneObject::smSceneObjectRemove.remove( this, &ShadowMapManager::_onStaticObjectChanged );
+   SceneObject::smStaticObjectMoved.remove( this, &ShadowMapManager::_onStaticObjectMoved );
+   TerrainBlock::smUpdateSignal.remove( this, &ShadowMapManager::_onTerrainUpdated );
+   ForestData::getItemsChangedSignal().remove( this, &ShadowMapManager::_onForestItemsChanged );
+
    SAFE_DELETE(mShadowMapPass);
    mTapRotationTex = NULL;
 
@@ -161,6 +203,33 @@ void ShadowMapManager::_onPreRender( SceneManager *sg, const SceneRenderState *s
       mShadowMapPass->render( sg, state, (U32)-1 );
 }
 
+void ShadowMapManager::_onStaticObjectChanged( SceneObject *obj )
+{
+   if ( obj->isClientObject() && obj->isStaticGeometry() )
+      LightShadowMap::markStaticCastersDirty( obj->getWorldBox() );
+}
+
+void ShadowMapManager::_onStaticObjectMoved( SceneObject *obj, const Box3F &oldWorldBox )
+{
+   if ( !obj->isClientObject() )
+      return;
+
+   // The shadows are wrong both where it was and where it is now.
+   LightShadowMap::markStaticCastersDirty( oldWorldBox );
+   LightShadowMap::markStaticCastersDirty( obj->getWorldBox() );
+}
+
+void ShadowMapManager::_onForestItemsChanged( const Box3F &worldBox )
+{
+   LightShadowMap::markStaticCastersDirty( worldBox );
+}
+
+void ShadowMapManager::_onTerrainUpdated( U32 flags, TerrainBlock *terrain, const Point2I &minPt, const Point2I &maxPt )
+{
+   if ( flags & ( TerrainBlock::HeightmapUpdate | TerrainBlock::EmptyUpdate ) )
+      LightShadowMap::markStaticCastersDirty( terrain->getWorldBox() );
+}
+
 void ShadowMapManager::_onTextureEvent( GFXTexCallbackCode code )
 {
    if ( code == GFXZombify )
@@ -45,6 +45,10 @@ class LightInfo;
 
 class SceneManager;
 class SceneRenderState;
+class SceneObject;
+class TerrainBlock;
+class Box3F;
+class Point2I;
 
 
 class ShadowMapManager : public ShadowManager
@@ -86,6 +90,21 @@ protected:
 
    void _onPreRender( SceneManager *sg, const SceneRenderState* state );
 
+   /// @name Static Caster Changes
+   /// These invalidate the cached shadow maps which
+   /// the changed static geometry could shadow.
+   /// @{
+
+   void _onStaticObjectChanged( SceneObject *obj );
+
+   void _onStaticObjectMoved( SceneObject *obj, const Box3F &oldWorldBox );
+
+   void _onTerrainUpdated( U32 flags, TerrainBlock *terrain, const Point2I &minPt, const Point2I &maxPt );
+
+   void _onForestItemsChanged( const Box3F &worldBox );
+
+   /// @}
+
    ShadowMapPass *mShadowMapPass;
    LightShadowMap *mCurrentShadowMap;
 
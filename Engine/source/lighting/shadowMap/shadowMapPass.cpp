@@ -45,6 +45,7 @@ const String ShadowMapPass::PassTypeName("ShadowMap");
 
 U32 ShadowMapPass::smActiveShadowMaps = 0;
 U32 ShadowMapPass::smUpdatedShadowMaps = 0;
+U32 ShadowMapPass::smCachedShadowMaps = 0;
 U32 ShadowMapPass::smNearShadowMaps = 0;
 U32 ShadowMapPass::smShadowMapsDrawCalls = 0;
 U32 ShadowMapPass::smShadowMapPolyCount = 0;
@@ -62,6 +63,9 @@ F32 ShadowMapPass::smShadowsTeleportDist = 4;
 F32 ShadowMapPass::smShadowsTurnRate = 1;
 /// We have a default 8ms render budget for shadow rendering.
 U32 ShadowMapPass::smRenderBudgetMs = 8;
+U32 ShadowMapPass::smDrawCallBudget = 0;
+U32 ShadowMapPass::smPolyBudget = 0;
+U32 ShadowMapPass::smDeferredShadowMaps = 0;
 
 ShadowMapPass::ShadowMapPass(LightManager* lightManager, ShadowMapManager* shadowManager)
 {
@@ -80,6 +84,7 @@ ShadowMapPass::ShadowMapPass(LightManager* lightManager, ShadowMapManager* shado
    mShadowRPM->addManager( new RenderImposterMgr( 0.6f, 0.6f )  );
 
    mActiveLights = 0;
+   mFrame = 0;
    mPrevCamPos = Point3F::Zero;
    mPrevCamRot = Point3F::Zero;
    mTimer = PlatformTimer::create();
@@ -92,6 +97,14 @@ ShadowMapPass::ShadowMapPass(LightManager* lightManager, ShadowMapManager* shado
       "The shadow stats showing the number of shadow maps updated this frame.\n"
       "@ingroup AdvancedLighting\n" );
 
+   Con::addVariable( "$ShadowStats::cachedMaps", TypeS32, &smCachedShadowMaps,
+      "The shadow stats showing the number of shadow maps reused from a previous frame.\n"
+      "@ingroup AdvancedLighting\n" );
+
+   Con::addVariable( "$ShadowStats::deferredMaps", TypeS32, &smDeferredShadowMaps,
+      "The shadow stats showing the number of shadow maps which needed an update but were left for a later frame to stay within the budget.\n"
+      "@ingroup AdvancedLighting\n" );
+
    Con::addVariable( "$ShadowStats::nearMaps", TypeS32, &smNearShadowMaps,
       "The shadow stats showing the number of shadow maps that are close enough to be updated very frame.\n"
       "@ingroup AdvancedLighting\n" );
@@ -134,6 +147,8 @@ void ShadowMapPass::render(   SceneManager *sceneManager,
    // Prep some shadow rendering stats.
    smActiveShadowMaps = 0;
    smUpdatedShadowMaps = 0;
+   smCachedShadowMaps = 0;
+   smDeferredShadowMaps = 0;
    smNearShadowMaps = 0;
    GFXDeviceStatistics stats;
    stats.start( GFX->getDeviceStatistics() );
@@ -180,10 +195,6 @@ void ShadowMapPass::render(   SceneManager *sceneManager,
       shadowMaps.push_back(lsm);
    }
 
-   // Now sort the shadow info by priority.
-   // andrewmac: tempoarily disabled until I find a better solution.
-   //shadowMaps.sort( LightShadowMap::cmpPriority );
-
    GFXDEBUGEVENT_SCOPE( ShadowMapPass_Render, ColorI::RED );
 
    // Use a timer for tracking our shadow rendering 
@@ -213,9 +224,38 @@ void ShadowMapPass::render(   SceneManager *sceneManager,
    mPrevCamPos = curCamMatrix.getPosition();
    mPrevCamFov = control->getCameraFov();
 
+   // Drop the shadows we can reuse from a previous frame
+   // and order the rest by priority and time waited.
+   for ( U32 i = 0; i < shadowMaps.size(); )
+   {
+      if ( !shadowMaps[i]->needsRender( diffuseState ) )
+      {
+         ++smCachedShadowMaps;
+         shadowMaps.erase_fast( i );
+         continue;
+      }
+
+      i++;
+   }
+
+   ++mFrame;
+   sortForUpdate( shadowMaps, mFrame );
+
    // 2 Shadow Maps per Light. This may fail.
    for ( U32 i = 0; i < shadowMaps.size(); i++ )
    {
+      // See if we're over our frame budget for shadow 
+      // updates... the rest wait for a later frame with
+      // a higher score.  We always do at least one.
+      if (  i > 0 &&
+            isOverBudget(  GFX->getDeviceStatistics()->mDrawCalls - stats.mDrawCalls,
+                           GFX->getDeviceStatistics()->mPolyCount - stats.mPolyCount,
+                           mTimer->getElapsedMs() ) )
+      {
+         smDeferredShadowMaps = shadowMaps.size() - i;
+         break;
+      }
+
 	   LightShadowMap *lsm = shadowMaps[i];
       {
          GFXDEBUGEVENT_SCOPE( ShadowMapPass_Render_Shadow, ColorI::RED );
@@ -223,14 +263,10 @@ void ShadowMapPass::render(   SceneManager *sceneManager,
 		   mShadowManager->setLightShadowMap(lsm);
 
          lsm->render(mShadowRPM, diffuseState);
+         lsm->setLastUpdateFrame( mFrame );
 
          ++smUpdatedShadowMaps;
       }
-
-      // See if we're over our frame budget for shadow 
-      // updates... give up completely in that case.
-      if ( mTimer->getElapsedMs() > smRenderBudgetMs )
-         break;
    }
 
    // Cleanup old unused textures.
@@ -249,6 +285,44 @@ void ShadowMapPass::render(   SceneManager *sceneManager,
    mShadowManager->setLightShadowMap( NULL );
 }
 
+struct ShadowMapUpdate
+{
+   LightShadowMap *lsm;
+   F32 score;
+};
+
+static S32 QSORT_CALLBACK _cmpUpdateScore( const void *a, const void *b )
+{
+   const F32 scoreA = static_cast<const ShadowMapUpdate*>( a )->score;
+   const F32 scoreB = static_cast<const ShadowMapUpdate*>( b )->score;
+   return scoreA > scoreB ? -1 : ( scoreA < scoreB ? 1 : 0 );
+}
+
+void ShadowMapPass::sortForUpdate( Vector<LightShadowMap*> &shadowMaps, U32 currFrame )
+{
+   PROFILE_SCOPE( ShadowMapPass_SortForUpdate );
+
+   Vector<ShadowMapUpdate> updates;
+   updates.setSize( shadowMaps.size() );
+   for ( U32 i = 0; i < shadowMaps.size(); i++ )
+   {
+      updates[i].lsm = shadowMaps[i];
+      updates[i].score = shadowMaps[i]->getUpdateScore( currFrame );
+   }
+
+   dQsort( updates.address(), updates.size(), sizeof( ShadowMapUpdate ), _cmpUpdateScore );
+
+   for ( U32 i = 0; i < updates.size(); i++ )
+      shadowMaps[i] = updates[i].lsm;
+}
+
+bool ShadowMapPass::isOverBudget( U32 drawCalls, U32 polyCount, U32 elapsedMs )
+{
+   return   elapsedMs > smRenderBudgetMs ||
+            ( smDrawCallBudget > 0 && drawCalls >= smDrawCallBudget ) ||
+            ( smPolyBudget > 0 && polyCount >= smPolyBudget );
+}
+
 void ShadowRenderPassManager::addInst( RenderInst *inst )
 {
    PROFILE_SCOPE(ShadowRenderPassManager_addInst);
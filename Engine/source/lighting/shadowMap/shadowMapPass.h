@@ -52,7 +52,7 @@ class ShadowMapPass
 {
 public:
 
-   ShadowMapPass() : mTimer(NULL), mLightManager(NULL), mShadowManager(NULL), mActiveLights(0), mPrevCamFov(90.0f) {}   // Only called by ConsoleSystem
+   ShadowMapPass() : mTimer(NULL), mLightManager(NULL), mShadowManager(NULL), mActiveLights(0), mPrevCamFov(90.0f), mFrame(0) {}   // Only called by ConsoleSystem
    ShadowMapPass(LightManager* LightManager, ShadowMapManager* ShadowManager);
    virtual ~ShadowMapPass();
 
@@ -88,20 +88,35 @@ public:
    /// angle turned per frame before forcing a shadow update
    static F32 smShadowsTurnRate;
 
+   /// The milliseconds alotted for shadow map updates
+   /// on a per frame basis.
+   static U32 smRenderBudgetMs;
+
+   /// The most draw calls and triangles spent on shadow map
+   /// updates per frame or zero for no limit.
+   static U32 smDrawCallBudget;
+   static U32 smPolyBudget;
+
+   /// Sorts the shadow maps into the order they should be updated
+   /// on the frame, highest priority and longest waiting first.
+   static void sortForUpdate( Vector<LightShadowMap*> &shadowMaps, U32 currFrame );
+
+   /// Returns true once the shadow updates this frame have used
+   /// up any of the budgets.
+   static bool isOverBudget( U32 drawCalls, U32 polyCount, U32 elapsedMs );
+
 private:
 
    static U32 smActiveShadowMaps;
    static U32 smUpdatedShadowMaps;
+   static U32 smCachedShadowMaps;
    static U32 smNearShadowMaps;
    static U32 smShadowMapsDrawCalls;
    static U32 smShadowMapPolyCount;
    static U32 smRenderTargetChanges;
    static U32 smShadowPoolTexturesCount;
    static F32 smShadowPoolMemory;
-
-   /// The milliseconds alotted for shadow map updates
-   /// on a per frame basis.
-   static U32 smRenderBudgetMs;
+   static U32 smDeferredShadowMaps;
 
    PlatformTimer *mTimer;
 
@@ -113,6 +128,9 @@ private:
    Point3F mPrevCamPos;
    Point3F mPrevCamRot;
    F32 mPrevCamFov;
+
+   /// Incremented on every render.
+   U32 mFrame;
 };
 
 class ShadowRenderPassManager : public RenderPassManager
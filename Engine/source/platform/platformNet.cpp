@@ -104,6 +104,9 @@ typedef int SOCKET;
 #include "console/console.h"
 #include "core/util/journal/process.h"
 #include "core/util/journal/journal.h"
+#include "core/module.h"
+#include "platform/threads/thread.h"
+#include "platform/threads/threadSafeRingBuffer.h"
 
 
 NetSocket NetSocket::INVALID = NetSocket::fromHandle(-1);
@@ -477,6 +480,9 @@ bool Net::smMulticastEnabled = true;
 bool Net::smIpv4Enabled = true;
 bool Net::smIpv6Enabled = false;
 //
+// UDP I/O thread
+bool Net::smIOThreadEnabled = false;
+//
 
 // the Socket structure helps us keep track of the
 // above states
@@ -544,6 +550,344 @@ bool netSocketWaitForWritable(NetSocket handleFd, S32 timeoutMs)
    return false;
 }
 
+//-----------------------------------------------------------------------------
+// UDP I/O thread
+//
+// With $pref::Net::IOThread set, the UDP port is serviced by a dedicated
+// thread.  It pulls packets off the sockets in batches (recvmmsg/sendmmsg
+// where the platform has them) straight into rings of preallocated packet
+// slots, so the main thread only has to walk the receive ring in
+// Net::process() and copy outgoing packets into the send ring.
+//-----------------------------------------------------------------------------
+
+namespace NetIOThreadState
+{
+   /// Maximum number of packets moved by a single batched system call.
+   static const U32 BatchSize = 32;
+
+   /// How long the thread sleeps waiting for input before it flushes the
+   /// send ring again.  This bounds the latency added to outgoing packets.
+   static const S32 WaitTimeoutMs = 1;
+
+   struct PacketSlot
+   {
+      sockaddr_storage address;
+      socklen_t addressLen;
+      SOCKET socketFd;
+      S32 size;
+      U8 data[Net::MaxPacketDataSize];
+   };
+
+   typedef ThreadSafeRingBuffer<PacketSlot, 512> PacketRing;
+
+   static PacketRing *smReceiveRing = NULL;
+   static PacketRing *smSendRing = NULL;
+
+   /// Sockets serviced by the thread, resolved when it is started.
+   static SOCKET smSockets[2];
+   static U32 smNumSockets = 0;
+
+   /// Running totals, only written by the I/O thread.
+   static volatile U32 smReceiveCalls = 0;
+   static volatile U32 smReceivePackets = 0;
+   static volatile U32 smSendCalls = 0;
+   static volatile U32 smSendPackets = 0;
+   static volatile U32 smDroppedPackets = 0;
+
+   /// Console stats, refreshed on the main thread.
+   static F32 smPacketsPerReceiveCall = 0.0f;
+   static F32 smPacketsPerSendCall = 0.0f;
+   static S32 smReceiveQueueDepth = 0;
+   static S32 smSendQueueDepth = 0;
+   static S32 smDroppedPacketCount = 0;
+
+   /// Pull everything currently queued on @a socketFd into the receive ring.
+   static void receive(SOCKET socketFd)
+   {
+      for (;;)
+      {
+         const U32 count = getMin(smReceiveRing->getWriteCount(), BatchSize);
+         if (count == 0)
+         {
+            // The main thread isn't keeping up.  Drain the socket anyway so
+            // we don't spin on it; the packet is lost either way.
+            char scratch[Net::MaxPacketDataSize];
+            if (::recvfrom(socketFd, scratch, sizeof(scratch), 0, NULL, NULL) == SOCKET_ERROR)
+               return;
+
+            smDroppedPackets++;
+            continue;
+         }
+
+#if defined(TORQUE_OS_LINUX)
+         mmsghdr msgs[BatchSize];
+         iovec iovs[BatchSize];
+         dMemset(msgs, 0, sizeof(mmsghdr) * count);
+
+         for (U32 i = 0; i < count; i++)
+         {
+            PacketSlot &slot = smReceiveRing->getWriteSlot(i);
+            iovs[i].iov_base = slot.data;
+            iovs[i].iov_len = Net::MaxPacketDataSize;
+            msgs[i].msg_hdr.msg_name = &slot.address;
+            msgs[i].msg_hdr.msg_namelen = sizeof(slot.address);
+            msgs[i].msg_hdr.msg_iov = &iovs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+         }
+
+         const S32 received = ::recvmmsg(socketFd, msgs, count, MSG_DONTWAIT, NULL);
+         if (received <= 0)
+            return;
+
+         for (S32 i = 0; i < received; i++)
+         {
+            PacketSlot &slot = smReceiveRing->getWriteSlot(i);
+            slot.addressLen = msgs[i].msg_hdr.msg_namelen;
+            slot.size = msgs[i].msg_len;
+         }
+#else
+         PacketSlot &slot = smReceiveRing->getWriteSlot(0);
+         slot.addressLen = sizeof(slot.address);
+         slot.size = ::recvfrom(socketFd, (char *)slot.data, Net::MaxPacketDataSize, 0, (sockaddr *)&slot.address, &slot.addressLen);
+         if (slot.size == SOCKET_ERROR)
+            return;
+
+         const S32 received = 1;
+#endif
+
+         smReceiveCalls++;
+         smReceivePackets += received;
+         smReceiveRing->commitWrite(received);
+
+#if defined(TORQUE_OS_LINUX)
+         // A short batch means the socket is drained.
+         if (received < S32(count))
+            return;
+#endif
+      }
+   }
+
+   /// Push everything in the send ring out onto the wire.
+   static void flushSends()
+   {
+      while (U32 count = smSendRing->getReadCount())
+      {
+#if defined(TORQUE_OS_LINUX)
+         // sendmmsg works on a single socket, so batch up the run of
+         // packets going out through the same one.
+         count = getMin(count, BatchSize);
+         const SOCKET socketFd = smSendRing->getReadSlot(0).socketFd;
+
+         mmsghdr msgs[BatchSize];
+         iovec iovs[BatchSize];
+         dMemset(msgs, 0, sizeof(mmsghdr) * count);
+
+         U32 batch = 0;
+         for (; batch < count; batch++)
+         {
+            PacketSlot &slot = smSendRing->getReadSlot(batch);
+            if (slot.socketFd != socketFd)
+               break;
+
+            iovs[batch].iov_base = slot.data;
+            iovs[batch].iov_len = slot.size;
+            msgs[batch].msg_hdr.msg_name = &slot.address;
+            msgs[batch].msg_hdr.msg_namelen = slot.addressLen;
+            msgs[batch].msg_hdr.msg_iov = &iovs[batch];
+            msgs[batch].msg_hdr.msg_iovlen = 1;
+         }
+
+         S32 sent = ::sendmmsg(socketFd, msgs, batch, 0);
+#else
+         PacketSlot &slot = smSendRing->getReadSlot(0);
+         S32 sent = ::sendto(slot.socketFd, (const char *)slot.data, slot.size, 0, (sockaddr *)&slot.address, slot.addressLen) == SOCKET_ERROR ? -1 : 1;
+#endif
+
+         if (sent <= 0)
+         {
+            // Keep the packets if the socket buffer is full and retry on the
+            // next pass.  Anything else is dropped like a failed sendto().
+            if (PlatformNetState::getLastError() == Net::WouldBlock)
+               return;
+
+            smDroppedPackets++;
+            sent = 1;
+         }
+         else
+         {
+            smSendCalls++;
+            smSendPackets += sent;
+         }
+
+         smSendRing->commitRead(sent);
+      }
+   }
+
+   /// Block until one of the sockets is readable or the wait times out.
+   static void waitForPackets()
+   {
+#if defined(TORQUE_USE_WINSOCK)
+      fd_set readSet;
+      FD_ZERO(&readSet);
+      for (U32 i = 0; i < smNumSockets; i++)
+         FD_SET(smSockets[i], &readSet);
+
+      timeval timeout = { 0, WaitTimeoutMs * 1000 };
+      ::select(0, &readSet, NULL, NULL, &timeout);
+#else
+      pollfd fds[2];
+      for (U32 i = 0; i < smNumSockets; i++)
+      {
+         fds[i].fd = smSockets[i];
+         fds[i].events = POLLIN;
+         fds[i].revents = 0;
+      }
+
+      ::poll(fds, smNumSockets, WaitTimeoutMs);
+#endif
+   }
+
+   class IOThread : public Thread
+   {
+   public:
+      virtual void run(void *arg)
+      {
+         while (!checkForStop())
+         {
+            waitForPackets();
+
+            for (U32 i = 0; i < smNumSockets; i++)
+               receive(smSockets[i]);
+
+            flushSends();
+         }
+      }
+   };
+
+   static IOThread *smThread = NULL;
+
+   /// Bumped every time the thread is started so a restart from inside a
+   /// packet handler can be detected.
+   static U32 smStartCount = 0;
+
+   static bool isRunning()
+   {
+      return smThread != NULL;
+   }
+
+   static void start()
+   {
+      smNumSockets = 0;
+      if (PlatformNetState::udpSocket != NetSocket::INVALID)
+         smSockets[smNumSockets++] = PlatformNetState::smReservedSocketList.resolve(PlatformNetState::udpSocket);
+      if (PlatformNetState::udp6Socket != NetSocket::INVALID)
+         smSockets[smNumSockets++] = PlatformNetState::smReservedSocketList.resolve(PlatformNetState::udp6Socket);
+
+      if (smNumSockets == 0)
+         return;
+
+      if (!smReceiveRing)
+      {
+         smReceiveRing = new PacketRing;
+         smSendRing = new PacketRing;
+      }
+
+      smReceiveRing->clear();
+      smSendRing->clear();
+
+      smStartCount++;
+      smThread = new IOThread;
+      smThread->start();
+   }
+
+   static void stop()
+   {
+      if (!smThread)
+         return;
+
+      smThread->stop();
+      smThread->join();
+      delete smThread;
+      smThread = NULL;
+
+      // Get out whatever was still queued before the sockets go away.
+      flushSends();
+
+      smReceiveRing->clear();
+      smSendRing->clear();
+   }
+
+   static void shutdown()
+   {
+      stop();
+
+      SAFE_DELETE(smReceiveRing);
+      SAFE_DELETE(smSendRing);
+   }
+
+   /// Queue a packet for the I/O thread.  Returns false if the thread isn't
+   /// running or the ring is full, in which case the caller sends directly.
+   static bool queueSend(SOCKET socketFd, const sockaddr *address, socklen_t addressLen, const U8 *buffer, S32 bufferSize)
+   {
+      if (!smThread || bufferSize > Net::MaxPacketDataSize || smSendRing->getWriteCount() == 0)
+         return false;
+
+      AssertFatal(ThreadManager::isMainThread(), "NetIOThreadState::queueSend - packets may only be sent from the main thread while the I/O thread is running");
+
+      PacketSlot &slot = smSendRing->getWriteSlot(0);
+      slot.socketFd = socketFd;
+      dMemcpy(&slot.address, address, addressLen);
+      slot.addressLen = addressLen;
+      slot.size = bufferSize;
+      dMemcpy(slot.data, buffer, bufferSize);
+
+      smSendRing->commitWrite(1);
+      return true;
+   }
+}
+
+/// Convert the source of a received packet, returning false if the packet
+/// should be ignored.
+static bool getPacketSource(const sockaddr_storage &sa, NetAddress *srcAddress)
+{
+   if (sa.ss_family == AF_INET)
+      IPSocketToNetAddress((sockaddr_in *)&sa, srcAddress);
+   else if (sa.ss_family == AF_INET6)
+      IPSocket6ToNetAddress((sockaddr_in6 *)&sa, srcAddress);
+   else
+      return false;
+
+   // Skip our own broadcasts.
+   if (srcAddress->type == NetAddress::IPAddress &&
+      srcAddress->address.ipv4.netNum[0] == 127 &&
+      srcAddress->address.ipv4.netNum[1] == 0 &&
+      srcAddress->address.ipv4.netNum[2] == 0 &&
+      srcAddress->address.ipv4.netNum[3] == 1 &&
+      srcAddress->port == PlatformNetState::netPort)
+      return false;
+
+   return true;
+}
+
+AFTER_MODULE_INIT( Sim )
+{
+   Con::addVariable( "$Net::ioPacketsPerReceiveCall", TypeF32, &NetIOThreadState::smPacketsPerReceiveCall,
+      "Average number of packets read per system call by the UDP I/O thread.\n"
+      "@ingroup Networking" );
+   Con::addVariable( "$Net::ioPacketsPerSendCall", TypeF32, &NetIOThreadState::smPacketsPerSendCall,
+      "Average number of packets written per system call by the UDP I/O thread.\n"
+      "@ingroup Networking" );
+   Con::addVariable( "$Net::ioReceiveQueueDepth", TypeS32, &NetIOThreadState::smReceiveQueueDepth,
+      "Number of received packets waiting for the main thread on the last network update.\n"
+      "@ingroup Networking" );
+   Con::addVariable( "$Net::ioSendQueueDepth", TypeS32, &NetIOThreadState::smSendQueueDepth,
+      "Number of outgoing packets waiting for the UDP I/O thread on the last network update.\n"
+      "@ingroup Networking" );
+   Con::addVariable( "$Net::ioDroppedPackets", TypeS32, &NetIOThreadState::smDroppedPacketCount,
+      "Number of packets the UDP I/O thread dropped because a queue was full or a send failed.\n"
+      "@ingroup Networking" );
+}
+
 bool Net::init()
 {
 #if defined(TORQUE_USE_WINSOCK)
@@ -588,6 +932,7 @@ void Net::shutdown()
    }
 
    closePort();
+   NetIOThreadState::shutdown();
    PlatformNetState::initCount--;
 
    // Destroy event handlers
@@ -902,6 +1247,8 @@ Net::Error Net::sendtoSocket(NetSocket handleFd, const U8 *buffer, S32  bufferSi
 
 bool Net::openPort(S32 port, bool doBind)
 {
+   NetIOThreadState::stop();
+
    if (PlatformNetState::udpSocket != NetSocket::INVALID)
    {
       closeSocket(PlatformNetState::udpSocket);
@@ -917,6 +1264,7 @@ bool Net::openPort(S32 port, bool doBind)
    Net::smMulticastEnabled = Con::getBoolVariable("pref::Net::Multicast6Enabled", true);
    Net::smIpv4Enabled = Con::getBoolVariable("pref::Net::IPV4Enabled", true);
    Net::smIpv6Enabled = Con::getBoolVariable("pref::Net::IPV6Enabled", false);
+   Net::smIOThreadEnabled = Con::getBoolVariable("pref::Net::IOThread", false);
 
    // we turn off VDP in non-release builds because VDP does not support broadcast packets
    // which are required for LAN queries (PC->Xbox connectivity).  The wire protocol still
@@ -1039,6 +1387,9 @@ bool Net::openPort(S32 port, bool doBind)
 
    PlatformNetState::netPort = port;
 
+   if (Net::smIOThreadEnabled && !Journal::IsPlaying())
+      NetIOThreadState::start();
+
    return PlatformNetState::udpSocket != NetSocket::INVALID || PlatformNetState::udp6Socket != NetSocket::INVALID;
 }
 
@@ -1049,6 +1400,8 @@ NetSocket Net::getPort()
 
 void Net::closePort()
 {
+   NetIOThreadState::stop();
+
    if (PlatformNetState::udpSocket != NetSocket::INVALID)
       closeSocket(PlatformNetState::udpSocket);
    if (PlatformNetState::udp6Socket != NetSocket::INVALID)
@@ -1070,6 +1423,9 @@ Net::Error Net::sendto(const NetAddress *address, const U8 *buffer, S32  bufferS
          sockaddr_in ipAddr;
          NetAddressToIPSocket(address, &ipAddr);
 
+         if (NetIOThreadState::queueSend(socketFd, (sockaddr *)&ipAddr, sizeof(sockaddr_in), buffer, bufferSize))
+            return NoError;
+
          if (::sendto(socketFd, (const char*)buffer, bufferSize, 0,
             (sockaddr *)&ipAddr, sizeof(sockaddr_in)) == SOCKET_ERROR)
             return PlatformNetState::getLastError();
@@ -1089,6 +1445,10 @@ Net::Error Net::sendto(const NetAddress *address, const U8 *buffer, S32  bufferS
       {
          sockaddr_in6 ipAddr;
          NetAddressToIPSocket6(address, &ipAddr);
+
+         if (NetIOThreadState::queueSend(socketFd, (sockaddr *)&ipAddr, sizeof(sockaddr_in6), buffer, bufferSize))
+            return NoError;
+
          if (::sendto(socketFd, (const char*)buffer, bufferSize, 0,
           (struct sockaddr *) &ipAddr, sizeof(sockaddr_in6)) == SOCKET_ERROR)
             return PlatformNetState::getLastError();
@@ -1107,8 +1467,13 @@ Net::Error Net::sendto(const NetAddress *address, const U8 *buffer, S32  bufferS
 void Net::process()
 {
    // Process listening sockets
-   processListenSocket(PlatformNetState::udpSocket);
-   processListenSocket(PlatformNetState::udp6Socket);
+   if (NetIOThreadState::isRunning())
+      processIOThreadPackets();
+   else
+   {
+      processListenSocket(PlatformNetState::udpSocket);
+      processListenSocket(PlatformNetState::udp6Socket);
+   }
 
 #ifdef TORQUE_NET_CURL
    // process HTTPObject
@@ -1374,28 +1739,45 @@ void Net::processListenSocket(NetSocket socketHandle)
       if (bytesRead == -1)
          break;
 
-      if (sa.ss_family == AF_INET)
-         IPSocketToNetAddress((sockaddr_in *)&sa, &srcAddress);
-      else if (sa.ss_family == AF_INET6)
-        IPSocket6ToNetAddress((sockaddr_in6 *)&sa, &srcAddress);
-     else
+      if (bytesRead <= 0 || !getPacketSource(sa, &srcAddress))
          continue;
 
-      if (bytesRead <= 0)
-         continue;
+      tmpBuffer.size = bytesRead;
+
+      smPacketReceive->trigger(srcAddress, tmpBuffer);
+   }
+}
 
-      if (srcAddress.type == NetAddress::IPAddress &&
-         srcAddress.address.ipv4.netNum[0] == 127 &&
-         srcAddress.address.ipv4.netNum[1] == 0 &&
-         srcAddress.address.ipv4.netNum[2] == 0 &&
-         srcAddress.address.ipv4.netNum[3] == 1 &&
-         srcAddress.port == PlatformNetState::netPort)
+void Net::processIOThreadPackets()
+{
+   using namespace NetIOThreadState;
+
+   const U32 count = smReceiveRing->getReadCount();
+   const U32 startCount = smStartCount;
+
+   smReceiveQueueDepth = count;
+   smSendQueueDepth = PacketRing::Size - smSendRing->getWriteCount();
+   smDroppedPacketCount = smDroppedPackets;
+   smPacketsPerReceiveCall = F32(smReceivePackets) / getMax(U32(smReceiveCalls), 1U);
+   smPacketsPerSendCall = F32(smSendPackets) / getMax(U32(smSendCalls), 1U);
+
+   NetAddress srcAddress;
+   for (U32 i = 0; i < count; i++)
+   {
+      PacketSlot &slot = smReceiveRing->getReadSlot(i);
+      if (slot.size <= 0 || !getPacketSource(slot.address, &srcAddress))
          continue;
 
-      tmpBuffer.size = bytesRead;
+      // The packet is handed out straight from the ring slot.
+      RawData buffer((S8 *)slot.data, slot.size);
+      smPacketReceive->trigger(srcAddress, buffer);
 
-      smPacketReceive->trigger(srcAddress, tmpBuffer);
+      // A handler may have closed or reopened the port, which discards the ring.
+      if (!isRunning() || smStartCount != startCount)
+         return;
    }
+
+   smReceiveRing->commitRead(count);
 }
 
 NetSocket Net::openSocket()
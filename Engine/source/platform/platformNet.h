@@ -214,6 +214,7 @@ struct Net
    static bool smMulticastEnabled;
    static bool smIpv4Enabled;
    static bool smIpv6Enabled;
+   static bool smIOThreadEnabled;
    
    static ConnectionNotifyEvent*   smConnectionNotify;
    static ConnectionAcceptedEvent* smConnectionAccept;
@@ -277,6 +278,7 @@ struct Net
 private:
    static void process();
    static void processListenSocket(NetSocket socket);
+   static void processIOThreadPackets();
 
 };
 
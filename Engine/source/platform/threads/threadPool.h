@@ -32,6 +32,9 @@
 #ifndef _PLATFORM_THREAD_SEMAPHORE_H_
    #include "platform/threads/semaphore.h"
 #endif
+#ifndef _PLATFORMINTRINSICS_H_
+   #include "platform/platformIntrinsics.h"
+#endif
 #ifndef _TSINGLETON_H_
    #include "core/util/tSingleton.h"
 #endif
@@ -331,6 +334,20 @@ class ThreadPool
       ///   all items to complete.  -1 = infinite.
       void waitForAllItems( S32 timeOut = -1 );
 
+      /// Call @a func( index ) for every index in [0, count) and return once
+      /// all calls have completed.
+      ///
+      /// The calls are spread over the pool's worker threads and the calling
+      /// thread, which keeps taking indices itself rather than sleeping.  Only
+      /// the calls made here are waited for, so unlike waitForAllItems() this
+      /// is not held up by unrelated items and may be used from a worker.
+      ///
+      /// @param count Number of indices to process.
+      /// @param func Callable taking a U32 index; must be safe to call
+      ///   concurrently for different indices.
+      template< typename Functor >
+      void parallelFor( U32 count, Functor& func );
+
       /// Add a work item to the main thread's work queue.
       ///
       /// The main thread's work queue will be processed each frame using
@@ -420,4 +437,80 @@ inline ThreadPool& ThreadPool::GLOBAL()
    return *( GlobalThreadPool::instance() );
 }
 
+//--------------------------------------------------------------------------
+
+/// State shared between ThreadPool::parallelFor() and its work items.  This
+/// is reference-counted as items may still be dequeued after the call has
+/// returned; by then all indices are taken and they exit without touching
+/// the functor.
+template< typename Functor >
+struct ThreadPoolParallelForState : public ThreadSafeRefCount< ThreadPoolParallelForState< Functor > >
+{
+   Functor* mFunc;
+   U32 mCount;
+   volatile U32 mNext;
+   volatile U32 mDone;
+   Semaphore mFinished;
+
+   ThreadPoolParallelForState( Functor* func, U32 count )
+      : mFunc( func ), mCount( count ), mNext( 0 ), mDone( 0 ), mFinished( 0 ) {}
+
+   /// Take and process indices until there are none left.
+   void run()
+   {
+      while( true )
+      {
+         const U32 index = dAtomicRead( mNext );
+         if( index >= mCount )
+            return;
+         if( !dCompareAndSwap( mNext, index, index + 1 ) )
+            continue;
+
+         ( *mFunc )( index );
+
+         // Whoever completes the last index wakes up the caller.
+         U32 done;
+         do
+            done = dAtomicRead( mDone );
+         while( !dCompareAndSwap( mDone, done, done + 1 ) );
+         if( done + 1 == mCount )
+            mFinished.release();
+      }
+   }
+};
+
+template< typename Functor >
+struct ThreadPoolParallelForItem : public ThreadPool::WorkItem
+{
+   ThreadSafeRef< ThreadPoolParallelForState< Functor > > mState;
+
+   ThreadPoolParallelForItem( ThreadPoolParallelForState< Functor >* state )
+      : mState( state ) {}
+
+   void execute() override
+   {
+      mState->run();
+   }
+};
+
+template< typename Functor >
+void ThreadPool::parallelFor( U32 count, Functor& func )
+{
+   if( !count )
+      return;
+
+   typedef ThreadPoolParallelForState< Functor > StateType;
+   ThreadSafeRef< StateType > state = new StateType( &func, count );
+
+   // The calling thread takes its share too, so one item less will do.
+   const U32 numItems = getMin( count, mNumThreads + 1 ) - 1;
+   for( U32 i = 0; i < numItems; i ++ )
+      queueWorkItem( new ThreadPoolParallelForItem< Functor >( state ) );
+
+   state->run();
+
+   // Wait for the indices still being processed by the workers.
+   state->mFinished.acquire();
+}
+
 #endif // !_THREADPOOL_H_
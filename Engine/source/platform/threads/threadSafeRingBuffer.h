@@ -0,0 +1,120 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026 tgemit contributors.
+// See AUTHORS file and git repository for contributor information.
+//
+// SPDX-License-Identifier: MIT
+//-----------------------------------------------------------------------------
+
+#ifndef _THREADSAFERINGBUFFER_H_
+#define _THREADSAFERINGBUFFER_H_
+
+#ifndef _PLATFORMINTRINSICS_H_
+#  include "platform/platformIntrinsics.h"
+#endif
+#ifndef _PLATFORMASSERT_H_
+#  include "platform/platformAssert.h"
+#endif
+
+
+/// Lock-free ring of preallocated elements shared by exactly one producer
+/// thread and exactly one consumer thread.
+///
+/// Elements are never copied in or out.  The producer fills slots in place
+/// and publishes them with commitWrite(), the consumer reads them in place
+/// and hands them back with commitRead().  This allows large fixed size
+/// records (like network packets) to move between threads without any
+/// allocation.
+///
+/// @param T Element type; must have a default constructor.
+/// @param SIZE Number of slots; must be a power of two.
+template< typename T, U32 SIZE >
+class ThreadSafeRingBuffer
+{
+   public:
+
+      typedef T ValueType;
+
+      enum { Size = SIZE, Mask = SIZE - 1 };
+
+   protected:
+
+      /// Slot storage; allocated on the heap as it may be large.
+      T* mSlots;
+
+      /// Total number of slots ever written.  Only advanced by the producer.
+      volatile U32 mHead;
+
+      /// Total number of slots ever read.  Only advanced by the consumer.
+      volatile U32 mTail;
+
+   public:
+
+      ThreadSafeRingBuffer()
+         : mSlots( new T[ SIZE ] ), mHead( 0 ), mTail( 0 )
+      {
+         AssertFatal( SIZE && !( SIZE & Mask ), "ThreadSafeRingBuffer - size must be a power of two" );
+      }
+
+      ~ThreadSafeRingBuffer()
+      {
+         delete [] mSlots;
+      }
+
+      /// Discard all queued elements.  Neither side may be active while
+      /// this is called.
+      void clear()
+      {
+         mHead = 0;
+         mTail = 0;
+      }
+
+      /// @name Producer
+      /// @{
+
+      /// Return the number of slots that may currently be written.
+      U32 getWriteCount()
+      {
+         return SIZE - ( mHead - dAtomicRead( mTail ) );
+      }
+
+      /// Return the @a index'th free slot after the last published one.
+      /// @a index must be less than getWriteCount().
+      T& getWriteSlot( U32 index )
+      {
+         return mSlots[ ( mHead + index ) & Mask ];
+      }
+
+      /// Publish the next @a count written slots to the consumer.
+      void commitWrite( U32 count )
+      {
+         dFetchAndAdd( mHead, count );
+      }
+
+      /// @}
+
+      /// @name Consumer
+      /// @{
+
+      /// Return the number of slots that are ready to be read.
+      U32 getReadCount()
+      {
+         return dAtomicRead( mHead ) - mTail;
+      }
+
+      /// Return the @a index'th published slot that has not been read yet.
+      /// @a index must be less than getReadCount().
+      T& getReadSlot( U32 index )
+      {
+         return mSlots[ ( mTail + index ) & Mask ];
+      }
+
+      /// Hand the next @a count read slots back to the producer.
+      void commitRead( U32 count )
+      {
+         dFetchAndAdd( mTail, count );
+      }
+
+      /// @}
+};
+
+#endif // _THREADSAFERINGBUFFER_H_
@@ -40,6 +40,7 @@ RenderBinManager::RenderBinManager( const RenderInstType& ritype, F32 renderOrde
    mBasicOnly ( false )
 {
    VECTOR_SET_ASSOCIATION( mElementList );
+   VECTOR_SET_ASSOCIATION( mSortScratch );
    mElementList.reserve( 2048 );
 }
 
@@ -139,7 +140,73 @@ void RenderBinManager::clear()
 
 void RenderBinManager::sort()
 {
-   dQsort( mElementList.address(), mElementList.size(), sizeof(MainSortElem), cmpKeyFunc);
+   _sortByKeys( mElementList );
+}
+
+void RenderBinManager::_sortByKeys( Vector<MainSortElem> &list )
+{
+   for ( U32 i=0; i < list.size(); i++ )
+      list[i].sortKey = makeSortKey( list[i].key, list[i].key2 );
+
+   radixSort( list, mSortScratch );
+}
+
+void RenderBinManager::radixSort( Vector<MainSortElem> &list, Vector<MainSortElem> &scratch )
+{
+   PROFILE_SCOPE( RenderBinManager_radixSort );
+
+   const U32 count = list.size();
+   if ( count < 2 )
+      return;
+
+   scratch.setSize( count );
+
+   // Gather the histograms for all eight bytes of
+   // the key in a single pass over the elements.
+   U32 histograms[8][256];
+   dMemset( histograms, 0, sizeof( histograms ) );
+
+   const MainSortElem *elems = list.address();
+   for ( U32 i=0; i < count; i++ )
+   {
+      U64 key = elems[i].sortKey;
+      for ( U32 b=0; b < 8; b++, key >>= 8 )
+         histograms[b][key & 0xFF]++;
+   }
+
+   MainSortElem *src = list.address();
+   MainSortElem *dst = scratch.address();
+
+   for ( U32 b=0; b < 8; b++ )
+   {
+      U32 *histogram = histograms[b];
+      const U32 shift = b * 8;
+
+      // If every element shares this byte then this
+      // pass would not change the order... skip it.
+      if ( histogram[ ( src[0].sortKey >> shift ) & 0xFF ] == count )
+         continue;
+
+      // Convert the counts into starting offsets.
+      U32 offset = 0;
+      for ( U32 i=0; i < 256; i++ )
+      {
+         const U32 bucketSize = histogram[i];
+         histogram[i] = offset;
+         offset += bucketSize;
+      }
+
+      for ( U32 i=0; i < count; i++ )
+         dst[ histogram[ ( src[i].sortKey >> shift ) & 0xFF ]++ ] = src[i];
+
+      MainSortElem *temp = src;
+      src = dst;
+      dst = temp;
+   }
+
+   // Copy the result back if it ended up in the scratch buffer.
+   if ( src != list.address() )
+      dMemcpy( list.address(), src, sizeof( MainSortElem ) * count );
 }
 
 S32 FN_CDECL RenderBinManager::cmpKeyFunc(const void* p1, const void* p2)
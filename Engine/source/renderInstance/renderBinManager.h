@@ -81,6 +81,14 @@ public:
    /// QSort callback function
    static S32 FN_CDECL cmpKeyFunc(const void* p1, const void* p2);
 
+   /// Packs the primary and secondary keys into a single 64bit
+   /// key which sorts the primary key descending and the secondary
+   /// key ascending.  Each key keeps its full 32bits here so the
+   /// radix order matches cmpKeyFunc.  Bins which pack their own
+   /// narrower fields into the sortKey, like RenderMeshMgr, only
+   /// match cmpKeyFunc while the keys fit the packed width.
+   static inline U64 makeSortKey( U32 key, U32 key2 ) { return ( U64( ~key ) << 32 ) | U64( key2 ); }
+
    DECLARE_CONOBJECT(RenderBinManager);
    static void initPersistFields();
 
@@ -91,8 +99,16 @@ public:
       RenderInst *inst;
       U32 key;
       U32 key2;
+
+      /// The packed key used by the radix sort.
+      /// @see makeSortKey
+      U64 sortKey;
    };
 
+   /// Does a stable LSD radix sort of the elements by their 64bit
+   /// sortKey using the scratch vector as a temporary buffer.
+   static void radixSort( Vector<MainSortElem> &list, Vector<MainSortElem> &scratch );
+
 protected:
    void setRenderPass( RenderPassManager *rpm );
 
@@ -101,6 +117,7 @@ protected:
    void notifyType( const RenderInstType &type );
 
    Vector< MainSortElem > mElementList; // List of our instances
+   Vector< MainSortElem > mSortScratch; // Temporary buffer for radixSort()
    F32 mProcessAddOrder;   // Where in the list do we process RenderInstance additions?
    F32 mRenderOrder;       // Where in the list do we render?
 
@@ -119,6 +136,10 @@ protected:
    virtual void setupSGData(MeshRenderInst *ri, SceneData &data );
    virtual void internalAddElement(RenderInst* inst);
 
+   /// Builds the 64bit sort key for every element from its
+   /// key and key2 and then radix sorts the list.
+   void _sortByKeys( Vector<MainSortElem> &list );
+
    /// A inlined helper method for testing if the next 
    /// MeshRenderInst requires a new batch/pass.
    inline bool newPassNeeded( MeshRenderInst *ri, MeshRenderInst* nextRI ) const;
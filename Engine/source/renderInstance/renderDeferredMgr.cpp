@@ -42,6 +42,7 @@
 #include "lighting/advanced/advancedLightBinManager.h"
 #include "terrain/terrCell.h"
 #include "renderInstance/renderTerrainMgr.h"
+#include "renderInstance/renderMeshMgr.h"
 #include "terrain/terrCellMaterial.h"
 #include "math/mathUtils.h"
 #include "math/util/matrixSet.h"
@@ -283,14 +284,26 @@ void RenderDeferredMgr::addElement( RenderInst *inst )
       elem.key2 = matInst->getStateHint();
    else
       elem.key2 = originalKey;
+
+   // With auto instancing we group meshes by material and then
+   // geometry so that identical meshes end up next to each other.
+   // Within a group they are still drawn front to back.
+   if (isMeshInst && matInst && RenderMeshMgr::smAutoInstancing)
+   {
+      U32 distBits;
+      dMemcpy(&distBits, &inst->sortDistSq, sizeof(distBits));
+
+      elem.key = matInst->getStateHint();
+      elem.key2 = (RenderMeshMgr::getMeshKey(static_cast<MeshRenderInst*>(inst)) << 16) | (distBits >> 16);
+   }
 }
 
 void RenderDeferredMgr::sort()
 {
    PROFILE_SCOPE( RenderDeferredMgr_sort );
    Parent::sort();
-   dQsort( mTerrainElementList.address(), mTerrainElementList.size(), sizeof(MainSortElem), cmpKeyFunc);
-   dQsort( mObjectElementList.address(), mObjectElementList.size(), sizeof(MainSortElem), cmpKeyFunc);
+   _sortByKeys( mTerrainElementList );
+   _sortByKeys( mObjectElementList );
 }
 
 void RenderDeferredMgr::clear()
@@ -384,8 +397,21 @@ void RenderDeferredMgr::render( SceneRenderState *state )
    {
       MeshRenderInst *ri = static_cast<MeshRenderInst*>( itr->inst );
 
-      // Get the deferred material.
-      BaseMatInstance *mat = getDeferredMaterial( ri->matInst );
+      // Get the deferred material, switching to the instancing
+      // version for long runs of the same mesh.
+      // An auto instanced batch stops at the end of the run.
+      U32 batchEnd = mElementList.size();
+      BaseMatInstance *baseMat = ri->matInst;
+      if ( ri->type == RenderPassManager::RIT_Mesh )
+         baseMat = RenderMeshMgr::getAutoInstancingMat( baseMat, mElementList, itr - mElementList.begin(), &batchEnd );
+      BaseMatInstance *mat = getDeferredMaterial( baseMat );
+      if ( baseMat != ri->matInst && ( !mat || !mat->isValid() ) )
+      {
+         mat = getDeferredMaterial( ri->matInst );
+         batchEnd = mElementList.size();
+      }
+
+      Vector< MainSortElem >::const_iterator batchEndItr = mElementList.begin() + batchEnd;
 
       // Set up SG data proper like and flag it 
       // as a pre-pass render
@@ -396,7 +422,7 @@ void RenderDeferredMgr::render( SceneRenderState *state )
       while ( mat->setupPass( state, sgData ) )
       {
          meshItr = itr;
-         for ( ; meshItr != mElementList.end(); meshItr++ )
+         for ( ; meshItr != batchEndItr; meshItr++ )
          {
             MeshRenderInst *passRI = static_cast<MeshRenderInst*>( meshItr->inst );
 
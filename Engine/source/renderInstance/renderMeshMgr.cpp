@@ -32,10 +32,14 @@
 #include "scene/sceneRenderState.h"
 #include "gfx/gfxDebugEvent.h"
 #include "math/util/matrixSet.h"
+#include "ts/instancingMatHook.h"
 
 
 IMPLEMENT_CONOBJECT(RenderMeshMgr);
 
+bool RenderMeshMgr::smAutoInstancing = true;
+S32 RenderMeshMgr::smMinAutoInstances = 4;
+
 ConsoleDocClass( RenderMeshMgr, 
    "@brief A render bin for mesh rendering.\n\n"
    "This is the primary render bin in Torque which does most of the "
@@ -73,6 +77,17 @@ void RenderMeshMgr::init()
 void RenderMeshMgr::initPersistFields()
 {
    docsURL;
+   Con::addVariable( "$pref::RenderMeshMgr::autoInstancing", TypeBool, &smAutoInstancing,
+      "@brief If true runs of identical non-skinned meshes sharing a material are "
+      "drawn with a single hardware instanced draw call.\n"
+      "@ingroup RenderBin\n" );
+
+   Con::addVariable( "$pref::RenderMeshMgr::minAutoInstances", TypeS32, &smMinAutoInstances,
+      "@brief The minimum count of identical meshes in a row before they are "
+      "automatically drawn as a single instanced draw call.\n"
+      "The default value is 4.\n"
+      "@ingroup RenderBin\n" );
+
    Parent::initPersistFields();
 }
 
@@ -88,6 +103,121 @@ void RenderMeshMgr::addElement( RenderInst *inst )
    AssertFatal( inst->defaultKey != 0, "RenderMeshMgr::addElement() - Got null sort key... did you forget to set it?" );
 
    internalAddElement(inst);
+
+   MainSortElem &elem = mElementList.last();
+   elem.sortKey = _makeMeshSortKey( static_cast<MeshRenderInst*>( inst ) );
+}
+
+U64 RenderMeshMgr::_makeMeshSortKey( MeshRenderInst *ri ) const
+{
+   // The pass is the primary type of this bin followed
+   // by the additional types it was notified about.
+   U64 pass = 0;
+   if ( ri->type != (RenderInstTypeHash)mRenderInstType )
+   {
+      for ( U32 i=0; i < mOtherTypes.size(); i++ )
+      {
+         if ( ri->type == (RenderInstTypeHash)mOtherTypes[i] )
+         {
+            pass = i + 1;
+            break;
+         }
+      }
+   }
+
+   // The default key is the material state hint, fold it
+   // down to 24bits.  A collision only costs us a batch
+   // break as newPassNeeded() still checks the real state.
+   const U32 matKey = ri->defaultKey;
+   const U64 material = ( matKey ^ ( matKey >> 24 ) ) & 0xFFFFFF;
+
+   // Identical meshes end up next to each other so
+   // they can be batched into instanced draws.
+   const U64 mesh = getMeshKey( ri );
+
+   // The bit pattern of a positive float sorts in the same
+   // order as its value, so the upper 16bits of the distance
+   // give us a coarse front to back order.
+   U32 distBits;
+   dMemcpy( &distBits, &ri->sortDistSq, sizeof( distBits ) );
+   const U64 depth = ( distBits >> 16 ) & 0xFFFF;
+
+   return ( ( pass & 0xFF ) << 56 ) | ( material << 32 ) | ( mesh << 16 ) | depth;
+}
+
+U32 RenderMeshMgr::getMeshKey( const MeshRenderInst *ri )
+{
+   uintptr_t meshKey = ( (uintptr_t)ri->vertBuff >> 4 ) ^ ( (uintptr_t)ri->prim >> 4 );
+   meshKey ^= meshKey >> 16;
+   meshKey ^= meshKey >> 32;
+   meshKey ^= ri->primBuffIndex * 0x9E37;
+   return meshKey & 0xFFFF;
+}
+
+U32 RenderMeshMgr::getIdenticalRunLength( const Vector<MainSortElem> &elements, U32 start )
+{
+   const MeshRenderInst *ri = static_cast<MeshRenderInst*>( elements[start].inst );
+
+   U32 end = start + 1;
+   for ( ; end < elements.size(); end++ )
+   {
+      const MeshRenderInst *nextRI = static_cast<MeshRenderInst*>( elements[end].inst );
+
+      if (  ri->matInst != nextRI->matInst ||
+            ri->vertBuff != nextRI->vertBuff ||
+            ri->primBuff != nextRI->primBuff ||
+            ri->prim != nextRI->prim ||
+            ri->primBuffIndex != nextRI->primBuffIndex ||
+            ri->lightmap != nextRI->lightmap ||
+            ri->cubemap != nextRI->cubemap ||
+            ri->reflectTex != nextRI->reflectTex ||
+            ri->miscTex != nextRI->miscTex ||
+            ri->accuTex != nextRI->accuTex ||
+            dMemcmp( ri->lights, nextRI->lights, sizeof( ri->lights ) ) != 0 )
+         break;
+   }
+
+   return end - start;
+}
+
+BaseMatInstance* RenderMeshMgr::getAutoInstancingMat( BaseMatInstance *mat, const Vector<MainSortElem> &elements, U32 start, U32 *outBatchEnd )
+{
+#ifdef TORQUE_OS_MAC
+
+   // Hardware instancing is disabled on Mac as it
+   // is in TSMesh::innerRender().
+   return mat;
+
+#else
+
+   if (  !smAutoInstancing ||
+         mat->isInstanced() ||
+         mat->isCustomMaterial() ||
+         mat->usesHardwareSkinning() )
+      return mat;
+
+   const U32 runLength = getIdenticalRunLength( elements, start );
+   if ( runLength < (U32)getMax( smMinAutoInstances, 2 ) )
+      return mat;
+
+   // The instancing material can fail to initialize in
+   // which case we fall back to the regular material.
+   BaseMatInstance *instMat = InstancingMaterialHook::getInstancingMat( mat );
+   if ( !instMat || !instMat->isValid() )
+      return mat;
+
+   *outBatchEnd = start + runLength;
+   return instMat;
+
+#endif
+}
+
+void RenderMeshMgr::sort()
+{
+   PROFILE_SCOPE( RenderMeshMgr_sort );
+
+   // The keys were already packed in addElement().
+   radixSort( mElementList, mSortScratch );
 }
 
 //-----------------------------------------------------------------------------
@@ -122,6 +252,7 @@ void RenderMeshMgr::render(SceneRenderState * state)
    sgData.init( state );
 
    U32 binSize = mElementList.size();
+   GFXDeviceStatistics *stats = GFX->getDeviceStatistics();
 
    for( U32 j=0; j<binSize; )
    {
@@ -142,8 +273,13 @@ void RenderMeshMgr::render(SceneRenderState * state)
          }
       }
 
+      // An auto instanced batch stops at the end of the run.
+      U32 batchEnd = binSize;
+
       if( !mat )
          mat = MATMGR->getWarningMatInstance();
+      else if ( !mMatOverrideDelegate )
+         mat = getAutoInstancingMat( mat, mElementList, j, &batchEnd );
 
       // Check if bin is disabled in advanced lighting.
       // Allow forward rendering pass on custom materials.
@@ -160,7 +296,7 @@ void RenderMeshMgr::render(SceneRenderState * state)
 
       while( mat && mat->setupPass(state, sgData ) )
       {
-         for( a=j; a<binSize; a++ )
+         for( a=j; a<batchEnd; a++ )
          {
             MeshRenderInst *passRI = static_cast<MeshRenderInst*>(mElementList[a].inst);
 
@@ -172,6 +308,11 @@ void RenderMeshMgr::render(SceneRenderState * state)
                break;
             }
 
+            // Every instance after the first in the batch
+            // reuses the material and buffer state.
+            if ( a != j )
+               stats->mStateChangesAvoided++;
+
             matrixSet.setWorld(*passRI->objectToWorld);
             matrixSet.setView(*passRI->worldToCamera);
             matrixSet.setProjection(*passRI->projection);
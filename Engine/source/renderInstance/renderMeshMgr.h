@@ -40,15 +40,53 @@ public:
    virtual void init();
    void render(SceneRenderState * state) override;
    void addElement( RenderInst *inst ) override;
+   void sort() override;
 
    // ConsoleObject interface
    static void initPersistFields();
    DECLARE_CONOBJECT(RenderMeshMgr);
+
+   /// If true runs of identical mesh instances are
+   /// automatically drawn with a single instanced draw.
+   static bool smAutoInstancing;
+
+   /// The minimum count of identical mesh instances in
+   /// a row before we switch to an instanced draw.
+   static S32 smMinAutoInstances;
+
+   /// Returns the vertex buffer, primitive and primitive
+   /// index of the mesh instance folded down to 16bits.
+   static U32 getMeshKey( const MeshRenderInst *ri );
+
+   /// Returns the count of mesh instances starting at the
+   /// element index which share the same material, geometry,
+   /// lights and textures.
+   static U32 getIdenticalRunLength( const Vector<MainSortElem> &elements, U32 start );
+
+   /// Returns the instancing version of the material if the
+   /// run of mesh instances starting at the element index is
+   /// long enough to be worth an instanced draw.  In that case
+   /// outBatchEnd is set to the element index past the run.  The
+   /// instanced draw only gets the textures of the first instance
+   /// so the batch must not go past it.
+   ///
+   /// This is shared with RenderDeferredMgr which draws the
+   /// meshes in place of this bin under Advanced Lighting.
+   static BaseMatInstance* getAutoInstancingMat( BaseMatInstance *mat, const Vector<MainSortElem> &elements, U32 start, U32 *outBatchEnd );
+
 protected:
    GFXStateBlockRef mNormalSB;
    GFXStateBlockRef mReflectSB;
 
    void construct();
+
+   /// Builds the packed 64bit sort key for a mesh instance.
+   ///
+   /// From the most to the least significant bits the key holds
+   /// the pass, the material state hint, the mesh geometry and the
+   /// camera distance.  This groups instances so that we minimize
+   /// material and buffer changes and then draw front to back.
+   U64 _makeMeshSortKey( MeshRenderInst *ri ) const;
 };
 
 #endif // _RENDERMESHMGR_H_
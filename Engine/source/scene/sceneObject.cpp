@@ -99,6 +99,7 @@ extern bool gEditingMission;
 
 Signal< void( SceneObject* ) > SceneObject::smSceneObjectAdd;
 Signal< void( SceneObject* ) > SceneObject::smSceneObjectRemove;
+Signal< void( SceneObject*, const Box3F& ) > SceneObject::smStaticObjectMoved;
 
 
 //-----------------------------------------------------------------------------
@@ -421,6 +422,8 @@ void SceneObject::setTransform( const MatrixF& mat )
 
    // Update the transforms.
 
+   const Box3F oldWorldBox = mWorldBox;
+
    mObjToWorld = mWorldToObj = mat;
    mWorldToObj.affineInverse();
 
@@ -431,8 +434,13 @@ void SceneObject::setTransform( const MatrixF& mat )
    // If we're in a SceneManager, sync our scene state.
 
    if( mSceneManager != NULL )
+   {
       mSceneManager->notifyObjectDirty( this );
 
+      if( isStaticGeometry() )
+         smStaticObjectMoved.trigger( this, oldWorldBox );
+   }
+
    setRenderTransform( mat );
 }
 
@@ -357,10 +357,24 @@ class SceneObject : public NetObject, public ProcessObject
       /// Triggered when a SceneObject onRemove is called.
       static Signal< void( SceneObject* ) > smSceneObjectRemove;
 
+      /// Triggered when an object whose isStaticGeometry() is true
+      /// changes its transform or shape, with its world box before
+      /// the change.
+      static Signal< void( SceneObject*, const Box3F& ) > smStaticObjectMoved;
+
       /// Return the type mask that indicates to which broad object categories
       /// this object belongs.
       U32 getTypeMask() const { return mTypeMask; }
 
+      /// Returns true if the rendered geometry of this object only changes
+      /// when it is added, removed or moved, or when it triggers
+      /// smStaticObjectMoved itself.  Results like shadow maps may then be
+      /// cached until one of those happens.
+      ///
+      /// This is false by default as StaticObjectType alone doesn't mean the
+      /// geometry never animates.
+      virtual bool isStaticGeometry() const { return false; }
+
       /// @name SceneManager Functionality
       /// @{
 
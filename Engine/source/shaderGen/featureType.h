@@ -70,6 +70,10 @@ public:
    /// Adds all the default features types to the set.
    static void addDefaultTypes( FeatureSet *outFeatures );
 
+   /// Returns the feature type with this name or NULL
+   /// if it doesn't exist.
+   static const FeatureType* find( const String &name );
+
    /// You should not use this constructor directly.
    /// @see DeclareFeatureType
    /// @see ImplementFeatureType
@@ -30,6 +30,9 @@
 #include "gfx/gfxDevice.h"
 #include "core/memVolume.h"
 #include "core/module.h"
+#include "console/engineAPI.h"
+#include "app/version.h"
+#include "console/consoleTypes.h"
 
 #ifdef TORQUE_D3D11
 #include "shaderGen/HLSL/customFeatureHLSL.h"
@@ -57,6 +60,165 @@ MODULE_END;
 
 String ShaderGen::smCommonShaderPath("shaders/common");
 
+// Debug and tools builds are where shader features get
+// worked on, so they always regenerate by default.
+#if defined(TORQUE_DEBUG) || defined(TORQUE_TOOLS)
+bool ShaderGen::smUseCache = false;
+#else
+bool ShaderGen::smUseCache = true;
+#endif
+
+
+AFTER_MODULE_INIT( Sim )
+{
+   Con::addVariable( "$ShaderGen::useCache", TypeBool, &ShaderGen::smUseCache,
+      "If true the procedural shader source in $shaderGen::cachePath is reused "
+      "when it was generated by the same engine build.  Turn it off when working "
+      "on shader features.  Defaults to false in debug and tools builds and true "
+      "otherwise.\n"
+      "@ingroup Materials\n" );
+}
+
+
+/// The version of the cache entry files.
+static const U8 sCacheEntryVersion = 1;
+
+/// The version of the generated shader source.  Bump this when
+/// a shader feature changes the source it generates so that
+/// release builds don't reuse stale cache entries.
+static const U32 sShaderGenVersion = 1;
+
+static void _writeFeatures( Stream &stream, const FeatureSet &features )
+{
+   stream.write( (U32)features.getCount() );
+   for ( U32 i=0; i < features.getCount(); i++ )
+   {
+      S32 index;
+      const FeatureType &type = features.getAt( i, &index );
+      stream.write( type.getName() );
+      stream.write( index );
+   }
+}
+
+static bool _readFeatures( Stream &stream, FeatureSet *outFeatures )
+{
+   U32 count = 0;
+   stream.read( &count );
+   for ( U32 i=0; i < count; i++ )
+   {
+      String name;
+      S32 index;
+      stream.read( &name );
+      stream.read( &index );
+
+      const FeatureType *type = FeatureType::find( name );
+      if ( !type )
+         return false;
+
+      outFeatures->addFeature( *type, index );
+   }
+
+   return stream.getStatus() == Stream::Ok;
+}
+
+static void _writeVertexFormat( Stream &stream, const GFXVertexFormat &format )
+{
+   stream.write( format.getElementCount() );
+   for ( U32 i=0; i < format.getElementCount(); i++ )
+   {
+      const GFXVertexElement &element = format.getElement( i );
+      stream.write( element.getSemantic() );
+      stream.write( (U32)element.getType() );
+      stream.write( element.getSemanticIndex() );
+      stream.write( element.getStreamIndex() );
+   }
+}
+
+static bool _readVertexFormat( Stream &stream, GFXVertexFormat *outFormat )
+{
+   U32 count = 0;
+   stream.read( &count );
+   for ( U32 i=0; i < count; i++ )
+   {
+      String semantic;
+      U32 type, index, streamIndex;
+      stream.read( &semantic );
+      stream.read( &type );
+      stream.read( &index );
+      stream.read( &streamIndex );
+
+      if ( type >= GFXDeclType_COUNT )
+         return false;
+
+      outFormat->addElement( semantic, (GFXDeclType)type, index, streamIndex );
+   }
+
+   return stream.getStatus() == Stream::Ok;
+}
+
+bool ShaderGenCacheEntry::write( Stream &stream ) const
+{
+   stream.write( 4, "SGCE" );
+   stream.write( sCacheEntryVersion );
+   stream.write( (U32)( stamp >> 32 ) );
+   stream.write( (U32)( stamp & 0xFFFFFFFF ) );
+
+   _writeFeatures( stream, featureData.features );
+   _writeFeatures( stream, featureData.materialFeatures );
+   _writeVertexFormat( stream, vertexFormat );
+
+   stream.write( (U32)macros.size() );
+   for ( U32 i=0; i < macros.size(); i++ )
+   {
+      stream.write( macros[i].name );
+      stream.write( macros[i].value );
+   }
+
+   stream.write( (U32)samplers.size() );
+   for ( U32 i=0; i < samplers.size(); i++ )
+      stream.write( samplers[i] );
+
+   _writeVertexFormat( stream, instancingFormat );
+
+   return stream.getStatus() == Stream::Ok;
+}
+
+bool ShaderGenCacheEntry::read( Stream &stream )
+{
+   char id[4];
+   U8 version;
+   stream.read( 4, id );
+   stream.read( &version );
+   if ( dStrncmp( id, "SGCE", 4 ) != 0 || version != sCacheEntryVersion )
+      return false;
+
+   U32 high, low;
+   stream.read( &high );
+   stream.read( &low );
+   stamp = ( (U64)high << 32 ) | low;
+
+   if (  !_readFeatures( stream, &featureData.features ) ||
+         !_readFeatures( stream, &featureData.materialFeatures ) ||
+         !_readVertexFormat( stream, &vertexFormat ) )
+      return false;
+
+   U32 count = 0;
+   stream.read( &count );
+   macros.setSize( count );
+   for ( U32 i=0; i < count; i++ )
+   {
+      stream.read( &macros[i].name );
+      stream.read( &macros[i].value );
+   }
+
+   stream.read( &count );
+   samplers.setSize( count );
+   for ( U32 i=0; i < count; i++ )
+      stream.read( &samplers[i] );
+
+   return _readVertexFormat( stream, &instancingFormat );
+}
+
 ShaderGen::ShaderGen()
 {
    mInit = false;
@@ -151,16 +313,10 @@ void ShaderGen::generateShader( const MaterialFeatureData &featureData,
    _uninit();
    _init();
 
-   char vertShaderName[256];
-   char pixShaderName[256];
-
-   // Note:  We use a postfix of _V/_P here so that it sorts the matching
-   // vert and pixel shaders together when listed alphabetically.
-   dSprintf( vertShaderName, sizeof(vertShaderName), "shadergen:/%s_V.%s", cacheName, mFileEnding.c_str() );
-   dSprintf( pixShaderName, sizeof(pixShaderName), "shadergen:/%s_P.%s", cacheName, mFileEnding.c_str() );
+   _getShaderFiles( cacheName, vertFile, pixFile );
 
-   dStrcpy( vertFile, vertShaderName, 256 );
-   dStrcpy( pixFile, pixShaderName, 256 );
+   const char *vertShaderName = vertFile;
+   const char *pixShaderName = pixFile;
 
    // this needs to change - need to optimize down to ps v.1.1
    *pixVersion = GFX->getPixelShaderVersion();
@@ -212,6 +368,161 @@ void ShaderGen::generateShader( const MaterialFeatureData &featureData,
    LangElement::deleteElements();
 }
 
+void ShaderGen::_getShaderFiles( const char *cacheName, char *vertFile, char *pixFile )
+{
+   // Note:  We use a postfix of _V/_P here so that it sorts the matching
+   // vert and pixel shaders together when listed alphabetically.
+   dSprintf( vertFile, 256, "shadergen:/%s_V.%s", cacheName, mFileEnding.c_str() );
+   dSprintf( pixFile, 256, "shadergen:/%s_P.%s", cacheName, mFileEnding.c_str() );
+}
+
+String ShaderGen::_getCacheEntryFile( const String &cacheName )
+{
+   return "shadergen:/" + cacheName + ".sgc";
+}
+
+U64 ShaderGen::getCacheStamp( const String &description, const FeatureSet &features ) const
+{
+   // The generated source changes with the engine build and
+   // with the feature implementations, which differ between
+   // the lighting managers.  The build time alone misses
+   // builds which didn't recompile this file.
+   String stamp = description;
+   stamp += String::ToString( sShaderGenVersion );
+   stamp += getVersionString();
+   stamp += getCompileTimeString();
+   stamp += mFileEnding;
+
+   for ( U32 i=0; i < features.getCount(); i++ )
+   {
+      ShaderFeature *feature = FEATUREMGR->getByType( features.getAt( i ) );
+      if ( feature )
+         stamp += feature->getName();
+   }
+
+   return Torque::hash64( (const U8*)stamp.c_str(), stamp.length(), 0 );
+}
+
+bool ShaderGen::_loadCachedShader(  const MaterialFeatureData &featureData,
+                                    const GFXVertexFormat *vertexFormat,
+                                    const String &cacheName,
+                                    U64 stamp,
+                                    char *vertFile,
+                                    char *pixFile,
+                                    F32 *pixVersion,
+                                    Vector<GFXShaderMacro> &macros )
+{
+   if ( !smUseCache )
+      return false;
+
+   PROFILE_SCOPE( ShaderGen_LoadCachedShader );
+
+   _getShaderFiles( cacheName, vertFile, pixFile );
+
+   if (  !Torque::FS::IsFile( vertFile ) ||
+         !Torque::FS::IsFile( pixFile ) )
+      return false;
+
+   FileStream stream;
+   if ( !stream.open( _getCacheEntryFile( cacheName ), Torque::FS::File::Read ) )
+      return false;
+
+   ShaderGenCacheEntry entry;
+   if ( !entry.read( stream ) || entry.stamp != stamp )
+      return false;
+
+   mFeatureData = featureData;
+   mVertexFormat = vertexFormat;
+
+   _uninit();
+   _init();
+
+   *pixVersion = GFX->getPixelShaderVersion();
+
+   // The features still need to add their macros.
+   _processVertFeatures( macros, true );
+   _processPixFeatures( macros, true );
+
+   mInstancingFormat.copy( entry.instancingFormat );
+
+   return true;
+}
+
+void ShaderGen::_writeCacheEntry(   const MaterialFeatureData &featureData,
+                                    const GFXVertexFormat *vertexFormat,
+                                    const String &cacheName,
+                                    U64 stamp,
+                                    const Vector<GFXShaderMacro> *macros,
+                                    const Vector<String> &samplers )
+{
+   PROFILE_SCOPE( ShaderGen_WriteCacheEntry );
+
+   ShaderGenCacheEntry entry;
+   entry.stamp = stamp;
+   entry.featureData = featureData;
+   entry.vertexFormat.copy( *vertexFormat );
+   if ( macros )
+      entry.macros = *macros;
+   entry.samplers = samplers;
+   entry.instancingFormat.copy( mInstancingFormat );
+
+   FileStream stream;
+   if ( !stream.open( _getCacheEntryFile( cacheName ), Torque::FS::File::Write ) )
+      return;
+
+   entry.write( stream );
+}
+
+bool ShaderGen::writeCacheManifest( const Torque::Path &path )
+{
+   FileStream stream;
+   if ( !stream.open( path, Torque::FS::File::Write ) )
+   {
+      Con::errorf( "ShaderGen::writeCacheManifest - Failed to open '%s'.", path.getFullPath().c_str() );
+      return false;
+   }
+
+   ShaderMap::Iterator iter = mProcShaders.begin();
+   for ( ; iter != mProcShaders.end(); iter++ )
+   {
+      if ( iter->value )
+         stream.writeLine( (const U8*)iter->key.c_str() );
+   }
+
+   return true;
+}
+
+U32 ShaderGen::pregenerateShaders( const Torque::Path &path )
+{
+   PROFILE_SCOPE( ShaderGen_PregenerateShaders );
+
+   FileStream stream;
+   if ( !stream.open( path, Torque::FS::File::Read ) )
+      return 0;
+
+   U32 count = 0;
+   char line[256];
+   while ( stream.getStatus() == Stream::Ok )
+   {
+      stream.readLine( (U8*)line, sizeof( line ) );
+      if ( line[0] == 0 || mProcShaders.contains( line ) )
+         continue;
+
+      FileStream entryStream;
+      if ( !entryStream.open( _getCacheEntryFile( line ), Torque::FS::File::Read ) )
+         continue;
+
+      ShaderGenCacheEntry entry;
+      if ( !entry.read( entryStream ) )
+         continue;
+
+      if ( getShader( entry.featureData, &entry.vertexFormat, &entry.macros, entry.samplers ) )
+         count++;
+   }
+
+   return count;
+}
+
 void ShaderGen::_init()
 {
    _createComponents();
@@ -490,7 +801,13 @@ GFXShader* ShaderGen::getShader( const MaterialFeatureData &featureData, const G
    shaderMacros.push_back( GFXShaderMacro( "TORQUE_SHADERGEN" ) );
    if ( macros )
       shaderMacros.merge( *macros );
-   generateShader( featureData, vertFile, pixFile, &pixVersion, vertexFormat, cacheKey, shaderMacros );
+
+   // Reuse the source from the shader cache if it
+   // was generated by this build with these features.
+   const U64 stamp = getCacheStamp( shaderDescription, features );
+   const bool cached = _loadCachedShader( featureData, vertexFormat, cacheKey, stamp, vertFile, pixFile, &pixVersion, shaderMacros );
+   if ( !cached )
+      generateShader( featureData, vertFile, pixFile, &pixVersion, vertexFormat, cacheKey, shaderMacros );
 
    GFXShader *shader = GFX->createShader();
    shader->setShaderStageFile(GFXShaderStage::VERTEX_SHADER, vertFile);
@@ -499,11 +816,20 @@ GFXShader* ShaderGen::getShader( const MaterialFeatureData &featureData, const G
    if (!shader->init(pixVersion, shaderMacros, samplers, &mInstancingFormat))
    {
       delete shader;
+
+      // Drop the cache entry so that the source
+      // is generated again on the next try.
+      if ( cached )
+         Torque::FS::Remove( _getCacheEntryFile( cacheKey ) );
+
       return NULL;
    }
 
    mProcShaders[cacheKey] = shader;
 
+   if ( !cached && Con::getBoolVariable( "ShaderGen::GenNewShaders", true ) )
+      _writeCacheEntry( featureData, vertexFormat, cacheKey, stamp, macros, samplers );
+
    return shader;
 }
 
@@ -513,3 +839,24 @@ void ShaderGen::flushProceduralShaders()
    // just need to clear the map.
    mProcShaders.clear();
 }
+
+DefineEngineFunction( writeShaderCacheManifest, bool, ( const char *path ),,
+   "@brief Writes the cache keys of all the loaded procedural shaders to a file.\n\n"
+   "Call it after playing a level and pass the file to pregenerateShaders() "
+   "when the level loads to avoid generating shaders on first use.\n\n"
+   "@param path The manifest file to write.\n"
+   "@return True if the file was written.\n\n"
+   "@ingroup Materials")
+{
+   return SHADERGEN->writeCacheManifest( path );
+}
+
+DefineEngineFunction( pregenerateShaders, S32, ( const char *path ),,
+   "@brief Generates and compiles every procedural shader listed in a manifest "
+   "from writeShaderCacheManifest() which isn't already loaded.\n\n"
+   "@param path The manifest file to read.\n"
+   "@return The number of shaders loaded.\n\n"
+   "@ingroup Materials")
+{
+   return SHADERGEN->pregenerateShaders( path );
+}
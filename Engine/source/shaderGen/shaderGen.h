@@ -93,6 +93,39 @@ public:
    virtual ShaderComponent* createPixelParamsDef() = 0;
 };
 
+/// Everything needed to regenerate a procedural shader which is kept
+/// next to its source in the shader cache.
+///
+/// The features are stored by name so that the entry stays valid when
+/// the feature ids change between builds.
+struct ShaderGenCacheEntry
+{
+   /// The hash of the shader description and the generator.
+   /// @see ShaderGen::getCacheStamp
+   U64 stamp;
+
+   MaterialFeatureData featureData;
+
+   GFXVertexFormat vertexFormat;
+
+   /// The macros passed to ShaderGen::getShader.
+   Vector<GFXShaderMacro> macros;
+
+   Vector<String> samplers;
+
+   /// The instancing format filled in by the features
+   /// when the shader was generated.
+   GFXVertexFormat instancingFormat;
+
+   ShaderGenCacheEntry() : stamp( 0 ) {}
+
+   bool write( Stream &stream ) const;
+
+   /// Returns false if the entry is from an older version
+   /// or uses features which no longer exist.
+   bool read( Stream &stream );
+};
+
 //**************************************************************************
 /*!
    The ShaderGen class takes shader feature data (usually created by 
@@ -160,12 +193,32 @@ public:
    // the ShaderFeatures have changed (due to lighting system change, or new plugin)
    virtual void flushProceduralShaders();
 
+   /// Writes the cache keys of all the loaded procedural shaders
+   /// to a text file.  Call it after playing a level to get the
+   /// shader permutations it uses.
+   bool writeCacheManifest( const Torque::Path &path );
+
+   /// Loads every shader listed in a manifest from writeCacheManifest()
+   /// which isn't already loaded, so that they are generated and compiled
+   /// at load time and not on first use.
+   /// @return The number of shaders loaded.
+   U32 pregenerateShaders( const Torque::Path &path );
+
+   /// Returns the hash which validates a cache entry for a shader
+   /// description.  It changes with the engine build and with the
+   /// feature implementations registered for the feature set.
+   U64 getCacheStamp( const String &description, const FeatureSet &features ) const;
+
    void setPrinter(ShaderGenPrinter* printer) { mPrinter = printer; }
    void setComponentFactory(ShaderGenComponentFactory* factory) { mComponentFactory = factory; }
    void setFileEnding(String ending) { mFileEnding = ending; }
 
    static String smCommonShaderPath;
 
+   /// If true the generated source is reused from the shader
+   /// cache path when its cache entry is still valid.
+   static bool smUseCache;
+
 protected:   
 
    friend class ManagedSingleton<ShaderGen>;
@@ -206,6 +259,31 @@ protected:
    void _init();
    void _uninit();
 
+   /// Fills in the shader file names for a cache key.
+   void _getShaderFiles( const char *cacheName, char *vertFile, char *pixFile );
+
+   /// Returns the cache entry file name for a cache key.
+   String _getCacheEntryFile( const String &cacheName );
+
+   /// Sets up the shader from its cached source if the cache entry
+   /// stamp matches.  The features are only processed for the macros.
+   bool _loadCachedShader( const MaterialFeatureData &featureData,
+                           const GFXVertexFormat *vertexFormat,
+                           const String &cacheName,
+                           U64 stamp,
+                           char *vertFile,
+                           char *pixFile,
+                           F32 *pixVersion,
+                           Vector<GFXShaderMacro> &macros );
+
+   /// Writes the cache entry for a freshly generated shader.
+   void _writeCacheEntry(  const MaterialFeatureData &featureData,
+                           const GFXVertexFormat *vertexFormat,
+                           const String &cacheName,
+                           U64 stamp,
+                           const Vector<GFXShaderMacro> *macros,
+                           const Vector<String> &samplers );
+
    /// Creates all the various shader components that will be filled in when 
    /// the shader features are processed.
    void _createComponents();
@@ -278,6 +278,26 @@ void NetConnection::consoleInit()
 
       "@ingroup Networking");
 
+   Con::addVariable("$pref::Net::ghostDeltaCompression", TypeBool, &smGhostDeltaCompression,
+      "@brief Sets whether new connections delta compress the ghost updates they send.\n\n"
+
+      "When enabled each ghost update is encoded against the last update the client "
+      "acknowledged for that ghost, so fields which did not change since then cost a "
+      "single bit per byte.  This trades server memory and CPU time for bandwidth.  "
+      "The default value is false.\n\n"
+
+      "@see NetConnection::setGhostDeltaCompression()\n\n"
+
+      "@ingroup Networking");
+
+   Con::addVariable("$NetConnection::compressDownloads", TypeBool, &smCompressDownloads,
+      "@brief Sets whether files sent to clients are deflated.\n\n"
+
+      "Each block of a file is only sent compressed when that makes it smaller.  Clients "
+      "using an older protocol version always get the raw data.  The default value is true.\n\n"
+
+      "@ingroup Networking");
+
    Con::addVariable("$Stats::netBitsSent", TypeS32, &gNetBitsSent,
       "@brief The number of bytes sent during the last packet send operation.\n\n"
 
@@ -418,6 +438,9 @@ NetConnection::NetConnection()
    mGhostRefs = NULL;
    mGhostLookupTable = NULL;
    mLocalGhosts = NULL;
+   mGhostDeltaCompression = smGhostDeltaCompression;
+   mGhostDeltaHistory = NULL;
+   mProtocolVersion = 0;
 
    mGhostsActive = 0;
 
@@ -434,6 +457,21 @@ NetConnection::NetConnection()
    mCurrentFileBufferSize = 0;
    mCurrentFileBufferOffset = 0;
    mNumDownloadedFiles = 0;
+   mPartialDownloadFile = NULL;
+   mDownloadBlock = NULL;
+   mDownloadBlockSize = 0;
+   mDownloadBlockRawSize = 0;
+   mDownloadBlockReceived = 0;
+   mUploadBlock = NULL;
+   mUploadBlockSize = 0;
+   mUploadBlockSent = 0;
+   mFileChunksQueued = 0;
+
+   mBulkWindow = MinBulkWindow;
+   mBulkSlowStartThreshold = MaxBulkWindow;
+   mBulkPacketsInFlight = 0;
+   mBulkLastLossTime = 0;
+   mWritingBulkPacket = false;
 
    // Disable starting a new journal recording or playback from here on
    Journal::Disable();
@@ -450,10 +488,27 @@ NetConnection::~NetConnection()
    dFree(mCurrentFileBuffer);
    if(mCurrentDownloadingFile)
       delete mCurrentDownloadingFile;
+   if(mPartialDownloadFile)
+      delete mPartialDownloadFile;
+   delete [] mDownloadBlock;
+   delete [] mUploadBlock;
 
    delete[] mLocalGhosts;
    delete[] mGhostLookupTable;
+   if(mGhostRefs)
+   {
+      for(U32 i = 0; i < MaxGhostCount; i++)
+         delete mGhostRefs[i].baseline;
+   }
    delete[] mGhostRefs;
+   for(U32 i = 0; i < mFreeGhostStates.size(); i++)
+      delete mFreeGhostStates[i];
+   if(mGhostDeltaHistory)
+   {
+      for(U32 i = 0; i < MaxGhostCount; i++)
+         delete [] mGhostDeltaHistory[i];
+      delete [] mGhostDeltaHistory;
+   }
    delete[] mGhostArray;
    delete mStringTable;
    if(mDemoWriteStream)
@@ -467,6 +522,7 @@ NetConnection::PacketNotify::PacketNotify()
    rateChanged = false;
    maxRateChanged = false;
    sendTime = 0;
+   bulk = false;
    eventList = 0;
    ghostList = 0;
    subList = NULL;
@@ -708,6 +764,9 @@ void NetConnection::handleNotify(bool recvd)
    if(note->maxRateChanged && !recvd)
       mMaxRate.changed = true;
 
+   if(note->bulk)
+      bulkPacketNotify(note, recvd);
+
    if(recvd) 
    {
       // Running average of roundTrip time
@@ -804,7 +863,10 @@ void NetConnection::checkPacketSend(bool force)
    if(!force)
    {
       if(curTime < mLastUpdateTime + delay - mSendDelayCredit)
+      {
+         checkBulkSend(curTime);
          return;
+      }
 
       mSendDelayCredit = curTime - (mLastUpdateTime + delay - mSendDelayCredit);
       if(mSendDelayCredit > 1000)
@@ -816,10 +878,59 @@ void NetConnection::checkPacketSend(bool force)
    if(windowFull())
       return;
 
-   BitStream *stream = BitStream::getPacketStream(mCurRate.packetSize);
-   buildSendPacketHeader(stream);
-
    mLastUpdateTime = curTime;
+   sendDataPacket(curTime, mCurRate.packetSize, false);
+
+   if(!force)
+      checkBulkSend(curTime);
+}
+
+void NetConnection::checkBulkSend(U32 curTime)
+{
+   if(!isUploadingFile() || !isNetworkConnection() || mDemoWriteStream || mDemoReadStream)
+      return;
+
+   // Only send while there are file chunks the ordered event window
+   // lets us write; the regular packets handle everything else.
+   while(mBulkPacketsInFlight < U32(mBulkWindow) && !windowFull() &&
+         mSendEventQueueHead && mSendEventQueueHead->mSeqCount <= mLastAckedEventSeq + 126)
+   {
+      mBulkPacketsInFlight++;
+      sendDataPacket(curTime, BulkPacketSize, true);
+   }
+}
+
+void NetConnection::bulkPacketNotify(PacketNotify *note, bool recvd)
+{
+   if(mBulkPacketsInFlight)
+      mBulkPacketsInFlight--;
+
+   if(recvd)
+   {
+      if(mBulkWindow < mBulkSlowStartThreshold)
+         mBulkWindow += 1.0f;
+      else
+         mBulkWindow += 1.0f / mBulkWindow;
+
+      mBulkWindow = getMin(mBulkWindow, F32(MaxBulkWindow));
+   }
+   else
+   {
+      // Losses from the same round trip count as a single congestion event.
+      const U32 curTime = Platform::getVirtualMilliseconds();
+      if(note->sendTime < mBulkLastLossTime)
+         return;
+
+      mBulkSlowStartThreshold = getMax(mBulkWindow * 0.5f, F32(MinBulkWindow));
+      mBulkWindow = mBulkSlowStartThreshold;
+      mBulkLastLossTime = curTime;
+   }
+}
+
+void NetConnection::sendDataPacket(U32 curTime, U32 packetSize, bool bulk)
+{
+   BitStream *stream = BitStream::getPacketStream(packetSize);
+   buildSendPacketHeader(stream);
 
    PacketNotify *note = allocNotify();
    if(!mNotifyQueueHead)
@@ -829,6 +940,7 @@ void NetConnection::checkPacketSend(bool force)
    mNotifyQueueTail = note;
    note->nextPacket = NULL;
    note->sendTime = curTime;
+   note->bulk = bulk;
 
    note->rateChanged = mCurRate.changed;
    note->maxRateChanged = mMaxRate.changed;
@@ -850,7 +962,9 @@ void NetConnection::checkPacketSend(bool force)
 #endif
 
    DEBUG_LOG(("PKLOG %d START", getId()) );
+   mWritingBulkPacket = bulk;
    writePacket(stream, note);
+   mWritingBulkPacket = false;
    DEBUG_LOG(("PKLOG %d END - %d", getId(), stream->getCurPos() - start) );
    if(mSimulatedPacketLoss && Platform::getRandom() < mSimulatedPacketLoss)
    {
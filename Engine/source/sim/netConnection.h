@@ -427,6 +427,25 @@ class NetConnection : public SimGroup, public ConnectionProtocol
    typedef SimGroup Parent;
 
 public:
+   /// A serialized ghost update kept around for delta compression.
+   ///
+   /// The server keeps the last update the client acknowledged for each ghost and
+   /// encodes new updates as a byte wise XOR against it.  The client keeps the
+   /// last few updates it received so it can undo the XOR against whichever one
+   /// the server picked.
+   struct GhostState
+   {
+      U32 serial;                ///< Update serial number for this ghost.
+      U32 bitCount;              ///< Size of the update; zero if the state is empty.
+      U32 capacity;              ///< Allocated size of data in bytes.
+      U8 *data;                  ///< The packUpdate output.
+
+      GhostState() : serial(0), bitCount(0), capacity(0), data(NULL) {}
+      ~GhostState() { delete [] data; }
+
+      void set(U32 inSerial, const U8 *bits, U32 inBitCount);
+   };
+
    /// Structure to track ghost references in packets.
    ///
    /// Every packet we send out with an update from a ghost causes one of these to be
@@ -441,6 +460,7 @@ public:
       GhostInfo *ghost;          ///< Reference to the GhostInfo we're from.
       GhostRef *nextRef;         ///< Next GhostRef in this packet.
       GhostRef *nextUpdateChain; ///< Next update we sent for this ghost.
+      GhostState *sentState;     ///< Serialized update we sent, if delta compressing.
    };
 
    enum Constants
@@ -637,6 +657,7 @@ public:
    bool checkTimeout(U32 time); ///< returns true if the connection timed out
 
    void checkPacketSend(bool force);
+   void sendDataPacket(U32 curTime, U32 packetSize, bool bulk);
 
    bool missionPathsSent() const          { return mMissionPathsSent; }
    void setMissionPathsSent(const bool s) { mMissionPathsSent = s; }
@@ -685,6 +706,7 @@ public:
       bool rateChanged;       ///< Did the rate change on this packet?
       bool maxRateChanged;    ///< Did the max rate change on this packet?
       U32  sendTime;          ///< Timestampe, when we sent this packet.
+      bool bulk;              ///< Was this an extra packet sent for a file transfer?
 
       NetEventNote *eventList;    ///< Linked list of events sent over this packet.
       GhostRef *ghostList;    ///< Linked list of ghost updates we sent in this packet.
@@ -825,6 +847,43 @@ protected:
    void ghostWriteStartBlock(ResizeBitStream *stream);
    void ghostReadStartBlock(BitStream *stream);
 
+   /// @name Ghost Delta Compression
+   ///
+   /// When enabled each ghost update is serialized into a scratch stream and
+   /// sent either as is or XORed against the most recent update the client has
+   /// acknowledged, whichever is smaller.  Unchanged bytes then cost a single bit.
+   /// @{
+
+   enum GhostDeltaConstants
+   {
+      GhostDeltaSerialBitSize = 8,  ///< Bits of the update serial sent with each update.
+      GhostDeltaDistanceBitSize = 3,
+      GhostDeltaHistorySize = 1 << GhostDeltaDistanceBitSize, ///< Updates kept by the client per ghost.
+      GhostDeltaSizeBitSize = 14,   ///< Enough for Net::MaxPacketDataSize bytes.
+      GhostDeltaProtocolVersion = 13, ///< First protocol version which knows about delta compression.
+   };
+
+   static bool smGhostDeltaCompression;   ///< Default for new connections; $pref::Net::ghostDeltaCompression.
+   bool mGhostDeltaCompression;           ///< Are we delta compressing ghost updates we send?
+   GhostState **mGhostDeltaHistory;       ///< Received updates per ghost index; allocated on first use.
+   Vector<GhostState *> mFreeGhostStates; ///< Recycled server side states.
+
+   GhostState *allocGhostState();
+   void freeGhostState(GhostState *state);
+   GhostState *getGhostDeltaHistory(U32 index);
+   void clearGhostDeltaHistory(U32 index);
+
+   void ghostWriteDeltaUpdate(GhostInfo *ghost, GhostRef *ref, U8 *bits, U32 bitCount, BitStream *bstream);
+   bool ghostReadDeltaUpdate(U32 index, BitStream *bstream, U8 *bits, U32 &bitCount);
+
+   /// Run packUpdate, delta compressing the result if enabled for this packet.
+   U32 ghostPackUpdate(GhostInfo *ghost, GhostRef *ref, U32 updateMask, bool delta, BitStream *bstream);
+
+   /// Run unpackUpdate, undoing the delta compression if used for this packet.
+   void ghostUnpackUpdate(U32 index, bool delta, BitStream *bstream);
+
+   /// @}
+
    virtual void ghostWriteExtra(NetObject *,BitStream *) {}
    virtual void ghostReadExtra(NetObject *,BitStream *, bool newGhost) {}
    virtual void ghostPreRead(NetObject *, bool newGhost) {}
@@ -850,6 +909,15 @@ public:
    /// Are we ghosting from someone?
    bool isGhostingFrom() { return mGhostArray != NULL; };
 
+   /// Enable or disable delta compression of the ghost updates we send.
+   void setGhostDeltaCompression(bool enable) { mGhostDeltaCompression = enable; }
+   bool getGhostDeltaCompression() const { return mGhostDeltaCompression; }
+
+   /// Returns true if the negotiated protocol version carries the delta
+   /// compression bits in ghost packets and demo start blocks.  Older
+   /// clients and demos never see them.
+   bool isGhostDeltaSupported() const { return mProtocolVersion >= GhostDeltaProtocolVersion; }
+
    /// Called by onRemove, to shut down the ghost subsystem.
    void ghostOnRemove();
 
@@ -973,6 +1041,75 @@ protected:
    /// Number of files we have downloaded.
    U32 mNumDownloadedFiles;
 
+   /// Partially downloaded file on disk, kept so a dropped download can be resumed.
+   Stream *mPartialDownloadFile;
+
+   /// Storage for the block currently being received.
+   U8 *mDownloadBlock;
+
+   /// Size of the block currently being received as sent over the wire.
+   U32 mDownloadBlockSize;
+
+   /// Size of the block currently being received once decompressed.
+   U32 mDownloadBlockRawSize;
+
+   /// Bytes of the current block received so far.
+   U32 mDownloadBlockReceived;
+
+   /// Storage for the block currently being uploaded, followed by space
+   /// for the raw file data it was compressed from.
+   U8 *mUploadBlock;
+
+   /// Size of the block currently being uploaded.
+   U32 mUploadBlockSize;
+
+   /// Bytes of the current upload block posted so far.
+   U32 mUploadBlockSent;
+
+   /// Number of FileChunkEvents posted but not delivered yet.
+   U32 mFileChunksQueued;
+
+   /// Deflate the file blocks we upload; $NetConnection::compressDownloads.
+   static bool smCompressDownloads;
+
+   /// @name Bulk transfer
+   ///
+   /// While a file is being uploaded, extra "bulk" packets are sent on top of
+   /// the regular packet rate to carry the file chunks.  The number of bulk
+   /// packets in flight follows a congestion window which grows by one packet
+   /// per round trip (doubling in slow start) and halves on packet loss.
+   /// @{
+
+   enum
+   {
+      MinBulkWindow = 2,
+      MaxBulkWindow = 24,  ///< Leaves room in the protocol's packet window for regular packets.
+      BulkPacketSize = Net::MaxPacketDataSize - 512,  ///< Leaves room for the last file chunk to run over.
+   };
+
+   /// Current number of bulk packets allowed in flight.
+   F32 mBulkWindow;
+
+   /// Window size at which growth switches from doubling to linear.
+   F32 mBulkSlowStartThreshold;
+
+   /// Bulk packets sent that have not been acked or dropped yet.
+   U32 mBulkPacketsInFlight;
+
+   /// Time the window was last reduced; loss is only acted on once per round trip.
+   U32 mBulkLastLossTime;
+
+   /// True while a bulk packet is being written.
+   bool mWritingBulkPacket;
+
+   /// Send as many bulk packets as the window allows.
+   void checkBulkSend(U32 curTime);
+
+   /// Adjust the bulk window for an acked or dropped bulk packet.
+   void bulkPacketNotify(PacketNotify *note, bool recvd);
+
+   /// @}
+
    /// Error storage for file transfers.
    String mLastFileErrorBuffer;
 
@@ -987,16 +1124,41 @@ protected:
 
 public:
    /// Start sending the specified file over the link.
-   bool startSendingFile(const char *fileName);
+   ///
+   /// @param  resumeOffset   Size of the client's partial copy of the file, if any.
+   /// @param  resumeCRC      CRC of the client's partial copy.
+   bool startSendingFile(const char *fileName, U32 resumeOffset = 0, U32 resumeCRC = 0);
+
+   /// Is a file upload still pushing data through the event queue?
+   bool isUploadingFile() const { return mCurrentDownloadingFile != NULL || mFileChunksQueued != 0; }
+
+   enum
+   {
+      FileBlockProtocolVersion = 14,   ///< First protocol version with compressed file blocks and resume.
+   };
+
+   /// Returns true if the negotiated protocol version sends files as
+   /// compressed blocks and lets the client resume a partial download.
+   /// Older versions use raw 63 byte chunks.
+   bool isFileBlockSupported() const { return mProtocolVersion >= FileBlockProtocolVersion; }
+
+   /// Called when we receive a FileChunkEvent that starts a new block.
+   void fileBlockStarted(U32 offset, U32 rawSize, U32 size);
 
    /// Called when we receive a FileChunkEvent.
    void chunkReceived(U8 *chunkData, U32 chunkLen);
 
+   /// Called when a FileChunkEvent we posted has been delivered.
+   void fileChunkDelivered();
+
    /// Get the next file...
    void sendNextFileDownloadRequest();
 
-   /// Post the next FileChunkEvent.
-   void sendFileChunk();
+   /// Post the next FileChunkEvent.  Returns false when the file is done.
+   bool sendFileChunk();
+
+   /// Post FileChunkEvents until enough are queued to fill the bulk window.
+   void queueFileChunks();
 
    /// Called when we finish downloading file data.
    virtual void fileDownloadSegmentComplete();
@@ -1098,6 +1260,9 @@ public:  // required for MSVC
    U32 index;
    U32 arrayIndex;
 
+   U32 deltaSerial;                       ///< Serial of the next update sent for delta compression.
+   NetConnection::GhostState *baseline;   ///< Last update acknowledged by the client, or NULL.
+
    /// Flags relating to the state of the object.
    enum Flags
    {
@@ -28,6 +28,83 @@
 #include "core/stream/bitStream.h"
 #include "core/stream/fileStream.h"
 #include "sim/netObject.h"
+#include "core/stream/memStream.h"
+#include "core/util/zip/compressor.h"
+#include "core/crc.h"
+#include "core/volume.h"
+
+/// Name of the file a download is saved to while it is in progress.
+static String getPartialDownloadName(const char *fileName)
+{
+   return String(fileName) + ".part";
+}
+
+/// CRC the first @a size bytes of @a stream.
+static U32 calculatePrefixCRC(Stream *stream, U32 size)
+{
+   U8 buffer[4096];
+   U32 crc = CRC::INITIAL_CRC_VALUE;
+
+   stream->setPosition(0);
+   while(size)
+   {
+      const U32 len = getMin(size, U32(sizeof(buffer)));
+      if(!stream->read(len, buffer))
+         return CRC::INVALID_CRC;
+
+      crc = CRC::calculateCRC(buffer, len, crc);
+      size -= len;
+   }
+
+   return crc;
+}
+
+/// Deflate a block of file data using the zip deflate compressor.  Returns
+/// false if the block doesn't compress, in which case it is sent as is.
+static bool deflateFileBlock(const U8 *src, U32 srcSize, U8 *dest, U32 *destSize)
+{
+   Zip::Compressor *compressor = Zip::Compressor::findCompressor(Zip::Deflated);
+   if(!compressor)
+      return false;
+
+   MemStream out(srcSize, dest, false, true);
+   Zip::CentralDir cdir;
+
+   Stream *zipStream = compressor->createWriteStream(&cdir, &out);
+   if(!zipStream)
+      return false;
+
+   zipStream->write(srcSize, src);
+   delete zipStream;
+
+   *destSize = out.getPosition();
+   return out.getStatus() == Stream::Ok && *destSize < srcSize;
+}
+
+/// Inflate a block deflated by deflateFileBlock().
+static bool inflateFileBlock(const U8 *src, U32 srcSize, U8 *dest, U32 destSize)
+{
+   Zip::Compressor *compressor = Zip::Compressor::findCompressor(Zip::Deflated);
+   if(!compressor)
+      return false;
+
+   MemStream in(srcSize, (void *)src, true, false);
+   Zip::CentralDir cdir;
+   cdir.mUncompressedSize = destSize;
+
+   Stream *zipStream = compressor->createReadStream(&cdir, &in);
+   if(!zipStream)
+      return false;
+
+   bool success = zipStream->read(destSize, dest);
+
+   IStreamByteCount *byteCount = dynamic_cast<IStreamByteCount *>(zipStream);
+   if(byteCount && byteCount->getLastBytesRead() != destSize)
+      success = false;
+
+   delete zipStream;
+   return success;
+}
 
 class FileDownloadRequestEvent : public NetEvent
 {
@@ -41,6 +118,10 @@ public:
    U32 nameCount;
    char mFileNames[MaxFileNames][256];
 
+   /// Size and CRC of the partial copy the client already has of each file.
+   U32 mResumeOffsets[MaxFileNames];
+   U32 mResumeCRCs[MaxFileNames];
+
    FileDownloadRequestEvent(Vector<char *> *nameList = NULL)
    {
       nameCount = 0;
@@ -55,36 +136,65 @@ public:
          {
             dStrcpy(mFileNames[i], (*nameList)[i], 256);
             //Con::printf("Sending request for file %s", mFileNames[i]);
+
+            mResumeOffsets[i] = 0;
+            mResumeCRCs[i] = 0;
+
+            const String partialName = getPartialDownloadName(mFileNames[i]);
+            FileStream *partial = Torque::FS::IsFile(partialName) ? FileStream::createAndOpen( partialName, Torque::FS::File::Read ) : NULL;
+            if(partial)
+            {
+               mResumeOffsets[i] = partial->getStreamSize();
+               mResumeCRCs[i] = calculatePrefixCRC(partial, mResumeOffsets[i]);
+               delete partial;
+            }
          }
       }
    }
 
-   void pack(NetConnection *, BitStream *bstream) override
+   void pack(NetConnection *conn, BitStream *bstream) override
    {
       bstream->writeRangedU32(nameCount, 0, MaxFileNames);
       for(U32 i = 0; i < nameCount; i++)
+      {
          bstream->writeString(mFileNames[i]);
+         if(!conn->isFileBlockSupported())
+            continue;
+
+         if(bstream->writeFlag(mResumeOffsets[i] != 0))
+         {
+            bstream->write(mResumeOffsets[i]);
+            bstream->write(mResumeCRCs[i]);
+         }
+      }
    }
 
-   void write(NetConnection *, BitStream *bstream) override
+   void write(NetConnection *conn, BitStream *bstream) override
    {
-      bstream->writeRangedU32(nameCount, 0, MaxFileNames);
-      for(U32 i = 0; i < nameCount; i++)
-         bstream->writeString(mFileNames[i]);
+      pack(conn, bstream);
    }
 
-   void unpack(NetConnection *, BitStream *bstream) override
+   void unpack(NetConnection *conn, BitStream *bstream) override
    {
       nameCount = bstream->readRangedU32(0, MaxFileNames);
       for(U32 i = 0; i < nameCount; i++)
+      {
          bstream->readString(mFileNames[i]);
+         mResumeOffsets[i] = 0;
+         mResumeCRCs[i] = 0;
+         if(conn->isFileBlockSupported() && bstream->readFlag())
+         {
+            bstream->read(&mResumeOffsets[i]);
+            bstream->read(&mResumeCRCs[i]);
+         }
+      }
    }
 
    void process(NetConnection *connection) override
    {
       U32 i;
       for(i = 0; i < nameCount; i++)
-         if(connection->startSendingFile(mFileNames[i]))
+         if(connection->startSendingFile(mFileNames[i], mResumeOffsets[i], mResumeCRCs[i]))
             break;
       if(i == nameCount)
          connection->startSendingFile(NULL);  // none of the files were sent
@@ -101,15 +211,25 @@ ConsoleDocClass( FileDownloadRequestEvent,
 				"Not intended for game development, for editors or internal use only.\n\n "
 				"@internal");
 
+/// Files are sent in blocks which are deflated when that makes them smaller.
+/// Each block is split into chunks small enough to share a packet with other
+/// traffic, and the first chunk of a block carries its header.
 class FileChunkEvent : public NetEvent
 {
 public:
    typedef NetEvent Parent;
    enum
    {
-      ChunkSize = 63,
+      ChunkSize = 448,
+      BlockSize = 16384,
+      LegacyChunkSize = 63,   ///< Chunk size before NetConnection::FileBlockProtocolVersion.
    };
 
+   bool blockStart;
+   U32 blockOffset;     ///< Offset of the block in the file.
+   U32 blockRawSize;    ///< Size of the block once inflated.
+   U32 blockSize;       ///< Size of the block as sent.
+
    U8 chunkData[ChunkSize];
    U32 chunkLen;
    
@@ -118,35 +238,77 @@ public:
       if(data)
          dMemcpy(chunkData, data, len);
       chunkLen = len;
+      blockStart = false;
+      blockOffset = 0;
+      blockRawSize = 0;
+      blockSize = 0;
+   }
+
+   void setBlockStart(U32 offset, U32 rawSize, U32 size)
+   {
+      blockStart = true;
+      blockOffset = offset;
+      blockRawSize = rawSize;
+      blockSize = size;
    }
    
-   void pack(NetConnection *, BitStream *bstream) override
+   void pack(NetConnection *conn, BitStream *bstream) override
    {
+      // older protocols only know raw chunks appended in order.
+      if(!conn->isFileBlockSupported())
+      {
+         bstream->writeRangedU32(chunkLen, 0, LegacyChunkSize);
+         bstream->write(chunkLen, chunkData);
+         return;
+      }
+
+      if(bstream->writeFlag(blockStart))
+      {
+         bstream->write(blockOffset);
+         bstream->writeRangedU32(blockRawSize, 1, BlockSize);
+         bstream->writeRangedU32(blockSize, 1, BlockSize);
+      }
       bstream->writeRangedU32(chunkLen, 0, ChunkSize);
       bstream->write(chunkLen, chunkData);
    }
    
-   void write(NetConnection *, BitStream *bstream) override
+   void write(NetConnection *conn, BitStream *bstream) override
    {
-      bstream->writeRangedU32(chunkLen, 0, ChunkSize);
-      bstream->write(chunkLen, chunkData);
+      pack(conn, bstream);
    }
    
-   void unpack(NetConnection *, BitStream *bstream) override
+   void unpack(NetConnection *conn, BitStream *bstream) override
    {
+      if(!conn->isFileBlockSupported())
+      {
+         blockStart = false;
+         chunkLen = bstream->readRangedU32(0, LegacyChunkSize);
+         bstream->read(chunkLen, chunkData);
+         return;
+      }
+
+      blockStart = bstream->readFlag();
+      if(blockStart)
+      {
+         bstream->read(&blockOffset);
+         blockRawSize = bstream->readRangedU32(1, BlockSize);
+         blockSize = bstream->readRangedU32(1, BlockSize);
+      }
       chunkLen = bstream->readRangedU32(0, ChunkSize);
       bstream->read(chunkLen, chunkData);
    }
    
    void process(NetConnection *connection) override
    {
+      if(blockStart)
+         connection->fileBlockStarted(blockOffset, blockRawSize, blockSize);
       connection->chunkReceived(chunkData, chunkLen);
    }
    
    void notifyDelivered(NetConnection *nc, bool madeIt) override
    {
       if(!nc->isRemoved())
-        nc->sendFileChunk();
+        nc->fileChunkDelivered();
    }
    
    DECLARE_CONOBJECT(FileChunkEvent);
@@ -159,26 +321,78 @@ ConsoleDocClass( FileChunkEvent,
 				"Not intended for game development, for editors or internal use only.\n\n "
 				"@internal");
 
-void NetConnection::sendFileChunk()
+bool NetConnection::smCompressDownloads = true;
+
+bool NetConnection::sendFileChunk()
 {
-   U8 buffer[FileChunkEvent::ChunkSize];
-   U32 len = FileChunkEvent::ChunkSize;
-   if(len + mCurrentFileBufferOffset > mCurrentFileBufferSize)
-      len = mCurrentFileBufferSize - mCurrentFileBufferOffset;
+   const U32 chunkSize = isFileBlockSupported() ? FileChunkEvent::ChunkSize : FileChunkEvent::LegacyChunkSize;
 
-   if(!len)
+   if(mUploadBlockSent == mUploadBlockSize)
    {
-      delete mCurrentDownloadingFile;
-      mCurrentDownloadingFile = NULL;
-      return;
+      if(!mCurrentDownloadingFile)
+         return false;
+
+      const U32 rawSize = getMin(U32(FileChunkEvent::BlockSize), mCurrentFileBufferSize - mCurrentFileBufferOffset);
+      if(!rawSize)
+      {
+         delete mCurrentDownloadingFile;
+         mCurrentDownloadingFile = NULL;
+         return false;
+      }
+
+      // The raw data is read into the second half of the buffer.
+      if(!mUploadBlock)
+         mUploadBlock = new U8[FileChunkEvent::BlockSize * 2];
+      U8 *rawData = mUploadBlock + FileChunkEvent::BlockSize;
+
+      const U32 offset = mCurrentFileBufferOffset;
+      mCurrentDownloadingFile->read(rawSize, rawData);
+      mCurrentFileBufferOffset += rawSize;
+
+      // older clients can't inflate, and get the blocks back to back.
+      if(!smCompressDownloads || !isFileBlockSupported() ||
+         !deflateFileBlock(rawData, rawSize, mUploadBlock, &mUploadBlockSize))
+      {
+         dMemcpy(mUploadBlock, rawData, rawSize);
+         mUploadBlockSize = rawSize;
+      }
+
+      U32 len = getMin(chunkSize, mUploadBlockSize);
+      FileChunkEvent *event = new FileChunkEvent(mUploadBlock, len);
+      event->setBlockStart(offset, rawSize, mUploadBlockSize);
+      mUploadBlockSent = len;
+      mFileChunksQueued++;
+      postNetEvent(event);
+      return true;
    }
 
-   mCurrentFileBufferOffset += len;
-   mCurrentDownloadingFile->read(len, buffer);
-   postNetEvent(new FileChunkEvent(buffer, len));
+   U32 len = getMin(chunkSize, mUploadBlockSize - mUploadBlockSent);
+   FileChunkEvent *event = new FileChunkEvent(mUploadBlock + mUploadBlockSent, len);
+   mUploadBlockSent += len;
+   mFileChunksQueued++;
+   postNetEvent(event);
+   return true;
 }
 
-bool NetConnection::startSendingFile(const char *fileName)
+void NetConnection::queueFileChunks()
+{
+   // Keep enough chunks queued to fill the bulk window, but stay inside the
+   // ordered event window so other events can still get through.
+   const U32 target = getMin(U32(mBulkWindow * 3) + 32, 112U);
+
+   while(mFileChunksQueued < target && sendFileChunk())
+      ;
+}
+
+void NetConnection::fileChunkDelivered()
+{
+   if(mFileChunksQueued)
+      mFileChunksQueued--;
+
+   queueFileChunks();
+}
+
+bool NetConnection::startSendingFile(const char *fileName, U32 resumeOffset, U32 resumeCRC)
 {
    if(!fileName || Con::getBoolVariable("$NetConnection::neverUploadFiles"))
    {
@@ -195,14 +409,25 @@ bool NetConnection::startSendingFile(const char *fileName)
       return false;
    }
 
-   Con::printf("Sending file '%s'.", fileName);
    mCurrentFileBufferSize = mCurrentDownloadingFile->getStreamSize();
    mCurrentFileBufferOffset = 0;
+   mUploadBlockSize = 0;
+   mUploadBlockSent = 0;
+
+   // Pick up where the client left off if its partial copy matches ours.
+   if(resumeOffset && resumeOffset < mCurrentFileBufferSize &&
+      calculatePrefixCRC(mCurrentDownloadingFile, resumeOffset) == resumeCRC)
+   {
+      Con::printf("Resuming file '%s' at byte %d.", fileName, resumeOffset);
+      mCurrentFileBufferOffset = resumeOffset;
+   }
+   else
+      Con::printf("Sending file '%s'.", fileName);
+
+   mCurrentDownloadingFile->setPosition(mCurrentFileBufferOffset);
 
-   // always have 32 file chunks (64 bytes each) in transit
    sendConnectionMessage(FileDownloadSizeMessage, mCurrentFileBufferSize);
-   for(U32 i = 0; i < 32; i++)
-      sendFileChunk();
+   queueFileChunks();
    return true;
 }
 
@@ -225,6 +450,53 @@ void NetConnection::sendNextFileDownloadRequest()
    }
 }
 
+void NetConnection::fileBlockStarted(U32 offset, U32 rawSize, U32 size)
+{
+   if(!mMissingFileList.size() || mDownloadBlockReceived != mDownloadBlockSize ||
+      size > rawSize || rawSize > mCurrentFileBufferSize - getMin(offset, mCurrentFileBufferSize))
+   {
+      setLastError("Invalid file chunk from server.");
+      return;
+   }
+
+   if(mCurrentFileBufferOffset == 0)
+   {
+      // First block of a file.  The server may be resuming from the partial
+      // copy we reported, in which case the data we have is read back in.
+      const String partialName = getPartialDownloadName(mMissingFileList[0]);
+      if(offset)
+      {
+         FileStream *partial = FileStream::createAndOpen( partialName, Torque::FS::File::Read );
+         bool success = partial && partial->getStreamSize() >= offset && partial->read(offset, mCurrentFileBuffer);
+         delete partial;
+
+         if(!success)
+         {
+            setLastError("Invalid file chunk from server.");
+            return;
+         }
+
+         mCurrentFileBufferOffset = offset;
+      }
+
+      delete mPartialDownloadFile;
+      mPartialDownloadFile = FileStream::createAndOpen( partialName, Torque::FS::File::Write );
+      if(mPartialDownloadFile && offset)
+         mPartialDownloadFile->write(offset, mCurrentFileBuffer);
+   }
+   else if(offset != mCurrentFileBufferOffset)
+   {
+      setLastError("Invalid file chunk from server.");
+      return;
+   }
+
+   if(!mDownloadBlock)
+      mDownloadBlock = new U8[FileChunkEvent::BlockSize];
+
+   mDownloadBlockSize = size;
+   mDownloadBlockRawSize = rawSize;
+   mDownloadBlockReceived = 0;
+}
 
 void NetConnection::chunkReceived(U8 *chunkData, U32 chunkLen)
 {
@@ -237,16 +509,59 @@ void NetConnection::chunkReceived(U8 *chunkData, U32 chunkLen)
       mMissingFileList.pop_front();
       return;
    }
-   if(chunkLen + mCurrentFileBufferOffset > mCurrentFileBufferSize)
+
+   if(!isFileBlockSupported())
    {
-      setLastError("Invalid file chunk from server.");
-      return;
+      // raw chunks from an older server.
+      if(chunkLen + mCurrentFileBufferOffset > mCurrentFileBufferSize)
+      {
+         setLastError("Invalid file chunk from server.");
+         return;
+      }
+      dMemcpy(((U8 *) mCurrentFileBuffer) + mCurrentFileBufferOffset, chunkData, chunkLen);
+      mCurrentFileBufferOffset += chunkLen;
    }
-   dMemcpy(((U8 *) mCurrentFileBuffer) + mCurrentFileBufferOffset, chunkData, chunkLen);
-   mCurrentFileBufferOffset += chunkLen;
+   else
+   {
+      if(chunkLen + mDownloadBlockReceived > mDownloadBlockSize)
+      {
+         setLastError("Invalid file chunk from server.");
+         return;
+      }
+      dMemcpy(mDownloadBlock + mDownloadBlockReceived, chunkData, chunkLen);
+      mDownloadBlockReceived += chunkLen;
+
+      // Wait for the rest of the block.
+      if(mDownloadBlockReceived < mDownloadBlockSize)
+         return;
+
+      U8 *dest = ((U8 *) mCurrentFileBuffer) + mCurrentFileBufferOffset;
+      if(mDownloadBlockSize < mDownloadBlockRawSize)
+      {
+         if(!inflateFileBlock(mDownloadBlock, mDownloadBlockSize, dest, mDownloadBlockRawSize))
+         {
+            setLastError("Invalid file chunk from server.");
+            return;
+         }
+      }
+      else
+         dMemcpy(dest, mDownloadBlock, mDownloadBlockRawSize);
+
+      if(mPartialDownloadFile)
+         mPartialDownloadFile->write(mDownloadBlockRawSize, dest);
+
+      mCurrentFileBufferOffset += mDownloadBlockRawSize;
+      mDownloadBlockSize = 0;
+      mDownloadBlockReceived = 0;
+   }
+
    if(mCurrentFileBufferOffset == mCurrentFileBufferSize)
    {
       // this file's done...
+      delete mPartialDownloadFile;
+      mPartialDownloadFile = NULL;
+      Torque::FS::Remove(getPartialDownloadName(mMissingFileList[0]));
+
       // save it to disk:
       FileStream *stream;
 
@@ -271,4 +586,3 @@ void NetConnection::chunkReceived(U8 *chunkData, U32 chunkLen)
       Con::executef("onFileChunkReceived", mMissingFileList[0], Con::getIntArg(mCurrentFileBufferOffset), Con::getIntArg(mCurrentFileBufferSize));
    }
 }
-
@@ -219,9 +219,14 @@ void NetConnection::eventWritePacket(BitStream *bstream, PacketNotify *notify)
    bstream->writeFlag(false);
    S32 prevSeq = -2;
 
+   // While a file upload is pushing chunks through the ordered queue, keep
+   // half of each regular packet for ghost updates.  Bulk packets carry the
+   // rest of the file data.
+   const S32 orderedBitLimit = (mGhosting && !mWritingBulkPacket && isUploadingFile()) ? mCurRate.packetSize * 4 : S32_MAX;
+
    while(mSendEventQueueHead)
    {
-      if(bstream->isFull())
+      if(bstream->isFull() || bstream->getCurPos() >= orderedBitLimit)
          break;
 
       // if the event window is full, stop processing
@@ -35,6 +35,11 @@
 
 Signal<void()>    NetConnection::smGhostAlwaysDone;
 
+bool NetConnection::smGhostDeltaCompression = false;
+
+/// Scratch space for serializing a single delta compressed ghost update.
+static U8 sGhostDeltaBuffer[Net::MaxPacketDataSize];
+
 extern U32 gGhostUpdates;
 
 class GhostAlwaysObjectEvent : public NetEvent
@@ -161,6 +166,194 @@ DefineEngineMethod( NetConnection, getGhostsActive, S32, (),,
 	return object->getGhostsActive();
 }
 
+DefineEngineMethod( NetConnection, setGhostDeltaCompression, void, (bool enable),,
+   "@brief Enables or disables delta compression of the ghost updates sent over this connection.\n\n"
+
+   "New connections use the value of $pref::Net::ghostDeltaCompression.  This may be changed "
+   "at any time; the client does not need to be told.\n\n"
+
+   "@param enable True to encode ghost updates against the last update the client acknowledged.\n"
+   "@see @ref ghosting_scoping for a description of the ghosting system.\n\n")
+{
+   object->setGhostDeltaCompression(enable);
+}
+
+DefineEngineMethod( NetConnection, getGhostDeltaCompression, bool, (),,
+   "@brief Returns true if ghost updates sent over this connection are delta compressed.\n\n")
+{
+   return object->getGhostDeltaCompression();
+}
+
+//-----------------------------------------------------------------------------
+
+void NetConnection::GhostState::set(U32 inSerial, const U8 *bits, U32 inBitCount)
+{
+   const U32 byteCount = (inBitCount + 7) >> 3;
+   if(byteCount > capacity)
+   {
+      delete [] data;
+      capacity = getMax(byteCount, U32(64));
+      data = new U8[capacity];
+   }
+   dMemcpy(data, bits, byteCount);
+   serial = inSerial;
+   bitCount = inBitCount;
+}
+
+NetConnection::GhostState *NetConnection::allocGhostState()
+{
+   if(mFreeGhostStates.empty())
+      return new GhostState;
+
+   GhostState *state = mFreeGhostStates.last();
+   mFreeGhostStates.pop_back();
+   return state;
+}
+
+void NetConnection::freeGhostState(GhostState *state)
+{
+   if(state)
+      mFreeGhostStates.push_back(state);
+}
+
+NetConnection::GhostState *NetConnection::getGhostDeltaHistory(U32 index)
+{
+   if(!mGhostDeltaHistory)
+   {
+      mGhostDeltaHistory = new GhostState *[MaxGhostCount];
+      dMemset(mGhostDeltaHistory, 0, sizeof(GhostState *) * MaxGhostCount);
+   }
+   if(!mGhostDeltaHistory[index])
+      mGhostDeltaHistory[index] = new GhostState[GhostDeltaHistorySize];
+   return mGhostDeltaHistory[index];
+}
+
+void NetConnection::clearGhostDeltaHistory(U32 index)
+{
+   if(!mGhostDeltaHistory || !mGhostDeltaHistory[index])
+      return;
+
+   for(U32 i = 0; i < GhostDeltaHistorySize; i++)
+      mGhostDeltaHistory[index][i].bitCount = 0;
+}
+
+void NetConnection::ghostWriteDeltaUpdate(GhostInfo *ghost, GhostRef *ref, U8 *bits, U32 bitCount, BitStream *bstream)
+{
+   // Clear the unused bits of the last byte so states compare cleanly.
+   const U32 byteCount = (bitCount + 7) >> 3;
+   if(bitCount & 7)
+      bits[byteCount - 1] &= (1 << (bitCount & 7)) - 1;
+
+   const U32 serial = ghost->deltaSerial++;
+   bstream->writeInt(serial & ((1 << GhostDeltaSerialBitSize) - 1), GhostDeltaSerialBitSize);
+   bstream->writeInt(bitCount, GhostDeltaSizeBitSize);
+
+   // We can only encode against a baseline the client still has in its
+   // history, and only want to if it is actually smaller.
+   const GhostState *base = ghost->baseline;
+   const U32 distance = base ? serial - base->serial : 0;
+   const U32 baseBytes = base ? (base->bitCount + 7) >> 3 : 0;
+   bool useDelta = false;
+   if(base && base->bitCount && distance < GhostDeltaHistorySize)
+   {
+      U32 deltaBits = GhostDeltaDistanceBitSize;
+      for(U32 i = 0; i < byteCount && deltaBits < bitCount; i++)
+         deltaBits += (bits[i] != (i < baseBytes ? base->data[i] : 0)) ? 9 : 1;
+      useDelta = deltaBits < bitCount;
+   }
+
+   if(bstream->writeFlag(useDelta))
+   {
+      bstream->writeInt(distance, GhostDeltaDistanceBitSize);
+      for(U32 i = 0; i < byteCount; i++)
+      {
+         const U8 diff = bits[i] ^ (i < baseBytes ? base->data[i] : 0);
+         if(bstream->writeFlag(diff != 0))
+            bstream->writeInt(diff, 8);
+      }
+   }
+   else
+      bstream->writeBits(bitCount, bits);
+
+   // Remember what we sent; it becomes the baseline once the client acks it.
+   ref->sentState = allocGhostState();
+   ref->sentState->set(serial, bits, bitCount);
+}
+
+bool NetConnection::ghostReadDeltaUpdate(U32 index, BitStream *bstream, U8 *bits, U32 &bitCount)
+{
+   const U32 serial = bstream->readInt(GhostDeltaSerialBitSize);
+   bitCount = bstream->readInt(GhostDeltaSizeBitSize);
+   if(bitCount > Net::MaxPacketDataSize << 3)
+   {
+      setLastError("Invalid packet. (ghost update too large)");
+      return false;
+   }
+   const U32 byteCount = (bitCount + 7) >> 3;
+   GhostState *history = getGhostDeltaHistory(index);
+
+   if(bstream->readFlag())
+   {
+      const U32 baseSerial = (serial - bstream->readInt(GhostDeltaDistanceBitSize)) & ((1 << GhostDeltaSerialBitSize) - 1);
+      const GhostState &base = history[baseSerial & (GhostDeltaHistorySize - 1)];
+      if(!base.bitCount || base.serial != baseSerial)
+      {
+         setLastError("Invalid packet. (missing ghost update baseline)");
+         return false;
+      }
+
+      const U32 baseBytes = (base.bitCount + 7) >> 3;
+      for(U32 i = 0; i < byteCount; i++)
+      {
+         const U8 diff = bstream->readFlag() ? U8(bstream->readInt(8)) : 0;
+         bits[i] = diff ^ (i < baseBytes ? base.data[i] : 0);
+      }
+   }
+   else
+   {
+      bstream->readBits(bitCount, bits);
+      if(bitCount & 7)
+         bits[byteCount - 1] &= (1 << (bitCount & 7)) - 1;
+   }
+
+   history[serial & (GhostDeltaHistorySize - 1)].set(serial, bits, bitCount);
+   return true;
+}
+
+U32 NetConnection::ghostPackUpdate(GhostInfo *ghost, GhostRef *ref, U32 updateMask, bool delta, BitStream *bstream)
+{
+   if(!delta)
+      return ghost->obj->packUpdate(this, updateMask, bstream);
+
+   // Serialize on the side so the result can be compared with the
+   // baseline.  The compression point carries over between updates.
+   BitStream scratch(sGhostDeltaBuffer, sizeof(sGhostDeltaBuffer));
+   scratch.setCompressionPoint(bstream->getCompressionPoint());
+   U32 retMask = ghost->obj->packUpdate(this, updateMask, &scratch);
+   bstream->setCompressionPoint(scratch.getCompressionPoint());
+
+   ghostWriteDeltaUpdate(ghost, ref, sGhostDeltaBuffer, scratch.getCurPos(), bstream);
+   return retMask;
+}
+
+void NetConnection::ghostUnpackUpdate(U32 index, bool delta, BitStream *bstream)
+{
+   if(!delta)
+   {
+      mLocalGhosts[index]->unpackUpdate(this, bstream);
+      return;
+   }
+
+   U32 bitCount;
+   if(!ghostReadDeltaUpdate(index, bstream, sGhostDeltaBuffer, bitCount))
+      return;
+
+   BitStream scratch(sGhostDeltaBuffer, (bitCount + 7) >> 3);
+   scratch.setCompressionPoint(bstream->getCompressionPoint());
+   mLocalGhosts[index]->unpackUpdate(this, &scratch);
+   bstream->setCompressionPoint(scratch.getCompressionPoint());
+}
+
 void NetConnection::setGhostTo(bool ghostTo)
 {
    if(mLocalGhosts) // if ghosting to this is already enabled, silently return
@@ -190,6 +383,8 @@ void NetConnection::setGhostFrom(bool ghostFrom)
          mGhostRefs[i].obj = NULL;
          mGhostRefs[i].index = i;
          mGhostRefs[i].updateMask = 0;
+         mGhostRefs[i].deltaSerial = 0;
+         mGhostRefs[i].baseline = NULL;
       }
       mGhostLookupTable = new GhostInfo *[GhostLookupTableSize];
       for(i = 0; i < GhostLookupTableSize; i++)
@@ -260,6 +455,7 @@ void NetConnection::ghostPacketDropped(PacketNotify *notify)
          packRef->ghost->flags &= ~GhostInfo::KillingGhost;
       }
 
+      freeGhostState(packRef->sentState);
       delete packRef;
       packRef = temp;
    }
@@ -286,6 +482,15 @@ void NetConnection::ghostPacketReceived(PacketNotify *notify)
 
       *walk = 0;
 
+      // the client has this update now, so it can be delta compressed against.
+      // acks arrive in order so it is always newer than the current baseline.
+
+      if(packRef->sentState)
+      {
+         freeGhostState(packRef->ghost->baseline);
+         packRef->ghost->baseline = packRef->sentState;
+      }
+
       // if this object was ghosting , it is now ghosted
 
       if(packRef->ghostInfoFlags & GhostInfo::Ghosting)
@@ -330,7 +535,8 @@ void NetConnection::ghostWritePacket(BitStream *bstream, PacketNotify *notify)
    if(!isGhostingFrom())
       return;
 
-   if(!bstream->writeFlag(mGhosting))
+   // Bulk packets only carry file data.
+   if(!bstream->writeFlag(mGhosting && !mWritingBulkPacket))
       return;
 
    // fill a packet (or two) with ghosting data
@@ -423,6 +629,8 @@ void NetConnection::ghostWritePacket(BitStream *bstream, PacketNotify *notify)
       sendSize = 3;
 
    bstream->writeInt(sendSize - 3, GhostIndexBitSize);
+   // older protocols don't have the delta flag at all.
+   const bool delta = isGhostDeltaSupported() && bstream->writeFlag(mGhostDeltaCompression);
 
    U32 count = 0;
    //
@@ -446,6 +654,7 @@ void NetConnection::ghostWritePacket(BitStream *bstream, PacketNotify *notify)
 
       upd->ghost = walk;
       upd->ghostInfoFlags = 0;
+      upd->sentState = NULL;
 
       if(walk->flags & GhostInfo::KillGhost)
       {
@@ -486,7 +695,7 @@ void NetConnection::ghostWritePacket(BitStream *bstream, PacketNotify *notify)
 #ifdef TORQUE_NET_STATS
          U32 beginSize = bstream->getBitPosition();
 #endif
-         U32 retMask = walk->obj->packUpdate(this, updateMask, bstream);
+         U32 retMask = ghostPackUpdate(walk, upd, updateMask, delta, bstream);
 #ifdef TORQUE_NET_STATS
          walk->obj->getClassRep()->updateNetStatPack(updateMask, bstream->getBitPosition() - beginSize);
 #endif
@@ -531,6 +740,7 @@ void NetConnection::ghostReadPacket(BitStream *bstream)
    S32 idSize;
    idSize = bstream->readInt( GhostIndexBitSize);
    idSize += 3;
+   const bool delta = isGhostDeltaSupported() && bstream->readFlag();
 
    // while there's an object waiting...
    gGhostUpdates = 0;
@@ -592,10 +802,13 @@ void NetConnection::ghostReadPacket(BitStream *bstream)
 #ifdef TORQUE_NET_STATS
             U32 beginSize = bstream->getBitPosition();
 #endif
-            mLocalGhosts[index]->unpackUpdate(this, bstream);
+            clearGhostDeltaHistory(index);
+            ghostUnpackUpdate(index, delta, bstream);
 #ifdef TORQUE_NET_STATS
             mLocalGhosts[index]->getClassRep()->updateNetStatUnpack(bstream->getBitPosition() - beginSize);
 #endif
+            if(mErrorBuffer.isNotEmpty())
+               return;
             // Setup the remote object pointers before
             // we register so that it can be used from onAdd.
             if( mRemoteConnection )
@@ -641,7 +854,7 @@ void NetConnection::ghostReadPacket(BitStream *bstream)
 #ifdef TORQUE_NET_STATS
             U32 beginSize = bstream->getBitPosition();
 #endif
-            mLocalGhosts[index]->unpackUpdate(this, bstream);
+            ghostUnpackUpdate(index, delta, bstream);
 #ifdef TORQUE_NET_STATS
             mLocalGhosts[index]->getClassRep()->updateNetStatUnpack(bstream->getBitPosition() - beginSize);
 #endif
@@ -720,6 +933,9 @@ void NetConnection::freeGhostInfo(GhostInfo *ghost)
    }
    ghostPushZeroToFree(ghost);
    AssertFatal(ghost->updateChain == NULL, "Ack!");
+
+   freeGhostState(ghost->baseline);
+   ghost->baseline = NULL;
 }
 
 //-----------------------------------------------------------------------------
@@ -903,6 +1119,8 @@ void NetConnection::handleConnectionMessage(U32 message, U32 sequence, U32 ghost
          mCurrentFileBufferSize = sequence;
          mCurrentFileBuffer = dRealloc(mCurrentFileBuffer, mCurrentFileBufferSize);
          mCurrentFileBufferOffset = 0;
+         mDownloadBlockSize = 0;
+         mDownloadBlockReceived = 0;
          break;
    }
 }
@@ -1177,6 +1395,7 @@ void NetConnection::loadNextGhostAlwaysObject(bool hadNewFiles)
 
       AssertFatal(mLocalGhosts[index] == NULL, "Ghost already in table!");
       mLocalGhosts[index] = object;
+      clearGhostDeltaHistory(index);
       hadNewFiles = true;
    }
 }
@@ -1253,6 +1472,29 @@ void NetConnection::ghostWriteStartBlock(ResizeBitStream *stream)
          stream->validate();
       }
    }
+
+   // delta compressed updates later in the demo may be encoded against
+   // updates received before it started, so record those as well.
+   if(isGhostDeltaSupported() && stream->writeFlag(mGhostDeltaHistory != NULL))
+   {
+      for(U32 i = 0; i < MaxGhostCount; i++)
+      {
+         if(!mLocalGhosts[i] || !mGhostDeltaHistory[i])
+            continue;
+
+         stream->writeFlag(true);
+         stream->writeInt(i, GhostIdBitSize);
+         for(U32 j = 0; j < GhostDeltaHistorySize; j++)
+         {
+            const GhostState &state = mGhostDeltaHistory[i][j];
+            stream->writeInt(state.serial, GhostDeltaSerialBitSize);
+            stream->writeInt(state.bitCount, GhostDeltaSizeBitSize);
+            stream->writeBits(state.bitCount, state.data);
+            stream->validate();
+         }
+      }
+      stream->writeFlag(false);
+   }
 }
 
 void NetConnection::ghostReadStartBlock(BitStream *stream)
@@ -1295,6 +1537,30 @@ void NetConnection::ghostReadStartBlock(BitStream *stream)
          addObject(mLocalGhosts[i]);
       }
    }
+
+   // demos recorded before delta compression have no history.
+   if(isGhostDeltaSupported() && stream->readFlag())
+   {
+      while(stream->readFlag())
+      {
+         U32 index = stream->readInt(GhostIdBitSize);
+         GhostState *history = getGhostDeltaHistory(index);
+         for(U32 j = 0; j < GhostDeltaHistorySize; j++)
+         {
+            U32 serial = stream->readInt(GhostDeltaSerialBitSize);
+            U32 bitCount = stream->readInt(GhostDeltaSizeBitSize);
+            if(bitCount > Net::MaxPacketDataSize << 3)
+            {
+               setLastError("Invalid packet. (ghost update too large in demo block)");
+               return;
+            }
+            stream->readBits(bitCount, sGhostDeltaBuffer);
+            if(bitCount & 7)
+               sGhostDeltaBuffer[bitCount >> 3] &= (1 << (bitCount & 7)) - 1;
+            history[j].set(serial, sGhostDeltaBuffer, bitCount);
+         }
+      }
+   }
    // MARKF - TODO - looks like we could have memory leaks here
    // if there are errors.
 }
@@ -34,6 +34,7 @@
 #include "scene/sceneRenderState.h"
 #include "lighting/lightManager.h"
 #include "gfx/gfxDrawUtil.h"
+#include "platform/threads/threadPool.h"
 
 
 GFXImplementVertexFormat( TerrVertex )
@@ -286,6 +287,11 @@ TerrCell* TerrCell::init( TerrainBlock *terrain )
                   terrain->getBlockSize(),
                   0 );
 
+   // Generate the VBs (and maybe PBs) for every cell but the root.
+   Vector<TerrCell*> cells;
+   root->_findDirtyCells( RectI( 0, 0, terrain->getBlockSize(), terrain->getBlockSize() ), &cells );
+   _rebuildBuffers( cells );
+
    // Set initial states of OBBs.
    root->updateOBBs();
 
@@ -305,13 +311,6 @@ void TerrCell::_init( TerrainBlock *terrain,
    mSize = size;
    mLevel = level;
 
-   // Generate a VB (and maybe a PB) for this cell, unless we are the Root cell.
-   if ( level > 0 )
-   {
-      _updateVertexBuffer();
-      _updatePrimitiveBuffer();
-   }
-      
    if ( mSize <= smMinCellSize )
    {
       // Update our bounds and materials... the 
@@ -368,13 +367,137 @@ void TerrCell::updateGrid( const RectI &gridRect, bool opacityOnly )
 {
    PROFILE_SCOPE( TerrCell_UpdateGrid );
 
-   // If we have a VB... then update it.
-   if ( mVertexBuffer.isValid() && !opacityOnly )            
-      _updateVertexBuffer();
+   // Only the vertices depend on the heights and empty state, and
+   // the indices only depend on the empty vertex list, so there is
+   // nothing to rebuild for opacity changes.
+   if ( !opacityOnly )
+   {
+      Vector<TerrCell*> cells;
+      _findDirtyCells( gridRect, &cells );
+      _rebuildBuffers( cells );
+   }
+
+   _updateGrid( gridRect, opacityOnly );
+}
+
+void TerrCell::_findDirtyCells( const RectI &gridRect, Vector<TerrCell*> *outCells )
+{
+   // The root cell has no VB of its own.
+   if ( mLevel > 0 )
+      outCells->push_back( this );
+
+   if ( !mChildren[0] )
+      return;
+
+   for ( U32 i = 0; i < 4; i++ )
+   {
+      TerrCell *cell = mChildren[i];
+
+      // The overlap test doesn't hit shared edges
+      // so grow it a bit when we create it.
+      const RectI cellRect( cell->mPoint.x - 1,
+                            cell->mPoint.y - 1,
+                            cell->mSize + 2, 
+                            cell->mSize + 2 );
+
+      // We do an overlap and containment test as it 
+      // properly handles zero sized rects.
+      if (  cellRect.contains( gridRect ) ||
+            cellRect.overlaps( gridRect ) )
+         cell->_findDirtyCells( gridRect, outCells );
+   }
+}
+
+void TerrCell::_rebuildBuffers( const Vector<TerrCell*> &cells )
+{
+   PROFILE_SCOPE( TerrCell_RebuildBuffers );
+
+   // The cells are built on the thread pool into these staging
+   // buffers a batch at a time, which bounds the memory used
+   // while still giving each thread a few cells to work on.
+   const U32 batchSize = 16;
 
-   // Update our PB, if any
-   _updatePrimitiveBuffer();
+   static Vector<TerrVertex> sStagingVerts;
+   static Vector<U16> sStagingIndices;
+   U32 triCounts[ batchSize ];
 
+   struct BuildCells
+   {
+      TerrCell *const *cells;
+      TerrVertex *verts;
+      U16 *indices;
+      U32 *triCounts;
+
+      void operator()( U32 i )
+      {
+         TerrCell *cell = cells[i];
+         cell->_buildVertices( verts + i * smVBSize );
+         triCounts[i] = cell->mHasEmpty ? cell->_buildIndices( indices + i * smPBSize ) : 0;
+      }
+   };
+
+   for ( U32 start = 0; start < cells.size(); start += batchSize )
+   {
+      const U32 count = getMin( cells.size() - start, batchSize );
+      if ( sStagingVerts.size() < count * smVBSize )
+      {
+         sStagingVerts.setSize( count * smVBSize );
+         sStagingIndices.setSize( count * smPBSize );
+      }
+
+      BuildCells build = { cells.address() + start, sStagingVerts.address(), sStagingIndices.address(), triCounts };
+      ThreadPool::GLOBAL().parallelFor( count, build );
+
+      for ( U32 i = 0; i < count; i++ )
+         cells[ start + i ]->_uploadBuffers( sStagingVerts.address() + i * smVBSize, sStagingIndices.address() + i * smPBSize, triCounts[i] );
+   }
+}
+
+void TerrCell::_uploadBuffers( const TerrVertex *verts, const U16 *indices, U32 triCount )
+{
+   PROFILE_SCOPE( TerrCell_UploadBuffers );
+
+   mVertexBuffer.set( GFX, smVBSize, GFXBufferTypeStatic );
+   TerrVertex *vert = mVertexBuffer.lock();
+   dMemcpy( vert, verts, smVBSize * sizeof( TerrVertex ) );
+   mVertexBuffer.unlock();
+   deleteZodiacVertexBuffer();
+
+   mTriCount = triCount;
+
+   if ( !mHasEmpty )
+   {
+      if ( mPrimBuffer.isValid() )
+      {
+         // There are no more empty squares for this cell, so
+         // get rid of the primitive buffer to use the standard one.
+         mPrimBuffer = NULL;
+      }
+
+      return;
+   }
+
+   // Build our custom primitive buffer.  We're setting it to the maximum allowed
+   // size, but should be just shy of it depending on the number of empty squares
+   // in this cell.  We could calculate it, but note that it would be different
+   // from mEmptyVertexList.size() as that can include vertices on the edges that
+   // are really considered part of another cell's squares.  So we take a slightly
+   // larger buffer over running through the calculation.
+   mPrimBuffer.set( GFX, smPBSize, 1, GFXBufferTypeStatic, "TerrCell" );
+
+   GFXPrimitive *prim = mPrimBuffer.getPointer()->mPrimitiveArray;
+   prim->type = GFXTriangleList;
+   prim->numVertices = smVBSize;
+
+   U16 *idxBuff;
+   mPrimBuffer.lock( &idxBuff );
+   dMemcpy( idxBuff, indices, triCount * 3 * sizeof( U16 ) );
+   mPrimBuffer.unlock();
+   prim->numPrimitives = mTriCount;
+}
+
+void TerrCell::_updateGrid( const RectI &gridRect, bool opacityOnly )
+{
    // If we don't have children... then we're
    // a leaf at the bottom of the cell quadtree
    // and we should just update our bounds.
@@ -387,8 +510,8 @@ void TerrCell::updateGrid( const RectI &gridRect, bool opacityOnly )
       return;
    }
 
-   // Otherwise, we must call updateGrid on our children
-   // and then update our bounds/materials AFTER to contain them.
+   // Otherwise, we must update our children and then
+   // update our bounds/materials AFTER to contain them.
 
    mMaterials = 0;
 
@@ -396,18 +519,14 @@ void TerrCell::updateGrid( const RectI &gridRect, bool opacityOnly )
    {
       TerrCell *cell = mChildren[i];
 
-      // The overlap test doesn't hit shared edges
-      // so grow it a bit when we create it.
       const RectI cellRect( cell->mPoint.x - 1,
                             cell->mPoint.y - 1,
                             cell->mSize + 2, 
                             cell->mSize + 2 );
 
-      // We do an overlap and containment test as it 
-      // properly handles zero sized rects.
       if (  cellRect.contains( gridRect ) ||
             cellRect.overlaps( gridRect ) )
-         cell->updateGrid( gridRect, opacityOnly );
+         cell->_updateGrid( gridRect, opacityOnly );
 
       // Update the bounds from our children.
       if ( !opacityOnly )
@@ -428,28 +547,26 @@ void TerrCell::updateGrid( const RectI &gridRect, bool opacityOnly )
       mMaterial->init( mTerrain, mMaterials );
 }
 
-void TerrCell::_updateVertexBuffer()
+void TerrCell::_buildVertices( TerrVertex *vert )
 {
-   PROFILE_SCOPE( TerrCell_UpdateVertexBuffer );
-
    // Start off with no empty squares
    mHasEmpty = false;
    mEmptyVertexList.clear();
 
-   mVertexBuffer.set( GFX, smVBSize, GFXBufferTypeStatic );
-
    const F32 squareSize = mTerrain->getSquareSize();
    const U32 blockSize = mTerrain->getBlockSize();
    const U32 stepSize = mSize / smMinCellSize;
 
    U32 vbcounter = 0;
 
-   TerrVertex *vert = mVertexBuffer.lock();
-
    Point2I gridPt;
    Point2F point;
    F32 height;
    Point3F normal;   
+
+   // The normals for a row of verts are sampled in one batch.
+   Point2F rowPoints[ smVBStride ];
+   Point3F rowNormals[ smVBStride ];
    
    const TerrainFile *file = mTerrain->getFile();
 
@@ -462,18 +579,24 @@ void TerrCell::_updateVertexBuffer()
          // around the edges of the terrain.
          gridPt.x = mClamp( mPoint.x + x * stepSize, 0, blockSize - 1 );
          gridPt.y = mClamp( mPoint.y + y * stepSize, 0, blockSize - 1 );
+         rowPoints[x].set( (F32)gridPt.x * squareSize, (F32)gridPt.y * squareSize );
+      }
+
+      mTerrain->getSmoothNormalBatch( rowPoints, smVBStride, rowNormals, NULL, true, false );
+
+      for ( U32 x = 0; x < smVBStride; x++ )
+      {
+         gridPt.x = mClamp( mPoint.x + x * stepSize, 0, blockSize - 1 );
+         gridPt.y = mClamp( mPoint.y + y * stepSize, 0, blockSize - 1 );
 
          // Setup this point.
-         point.x = (F32)gridPt.x * squareSize;
-         point.y = (F32)gridPt.y * squareSize;
+         point = rowPoints[x];
          height = fixedToFloat( file->getHeight( gridPt.x, gridPt.y ) );
          vert->point.x = point.x;
          vert->point.y = point.y;
          vert->point.z = height;
 
-         // Get the normal.
-         mTerrain->getSmoothNormal( point, &normal, true, false );
-         vert->normal = normal;
+         vert->normal = rowNormals[x];
 
          // Get the tangent z.
          vert->tangentZ = fixedToFloat( file->getHeight( gridPt.x + 1, gridPt.y ) ) - height;
@@ -592,43 +715,11 @@ void TerrCell::_updateVertexBuffer()
    }
 
    AssertFatal( vbcounter == smVBSize, "bad" );
-   mVertexBuffer.unlock();
-   deleteZodiacVertexBuffer();
 }
 
-void TerrCell::_updatePrimitiveBuffer()
+U32 TerrCell::_buildIndices( U16 *idxBuff ) const
 {
-   PROFILE_SCOPE( TerrCell_UpdatePrimitiveBuffer );
-
-   if ( !mHasEmpty )
-   {
-      if ( mPrimBuffer.isValid() )
-      {
-         // There are no more empty squares for this cell, so
-         // get rid of the primitive buffer to use the standard one.
-         mPrimBuffer = NULL;
-      }
-
-      return;
-   }
-
-   // Build our custom primitive buffer.  We're setting it to the maximum allowed
-   // size, but should be just shy of it depending on the number of empty squares
-   // in this cell.  We could calculate it, but note that it would be different
-   // from mEmptyVertexList.size() as that can include vertices on the edges that
-   // are really considered part of another cell's squares.  So we take a slightly
-   // larger buffer over running through the calculation.
-   mPrimBuffer.set( GFX, smPBSize, 1, GFXBufferTypeStatic, "TerrCell" );
-
-   GFXPrimitive *prim = mPrimBuffer.getPointer()->mPrimitiveArray;
-   prim->type = GFXTriangleList;
-   prim->numVertices = smVBSize;
-
-   mTriCount = 0;
-
-   // Lock and fill it up!
-   U16 *idxBuff;
-   mPrimBuffer.lock( &idxBuff );
+   U32 triCount = 0;
    U32 counter = 0;
    U32 maxIndex = 0;
 
@@ -672,7 +763,7 @@ void TerrCell::_updatePrimitiveBuffer()
          maxIndex = index + 1 + smVBStride;         
          counter += 6;         
 
-         mTriCount += 2;
+         triCount += 2;
       }
    }
 
@@ -716,7 +807,7 @@ void TerrCell::_updatePrimitiveBuffer()
       maxIndex = b1;
       counter += 6;
 
-      mTriCount += 2;
+      triCount += 2;
    }
 
    // Bottom edge skirt...
@@ -754,7 +845,7 @@ void TerrCell::_updatePrimitiveBuffer()
       maxIndex = b1;
       counter += 6;
 
-      mTriCount += 2;
+      triCount += 2;
    }
 
    // Left edge skirt...
@@ -790,7 +881,7 @@ void TerrCell::_updatePrimitiveBuffer()
       maxIndex = b1;
       counter += 6;
 
-      mTriCount += 2;
+      triCount += 2;
    }
 
    // Right edge skirt...
@@ -828,11 +919,10 @@ void TerrCell::_updatePrimitiveBuffer()
       maxIndex = b1;
       counter += 6;
 
-      mTriCount += 2;
+      triCount += 2;
    }
 
-   mPrimBuffer.unlock();
-   prim->numPrimitives = mTriCount;
+   return triCount;
 }
 
 void TerrCell::_updateMaterials()
@@ -154,11 +154,28 @@ protected:
                U32 size,
                U32 level );
 
-   // 
-   void _updateVertexBuffer();
+   /// Fills @a vert with the smVBSize vertices of this cell and
+   /// refreshes the empty vertex list.  This only reads from the
+   /// terrain so several cells can be built at once.
+   void _buildVertices( TerrVertex *vert );
 
-   //
-   void _updatePrimitiveBuffer();
+   /// Fills @a idxBuff with the indices of this cell skipping
+   /// the empty squares and returns the triangle count.
+   U32 _buildIndices( U16 *idxBuff ) const;
+
+   /// Copies the built vertices and indices into the GFX buffers.
+   void _uploadBuffers( const TerrVertex *verts, const U16 *indices, U32 triCount );
+
+   /// Adds the cells with their own vertex buffer which 
+   /// overlap the grid rect to @a outCells.
+   void _findDirtyCells( const RectI &gridRect, Vector<TerrCell*> *outCells );
+
+   /// Builds the buffers for the cells on the thread pool
+   /// and uploads them from the calling thread.
+   static void _rebuildBuffers( const Vector<TerrCell*> &cells );
+
+   /// Updates the bounds and materials after a grid change.
+   void _updateGrid( const RectI &gridRect, bool opacityOnly );
 
    // 
    void _updateMaterials();
@@ -258,6 +258,25 @@ protected:
 
    void _updateZoning();
 
+   /// Returns true and fills outKeys with the order in which to visit
+   /// the points of a batched sample so that points in the same part of
+   /// the heightmap are sampled together.  The point index is in the low
+   /// 32 bits of each key.  Returns false if the points can be sampled
+   /// in the order given.
+   bool _getBatchOrder( const Point2F *pos, U32 count, Vector<U64> &outKeys ) const;
+
+   /// The shared implementation of the batched sampling functions.
+   U32 _sampleBatch( const Point2F *pos,
+                     U32 count,
+                     F32 *outHeights,
+                     Point3F *outNormals,
+                     U8 *outMaterials,
+                     bool *outValid,
+                     bool normalize,
+                     bool skipEmpty,
+                     bool smooth,
+                     Vector<U64> *scratch ) const;
+
    // Protected fields
    static bool _setTerrainFile( void *obj, const char *index, const char *data );
    static bool _setTerrainAsset(void* obj, const char* index, const char* data);
@@ -417,6 +436,57 @@ public:
                                  F32 *height, 
                                  StringTableEntry &matName ) const;
 
+   /// @name Batched Sampling
+   /// These are the array versions of getHeight(), getNormal(),
+   /// getSmoothNormal() and getNormalAndHeight() for callers that query
+   /// many points at once.  Positions are in the terrain's object space
+   /// and the results match the single point versions.
+   ///
+   /// The points are grouped by heightmap tile before sampling and
+   /// interpolated four at a time.  Any output array may be NULL.  If
+   /// outValid is set it receives false for points outside the terrain
+   /// or within an empty square.  Each returns the number of valid points.
+   ///
+   /// Points already in tile order, like a row of grid points, are not
+   /// sorted.  Callers sampling scattered points every frame can pass a
+   /// scratch vector which they keep around to hold the sort keys, so
+   /// the calls stop allocating once it has grown.
+   /// @{
+
+   U32 getHeightBatch(  const Point2F *pos,
+                        U32 count,
+                        F32 *outHeights,
+                        bool *outValid = NULL,
+                        Vector<U64> *scratch = NULL ) const;
+
+   U32 getNormalBatch(  const Point2F *pos,
+                        U32 count,
+                        Point3F *outNormals,
+                        bool *outValid = NULL,
+                        bool normalize = true,
+                        bool skipEmpty = true,
+                        Vector<U64> *scratch = NULL ) const;
+
+   U32 getSmoothNormalBatch(  const Point2F *pos,
+                              U32 count,
+                              Point3F *outNormals,
+                              bool *outValid = NULL,
+                              bool normalize = true,
+                              bool skipEmpty = true,
+                              Vector<U64> *scratch = NULL ) const;
+
+   /// The material output is the layer index used by the terrain file
+   /// for each point, U8_MAX where there is none.
+   U32 getNormalHeightMaterialBatch(   const Point2F *pos,
+                                       U32 count,
+                                       Point3F *outNormals,
+                                       F32 *outHeights,
+                                       U8 *outMaterials,
+                                       bool *outValid = NULL,
+                                       bool normalize = true,
+                                       Vector<U64> *scratch = NULL ) const;
+   /// @}
+
    // only the editor currently uses this method - should always be using a ray to collide with
    bool collideBox( const Point3F &start, const Point3F &end, RayInfo* info ) override
    {
@@ -464,6 +534,9 @@ public:
    void setTransform( const MatrixF &mat ) override;
    void setScale( const VectorF &scale ) override;
 
+   /// Heightmap edits are reported thru smUpdateSignal.
+   bool isStaticGeometry() const override { return true; }
+
    void prepRenderImage  ( SceneRenderState* state ) override;
 
    void buildConvex(const Box3F& box,Convex* convex) override;
@@ -29,7 +29,10 @@
 #include "gfx/gfxTextureHandle.h"
 #include "gfx/bitmap/gBitmap.h"
 #include "platform/profiler.h"
+#include "platform/platformIntrinsics.h"
 #include "math/mPlane.h"
+#include "core/util/journal/process.h"
+#include "console/consoleTypes.h"
 
 
 template<>
@@ -44,9 +47,28 @@ template<> ResourceBase::Signature Resource<TerrainFile>::signature()
 }
 
 
+S32 TerrainFile::smMaxGridTiles = 256;
+
+Vector<TerrainFile*> TerrainFile::smTerrainFiles;
+
+
+AFTER_MODULE_INIT( Sim )
+{
+   Con::addVariable( "$pref::Terrain::maxGridTiles", TypeS32, &TerrainFile::smMaxGridTiles,
+      "The maximum number of collision grid tiles of 64x64 height samples kept "
+      "per terrain.  The least recently used tiles above this are freed and "
+      "rebuilt when next needed.  Defaults to 256.\n"
+      "@ingroup Terrain\n" );
+
+   Process::notify( &TerrainFile::trimAllGridTiles );
+}
+
 TerrainFile::TerrainFile()
    : mSize( 256 ),
      mGridLevels(0),
+     mGridTileLevels(0),
+     mGridTileSize(0),
+     mGridTileTrims(0),
      mFileVersion( FILE_VERSION ),
      mNeedsResaving( false )
 {
@@ -55,10 +77,15 @@ TerrainFile::TerrainFile()
 
    mHeightMap.setSize( mSize * mSize );
    dMemset( mHeightMap.address(), 0, mHeightMap.memSize() );
+
+   smTerrainFiles.push_back( this );
 }
 
 TerrainFile::~TerrainFile()
 {
+   smTerrainFiles.remove( this );
+
+   _freeGridTiles();
 }
 
 static U16 calcDev( const PlaneF &pl, const Point3F &pt )
@@ -90,35 +117,320 @@ inline U32 getMostSignificantBit( U32 v )
    return bit;
 }
 
+void TerrainFile::_buildGridSquare(   U32 level, 
+                                       U32 x, 
+                                       U32 y, 
+                                       TerrainSquare *sq, 
+                                       TerrainSquare *parent, 
+                                       bool updateParent ) const
+{
+   const S32 squareSize = 1 << level;
+   const U32 squareX = x >> level;
+   const U32 squareY = y >> level;
+
+   U16 min = 0xFFFF;
+   U16 max = 0;
+   U16 mindev45 = 0;
+   U16 mindev135 = 0;
+
+   // determine max error for both possible splits.
+
+   const Point3F p1(0, 0, getHeight(x, y));
+   const Point3F p2(0, (F32)squareSize, getHeight(x, y + squareSize));
+   const Point3F p3((F32)squareSize, (F32)squareSize, getHeight(x + squareSize, y + squareSize));
+   const Point3F p4((F32)squareSize, 0, getHeight(x + squareSize, y));
+
+   // pl1, pl2 = split45, pl3, pl4 = split135
+   const PlaneF pl1(p1, p2, p3);
+   const PlaneF pl2(p1, p3, p4);
+   const PlaneF pl3(p1, p2, p4);
+   const PlaneF pl4(p2, p3, p4);
+
+   const bool parentSplit45 = parent && ( parent->flags & TerrainSquare::Split45 );
+
+   bool empty = true;
+   bool hasEmpty = false;
+
+   for ( S32 sizeX = 0; sizeX <= squareSize; sizeX++ )
+   {
+      for ( S32 sizeY = 0; sizeY <= squareSize; sizeY++ )
+      {
+         const U32 px = x + sizeX;
+         const U32 py = y + sizeY;
+
+         if(sizeX != squareSize && sizeY != squareSize)
+         {
+            if ( !isEmptyAt( px, py ) )
+               empty = false;
+            else
+               hasEmpty = true;
+         }
+
+         U16 ht = getHeight( px, py );
+         if ( ht < min )
+            min = ht;
+         if( ht > max )
+            max = ht;
+
+         Point3F pt( (F32)sizeX, (F32)sizeY, (F32)ht );
+         U16 dev;
+
+         if(sizeX < sizeY)
+            dev = calcDev(pl1, pt);
+         else if(sizeX > sizeY)
+            dev = calcDev(pl2, pt);
+         else
+            dev = Umax(calcDev(pl1, pt), calcDev(pl2, pt));
+
+         if(dev > mindev45)
+            mindev45 = dev;
+
+         if(sizeX + sizeY < squareSize)
+            dev = calcDev(pl3, pt);
+         else if(sizeX + sizeY > squareSize)
+            dev = calcDev(pl4, pt);
+         else
+            dev = Umax(calcDev(pl3, pt), calcDev(pl4, pt));
+
+         if(dev > mindev135)
+            mindev135 = dev;
+      }
+   }
+
+   sq->minHeight = min;
+   sq->maxHeight = max;
+
+   sq->flags = empty ? TerrainSquare::Empty : 0;
+   if ( hasEmpty )
+      sq->flags |= TerrainSquare::HasEmpty;
+
+   bool shouldSplit45 = ((squareX ^ squareY) & 1) == 0;
+   bool split45;
+
+   //split45 = shouldSplit45;
+   if ( level == 0 )
+      split45 = shouldSplit45;
+   else if( level < 4 && shouldSplit45 == parentSplit45 )
+      split45 = shouldSplit45;
+   else
+      split45 = mindev45 < mindev135;
+
+   //split45 = shouldSplit45;
+   if(split45)
+   {
+      sq->flags |= TerrainSquare::Split45;
+      sq->heightDeviance = mindev45;
+   }
+   else
+      sq->heightDeviance = mindev135;
+
+   if( parent && updateParent )
+      if (  parent->heightDeviance < sq->heightDeviance )
+            parent->heightDeviance = sq->heightDeviance;
+}
+
+void TerrainFile::_freeGridTiles()
+{
+   for ( U32 i = 0; i < mGridTiles.size(); i++ )
+      delete [] mGridTiles[i];
+
+   for ( U32 i = 0; i < mRetiredGridTiles.size(); i++ )
+      delete [] mRetiredGridTiles[i].tile;
+
+   mGridTiles.clear();
+   mGridTileStamps.clear();
+   mRetiredGridTiles.clear();
+}
+
+static S32 QSORT_CALLBACK _compareGridTileKeys( const U64 *a, const U64 *b )
+{
+   return *a < *b ? -1 : ( *a > *b ? 1 : 0 );
+}
+
+void TerrainFile::trimAllGridTiles()
+{
+   for ( U32 i = 0; i < smTerrainFiles.size(); i++ )
+      smTerrainFiles[i]->trimGridTiles();
+}
+
+U32 TerrainFile::getGridTileCount() const
+{
+   U32 count = 0;
+   for ( U32 i = 0; i < mGridTiles.size(); i++ )
+   {
+      if ( mGridTiles[i] )
+         count++;
+   }
+
+   return count;
+}
+
+void TerrainFile::trimGridTiles()
+{
+   PROFILE_SCOPE( TerrainFile_TrimGridTiles );
+
+   // Free the tiles evicted long enough ago that no
+   // query can still be holding on to their squares.
+   for ( S32 i = mRetiredGridTiles.size() - 1; i >= 0; i-- )
+   {
+      if ( mGridTileTrims - mRetiredGridTiles[i].trim >= GridTileRetireTrims )
+      {
+         delete [] mRetiredGridTiles[i].tile;
+         mRetiredGridTiles.erase_fast( i );
+      }
+   }
+
+   const U32 maxTiles = getMax( smMaxGridTiles, 0 );
+   U32 count = getGridTileCount();
+   if ( count > maxTiles )
+   {
+      // Gather the built tiles which weren't used since the 
+      // last trim, the others may be in use right now.  The
+      // keys sort by the last use and then the tile index.
+      Vector<U64> unused;
+      for ( U32 i = 0; i < mGridTiles.size(); i++ )
+      {
+         if ( mGridTiles[i] && mGridTileStamps[i] != mGridTileTrims )
+            unused.push_back( ( (U64)mGridTileStamps[i] << 32 ) | i );
+      }
+
+      // Evict the least recently used first.
+      unused.sort( _compareGridTileKeys );
+
+      for ( U32 i = 0; i < unused.size() && count > maxTiles; i++ )
+      {
+         // A worker which reads the empty slot after
+         // this just builds the tile over again.
+         TerrainSquare* volatile &slot = reinterpret_cast<TerrainSquare* volatile&>( mGridTiles[ U32( unused[i] ) ] );
+         TerrainSquare *tile = slot;
+         if ( !dCompareAndSwap( slot, tile, (TerrainSquare*)NULL ) )
+            continue;
+
+         RetiredGridTile retired;
+         retired.tile = tile;
+         retired.trim = mGridTileTrims;
+         mRetiredGridTiles.push_back( retired );
+         count--;
+      }
+   }
+
+   mGridTileTrims++;
+}
+
+TerrainSquare* TerrainFile::_buildGridTile( U32 tileIndex ) const
+{
+   PROFILE_SCOPE( TerrainFile_BuildGridTile );
+
+   const U32 tileShift = mGridLevels - mGridTileLevels;
+   const U32 tileX = ( tileIndex & ( ( 1 << tileShift ) - 1 ) ) << mGridTileLevels;
+   const U32 tileY = ( tileIndex >> tileShift ) << mGridTileLevels;
+   const U32 tileMask = ( 1 << mGridTileLevels ) - 1;
+
+   TerrainSquare *tile = new TerrainSquare[ mGridTileSize ];
+
+   // Walk down the levels like _buildGridMap() does as the
+   // split of the lowest levels depends on their parent.
+   for ( S32 i = mGridTileLevels - 1; i >= 0; i-- )
+   {
+      const U32 squareCount = 1 << ( mGridTileLevels - i );
+
+      for ( U32 squareX = 0; squareX < squareCount; squareX++ )
+      {
+         for ( U32 squareY = 0; squareY < squareCount; squareY++ )
+         {
+            const U32 x = tileX + ( squareX << i );
+            const U32 y = tileY + ( squareY << i );
+
+            TerrainSquare *sq = tile + mGridTileOffsets[i] + squareX + ( squareY << ( mGridTileLevels - i ) );
+
+            // The parent of the top tile level is shared and already 
+            // includes our deviance, so only read from it.
+            TerrainSquare *parent;
+            const bool parentInTile = i + 1 < mGridTileLevels;
+            if ( parentInTile )
+            {
+               const U32 parentLevel = i + 1;
+               parent = tile + mGridTileOffsets[parentLevel] + 
+                           ( ( x & tileMask ) >> parentLevel ) + 
+                           ( ( ( y & tileMask ) >> parentLevel ) << ( mGridTileLevels - parentLevel ) );
+            }
+            else
+               parent = findSquare( i + 1, x, y );
+
+            _buildGridSquare( i, x, y, sq, parent, parentInTile );
+         }
+      }
+   }
+
+   // Another thread may have beaten us to it.
+   TerrainSquare* volatile &slot = reinterpret_cast<TerrainSquare* volatile&>( mGridTiles[ tileIndex ] );
+   if ( !dCompareAndSwap( slot, (TerrainSquare*)NULL, tile ) )
+   {
+      delete [] tile;
+      tile = slot;
+   }
+
+   return tile;
+}
+
 void TerrainFile::_buildGridMap()
 {
+   PROFILE_SCOPE( TerrainFile_BuildGridMap );
+
    // The grid level count is the same as the
-   // most significant bit of the size.  While 
-   // we loop we take the time to calculate the
-   // grid memory pool size.
+   // most significant bit of the size.
    mGridLevels = 0;
    U32 size = mSize;
-   U32 poolSize = size * size;
    while ( size >>= 1 )
-   {
-      poolSize += size * size;
       mGridLevels++;
+
+   // The lower levels are split into tiles which are
+   // built on demand.  Calculate the memory needed for
+   // a tile and for the levels above them.
+   _freeGridTiles();
+   mGridTileLevels = getMin( mGridLevels, (U32)GridTileLevels );
+   mGridTileSize = 0;
+   for ( U32 i = 0; i < mGridTileLevels; i++ )
+   {
+      mGridTileOffsets[i] = mGridTileSize;
+      mGridTileSize += 1 << ( 2 * ( mGridTileLevels - i ) );
    }
 
+   U64 poolSize = 0;
+   for ( U32 i = mGridTileLevels; i <= mGridLevels; i++ )
+      poolSize += (U64)1 << (U64)( 2 * ( mGridLevels - i ) );
+
    mGridMapPool.setSize( poolSize ); 
    mGridMapPool.compact();
    mGridMap.setSize( mGridLevels + 1 );
    mGridMap.compact();
 
+   const U32 tileCount = 1 << ( 2 * ( mGridLevels - mGridTileLevels ) );
+   mGridTiles.setSize( mGridTileLevels ? tileCount : 0 );
+   mGridTiles.compact();
+   mGridTileStamps.setSize( mGridTiles.size() );
+   mGridTileStamps.compact();
+   for ( U32 i = 0; i < mGridTiles.size(); i++ )
+   {
+      mGridTiles[i] = NULL;
+      mGridTileStamps[i] = 0;
+   }
+
    // Assign memory from the pool to each grid level.
    TerrainSquare *grid = mGridMapPool.address();
    for ( S32 i = mGridLevels; i >= 0; i-- )
    {
+      if ( i < mGridTileLevels )
+      {
+         mGridMap[i] = NULL;
+         continue;
+      }
+
       mGridMap[i] = grid;
 	  grid += (U64)1 << (U64)( 2 * ( mGridLevels - i ) );
    }
 
-   for( S32 i = mGridLevels; i >= 0; i-- )
+   for( S32 i = mGridLevels; i >= (S32)mGridTileLevels; i-- )
    {
       S32 squareCount = 1 << ( mGridLevels - i );
       S32 squareSize = mSize / squareCount;
@@ -127,130 +439,36 @@ void TerrainFile::_buildGridMap()
       {
          for ( S32 squareY = 0; squareY < squareCount; squareY++ )
          {
-            U16 min = 0xFFFF;
-            U16 max = 0;
-            U16 mindev45 = 0;
-            U16 mindev135 = 0;
-
-            // determine max error for both possible splits.
-
-            const Point3F p1(0, 0, getHeight(squareX * squareSize, squareY * squareSize));
-            const Point3F p2(0, (F32)squareSize, getHeight(squareX * squareSize, squareY * squareSize + squareSize));
-            const Point3F p3((F32)squareSize, (F32)squareSize, getHeight(squareX * squareSize + squareSize, squareY * squareSize + squareSize));
-            const Point3F p4((F32)squareSize, 0, getHeight(squareX * squareSize + squareSize, squareY * squareSize));
-
-            // pl1, pl2 = split45, pl3, pl4 = split135
-            const PlaneF pl1(p1, p2, p3);
-            const PlaneF pl2(p1, p3, p4);
-            const PlaneF pl3(p1, p2, p4);
-            const PlaneF pl4(p2, p3, p4);
-
-            bool parentSplit45 = false;
-            TerrainSquare *parent = NULL;
-            if ( i < mGridLevels )
-            {
-               parent = findSquare( i+1, squareX * squareSize, squareY * squareSize );
-               parentSplit45 = parent->flags & TerrainSquare::Split45;
-            }
-
-            bool empty = true;
-            bool hasEmpty = false;
+            const U32 x = squareX * squareSize;
+            const U32 y = squareY * squareSize;
 
-            for ( S32 sizeX = 0; sizeX <= squareSize; sizeX++ )
-            {
-               for ( S32 sizeY = 0; sizeY <= squareSize; sizeY++ )
-               {
-                  S32 x = squareX * squareSize + sizeX;
-                  S32 y = squareY * squareSize + sizeY;
-
-                  if(sizeX != squareSize && sizeY != squareSize)
-                  {
-                     if ( !isEmptyAt( x, y ) )
-                        empty = false;
-                     else
-                        hasEmpty = true;
-                  }
-
-                  U16 ht = getHeight( x, y );
-                  if ( ht < min )
-                     min = ht;
-                  if( ht > max )
-                     max = ht;
-
-                  Point3F pt( (F32)sizeX, (F32)sizeY, (F32)ht );
-                  U16 dev;
-
-                  if(sizeX < sizeY)
-                     dev = calcDev(pl1, pt);
-                  else if(sizeX > sizeY)
-                     dev = calcDev(pl2, pt);
-                  else
-                     dev = Umax(calcDev(pl1, pt), calcDev(pl2, pt));
-
-                  if(dev > mindev45)
-                     mindev45 = dev;
-
-                  if(sizeX + sizeY < squareSize)
-                     dev = calcDev(pl3, pt);
-                  else if(sizeX + sizeY > squareSize)
-                     dev = calcDev(pl4, pt);
-                  else
-                     dev = Umax(calcDev(pl3, pt), calcDev(pl4, pt));
-
-                  if(dev > mindev135)
-                     mindev135 = dev;
-               }
-            }
-
-            TerrainSquare *sq = findSquare( i, squareX * squareSize, squareY * squareSize );
-            sq->minHeight = min;
-            sq->maxHeight = max;
-
-            sq->flags = empty ? TerrainSquare::Empty : 0;
-            if ( hasEmpty )
-               sq->flags |= TerrainSquare::HasEmpty;
-
-            bool shouldSplit45 = ((squareX ^ squareY) & 1) == 0;
-            bool split45;
-
-            //split45 = shouldSplit45;
-            if ( i == 0 )
-               split45 = shouldSplit45;
-            else if( i < 4 && shouldSplit45 == parentSplit45 )
-               split45 = shouldSplit45;
-            else
-               split45 = mindev45 < mindev135;
-
-            //split45 = shouldSplit45;
-            if(split45)
-            {
-               sq->flags |= TerrainSquare::Split45;
-               sq->heightDeviance = mindev45;
-            }
-            else
-               sq->heightDeviance = mindev135;
-
-            if( parent )
-               if (  parent->heightDeviance < sq->heightDeviance )
-                     parent->heightDeviance = sq->heightDeviance;
+            TerrainSquare *parent = i < mGridLevels ? findSquare( i+1, x, y ) : NULL;
+            _buildGridSquare( i, x, y, findSquare( i, x, y ), parent, true );
          }
       }
    }
 
-   /*
-   for ( S32 y = 0; y < mSize; y += 2 )
+   // The squares at the top tile level contribute their
+   // deviance to their parents, so calculate them now 
+   // without keeping them around.
+   if ( mGridTileLevels > 0 )
    {
-      for ( S32 x=0; x < mSize; x += 2 )
+      const S32 i = mGridTileLevels - 1;
+      const S32 squareCount = 1 << ( mGridLevels - i );
+      const S32 squareSize = mSize / squareCount;
+
+      for ( S32 squareX = 0; squareX < squareCount; squareX++ )
       {
-         GridSquare *sq = findSquare(1, Point2I(x, y));
-         GridSquare *s1 = findSquare(0, Point2I(x, y));
-         GridSquare *s2 = findSquare(0, Point2I(x+1, y));
-         GridSquare *s3 = findSquare(0, Point2I(x, y+1));
-         GridSquare *s4 = findSquare(0, Point2I(x+1, y+1));
-         sq->flags |= (s1->flags | s2->flags | s3->flags | s4->flags) & ~(GridSquare::MaterialStart -1);
+         for ( S32 squareY = 0; squareY < squareCount; squareY++ )
+         {
+            const U32 x = squareX * squareSize;
+            const U32 y = squareY * squareSize;
+
+            TerrainSquare sq;
+            _buildGridSquare( i, x, y, &sq, findSquare( i+1, x, y ), true );
+         }
       }
    }
-   */
 }
 
 void TerrainFile::_initMaterialInstMapping()
@@ -826,9 +1044,14 @@ void TerrainFile::updateGrid( const Point2I &minPt, const Point2I &maxPt )
 
    PROFILE_SCOPE( TerrainFile_UpdateGrid );
 
-   for ( S32 y = minPt.y - 1; y < maxPt.y + 1; y++ )
+   // Callers pass Point2I::Max to mean everything, so clamp
+   // to the height map before doing any math on the extents.
+   const Point2I clampedMin( mClamp( minPt.x, 0, (S32)mSize ), mClamp( minPt.y, 0, (S32)mSize ) );
+   const Point2I clampedMax( mClamp( maxPt.x, 0, (S32)mSize ), mClamp( maxPt.y, 0, (S32)mSize ) );
+
+   for ( S32 y = clampedMin.y - 1; y < clampedMax.y + 1; y++ )
    {
-      for ( S32 x = minPt.x - 1; x < maxPt.x + 1; x++ )
+      for ( S32 x = clampedMin.x - 1; x < clampedMax.x + 1; x++ )
       {
          S32 px = x;
          S32 py = y;
@@ -837,6 +1060,11 @@ void TerrainFile::updateGrid( const Point2I &minPt, const Point2I &maxPt )
          if ( py < 0 )
             py += mSize;
 
+         // Tiles which were never built will be built from
+         // the new heights on first use, so leave them be.
+         if ( mGridTileLevels && !mGridTiles[ _getGridTileIndex( px % mSize, py % mSize ) ] )
+            continue;
+
          TerrainSquare *sq = findSquare( 0, px, py );
          sq->minHeight = 0xFFFF;
          sq->maxHeight = 0;
@@ -861,18 +1089,40 @@ void TerrainFile::updateGrid( const Point2I &minPt, const Point2I &maxPt )
       S32 size = 1 << level;
       S32 halfSize = size >> 1;  
 
-      for( S32 y = (minPt.y - 1) >> level; y < (maxPt.y + size) >> level; y++ )
+      for( S32 y = (clampedMin.y - 1) >> level; y < (clampedMax.y + size) >> level; y++ )
       {
-         for ( S32 x = (minPt.x - 1) >> level; x < (maxPt.x + size) >> level; x++ )
+         for ( S32 x = (clampedMin.x - 1) >> level; x < (clampedMax.x + size) >> level; x++ )
          {
             S32 px = x << level;
             S32 py = y << level;
 
+            // The children of this square live in a grid tile.
+            const bool tileLevel = level <= mGridTileLevels;
+            const bool tileBuilt = tileLevel && mGridTiles[ _getGridTileIndex( U32( px ) % mSize, U32( py ) % mSize ) ];
+            if ( level < mGridTileLevels && !tileBuilt )
+               continue;
+
             TerrainSquare *sq = findSquare(level, px, py);
             sq->minHeight = 0xFFFF;
             sq->maxHeight = 0;
             sq->flags &= ~( TerrainSquare::Empty | TerrainSquare::HasEmpty );
 
+            if ( tileLevel && !tileBuilt )
+            {
+               // Scan the heights directly instead of
+               // building the tile just to update this.
+               for ( S32 sy = 0; sy <= size; sy++ )
+               {
+                  for ( S32 sx = 0; sx <= size; sx++ )
+                  {
+                     getMinMax( sq->minHeight, sq->maxHeight, getHeight( px + sx, py + sy ) );
+                     if ( sx < size && sy < size && isEmptyAt( px + sx, py + sy ) )
+                        sq->flags |= TerrainSquare::HasEmpty;
+                  }
+               }
+               continue;
+            }
+
             checkSquare( sq, findSquare( level - 1, px, py ) );
             checkSquare( sq, findSquare( level - 1, px + halfSize, py ) );
             checkSquare( sq, findSquare( level - 1, px, py + halfSize ) );
@@ -71,6 +71,23 @@ typedef U16 TerrainHeight;
 /// 
 class TerrainFile
 {
+public:
+
+   enum GridConstants
+   {
+      /// The grid levels below this are built lazily
+      /// per tile of ( 1 << GridTileLevels ) samples.
+      GridTileLevels = 6,
+
+      /// The number of trims an evicted grid tile is kept
+      /// around for queries which still hold its squares.
+      GridTileRetireTrims = 2
+   };
+
+   /// The maximum number of grid tiles kept built per terrain
+   /// file before the least recently used ones are freed.
+   static S32 smMaxGridTiles;
+
 protected:
 
    friend class TerrainBlock;
@@ -88,15 +105,52 @@ protected:
    /// @see fixedToFloat
    Vector<U16> mHeightMap;
 
-   /// The memory pool used by the grid map layers.
+   /// The memory pool used by the grid map layers
+   /// at or above mGridTileLevels.
    Vector<TerrainSquare> mGridMapPool;
 
    ///
    U32 mGridLevels;
 
    /// The grid map layers used to accelerate collision
-   /// queries for the height map data.
+   /// queries for the height map data.  The layers below
+   /// mGridTileLevels are NULL and live in mGridTiles.
    Vector<TerrainSquare*> mGridMap;
+
+   /// The number of grid levels stored per tile.
+   U32 mGridTileLevels;
+
+   /// The number of squares in a single grid tile.
+   U32 mGridTileSize;
+
+   /// The offset of each level within a grid tile.
+   U32 mGridTileOffsets[ GridTileLevels ];
+
+   /// The lower grid levels for each GridTileSize square
+   /// region of the height map.  These hold most of the
+   /// grid map memory so they are only built when first
+   /// accessed by findSquare().
+   mutable Vector<TerrainSquare*> mGridTiles;
+
+   /// The trim count at which each grid tile was last used.
+   mutable Vector<U32> mGridTileStamps;
+
+   /// The number of times trimGridTiles() was called.
+   U32 mGridTileTrims;
+
+   /// An evicted grid tile waiting to be freed.
+   struct RetiredGridTile
+   {
+      TerrainSquare *tile;
+      U32 trim;
+   };
+
+   /// The evicted grid tiles which are freed once
+   /// they are GridTileRetireTrims old.
+   Vector<RetiredGridTile> mRetiredGridTiles;
+
+   /// All the terrain files for trimming their grid tiles.
+   static Vector<TerrainFile*> smTerrainFiles;
    
    /// MaterialList used to map terrain materials to material instances for the
    /// sake of collision (physics, etc.).
@@ -123,6 +177,25 @@ protected:
 
    /// 
    void _buildGridMap();
+
+   /// Releases all the lazily built grid tiles.
+   void _freeGridTiles();
+
+   /// Builds the lower grid levels for a tile.  This is
+   /// safe to call from multiple threads at once.
+   TerrainSquare* _buildGridTile( U32 tileIndex ) const;
+
+   /// Returns the index of the grid tile holding the
+   /// lower levels for a wrapped height map position.
+   U32 _getGridTileIndex( U32 x, U32 y ) const;
+
+   /// Calculates a single grid square from the height map.
+   void _buildGridSquare(  U32 level, 
+                           U32 x, 
+                           U32 y, 
+                           TerrainSquare *sq, 
+                           TerrainSquare *parent, 
+                           bool updateParent ) const;
    
    ///
    void _initMaterialInstMapping();
@@ -163,7 +236,23 @@ public:
 
    void setSize( U32 newResolution, bool clear );
 
+   /// Returns the grid square at the level containing the
+   /// height map sample.  Squares below GridTileLevels are
+   /// only valid until the tile is evicted, so they should
+   /// not be held past the end of the frame.
+   /// @see trimGridTiles
    TerrainSquare* findSquare( U32 level, U32 x, U32 y ) const;
+
+   /// Frees the least recently used grid tiles above
+   /// smMaxGridTiles which were not used since the last
+   /// trim.  This is called on the main thread each frame.
+   void trimGridTiles();
+
+   /// Trims the grid tiles of all the terrain files.
+   static void trimAllGridTiles();
+
+   /// Returns the number of grid tiles currently built.
+   U32 getGridTileCount() const;
    
    BaseMatInstance* getMaterialMapping( U32 index ) const;
    
@@ -194,10 +283,32 @@ public:
 };
 
 
+inline U32 TerrainFile::_getGridTileIndex( U32 x, U32 y ) const
+{
+   return ( x >> mGridTileLevels ) + ( ( y >> mGridTileLevels ) << ( mGridLevels - mGridTileLevels ) );
+}
+
 inline TerrainSquare* TerrainFile::findSquare( U32 level, U32 x, U32 y ) const
 {
    x %= mSize;
    y %= mSize;
+
+   if ( level < mGridTileLevels )
+   {
+      const U32 tileIndex = _getGridTileIndex( x, y );
+      TerrainSquare *tile = mGridTiles[ tileIndex ];
+      if ( !tile )
+         tile = _buildGridTile( tileIndex );
+
+      mGridTileStamps[ tileIndex ] = mGridTileTrims;
+
+      const U32 tileMask = ( 1 << mGridTileLevels ) - 1;
+      x = ( x & tileMask ) >> level;
+      y = ( y & tileMask ) >> level;
+
+      return tile + mGridTileOffsets[level] + x + ( y << ( mGridTileLevels - level ) );
+   }
+
    x >>= level;
    y >>= level;
 
@@ -0,0 +1,405 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026 tgemit contributors.
+// See AUTHORS file and git repository for contributor information.
+//
+// SPDX-License-Identifier: MIT
+//-----------------------------------------------------------------------------
+
+#include "platform/platform.h"
+#include "terrain/terrData.h"
+
+#include "terrain/terrFile.h"
+#include "platform/profiler.h"
+
+#if (defined( TORQUE_CPU_X86 ) || defined( TORQUE_CPU_X64 ))
+#define TERRAIN_SAMPLE_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace
+{
+   /// Points are sorted into square tiles of the heightmap of this
+   /// many grid squares per side before being sampled.
+   const U32 TileShift = 4;
+
+   /// Below this many points the sorting costs more than it saves.
+   const U32 SortThreshold = 32;
+
+   /// Four samples in structure of arrays form.
+   struct SampleQuad
+   {
+      F32 bottomLeft[4];
+      F32 bottomRight[4];
+      F32 topLeft[4];
+      F32 topRight[4];
+      F32 xp[4];
+      F32 yp[4];
+
+      /// 1 where the square is split along the 45 degree diagonal.
+      F32 split45[4];
+   };
+
+   /// Returns the tile a point falls in.  Points off the terrain are
+   /// rejected without touching memory so they go at the end.
+   inline U64 getSampleTile( const Point2F &pos, F32 invSquareSize, U32 blockMask )
+   {
+      const S32 x = S32( pos.x * invSquareSize );
+      const S32 y = S32( pos.y * invSquareSize );
+
+      if ( x & ~blockMask || y & ~blockMask )
+         return U32_MAX;
+
+      return ( U64( y >> TileShift ) << 16 ) | U64( x >> TileShift );
+   }
+
+   S32 QSORT_CALLBACK compareSampleKeys( const void *a, const void *b )
+   {
+      const U64 keyA = *( const U64* )a;
+      const U64 keyB = *( const U64* )b;
+      return keyA < keyB ? -1 : ( keyA > keyB ? 1 : 0 );
+   }
+
+#ifdef TERRAIN_SAMPLE_SSE
+
+   inline __m128 selectSSE( __m128 mask, __m128 a, __m128 b )
+   {
+      return _mm_or_ps( _mm_and_ps( mask, a ), _mm_andnot_ps( mask, b ) );
+   }
+
+   /// Interpolates the height and the x/y of the face normal across the
+   /// triangle each sample falls in.  This does the same math in the same
+   /// order as TerrainBlock::getNormalAndHeight() so the results match.
+   void interpolateQuad( const SampleQuad &quad, F32 *outHeight, F32 *outNx, F32 *outNy )
+   {
+      const __m128 bl = _mm_loadu_ps( quad.bottomLeft );
+      const __m128 br = _mm_loadu_ps( quad.bottomRight );
+      const __m128 tl = _mm_loadu_ps( quad.topLeft );
+      const __m128 tr = _mm_loadu_ps( quad.topRight );
+      const __m128 xp = _mm_loadu_ps( quad.xp );
+      const __m128 yp = _mm_loadu_ps( quad.yp );
+      const __m128 ixp = _mm_sub_ps( _mm_set1_ps( 1.0f ), xp );
+
+      const __m128 split45 = _mm_cmpgt_ps( _mm_loadu_ps( quad.split45 ), _mm_setzero_ps() );
+      const __m128 bottom = selectSSE( split45, _mm_cmpgt_ps( xp, yp ), _mm_cmpgt_ps( ixp, yp ) );
+
+      const __m128 h45Bottom = _mm_add_ps( _mm_add_ps( bl, _mm_mul_ps( xp, _mm_sub_ps( br, bl ) ) ), _mm_mul_ps( yp, _mm_sub_ps( tr, br ) ) );
+      const __m128 h45Top = _mm_add_ps( _mm_add_ps( bl, _mm_mul_ps( xp, _mm_sub_ps( tr, tl ) ) ), _mm_mul_ps( yp, _mm_sub_ps( tl, bl ) ) );
+      const __m128 hBottom = _mm_add_ps( _mm_add_ps( br, _mm_mul_ps( ixp, _mm_sub_ps( bl, br ) ) ), _mm_mul_ps( yp, _mm_sub_ps( tl, bl ) ) );
+      const __m128 hTop = _mm_add_ps( _mm_add_ps( br, _mm_mul_ps( ixp, _mm_sub_ps( tl, tr ) ) ), _mm_mul_ps( yp, _mm_sub_ps( tr, br ) ) );
+
+      _mm_storeu_ps( outHeight, selectSSE( split45, selectSSE( bottom, h45Bottom, h45Top ), selectSSE( bottom, hBottom, hTop ) ) );
+
+      _mm_storeu_ps( outNx, selectSSE( bottom, _mm_sub_ps( bl, br ), _mm_sub_ps( tl, tr ) ) );
+
+      const __m128 brTr = _mm_sub_ps( br, tr );
+      const __m128 blTl = _mm_sub_ps( bl, tl );
+      _mm_storeu_ps( outNy, selectSSE( split45, selectSSE( bottom, brTr, blTl ), selectSSE( bottom, blTl, brTr ) ) );
+   }
+
+   /// Normalizes four vectors in place the same way Point3F::normalize()
+   /// does.  The z components are never zero here.
+   void normalizeQuad( F32 *x, F32 *y, F32 *z )
+   {
+      const __m128 vx = _mm_loadu_ps( x );
+      const __m128 vy = _mm_loadu_ps( y );
+      const __m128 vz = _mm_loadu_ps( z );
+
+      const __m128 squared = _mm_add_ps( _mm_add_ps( _mm_mul_ps( vx, vx ), _mm_mul_ps( vy, vy ) ), _mm_mul_ps( vz, vz ) );
+      const __m128 factor = _mm_div_ps( _mm_set1_ps( 1.0f ), _mm_sqrt_ps( squared ) );
+
+      _mm_storeu_ps( x, _mm_mul_ps( vx, factor ) );
+      _mm_storeu_ps( y, _mm_mul_ps( vy, factor ) );
+      _mm_storeu_ps( z, _mm_mul_ps( vz, factor ) );
+   }
+
+#else
+
+   void interpolateQuad( const SampleQuad &quad, F32 *outHeight, F32 *outNx, F32 *outNy )
+   {
+      for ( U32 i = 0; i < 4; i++ )
+      {
+         const F32 bl = quad.bottomLeft[i];
+         const F32 br = quad.bottomRight[i];
+         const F32 tl = quad.topLeft[i];
+         const F32 tr = quad.topRight[i];
+         const F32 xp = quad.xp[i];
+         const F32 yp = quad.yp[i];
+
+         if ( quad.split45[i] > 0.0f )
+         {
+            if ( xp > yp )
+            {
+               outHeight[i] = bl + xp * (br-bl) + yp * (tr-br);
+               outNx[i] = bl - br;
+               outNy[i] = br - tr;
+            }
+            else
+            {
+               outHeight[i] = bl + xp * (tr-tl) + yp * (tl-bl);
+               outNx[i] = tl - tr;
+               outNy[i] = bl - tl;
+            }
+         }
+         else
+         {
+            if ( 1.0f - xp > yp )
+            {
+               outHeight[i] = br + (1.0f-xp) * (bl-br) + yp * (tl-bl);
+               outNx[i] = bl - br;
+               outNy[i] = bl - tl;
+            }
+            else
+            {
+               outHeight[i] = br + (1.0f-xp) * (tl-tr) + yp * (tr-br);
+               outNx[i] = tl - tr;
+               outNy[i] = br - tr;
+            }
+         }
+      }
+   }
+
+   void normalizeQuad( F32 *x, F32 *y, F32 *z )
+   {
+      for ( U32 i = 0; i < 4; i++ )
+      {
+         const F32 factor = 1.0f / mSqrt( x[i]*x[i] + y[i]*y[i] + z[i]*z[i] );
+         x[i] *= factor;
+         y[i] *= factor;
+         z[i] *= factor;
+      }
+   }
+
+#endif
+}
+
+bool TerrainBlock::_getBatchOrder( const Point2F *pos, U32 count, Vector<U64> &outKeys ) const
+{
+   if ( count < SortThreshold )
+      return false;
+
+   const F32 invSquareSize = 1.0f / mSquareSize;
+   const U32 blockMask = mFile->mSize - 1;
+
+   // Callers often pass points which are already in tile order, like
+   // a row of grid points, so look for that before paying for a sort.
+   U64 lastTile = 0;
+   U32 i = 0;
+   for ( ; i < count; i++ )
+   {
+      const U64 tile = getSampleTile( pos[i], invSquareSize, blockMask );
+      if ( tile < lastTile )
+         break;
+
+      lastTile = tile;
+   }
+
+   if ( i == count )
+      return false;
+
+   // Sort on the tile with the point index in the low bits, which also
+   // keeps points in the same tile in their original order.
+   outKeys.setSize( count );
+
+   for ( i = 0; i < count; i++ )
+      outKeys[i] = ( getSampleTile( pos[i], invSquareSize, blockMask ) << 32 ) | i;
+
+   dQsort( outKeys.address(), count, sizeof( U64 ), compareSampleKeys );
+
+   return true;
+}
+
+U32 TerrainBlock::_sampleBatch(  const Point2F *pos,
+                                 U32 count,
+                                 F32 *outHeights,
+                                 Point3F *outNormals,
+                                 U8 *outMaterials,
+                                 bool *outValid,
+                                 bool normalize,
+                                 bool skipEmpty,
+                                 bool smooth,
+                                 Vector<U64> *scratch ) const
+{
+   PROFILE_SCOPE( TerrainBlock_sampleBatch );
+
+   // The local keys are only allocated if they get used.
+   Vector<U64> localKeys;
+   Vector<U64> &keys = scratch ? *scratch : localKeys;
+   const bool sorted = _getBatchOrder( pos, count, keys );
+
+   const F32 invSquareSize = 1.0f / mSquareSize;
+   const U32 blockMask = mFile->mSize - 1;
+   const F32 normalZ = smooth ? mSquareSize * 2.0f : mSquareSize;
+
+   U32 numValid = 0;
+
+   for ( U32 start = 0; start < count; start += 4 )
+   {
+      const U32 numLanes = getMin( count - start, 4U );
+
+      SampleQuad quad;
+      dMemset( &quad, 0, sizeof( quad ) );
+
+      U32 lanes[4];
+      U32 numActive = 0;
+
+      for ( U32 lane = 0; lane < numLanes; lane++ )
+      {
+         const U32 i = sorted ? U32( keys[ start + lane ] ) : start + lane;
+
+         F32 xp = pos[i].x * invSquareSize;
+         F32 yp = pos[i].y * invSquareSize;
+         S32 x = S32(xp);
+         S32 y = S32(yp);
+         const S32 xm = S32( mFloor( xp + 0.5f ) );
+         const S32 ym = S32( mFloor( yp + 0.5f ) );
+         xp -= (F32)x;
+         yp -= (F32)y;
+
+         bool valid = !( x & ~blockMask || y & ~blockMask );
+         const TerrainSquare *sq = NULL;
+         if ( valid )
+         {
+            x &= blockMask;
+            y &= blockMask;
+
+            sq = mFile->findSquare( 0, x, y );
+            valid = !( skipEmpty && sq->flags & TerrainSquare::Empty );
+         }
+
+         if ( outValid )
+            outValid[i] = valid;
+
+         if ( !valid )
+         {
+            if ( outHeights )
+               outHeights[i] = 0.0f;
+            if ( outNormals )
+               outNormals[i].set( 0.0f, 0.0f, 1.0f );
+            if ( outMaterials )
+               outMaterials[i] = U8_MAX;
+            continue;
+         }
+
+         if ( outMaterials )
+            outMaterials[i] = mFile->getLayerIndex( xm, ym );
+
+         const U32 q = numActive++;
+         lanes[q] = i;
+
+         if ( smooth )
+         {
+            // The smooth normal is a central difference so we only
+            // need the x/y neighbors, which we stash in the corners.
+            quad.bottomRight[q] = fixedToFloat( mFile->getHeight( x + 1, y ) );
+            quad.topLeft[q] = fixedToFloat( mFile->getHeight( x, y + 1 ) );
+            quad.bottomLeft[q] = fixedToFloat( mFile->getHeight( x - 1, y ) );
+            quad.topRight[q] = fixedToFloat( mFile->getHeight( x, y - 1 ) );
+         }
+         else
+         {
+            const U16 *row = mFile->getHeightAddress( x, y );
+
+            // The far edge wraps around to the other side of the map.
+            if ( U32( x ) < blockMask && U32( y ) < blockMask )
+            {
+               quad.bottomLeft[q] = fixedToFloat( row[0] );
+               quad.bottomRight[q] = fixedToFloat( row[1] );
+               quad.topLeft[q] = fixedToFloat( row[ mFile->mSize ] );
+               quad.topRight[q] = fixedToFloat( row[ mFile->mSize + 1 ] );
+            }
+            else
+            {
+               quad.bottomLeft[q] = fixedToFloat( *row );
+               quad.bottomRight[q] = fixedToFloat( mFile->getHeight( x + 1, y ) );
+               quad.topLeft[q] = fixedToFloat( mFile->getHeight( x, y + 1 ) );
+               quad.topRight[q] = fixedToFloat( mFile->getHeight( x + 1, y + 1 ) );
+            }
+
+            quad.xp[q] = xp;
+            quad.yp[q] = yp;
+            quad.split45[q] = ( sq->flags & TerrainSquare::Split45 ) ? 1.0f : 0.0f;
+         }
+      }
+
+      if ( numActive == 0 )
+         continue;
+
+      numValid += numActive;
+
+      F32 heights[4], nx[4], ny[4], nz[4];
+
+      if ( smooth )
+      {
+         for ( U32 q = 0; q < 4; q++ )
+         {
+            nx[q] = quad.bottomLeft[q] - quad.bottomRight[q];
+            ny[q] = quad.topRight[q] - quad.topLeft[q];
+         }
+      }
+      else
+         interpolateQuad( quad, heights, nx, ny );
+
+      if ( outNormals )
+      {
+         for ( U32 q = 0; q < 4; q++ )
+            nz[q] = normalZ;
+
+         if ( normalize )
+            normalizeQuad( nx, ny, nz );
+
+         for ( U32 q = 0; q < numActive; q++ )
+            outNormals[ lanes[q] ].set( nx[q], ny[q], nz[q] );
+      }
+
+      if ( outHeights && !smooth )
+      {
+         for ( U32 q = 0; q < numActive; q++ )
+            outHeights[ lanes[q] ] = heights[q];
+      }
+   }
+
+   return numValid;
+}
+
+U32 TerrainBlock::getHeightBatch(   const Point2F *pos,
+                                    U32 count,
+                                    F32 *outHeights,
+                                    bool *outValid,
+                                    Vector<U64> *scratch ) const
+{
+   return _sampleBatch( pos, count, outHeights, NULL, NULL, outValid, false, true, false, scratch );
+}
+
+U32 TerrainBlock::getNormalBatch(   const Point2F *pos,
+                                    U32 count,
+                                    Point3F *outNormals,
+                                    bool *outValid,
+                                    bool normalize,
+                                    bool skipEmpty,
+                                    Vector<U64> *scratch ) const
+{
+   return _sampleBatch( pos, count, NULL, outNormals, NULL, outValid, normalize, skipEmpty, false, scratch );
+}
+
+U32 TerrainBlock::getSmoothNormalBatch(   const Point2F *pos,
+                                          U32 count,
+                                          Point3F *outNormals,
+                                          bool *outValid,
+                                          bool normalize,
+                                          bool skipEmpty,
+                                          Vector<U64> *scratch ) const
+{
+   return _sampleBatch( pos, count, NULL, outNormals, NULL, outValid, normalize, skipEmpty, true, scratch );
+}
+
+U32 TerrainBlock::getNormalHeightMaterialBatch( const Point2F *pos,
+                                                U32 count,
+                                                Point3F *outNormals,
+                                                F32 *outHeights,
+                                                U8 *outMaterials,
+                                                bool *outValid,
+                                                bool normalize,
+                                                Vector<U64> *scratch ) const
+{
+   return _sampleBatch( pos, count, outHeights, outNormals, outMaterials, outValid, normalize, true, false, scratch );
+}
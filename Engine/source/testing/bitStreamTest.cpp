@@ -0,0 +1,239 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026 tgemit contributors.
+// See AUTHORS file and git repository for contributor information.
+//
+// SPDX-License-Identifier: MIT
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "core/stream/bitStream.h"
+#include "math/mRandom.h"
+#include "console/console.h"
+
+/// The original bit at a time BitStream I/O.  All the higher level
+/// writers go through these virtuals, so this produces the reference
+/// wire format for the tests below.
+class LegacyBitStream : public BitStream
+{
+public:
+   LegacyBitStream(void *bufPtr, S32 bufSize) : BitStream(bufPtr, bufSize) {}
+
+   void writeBits(S32 bitCount, const void *bitPtr) override
+   {
+      if(!bitCount || (bitCount + bitNum) > maxWriteBitNum)
+         return;
+
+      const U8 *ptr = (U8 *)bitPtr;
+      for(S32 srcBitNum = 0;srcBitNum < bitCount;srcBitNum++)
+      {
+         if((*(ptr + (srcBitNum >> 3)) & (1 << (srcBitNum & 0x7))) != 0)
+            *(mDataPtr + (bitNum >> 3)) |= (1 << (bitNum & 0x7));
+         else
+            *(mDataPtr + (bitNum >> 3)) &= ~(1 << (bitNum & 0x7));
+         bitNum++;
+      }
+   }
+
+   void readBits(S32 bitCount, void *bitPtr) override
+   {
+      if(!bitCount || bitCount + bitNum > maxReadBitNum)
+         return;
+
+      U8 *stPtr = mDataPtr + (bitNum >> 3);
+      S32 byteCount = (bitCount + 7) >> 3;
+      U8 *ptr = (U8 *) bitPtr;
+      S32 downShift = bitNum & 0x7;
+      S32 upShift = 8 - downShift;
+      U8 curB = *stPtr;
+      const U8 *stEnd = mDataPtr + bufSize;
+      while(byteCount--)
+      {
+         stPtr++;
+         U8 nextB = stPtr < stEnd ? *stPtr : 0;
+         *ptr++ = (curB >> downShift) | (nextB << upShift);
+         curB = nextB;
+      }
+      bitNum += bitCount;
+   }
+};
+
+/// Writes the same random mix of values to any BitStream given the same seed.
+static void writeRandomOps(BitStream &stream, U32 seed, U32 numOps)
+{
+   MRandomLCG rand(seed);
+
+   static const char *strings[] = { "", "a", "Torque3D", "The quick brown fox jumps over the lazy dog", "0123456789!@#$%^&*()" };
+
+   for(U32 i = 0; i < numOps; i++)
+   {
+      switch(rand.randI(0, 8))
+      {
+         case 0:
+            stream.writeFlag(rand.randI(0, 1) != 0);
+            break;
+         case 1:
+         {
+            const S32 bits = rand.randI(1, 32);
+            stream.writeInt(bits == 32 ? rand.randI() : rand.randI() & ((1 << bits) - 1), bits);
+            break;
+         }
+         case 2:
+         {
+            U8 bytes[40];
+            for(U32 j = 0; j < sizeof(bytes); j++)
+               bytes[j] = rand.randI(0, 255);
+            stream.writeBits(rand.randI(1, sizeof(bytes) * 8), bytes);
+            break;
+         }
+         case 3:
+            stream.writeString(strings[rand.randI(0, 4)]);
+            break;
+         case 4:
+            stream.writeCompressedPoint(Point3F(rand.randF(-500, 500), rand.randF(-500, 500), rand.randF(-50, 50)));
+            break;
+         case 5:
+         {
+            Point3F normal(rand.randF(-1, 1), rand.randF(-1, 1), rand.randF(-1, 1));
+            normal.normalizeSafe();
+            stream.writeNormalVector(normal, rand.randI(4, 12));
+            break;
+         }
+         case 6:
+            stream.writeSignedFloat(rand.randF(-1, 1), rand.randI(2, 16));
+            break;
+         case 7:
+            stream.write(rand.randF(-1000, 1000));
+            break;
+         default:
+            stream.writeRangedU32(rand.randI(0, 1000), 0, 1000);
+            break;
+      }
+   }
+}
+
+TEST(BitStream, WireFormat_Matches_Legacy)
+{
+   const U32 bufSize = 64 * 1024;
+   U8 *newBuf = new U8[bufSize];
+   U8 *oldBuf = new U8[bufSize];
+
+   for(U32 seed = 1; seed <= 50; seed++)
+   {
+      // Start from the same garbage so untouched bits must match too.
+      for(U32 i = 0; i < bufSize; i++)
+         newBuf[i] = oldBuf[i] = U8(i * 31 + seed);
+
+      BitStream newStream(newBuf, bufSize);
+      LegacyBitStream oldStream(oldBuf, bufSize);
+
+      writeRandomOps(newStream, seed, 500);
+      writeRandomOps(oldStream, seed, 500);
+
+      ASSERT_EQ(newStream.getCurPos(), oldStream.getCurPos()) << "Bit position differs for seed " << seed;
+      ASSERT_EQ(dMemcmp(newBuf, oldBuf, bufSize), 0) << "Stream contents differ for seed " << seed;
+   }
+
+   delete [] newBuf;
+   delete [] oldBuf;
+}
+
+TEST(BitStream, Fuzz_RoundTrip)
+{
+   MRandomLCG rand(90210);
+
+   const U32 bufSize = 4096;
+   U8 buffer[bufSize];
+   U8 source[64];
+   U8 newOut[64 + 1];
+   U8 oldOut[64 + 1];
+
+   for(U32 iter = 0; iter < 20000; iter++)
+   {
+      for(U32 i = 0; i < bufSize; i++)
+         buffer[i] = rand.randI(0, 255);
+      for(U32 i = 0; i < sizeof(source); i++)
+         source[i] = rand.randI(0, 255);
+
+      const S32 start = rand.randI(0, bufSize * 8 - 1);
+      const S32 bitCount = rand.randI(1, getMin(S32(sizeof(source) * 8), S32(bufSize * 8) - start));
+
+      BitStream stream(buffer, bufSize);
+      stream.setCurPos(start);
+      stream.writeBits(bitCount, source);
+      ASSERT_EQ(stream.getCurPos(), start + bitCount);
+
+      // Read back through both implementations which must agree on
+      // every output byte including the bits past the end of the read.
+      dMemset(newOut, 0xCD, sizeof(newOut));
+      dMemset(oldOut, 0xCD, sizeof(oldOut));
+
+      stream.setCurPos(start);
+      stream.readBits(bitCount, newOut);
+
+      LegacyBitStream legacy(buffer, bufSize);
+      legacy.setCurPos(start);
+      legacy.readBits(bitCount, oldOut);
+
+      ASSERT_EQ(dMemcmp(newOut, oldOut, sizeof(newOut)), 0) << "readBits differs at " << start << "+" << bitCount;
+
+      for(S32 i = 0; i < bitCount; i++)
+         ASSERT_EQ((newOut[i >> 3] >> (i & 7)) & 1, (source[i >> 3] >> (i & 7)) & 1) << "Round trip failed at bit " << i;
+   }
+}
+
+TEST(BitStream, DISABLED_Benchmark_Throughput)
+{
+   const U32 bufSize = 256 * 1024;
+   U8 *buffer = new U8[bufSize];
+   dMemset(buffer, 0, bufSize);
+
+   const U32 passes = 20;
+   U32 legacyMs = 0, newMs = 0;
+
+   for(U32 impl = 0; impl < 2; impl++)
+   {
+      BitStream fastStream(buffer, bufSize);
+      LegacyBitStream legacyStream(buffer, bufSize);
+      BitStream &stream = impl ? (BitStream&)fastStream : (BitStream&)legacyStream;
+
+      const U32 start = Platform::getRealMilliseconds();
+      for(U32 pass = 0; pass < passes; pass++)
+      {
+         // A typical packUpdate mix of flags, small ints and floats.
+         stream.setCurPos(0);
+         U32 value = pass;
+         while(stream.getCurPos() < (S32)(bufSize * 8) - 256)
+         {
+            stream.writeFlag(value & 1);
+            stream.writeInt(value & 0x3FF, 10);
+            stream.writeRangedU32(value & 0xF, 0, 15);
+            stream.writeSignedFloat(0.25f, 12);
+            stream.write(U32(value));
+            value = value * 1664525 + 1013904223;
+         }
+
+         stream.setCurPos(0);
+         while(stream.getCurPos() < (S32)(bufSize * 8) - 256)
+         {
+            stream.readFlag();
+            stream.readInt(10);
+            stream.readRangedU32(0, 15);
+            stream.readSignedFloat(12);
+            U32 dummy;
+            stream.read(&dummy);
+         }
+      }
+
+      (impl ? newMs : legacyMs) = Platform::getRealMilliseconds() - start;
+   }
+
+   const F32 megabytes = F32(bufSize) * passes * 2 / (1024.0f * 1024.0f);
+   Con::printf("BitStream throughput: legacy %.1f MB/s (%dms), word %.1f MB/s (%dms)",
+      megabytes / getMax(legacyMs, 1U) * 1000.0f, legacyMs,
+      megabytes / getMax(newMs, 1U) * 1000.0f, newMs);
+
+   delete [] buffer;
+}
+
+#endif
@@ -0,0 +1,209 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026 tgemit contributors.
+// See AUTHORS file and git repository for contributor information.
+//
+// SPDX-License-Identifier: MIT
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "gfx/bitmap/bitmapUtils.h"
+#include "gfx/bitmap/gBitmap.h"
+#include "math/mRandom.h"
+#include "console/console.h"
+
+typedef void (*ExtrudeFn)(const void *srcMip, void *mip, U32 height, U32 width);
+typedef void (*ConvertFn)( U8 **src, U32 pixels );
+
+/// Fills a buffer with noise.
+static void fillRandom( MRandomLCG &rand, U8 *bits, U32 size )
+{
+   for ( U32 i = 0; i < size; i++ )
+      bits[i] = rand.randI( 0, 255 );
+}
+
+TEST(BitmapUtils, SRGB_Extrude_Is_Gamma_Correct)
+{
+   // A black and white checker should come out at linear
+   // half intensity and not sRGB 128.
+   const U8 checker[16] = { 0, 0, 0, 255,  255, 255, 255, 255,  255, 255, 255, 255,  0, 0, 0, 255 };
+   U8 mip[4];
+   bitmapExtrudeSRGBA( checker, mip, 2, 2 );
+   EXPECT_EQ( mip[0], 188 );
+   EXPECT_EQ( mip[2], 188 );
+   EXPECT_EQ( mip[3], 255 );
+
+   // Flat colors shouldn't change.
+   for ( U32 v = 0; v < 256; v++ )
+   {
+      U8 flat[12];
+      dMemset( flat, v, sizeof( flat ) );
+      bitmapExtrudeSRGB( flat, mip, 2, 2 );
+      ASSERT_EQ( mip[0], v );
+   }
+}
+
+TEST(BitmapUtils, Single_Column_Extrude)
+{
+   // Each row of the column holds its row index in every
+   // channel, so the mip rows are the average of two rows.
+   const U32 height = 8;
+
+   U8 rgb[height * 3], rgba[height * 4];
+   U16 fp[height * 4];
+   for ( U32 y = 0; y < height; y++ )
+   {
+      dMemset( rgb + y * 3, y * 20, 3 );
+      dMemset( rgba + y * 4, y * 20, 4 );
+      for ( U32 c = 0; c < 4; c++ )
+         fp[y * 4 + c] = y * 2000;
+   }
+
+   U8 rgbMip[height / 2 * 3], rgbaMip[height / 2 * 4];
+   U16 fpMip[height / 2 * 4];
+   bitmapExtrudeRGB_c( rgb, rgbMip, height, 1 );
+   bitmapExtrudeRGBA_c( rgba, rgbaMip, height, 1 );
+   bitmapExtrudeFPRGBA_c( fp, fpMip, height, 1 );
+
+   for ( U32 y = 0; y < height / 2; y++ )
+   {
+      for ( U32 c = 0; c < 3; c++ )
+         EXPECT_EQ( rgbMip[y * 3 + c], y * 40 + 10 ) << "RGB row " << y;
+      for ( U32 c = 0; c < 4; c++ )
+      {
+         EXPECT_EQ( rgbaMip[y * 4 + c], y * 40 + 10 ) << "RGBA row " << y;
+         EXPECT_EQ( fpMip[y * 4 + c], y * 4000 + 1000 ) << "FPRGBA row " << y;
+      }
+   }
+}
+
+#ifdef TORQUE_BITMAP_SSE2
+
+TEST(BitmapUtils, SSE2_Matches_C)
+{
+   MRandomLCG rand( 31337 );
+
+   const struct { ExtrudeFn c, sse2; U32 bytesPerPixel; } extrudes[] =
+   {
+      { bitmapExtrudeRGB_c, bitmapExtrudeRGB_sse2, 3 },
+      { bitmapExtrudeRGBA_c, bitmapExtrudeRGBA_sse2, 4 },
+      { bitmapExtrudeFPRGBA_c, bitmapExtrudeFPRGBA_sse2, 8 },
+   };
+
+   const U32 sizes[][2] = { { 1, 1 }, { 2, 1 }, { 1, 2 }, { 1, 4 }, { 1, 8 }, { 2, 2 }, { 8, 2 }, { 16, 16 }, { 32, 8 }, { 256, 64 }, { 1024, 2 } };
+
+   for ( U32 e = 0; e < 3; e++ )
+   {
+      for ( U32 s = 0; s < sizeof( sizes ) / sizeof( sizes[0] ); s++ )
+      {
+         const U32 width = sizes[s][0];
+         const U32 height = sizes[s][1];
+         const U32 bpp = extrudes[e].bytesPerPixel;
+
+         Vector<U8> src;
+         src.setSize( width * height * bpp );
+         fillRandom( rand, src.address(), src.size() );
+
+         // Pad the outputs to catch overruns.
+         const U32 mipSize = getMax( width / 2, 1U ) * getMax( height / 2, 1U ) * bpp;
+         Vector<U8> expected, result;
+         expected.setSize( mipSize + 16 );
+         result.setSize( mipSize + 16 );
+         dMemset( expected.address(), 0xCD, expected.size() );
+         dMemset( result.address(), 0xCD, result.size() );
+
+         extrudes[e].c( src.address(), expected.address(), height, width );
+         extrudes[e].sse2( src.address(), result.address(), height, width );
+
+         EXPECT_EQ( dMemcmp( expected.address(), result.address(), expected.size() ), 0 )
+            << "Extrude " << e << " at " << width << "x" << height;
+      }
+   }
+
+   const struct { ConvertFn c, sse2; U32 inBpp, outBpp; } converts[] =
+   {
+      { bitmapConvertRGB_to_RGBX_c, bitmapConvertRGB_to_RGBX_sse2, 3, 4 },
+      { bitmapConvertRGBX_to_RGB_c, bitmapConvertRGBX_to_RGB_sse2, 4, 3 },
+      { bitmapConvertA8_to_RGBA_c, bitmapConvertA8_to_RGBA_sse2, 1, 4 },
+   };
+
+   const U32 pixelCounts[] = { 1, 5, 6, 7, 16, 33, 4099 };
+
+   for ( U32 c = 0; c < 3; c++ )
+   {
+      for ( U32 p = 0; p < sizeof( pixelCounts ) / sizeof( pixelCounts[0] ); p++ )
+      {
+         const U32 pixels = pixelCounts[p];
+
+         U8 *expected = new U8[ pixels * converts[c].inBpp ];
+         fillRandom( rand, expected, pixels * converts[c].inBpp );
+         U8 *result = new U8[ pixels * converts[c].inBpp ];
+         dMemcpy( result, expected, pixels * converts[c].inBpp );
+
+         converts[c].c( &expected, pixels );
+         converts[c].sse2( &result, pixels );
+
+         EXPECT_EQ( dMemcmp( expected, result, pixels * converts[c].outBpp ), 0 )
+            << "Convert " << c << " of " << pixels << " pixels";
+
+         delete [] expected;
+         delete [] result;
+      }
+   }
+}
+
+TEST(BitmapUtils, DISABLED_Benchmark_Extrude_4k)
+{
+   MRandomLCG rand( 4096 );
+
+   const U32 size = 4096;
+   const U32 iterations = 4;
+
+   const struct { const char *name; ExtrudeFn c, sse2; U32 bytesPerPixel; } extrudes[] =
+   {
+      { "RGB", bitmapExtrudeRGB_c, bitmapExtrudeRGB_sse2, 3 },
+      { "RGBA", bitmapExtrudeRGBA_c, bitmapExtrudeRGBA_sse2, 4 },
+      { "FPRGBA", bitmapExtrudeFPRGBA_c, bitmapExtrudeFPRGBA_sse2, 8 },
+   };
+
+   for ( U32 e = 0; e < 3; e++ )
+   {
+      const U32 bpp = extrudes[e].bytesPerPixel;
+
+      Vector<U8> src;
+      src.setSize( size * size * bpp );
+      fillRandom( rand, src.address(), src.size() );
+
+      Vector<U8> mip;
+      mip.setSize( src.size() / 4 );
+
+      U32 start = Platform::getRealMilliseconds();
+      for ( U32 i = 0; i < iterations; i++ )
+         extrudes[e].c( src.address(), mip.address(), size, size );
+      const U32 cMs = Platform::getRealMilliseconds() - start;
+
+      start = Platform::getRealMilliseconds();
+      for ( U32 i = 0; i < iterations; i++ )
+         extrudes[e].sse2( src.address(), mip.address(), size, size );
+      const U32 sse2Ms = Platform::getRealMilliseconds() - start;
+
+      Con::printf( "Bitmap extrude %s: %d %dx%d mips, C %dms, SSE2 %dms", extrudes[e].name, iterations, size, size, cMs, sse2Ms );
+   }
+
+   // And the whole chain thru GBitmap.
+   GBitmap *bmp = new GBitmap( size, size, false, GFXFormatR8G8B8A8 );
+   fillRandom( rand, bmp->getWritableBits(), size * size * 4 );
+
+   const U32 start = Platform::getRealMilliseconds();
+   bmp->extrudeMipLevels();
+   const U32 chainMs = Platform::getRealMilliseconds() - start;
+
+   EXPECT_EQ( bmp->getNumMipLevels(), 13 );
+   Con::printf( "Bitmap extrude %dx%d RGBA mip chain: %dms", size, size, chainMs );
+
+   delete bmp;
+}
+
+#endif // TORQUE_BITMAP_SSE2
+
+#endif
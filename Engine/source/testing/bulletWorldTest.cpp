@@ -0,0 +1,89 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026 tgemit contributors.
+// See AUTHORS file and git repository for contributor information.
+//
+// SPDX-License-Identifier: MIT
+//-----------------------------------------------------------------------------
+
+#if defined(TORQUE_TESTS_ENABLED) && defined(TORQUE_PHYSICS_BULLET)
+#include "testing/unitTesting.h"
+#include "T3D/physics/physicsPlugin.h"
+#include "T3D/physics/bullet/btWorld.h"
+#include "T3D/physics/bullet/btBody.h"
+#include "T3D/physics/bullet/btCollision.h"
+#include "T3D/gameBase/processList.h"
+
+/// Drops a stack of boxes on a ground box and returns where they
+/// came to rest after the given count of ticks.
+static void simulateBoxStack( bool asyncStep, U32 ticks, Vector<MatrixF> &outTransforms )
+{
+   const bool oldAsyncStep = PhysicsPlugin::smAsyncStep;
+   PhysicsPlugin::smAsyncStep = asyncStep;
+
+   ProcessList processList;
+   BtWorld world;
+   ASSERT_TRUE( world.initWorld( true, &processList ) );
+   world.setEnabled( true );
+
+   // The bodies hold references to their shapes.
+   StrongRefPtr<BtCollision> ground = new BtCollision;
+   ground->addBox( Point3F( 50.0f, 50.0f, 1.0f ), MatrixF::Identity );
+
+   Vector<BtBody*> bodies;
+   bodies.push_back( new BtBody );
+   ASSERT_TRUE( bodies[0]->init( ground, 0.0f, 0, NULL, &world ) );
+
+   StrongRefPtr<BtCollision> box = new BtCollision;
+   box->addBox( Point3F( 0.5f, 0.5f, 0.5f ), MatrixF::Identity );
+
+   // Offset each box a little so they topple over each other.
+   for ( U32 i = 0; i < 8; i++ )
+   {
+      BtBody *body = new BtBody;
+      ASSERT_TRUE( body->init( box, 1.0f, 0, NULL, &world ) );
+
+      MatrixF xfm( EulerF( 0.0f, 0.0f, i * 0.3f ) );
+      xfm.setPosition( Point3F( i * 0.15f, i * -0.1f, 2.0f + i * 1.1f ) );
+      body->setTransform( xfm );
+      bodies.push_back( body );
+   }
+
+   for ( U32 i = 0; i < ticks; i++ )
+   {
+      world.getPhysicsResults();
+      world.tickPhysics( TickMs );
+   }
+   world.getPhysicsResults();
+
+   // Skip the ground which never moves.
+   outTransforms.setSize( bodies.size() - 1 );
+   for ( U32 i = 1; i < bodies.size(); i++ )
+      bodies[i]->getTransform( &outTransforms[i - 1] );
+
+   for ( U32 i = 0; i < bodies.size(); i++ )
+      delete bodies[i];
+
+   world.destroyWorld();
+
+   PhysicsPlugin::smAsyncStep = oldAsyncStep;
+}
+
+TEST(BtWorld, Async_Step_Matches_Sync_Step)
+{
+   Vector<MatrixF> sync;
+   simulateBoxStack( false, 200, sync );
+
+   Vector<MatrixF> async;
+   simulateBoxStack( true, 200, async );
+
+   // The same steps run in the same order just on another
+   // thread, so the results should match to the bit.
+   ASSERT_EQ( sync.size(), async.size() );
+   for ( U32 i = 0; i < sync.size(); i++ )
+      EXPECT_EQ( dMemcmp( &sync[i], &async[i], sizeof( MatrixF ) ), 0 ) << "Box " << i;
+
+   // And the boxes should have actually moved.
+   EXPECT_LT( sync.last().getPosition().z, 2.0f + 7 * 1.1f );
+}
+
+#endif
@@ -0,0 +1,74 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026 tgemit contributors.
+// See AUTHORS file and git repository for contributor information.
+//
+// SPDX-License-Identifier: MIT
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "T3D/decal/decalDataFile.h"
+#include "T3D/decal/decalData.h"
+#include "T3D/decal/decalInstance.h"
+#include "math/mRandom.h"
+
+TEST(DecalDataFile, SpatialHash_Finds_Spheres)
+{
+   MRandomLCG rand( 2468 );
+
+   DecalData *data = new DecalData;
+   DecalDataFile *file = new DecalDataFile;
+
+   // Clusters of bullet holes spread over a large level.
+   Vector<DecalInstance*> decals;
+   for ( U32 i = 0; i < 3000; i++ )
+   {
+      Point3F pos( rand.randF( -2000.0f, 2000.0f ), rand.randF( -2000.0f, 2000.0f ), rand.randF( 0.0f, 100.0f ) );
+      if ( i > 0 && rand.randI( 0, 3 ) != 0 )
+         pos = decals[ rand.randI( 0, decals.size() - 1 ) ]->mPosition + Point3F( rand.randF( -5.0f, 5.0f ), rand.randF( -5.0f, 5.0f ), 0.0f );
+
+      decals.push_back( file->addDecal( pos, Point3F( 0, 0, 1 ), Point3F( 1, 0, 0 ), data, rand.randF( 0.1f, 4.0f ), 0, 0 ) );
+
+      // Expire some of them as we go.
+      if ( rand.randI( 0, 2 ) == 0 )
+      {
+         const U32 index = rand.randI( 0, decals.size() - 1 );
+         file->removeDecal( decals[index] );
+         decals.erase_fast( index );
+      }
+   }
+
+   const Vector<DecalSphere*> &spheres = file->getSphereList();
+
+   // Every decal must be in the sphere it points at.
+   for ( U32 i = 0; i < decals.size(); i++ )
+   {
+      ASSERT_TRUE( decals[i]->mSphere != NULL );
+      EXPECT_TRUE( spheres.contains( decals[i]->mSphere ) );
+      EXPECT_TRUE( decals[i]->mSphere->mItems.contains( decals[i] ) );
+   }
+
+   // Every sphere overlapping the query box must be returned.
+   Vector<DecalSphere*> found;
+   for ( U32 i = 0; i < 500; i++ )
+   {
+      const Point3F center( rand.randF( -2100.0f, 2100.0f ), rand.randF( -2100.0f, 2100.0f ), 50.0f );
+      const Point3F extent( rand.randF( 0.5f, 200.0f ), rand.randF( 0.5f, 200.0f ), 100.0f );
+      const Box3F box( center - extent, center + extent );
+
+      found.clear();
+      file->findSpheres( box, &found );
+      EXPECT_LT( found.size(), spheres.size() );
+
+      for ( U32 n = 0; n < spheres.size(); n++ )
+      {
+         if ( box.isOverlapped( spheres[n]->mWorldSphere ) )
+            EXPECT_TRUE( found.contains( spheres[n] ) ) << "Query " << i << " missed sphere " << n;
+      }
+   }
+
+   delete file;
+   delete data;
+}
+
+#endif
@@ -0,0 +1,199 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026 tgemit contributors.
+// See AUTHORS file and git repository for contributor information.
+//
+// SPDX-License-Identifier: MIT
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "forest/forestDataFile.h"
+#include "forest/ts/tsForestItemData.h"
+#include "core/stream/memStream.h"
+#include "math/mathIO.h"
+#include "math/mRandom.h"
+#include "console/console.h"
+
+FIXTURE(ForestDataFile)
+{
+public:
+   TSForestItemData *mData;
+   ForestData *mForest;
+
+   void SetUp() override
+   {
+      mData = new TSForestItemData;
+      mData->setInternalName( "ForestDataFileTestTree" );
+      mData->registerObject();
+
+      mForest = new ForestData;
+   }
+
+   void TearDown() override
+   {
+      delete mForest;
+      mData->deleteObject();
+   }
+
+   /// Plants clumps of trees over a 16km square.
+   void plant( U32 count )
+   {
+      MRandomLCG rand( 1979 );
+
+      Point3F center( 0, 0, 0 );
+      for ( U32 i = 0; i < count; i++ )
+      {
+         if ( ( i % 500 ) == 0 )
+            center.set( rand.randF( -8000.0f, 8000.0f ), rand.randF( -8000.0f, 8000.0f ), 0.0f );
+
+         const Point3F pos( center.x + rand.randF( -100.0f, 100.0f ), center.y + rand.randF( -100.0f, 100.0f ), rand.randF( 0.0f, 300.0f ) );
+         mForest->addItem( mData, pos, rand.randF( 0.0f, M_2PI_F ), rand.randF( 0.5f, 2.0f ) );
+      }
+   }
+
+   /// Writes the forest in the old field by field layout.
+   void writeV1( Stream &stream )
+   {
+      stream.write( 4, "FKDF" );
+      stream.write( (U8)1 );
+      stream.write( (U32)1 );
+      stream.writeString( mData->getInternalName() );
+
+      Vector<ForestItem> items;
+      mForest->getItems( &items );
+      stream.write( (U32)items.size() );
+      for ( U32 i = 0; i < items.size(); i++ )
+      {
+         stream.write( (U8)0 );
+         mathWrite( stream, items[i].getPosition() );
+
+         QuatF quat;
+         quat.set( items[i].getTransform() );
+         mathWrite( stream, quat );
+
+         stream.write( items[i].getScale() );
+      }
+   }
+
+   /// Returns the sum of all the item positions.
+   static Point3F sumPositions( const ForestData *forest, U32 *outCount )
+   {
+      Vector<ForestItem> items;
+      *outCount = forest->getItems( &items );
+
+      Point3F sum( 0, 0, 0 );
+      for ( U32 i = 0; i < items.size(); i++ )
+         sum += items[i].getPosition() / items.size();
+
+      return sum;
+   }
+};
+
+TEST_FIX(ForestDataFile, RoundTrip)
+{
+   plant( 5000 );
+
+   MemStream stream( 4096 );
+   ASSERT_TRUE( mForest->write( stream ) );
+
+   stream.setPosition( 0 );
+   ForestData *loaded = new ForestData;
+   ASSERT_TRUE( loaded->read( stream ) );
+
+   U32 count, loadedCount;
+   const Point3F sum = sumPositions( mForest, &count );
+   const Point3F loadedSum = sumPositions( loaded, &loadedCount );
+   EXPECT_EQ( loadedCount, count );
+   EXPECT_TRUE( loadedSum.equal( sum, 0.01f ) );
+
+   // Every item should be found again at the same place.
+   Vector<ForestItem> items;
+   loaded->getItems( &items );
+   for ( U32 i = 0; i < items.size(); i += 97 )
+   {
+      const ForestItem &item = loaded->findItem( items[i].getKey(), items[i].getPosition() );
+      ASSERT_TRUE( item.isValid() );
+      EXPECT_EQ( item.getData(), mData );
+   }
+
+   delete loaded;
+}
+
+/// Collects the boxes passed to ForestData::getItemsChangedSignal().
+static Vector<Box3F> sChangedBoxes;
+static void _onForestItemsChanged( const Box3F &worldBox ) { sChangedBoxes.push_back( worldBox ); }
+
+TEST_FIX(ForestDataFile, Items_Changed_Signal)
+{
+   sChangedBoxes.clear();
+   ForestData::getItemsChangedSignal().notify( &_onForestItemsChanged );
+
+   // The test tree has no shape so its box is just its position.
+   const Point3F pos( 10.0f, 20.0f, 5.0f );
+   const ForestItem &item = mForest->addItem( mData, pos, 0.0f, 1.0f );
+   const ForestItemKey key = item.getKey();
+   ASSERT_EQ( sChangedBoxes.size(), 1 );
+   EXPECT_TRUE( sChangedBoxes[0].getCenter().equal( pos, 0.001f ) );
+
+   // Moving reports both the old and new place.
+   MatrixF xfm( true );
+   const Point3F newPos( 500.0f, 20.0f, 5.0f );
+   xfm.setPosition( newPos );
+   mForest->updateItem( key, pos, mData, xfm, 1.0f );
+   ASSERT_EQ( sChangedBoxes.size(), 3 );
+   EXPECT_TRUE( sChangedBoxes[1].getCenter().equal( pos, 0.001f ) );
+   EXPECT_TRUE( sChangedBoxes[2].getCenter().equal( newPos, 0.001f ) );
+
+   EXPECT_TRUE( mForest->removeItem( key, newPos ) );
+   ASSERT_EQ( sChangedBoxes.size(), 4 );
+   EXPECT_TRUE( sChangedBoxes[3].getCenter().equal( newPos, 0.001f ) );
+
+   // Failed edits change nothing.
+   EXPECT_FALSE( mForest->removeItem( key, newPos ) );
+   EXPECT_EQ( sChangedBoxes.size(), 4 );
+
+   ForestData::getItemsChangedSignal().remove( &_onForestItemsChanged );
+}
+
+TEST_FIX(ForestDataFile, DISABLED_Benchmark_Million_Items)
+{
+   const U32 numItems = 1000000;
+
+   U32 start = Platform::getRealMilliseconds();
+   plant( numItems );
+   const U32 plantMs = Platform::getRealMilliseconds() - start;
+
+   MemStream v1Stream( 1024 * 1024 );
+   writeV1( v1Stream );
+
+   MemStream v2Stream( 1024 * 1024 );
+   start = Platform::getRealMilliseconds();
+   ASSERT_TRUE( mForest->write( v2Stream ) );
+   const U32 writeMs = Platform::getRealMilliseconds() - start;
+
+   ForestData *loaded = new ForestData;
+
+   v1Stream.setPosition( 0 );
+   start = Platform::getRealMilliseconds();
+   ASSERT_TRUE( loaded->read( v1Stream ) );
+   const U32 readV1Ms = Platform::getRealMilliseconds() - start;
+
+   v2Stream.setPosition( 0 );
+   start = Platform::getRealMilliseconds();
+   ASSERT_TRUE( loaded->read( v2Stream ) );
+   const U32 readV2Ms = Platform::getRealMilliseconds() - start;
+
+   U32 count, loadedCount;
+   const Point3F sum = sumPositions( mForest, &count );
+   const Point3F loadedSum = sumPositions( loaded, &loadedCount );
+   EXPECT_EQ( count, numItems );
+   EXPECT_EQ( loadedCount, numItems );
+   EXPECT_TRUE( loadedSum.equal( sum, 0.01f ) );
+
+   delete loaded;
+
+   Con::printf( "Forest data: %d items, plant %dms, write %dms, read v1 %dms, read v2 %dms",
+      numItems, plantMs, writeMs, readV1Ms, readV2Ms );
+}
+
+#endif
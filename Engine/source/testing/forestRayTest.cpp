@@ -0,0 +1,234 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026 tgemit contributors.
+// See AUTHORS file and git repository for contributor information.
+//
+// SPDX-License-Identifier: MIT
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "forest/forestDataFile.h"
+#include "forest/forestCell.h"
+#include "forest/forestCollision.h"
+#include "forest/ts/tsForestItemData.h"
+#include "math/mRandom.h"
+#include "console/console.h"
+
+/// A tree without a shape which still has a size.
+class ForestRayTestData : public TSForestItemData
+{
+public:
+   Box3F mBox;
+
+   ForestRayTestData() : mBox( Point3F( -1.0f, -1.0f, 0.0f ), Point3F( 1.0f, 1.0f, 10.0f ) ) {}
+
+   const Box3F& getObjBox() const override { return mBox; }
+};
+
+/// Exposes the packed item bounds to the tests.
+class ForestCellRayTest : public ForestCell
+{
+public:
+   ForestCellRayTest( const RectF &rect ) : ForestCell( rect ) {}
+
+   /// The bounds are kept up to date as the items change.
+   const F32* getItemBounds() const { return mItemBounds.address(); }
+   U32 getItemBoundsSize() const { return mItemBounds.size(); }
+};
+
+/// Returns true if the packed bounds of each item contain its world box.
+static bool itemBoundsMatch( const ForestCellRayTest *cell )
+{
+   const Vector<ForestItem> &items = cell->getItems();
+   if ( cell->getItemBoundsSize() != ( ( items.size() + 3 ) / 4 ) * 24 )
+      return false;
+
+   for ( U32 i = 0; i < items.size(); i++ )
+   {
+      const F32 *group = cell->getItemBounds() + ( i / 4 ) * 24;
+      const Box3F &box = items[i].getWorldBox();
+
+      for ( U32 axis = 0; axis < 3; axis++ )
+      {
+         if (  group[ axis * 4 + i % 4 ] > box.minExtents[axis] ||
+               group[ 12 + axis * 4 + i % 4 ] < box.maxExtents[axis] )
+            return false;
+      }
+   }
+
+   return true;
+}
+
+TEST(ForestRay, ItemBounds_Never_Miss)
+{
+   MRandomLCG rand( 4242 );
+
+   ForestRayTestData *data = new ForestRayTestData;
+   ForestCellRayTest *cell = new ForestCellRayTest( RectF( 0, 0, 100, 100 ) );
+
+   for ( U32 i = 0; i < ForestCell::MaxItems; i++ )
+   {
+      MatrixF xfm( EulerF( rand.randF( -0.3f, 0.3f ), rand.randF( -0.3f, 0.3f ), rand.randF( 0.0f, M_2PI_F ) ),
+                   Point3F( rand.randF( 0.0f, 100.0f ), rand.randF( 0.0f, 100.0f ), rand.randF( 0.0f, 20.0f ) ) );
+      cell->insertItem( i + 1, data, xfm, rand.randF( 0.2f, 3.0f ) );
+   }
+
+   ASSERT_TRUE( cell->isLeaf() );
+   const Vector<ForestItem> &items = cell->getItems();
+   const F32 *bounds = cell->getItemBounds();
+
+   RayInfo info;
+   ForestRayPacket packet;
+   packet.outInfo = &info;
+
+   U32 exact = 0, passed = 0;
+
+   for ( U32 r = 0; r < 2000; r++ )
+   {
+      Point3F start( rand.randF( -10.0f, 110.0f ), rand.randF( -10.0f, 110.0f ), rand.randF( -5.0f, 40.0f ) );
+      Point3F end( rand.randF( -10.0f, 110.0f ), rand.randF( -10.0f, 110.0f ), rand.randF( -5.0f, 40.0f ) );
+
+      // Throw in rays along the axes and rays which
+      // start or end right on an item box.
+      const U32 type = r % 4;
+      if ( type == 1 )
+      {
+         end = start;
+         end[ rand.randI( 0, 2 ) ] += rand.randF( -50.0f, 50.0f );
+      }
+      else if ( type == 2 )
+         end = items[ rand.randI( 0, items.size() - 1 ) ].getWorldBox().maxExtents;
+      else if ( type == 3 )
+         start = items[ rand.randI( 0, items.size() - 1 ) ].getWorldBox().minExtents;
+
+      packet.setRay( 0, start, end );
+
+      for ( U32 i = 0; i < items.size(); i++ )
+      {
+         const U32 mask = ForestCell::testItemBounds( bounds + ( i / 4 ) * 24, start, packet.invDir[0] );
+         const bool hit = ( mask & ( 1 << ( i % 4 ) ) ) != 0;
+
+         if ( items[i].getWorldBox().collideLine( start, end ) )
+         {
+            exact++;
+            ASSERT_TRUE( hit ) << "Ray " << r << " missed item " << i;
+         }
+
+         if ( hit )
+            passed++;
+      }
+   }
+
+   // The padding shouldn't let much more thru.
+   EXPECT_GT( exact, 0 );
+   EXPECT_LT( passed, exact * 2 );
+
+   delete cell;
+   delete data;
+}
+
+TEST(ForestRay, ItemBounds_Follow_Item_Changes)
+{
+   MRandomLCG rand( 2424 );
+
+   ForestRayTestData *data = new ForestRayTestData;
+   ForestCellRayTest *cell = new ForestCellRayTest( RectF( 0, 0, 100, 100 ) );
+
+   // Inserts rebuild the bounds, including moving an existing item.
+   for ( U32 i = 0; i < 10; i++ )
+   {
+      MatrixF xfm( EulerF( 0.0f, 0.0f, rand.randF( 0.0f, M_2PI_F ) ),
+                   Point3F( rand.randF( 0.0f, 100.0f ), rand.randF( 0.0f, 100.0f ), 0.0f ) );
+      cell->insertItem( ( i % 7 ) + 1, data, xfm, rand.randF( 0.5f, 2.0f ) );
+      ASSERT_TRUE( itemBoundsMatch( cell ) ) << "Insert " << i;
+   }
+
+   EXPECT_EQ( cell->getItems().size(), 7 );
+
+   // So do removes.
+   for ( U32 key = 1; key <= 7; key += 2 )
+   {
+      const Point3F pos = cell->getItems()[0].getPosition();
+      EXPECT_TRUE( cell->removeItem( key, pos, false ) );
+      ASSERT_TRUE( itemBoundsMatch( cell ) ) << "Remove " << key;
+   }
+
+   EXPECT_EQ( cell->getItems().size(), 3 );
+
+   delete cell;
+   delete data;
+}
+
+TEST(ForestRay, Batch_Matches_Single)
+{
+   MRandomLCG rand( 777 );
+
+   ForestRayTestData *data = new ForestRayTestData;
+   ForestData *forest = new ForestData;
+
+   // Spread the trees over a few buckets.
+   const U32 numItems = 100000;
+   for ( U32 i = 0; i < numItems; i++ )
+   {
+      const Point3F pos( rand.randF( -3000.0f, 3000.0f ), rand.randF( -3000.0f, 3000.0f ), rand.randF( 0.0f, 50.0f ) );
+      forest->addItem( data, pos, rand.randF( 0.0f, M_2PI_F ), rand.randF( 0.5f, 2.0f ) );
+   }
+
+   // Bullets and line of sight checks from clusters of
+   // shooters, so nearby rays go in the same direction.
+   const U32 numRays = 20000;
+   Vector<Point3F> starts, ends;
+   starts.setSize( numRays );
+   ends.setSize( numRays );
+
+   Point3F origin, target;
+   for ( U32 i = 0; i < numRays; i++ )
+   {
+      if ( ( i % 32 ) == 0 )
+      {
+         origin.set( rand.randF( -3000.0f, 3000.0f ), rand.randF( -3000.0f, 3000.0f ), rand.randF( 1.0f, 20.0f ) );
+         target = origin + Point3F( rand.randF( -200.0f, 200.0f ), rand.randF( -200.0f, 200.0f ), rand.randF( -10.0f, 10.0f ) );
+      }
+
+      starts[i] = origin + Point3F( rand.randF( -2.0f, 2.0f ), rand.randF( -2.0f, 2.0f ), 0.0f );
+      ends[i] = target + Point3F( rand.randF( -5.0f, 5.0f ), rand.randF( -5.0f, 5.0f ), rand.randF( -2.0f, 2.0f ) );
+   }
+
+   // The test trees have no shape to hit, so this compares the
+   // results and times the cell and item bounds tests.
+   Vector<RayInfo> infos;
+   infos.setSize( numRays );
+   Vector<bool> hits;
+   hits.setSize( numRays );
+
+   U32 start = Platform::getRealMilliseconds();
+   const U32 numHits = forest->castRayBatch( starts.address(), ends.address(), numRays, infos.address(), hits.address(), false );
+   const U32 batchMs = Platform::getRealMilliseconds() - start;
+
+   U32 singleHits = 0;
+   start = Platform::getRealMilliseconds();
+   for ( U32 i = 0; i < numRays; i++ )
+   {
+      RayInfo info;
+      const bool hit = forest->castRay( starts[i], ends[i], &info, false );
+      if ( hit )
+         singleHits++;
+
+      EXPECT_EQ( hits[i], hit ) << "Ray " << i;
+      if ( hit && hits[i] )
+      {
+         EXPECT_EQ( infos[i].t, info.t ) << "Ray " << i;
+         EXPECT_EQ( infos[i].normal, info.normal ) << "Ray " << i;
+      }
+   }
+   const U32 singleMs = Platform::getRealMilliseconds() - start;
+
+   EXPECT_EQ( numHits, singleHits );
+
+   Con::printf( "Forest rays: %d rays over %d items, single %dms, batch %dms", numRays, numItems, singleMs, batchMs );
+
+   delete forest;
+   delete data;
+}
+
+#endif
@@ -0,0 +1,157 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026 tgemit contributors.
+// See AUTHORS file and git repository for contributor information.
+//
+// SPDX-License-Identifier: MIT
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "gfx/gfxCommandBuffer.h"
+#include "gfx/gfxVertexBuffer.h"
+#include "gfx/gfxPrimitiveBuffer.h"
+#include "gfx/gfxVertexTypes.h"
+#include "gfx/Null/gfxNullDevice.h"
+
+FIXTURE(GFXCommandBuffer)
+{
+public:
+   GFXVertexBufferHandle<GFXVertexPCT> mVB;
+   GFXPrimitiveBufferHandle mPB;
+   GFXStateBlockRef mSB;
+
+   void SetUp() override
+   {
+      mVB.set( GFX, 6, GFXBufferTypeStatic );
+      mPB.set( GFX, 6, 2, GFXBufferTypeStatic );
+      mSB = GFX->createStateBlock( GFXStateBlockDesc() );
+   }
+
+   void TearDown() override
+   {
+      // Don't leave our buffers bound on the device.
+      GFX->setVertexBuffer( NULL );
+      GFX->setPrimitiveBuffer( NULL );
+   }
+};
+
+TEST_FIX(GFXCommandBuffer, Record_And_Replay)
+{
+   GFXVertexPCT verts[6];
+   dMemset( verts, 0, sizeof( verts ) );
+   const U16 indices[6] = { 0, 1, 2, 3, 4, 5 };
+
+   GFXCommandBuffer cmds;
+   cmds.setStateBlock( mSB );
+   cmds.setViewport( RectI( 0, 0, 64, 64 ) );
+   cmds.clear( GFXClearTarget, LinearColorF::BLACK, 1.0f, 0 );
+   cmds.updateVertexBuffer( mVB, 0, 6, verts );
+   cmds.updatePrimitiveBuffer( mPB, 0, 6, indices );
+   cmds.setVertexBuffer( mVB );
+   cmds.drawPrimitive( GFXTriangleList, 0, 2 );
+   cmds.setPrimitiveBuffer( mPB );
+   cmds.drawIndexedPrimitive( GFXTriangleList, 0, 0, 6, 0, 2 );
+
+   EXPECT_EQ( cmds.getCommandCount(), 9 );
+   EXPECT_EQ( cmds.getCommandCount( GFXCommandBuffer::DrawPrimitive ), 1 );
+   EXPECT_EQ( cmds.getCommandCount( GFXCommandBuffer::DrawIndexedPrimitive ), 1 );
+
+   // The vertex data is copied into the stream.
+   EXPECT_GT( cmds.getSize(), sizeof( verts ) + sizeof( indices ) );
+
+   // The stream holds its own references.
+   GFXVertexBuffer *vb = mVB;
+   mVB = NULL;
+   EXPECT_GE( vb->getRefCount(), 1 );
+
+   String error;
+   EXPECT_TRUE( cmds.validate( &error ) ) << error.c_str();
+
+   cmds.replay( GFX );
+
+   cmds.reset();
+   EXPECT_TRUE( cmds.isEmpty() );
+   EXPECT_EQ( cmds.getCommandCount(), 0 );
+}
+
+TEST_FIX(GFXCommandBuffer, Validate_Rejects_Bad_Streams)
+{
+   String error;
+
+   // Drawing with nothing bound.
+   GFXCommandBuffer noBuffer;
+   noBuffer.drawPrimitive( GFXTriangleList, 0, 1 );
+   EXPECT_FALSE( noBuffer.validate( &error ) );
+   EXPECT_TRUE( error.find( "vertex buffer" ) != String::NPos ) << error.c_str();
+
+   // Indexed drawing without indices.
+   GFXCommandBuffer noIndices;
+   noIndices.setVertexBuffer( mVB );
+   noIndices.drawIndexedPrimitive( GFXTriangleList, 0, 0, 6, 0, 2 );
+   EXPECT_FALSE( noIndices.validate() );
+
+   // Reading past the end of the buffers.
+   GFXCommandBuffer overrun;
+   overrun.setVertexBuffer( mVB );
+   overrun.drawPrimitive( GFXTriangleList, 3, 2 );
+   EXPECT_FALSE( overrun.validate() );
+
+   GFXCommandBuffer indexOverrun;
+   indexOverrun.setVertexBuffer( mVB );
+   indexOverrun.setPrimitiveBuffer( mPB );
+   indexOverrun.drawIndexedPrimitive( GFXTriangleList, 0, 0, 6, 3, 2 );
+   EXPECT_FALSE( indexOverrun.validate() );
+
+   // Unbinding makes a later draw invalid.
+   GFXCommandBuffer unbound;
+   unbound.setVertexBuffer( mVB );
+   unbound.drawPrimitive( GFXTriangleStrip, 0, 4 );
+   unbound.setVertexBuffer( NULL );
+   unbound.drawPrimitive( GFXTriangleStrip, 0, 4 );
+   EXPECT_FALSE( unbound.validate( &error ) );
+   EXPECT_TRUE( error.find( "Command 3" ) != String::NPos ) << error.c_str();
+
+   // Render target pushes must balance.
+   GFXCommandBuffer targets;
+   targets.pushActiveRenderTarget();
+   EXPECT_FALSE( targets.validate() );
+   targets.popActiveRenderTarget();
+   EXPECT_TRUE( targets.validate() );
+   targets.popActiveRenderTarget();
+   EXPECT_FALSE( targets.validate() );
+}
+
+TEST(GFXCommandQueue, Render_Thread_Replays_Every_Frame)
+{
+   // The render thread gets a device of its own so that it
+   // never touches the state of the global one.
+   GFXNullDevice device( false );
+   EXPECT_TRUE( GFX != &device );
+
+   GFXWindowTargetRef target = device.allocWindowTarget( NULL );
+   device.setActiveRenderTarget( target );
+
+   GFXCommandQueue queue;
+   GFXRenderThread thread( &queue, &device );
+   thread.start();
+
+   // Record on this thread while the last frame replays.  We stick
+   // to commands without resources as reference counts aren't atomic.
+   const U32 frames = 100;
+   for ( U32 i = 0; i < frames; i++ )
+   {
+      GFXCommandBuffer *cmds = queue.getRecordBuffer();
+      EXPECT_TRUE( cmds->isEmpty() );
+
+      cmds->setViewport( RectI( 0, 0, 64, 64 ) );
+      cmds->clear( GFXClearTarget, LinearColorF::BLACK, 1.0f, 0 );
+      queue.submit();
+   }
+
+   queue.shutdown();
+   thread.join();
+
+   EXPECT_EQ( queue.getReplayedFrames(), frames );
+}
+
+#endif
@@ -0,0 +1,120 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026 tgemit contributors.
+// See AUTHORS file and git repository for contributor information.
+//
+// SPDX-License-Identifier: MIT
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "gfx/gfxTransientBufferPool.h"
+#include "gfx/gfxVertexTypes.h"
+
+TEST(GFXTransientBufferPool, Bucket_Size)
+{
+   EXPECT_EQ( GFXTransientBufferPool::getBucketSize( 1 ), GFXTransientBufferPool::MinBucketSize );
+   EXPECT_EQ( GFXTransientBufferPool::getBucketSize( 64 ), 64 );
+   EXPECT_EQ( GFXTransientBufferPool::getBucketSize( 65 ), 128 );
+   EXPECT_EQ( GFXTransientBufferPool::getBucketSize( 1000 ), 1024 );
+}
+
+TEST(GFXTransientBufferPool, Reuses_After_Frames_In_Flight)
+{
+   // The null device fences can't be polled, so
+   // buffers are held for a fixed number of frames.
+   GFXTransientBufferPool pool( GFX );
+
+   GFXTransientVertexBuffer *vb = pool.allocVertexBuffer<GFXVertexPCT>( 100 );
+   ASSERT_TRUE( vb->isValid() );
+   EXPECT_EQ( (*vb)->mNumVerts, 128 );
+   EXPECT_EQ( (*vb)->mBufferType, GFXBufferTypeDynamic );
+
+   GFXVertexPCT *verts = vb->lock<GFXVertexPCT>( 0, 100 );
+   ASSERT_TRUE( verts != NULL );
+   dMemset( verts, 0, sizeof( GFXVertexPCT ) * 100 );
+   vb->unlock();
+
+   GFXPrimitiveBufferHandle *pb = pool.allocPrimitiveBuffer( 300 );
+   ASSERT_TRUE( pb->isValid() );
+
+   // Two buffers in the same frame are never the same.
+   GFXTransientVertexBuffer *vb2 = pool.allocVertexBuffer<GFXVertexPCT>( 100 );
+   EXPECT_NE( vb->getPointer(), vb2->getPointer() );
+
+   pool.endFrame();
+   const GFXTransientBufferPool::Stats &stats = pool.getStats();
+   EXPECT_EQ( stats.allocs, 3 );
+   EXPECT_EQ( stats.created, 3 );
+   EXPECT_EQ( stats.reused, 0 );
+   EXPECT_EQ( stats.requestedBytes, sizeof( GFXVertexPCT ) * 200 + sizeof( U16 ) * 300 );
+   EXPECT_EQ( stats.allocatedBytes, sizeof( GFXVertexPCT ) * 256 + sizeof( U16 ) * 512 );
+   EXPECT_EQ( stats.totalBuffers, 3 );
+   EXPECT_EQ( stats.freeBuffers, 0 );
+
+   // The GPU may still be reading them.
+   for ( U32 i = 1; i < GFXTransientBufferPool::FramesInFlight; i++ )
+   {
+      pool.allocVertexBuffer<GFXVertexPCT>( 100 );
+      pool.endFrame();
+   }
+   EXPECT_EQ( pool.getStats().created, 1 );
+
+   // Now the first frame is done and its buffers come back.
+   GFXVertexBuffer *first = vb->getPointer();
+   vb = pool.allocVertexBuffer<GFXVertexPCT>( 90 );
+   EXPECT_TRUE( vb->getPointer() == first || vb->getPointer() == vb2->getPointer() );
+   pb = pool.allocPrimitiveBuffer( 260 );
+   pool.endFrame();
+   EXPECT_EQ( pool.getStats().created, 0 );
+   EXPECT_EQ( pool.getStats().reused, 2 );
+}
+
+TEST(GFXTransientBufferPool, Matches_Format_And_Size)
+{
+   GFXTransientBufferPool pool( GFX );
+
+   pool.allocVertexBuffer<GFXVertexPCT>( 100 );
+   for ( U32 i = 0; i < GFXTransientBufferPool::FramesInFlight; i++ )
+      pool.endFrame();
+
+   EXPECT_EQ( pool.getStats().freeBuffers, 1 );
+
+   // A different vertex type or bucket gets a new buffer.
+   pool.allocVertexBuffer<GFXVertexPC>( 100 );
+   pool.allocVertexBuffer<GFXVertexPCT>( 1000 );
+   pool.endFrame();
+   EXPECT_EQ( pool.getStats().created, 2 );
+   EXPECT_EQ( pool.getStats().reused, 0 );
+   EXPECT_EQ( pool.getStats().freeBuffers, 1 );
+}
+
+TEST(GFXTransientBufferPool, Releases_Idle_Buffers)
+{
+   GFXTransientBufferPool pool( GFX );
+
+   const U32 maxIdleFrames = GFXTransientBufferPool::smMaxIdleFrames;
+   GFXTransientBufferPool::smMaxIdleFrames = 10;
+
+   pool.allocVertexBuffer<GFXVertexPCT>( 100 );
+   pool.allocPrimitiveBuffer( 100 );
+
+   U32 released = 0;
+   for ( U32 i = 0; i < 20; i++ )
+   {
+      pool.endFrame();
+      released += pool.getStats().released;
+   }
+
+   EXPECT_EQ( released, 2 );
+   EXPECT_EQ( pool.getStats().totalBuffers, 0 );
+   EXPECT_EQ( pool.getStats().totalBytes, 0 );
+
+   GFXTransientBufferPool::smMaxIdleFrames = maxIdleFrames;
+
+   // Buffers in use this frame survive releasing the rest.
+   GFXTransientVertexBuffer *vb = pool.allocVertexBuffer<GFXVertexPCT>( 100 );
+   pool.releaseFree();
+   EXPECT_TRUE( vb->isValid() );
+}
+
+#endif
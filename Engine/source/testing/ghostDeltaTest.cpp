@@ -0,0 +1,132 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026 tgemit contributors.
+// See AUTHORS file and git repository for contributor information.
+//
+// SPDX-License-Identifier: MIT
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "sim/netConnection.h"
+#include "core/stream/bitStream.h"
+#include "math/mRandom.h"
+
+/// Exposes the ghost delta encoding to the tests.
+class GhostDeltaTestConnection : public NetConnection
+{
+public:
+   void writeUpdate(GhostInfo *ghost, GhostRef *ref, U8 *bits, U32 bitCount, BitStream *stream)
+   {
+      ghostWriteDeltaUpdate(ghost, ref, bits, bitCount, stream);
+   }
+
+   bool readUpdate(U32 index, BitStream *stream, U8 *bits, U32 &bitCount)
+   {
+      return ghostReadDeltaUpdate(index, stream, bits, bitCount);
+   }
+
+   void packetAcked(GhostRef *ref)
+   {
+      PacketNotify note;
+      note.ghostList = ref;
+      ghostPacketReceived(&note);
+   }
+
+   void packetLost(GhostRef *ref)
+   {
+      PacketNotify note;
+      note.ghostList = ref;
+      ghostPacketDropped(&note);
+   }
+};
+
+TEST(GhostDelta, RoundTrip_With_Loss)
+{
+   MRandomLCG rand(1337);
+
+   GhostDeltaTestConnection *server = new GhostDeltaTestConnection;
+   GhostDeltaTestConnection *client = new GhostDeltaTestConnection;
+
+   GhostInfo ghost;
+   dMemset(&ghost, 0, sizeof(ghost));
+   ghost.index = 7;
+
+   U8 state[64];
+   for(U32 i = 0; i < sizeof(state); i++)
+      state[i] = rand.randI(0, 255);
+
+   U8 sent[64];
+   U8 received[Net::MaxPacketDataSize];
+   U8 packet[Net::MaxPacketDataSize];
+
+   // Updates still waiting for an ack, oldest first.
+   Vector<NetConnection::GhostRef *> pending;
+   Vector<bool> pendingLost;
+   U32 rawBits = 0, sentBits = 0;
+
+   for(U32 iter = 0; iter < 2000; iter++)
+   {
+      // Mutate a couple of fields, like a moving object would.
+      for(U32 j = rand.randI(0, 3); j > 0; j--)
+         state[rand.randI(0, sizeof(state) - 1)] = rand.randI(0, 255);
+
+      const U32 bitCount = rand.randI(sizeof(state) * 8 - 20, sizeof(state) * 8);
+      dMemcpy(sent, state, sizeof(state));
+
+      NetConnection::GhostRef *ref = new NetConnection::GhostRef;
+      dMemset(ref, 0, sizeof(*ref));
+      ref->ghost = &ghost;
+      ref->nextUpdateChain = ghost.updateChain;
+      ghost.updateChain = ref;
+      pending.push_back(ref);
+
+      BitStream out(packet, sizeof(packet));
+      server->writeUpdate(&ghost, ref, sent, bitCount, &out);
+      rawBits += bitCount;
+      sentBits += out.getCurPos();
+
+      const bool lost = rand.randI(0, 99) < 20;
+      pendingLost.push_back(lost);
+      if(!lost)
+      {
+         BitStream in(packet, sizeof(packet));
+         U32 readCount = 0;
+         ASSERT_TRUE(client->readUpdate(ghost.index, &in, received, readCount)) << "Update " << iter << " failed to decode";
+         ASSERT_EQ(readCount, bitCount);
+         ASSERT_EQ(in.getCurPos(), out.getCurPos());
+         for(U32 bit = 0; bit < bitCount; bit++)
+            ASSERT_EQ((received[bit >> 3] >> (bit & 7)) & 1, (sent[bit >> 3] >> (bit & 7)) & 1) << "Update " << iter << " differs at bit " << bit;
+      }
+
+      // Keep a few updates in flight so baselines lag behind.
+      if(pending.size() > (U32)rand.randI(0, 4))
+      {
+         NetConnection::GhostRef *oldest = pending.first();
+         const bool oldestLost = pendingLost.first();
+         pending.pop_front();
+         pendingLost.pop_front();
+         if(oldestLost)
+            server->packetLost(oldest);
+         else
+            server->packetAcked(oldest);
+      }
+   }
+
+   while(pending.size())
+   {
+      if(pendingLost.first())
+         server->packetLost(pending.first());
+      else
+         server->packetAcked(pending.first());
+      pending.pop_front();
+      pendingLost.pop_front();
+   }
+
+   EXPECT_LT(sentBits, rawBits / 2);
+
+   delete ghost.baseline;
+   delete server;
+   delete client;
+}
+
+#endif
@@ -0,0 +1,128 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026 tgemit contributors.
+// See AUTHORS file and git repository for contributor information.
+//
+// SPDX-License-Identifier: MIT
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "T3D/fx/groundCover.h"
+#include "platform/threads/threadPool.h"
+#include "platform/threads/semaphore.h"
+
+/// Exposes the cell queue to the tests.  Without terrains
+/// or a placement count the cells place nothing.
+class GroundCoverTestObject : public GroundCover
+{
+public:
+   ~GroundCoverTestObject() { _deleteCells(); }
+
+   void queueCells( U32 count, bool toCache )
+   {
+      const Vector<SceneObject*> terrains;
+      for ( U32 i = 0; i < count; i++ )
+      {
+         GroundCoverCell *cell = _allocCell( Point2I( i, 0 ), Box3F( F32( i ), 0, 0, F32( i + 1 ), 1, 1 ) );
+         if ( toCache )
+            mCellCache.push_back( cell );
+         _queueCell( cell, terrains );
+      }
+   }
+
+   void waitForPendingCells() { _waitForPendingCells(); }
+   void collectDoneCells() { _collectDoneCells(); }
+   void trimCellCache() { _trimCellCache(); }
+
+   static S32& cacheBudget() { return smCellCacheBudget; }
+
+   /// Returns the cached cells which are still being placed.
+   Vector<GroundCoverCell*> getPendingCachedCells() const
+   {
+      Vector<GroundCoverCell*> cells;
+      for ( U32 i = 0; i < mCellCache.size(); i++ )
+      {
+         if ( _isCellPending( mCellCache[i] ) )
+            cells.push_back( mCellCache[i] );
+      }
+
+      return cells;
+   }
+
+   bool isCellCached( GroundCoverCell *cell ) const { return mCellCache.contains( cell ); }
+
+   U32 getPendingCells() const { return mPendingCells; }
+   U32 getCachedCells() const { return mCellCache.size(); }
+   U32 getAllocatedCells() const { return mAllocCellList.size(); }
+
+   /// Returns true if a finished cell was not collected.
+   bool hasUncollectedCells() { return mCellsDone.acquire( false ); }
+};
+
+TEST(GroundCover, Wait_Collects_All_Cells)
+{
+   GroundCoverTestObject cover;
+
+   cover.queueCells( 64, false );
+   cover.waitForPendingCells();
+
+   EXPECT_EQ( cover.getPendingCells(), 0 );
+   EXPECT_FALSE( cover.hasUncollectedCells() );
+
+   // Collecting without blocking eventually gets them all too.
+   cover.queueCells( 16, false );
+   while ( cover.getPendingCells() > 0 )
+      cover.collectDoneCells();
+
+   EXPECT_FALSE( cover.hasUncollectedCells() );
+}
+
+TEST(GroundCover, Trim_Leaves_Pending_Cells)
+{
+   const S32 budget = GroundCoverTestObject::cacheBudget();
+   GroundCoverTestObject::cacheBudget() = 0;
+
+   // Hold up the workers ahead of the cells so they are still
+   // pending during the trim.  There are more of these than any
+   // pool has threads so no cell gets taken until they are let go.
+   struct StallItem : public ThreadPool::WorkItem
+   {
+      Semaphore *mRelease;
+      StallItem( Semaphore *release ) : mRelease( release ) {}
+
+      F32 getPriority() override { return 2.0f; }
+
+   protected:
+      void execute() override { mRelease->acquire(); }
+   };
+
+   const U32 numStallItems = 256;
+   Semaphore release( 0 );
+   for ( U32 i = 0; i < numStallItems; i++ )
+      ThreadPool::GLOBAL().queueWorkItem( new StallItem( &release ) );
+
+   GroundCoverTestObject cover;
+
+   // The pending cells have to stay in the cache untouched.
+   cover.queueCells( 64, true );
+   const Vector<GroundCoverCell*> pending = cover.getPendingCachedCells();
+   EXPECT_EQ( pending.size(), 64 );
+
+   cover.trimCellCache();
+   EXPECT_EQ( cover.getCachedCells(), 64 );
+   for ( U32 i = 0; i < pending.size(); i++ )
+      EXPECT_TRUE( cover.isCellCached( pending[i] ) ) << "Cell " << i;
+
+   for ( U32 i = 0; i < numStallItems; i++ )
+      release.release();
+
+   // Once they are done there is nothing left to keep.
+   cover.waitForPendingCells();
+   cover.trimCellCache();
+   EXPECT_EQ( cover.getCachedCells(), 0 );
+   EXPECT_EQ( cover.getAllocatedCells(), 64 );
+
+   GroundCoverTestObject::cacheBudget() = budget;
+}
+
+#endif
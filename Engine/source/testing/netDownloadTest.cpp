@@ -0,0 +1,210 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026 tgemit contributors.
+// See AUTHORS file and git repository for contributor information.
+//
+// SPDX-License-Identifier: MIT
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "sim/netConnection.h"
+#include "core/stream/bitStream.h"
+#include "core/stream/fileStream.h"
+#include "core/volume.h"
+#include "core/crc.h"
+#include "math/mRandom.h"
+
+/// Exposes the file transfer state to the tests.
+class DownloadTestConnection : public NetConnection
+{
+public:
+   void expectFile(const char *fileName) { mMissingFileList.push_back(dStrdup(fileName)); }
+
+   U32 getNumDownloadedFiles() const { return mNumDownloadedFiles; }
+
+   /// Writes the events waiting to be sent into a packet.
+   PacketNotify *writeTestPacket(BitStream *stream)
+   {
+      PacketNotify *note = allocNotify();
+      writePacket(stream, note);
+      return note;
+   }
+
+   void readTestPacket(BitStream *stream) { readPacket(stream); }
+
+   /// Acks the packet, which delivers its events.
+   void ackTestPacket(PacketNotify *note)
+   {
+      packetReceived(note);
+      delete note;
+   }
+};
+
+static const char *sSourceFile = "netDownloadTest.src";
+static const char *sDestFile = "netDownloadTest.dst";
+static const char *sPartialFile = "netDownloadTest.dst.part";
+
+FIXTURE(NetDownload)
+{
+public:
+   DownloadTestConnection *mServer;
+   DownloadTestConnection *mClient;
+   Vector<U8> mData;
+
+   void SetUp() override
+   {
+      mServer = new DownloadTestConnection;
+      mClient = new DownloadTestConnection;
+      mClient->setIsConnectionToServer();
+      setProtocolVersion(NetConnection::FileBlockProtocolVersion);
+      NetConnection::getErrorBuffer() = String();
+
+      // Half text like data which deflates well and half noise which
+      // doesn't, so both kinds of blocks get sent.  The size leaves
+      // the last block short.
+      MRandomLCG rand(4242);
+      mData.setSize(70000);
+      for(U32 i = 0; i < mData.size(); i++)
+         mData[i] = i < mData.size() / 2 ? U8('a' + (i / 7) % 20) : U8(rand.randI(0, 255));
+
+      writeFile(sSourceFile, mData.address(), mData.size());
+   }
+
+   void TearDown() override
+   {
+      delete mServer;
+      delete mClient;
+      Torque::FS::Remove(sSourceFile);
+      Torque::FS::Remove(sDestFile);
+      Torque::FS::Remove(sPartialFile);
+   }
+
+   void setProtocolVersion(U32 version)
+   {
+      mServer->setProtocolVersion(version);
+      mClient->setProtocolVersion(version);
+   }
+
+   static void writeFile(const char *fileName, const U8 *data, U32 size)
+   {
+      FileStream *stream = FileStream::createAndOpen(fileName, Torque::FS::File::Write);
+      ASSERT_TRUE(stream != NULL);
+      stream->write(size, data);
+      delete stream;
+   }
+
+   /// Returns true if the downloaded file matches the source data.
+   bool checkDownload()
+   {
+      FileStream *stream = FileStream::createAndOpen(sDestFile, Torque::FS::File::Read);
+      if(!stream)
+         return false;
+
+      Vector<U8> data;
+      data.setSize(stream->getStreamSize());
+      const bool read = stream->read(data.size(), data.address());
+      delete stream;
+
+      return read && data.size() == mData.size() && dMemcmp(data.address(), mData.address(), data.size()) == 0;
+   }
+
+   /// Sends packets from the server to the client until the server has
+   /// no more events to send, acking each one so the next chunks get
+   /// queued, and returns the number of bytes sent.
+   U32 pumpPackets()
+   {
+      U8 buffer[Net::MaxPacketDataSize];
+      U32 bytes = 0;
+
+      while(true)
+      {
+         BitStream stream(NULL, 0);
+         stream.setBuffer(buffer, Net::MaxPacketDataSize - 512, Net::MaxPacketDataSize);
+
+         NetConnection::PacketNotify *note = mServer->writeTestPacket(&stream);
+         if(!note->eventList)
+         {
+            mServer->ackTestPacket(note);
+            break;
+         }
+
+         bytes += stream.getPosition();
+         stream.setPosition(0);
+         mClient->readTestPacket(&stream);
+         mServer->ackTestPacket(note);
+
+         if(!NetConnection::getErrorBuffer().isEmpty())
+            break;
+      }
+
+      return bytes;
+   }
+
+   /// Sends the source file to the client as the destination file.
+   U32 download(U32 resumeOffset = 0, U32 resumeCRC = 0)
+   {
+      mClient->expectFile(sDestFile);
+      EXPECT_TRUE(mServer->startSendingFile(sSourceFile, resumeOffset, resumeCRC));
+      return pumpPackets();
+   }
+};
+
+TEST_FIX(NetDownload, Compressed_Blocks_Reassemble)
+{
+   const U32 bytes = download();
+
+   EXPECT_TRUE(NetConnection::getErrorBuffer().isEmpty()) << NetConnection::getErrorBuffer().c_str();
+   EXPECT_EQ(mClient->getNumDownloadedFiles(), 1);
+   EXPECT_TRUE(checkDownload());
+   EXPECT_FALSE(mServer->isUploadingFile());
+   EXPECT_FALSE(Torque::FS::IsFile(sPartialFile));
+
+   // The text half should have been deflated.
+   EXPECT_LT(bytes, mData.size() * 3 / 4);
+}
+
+TEST_FIX(NetDownload, Legacy_Protocol_Sends_Raw_Chunks)
+{
+   setProtocolVersion(NetConnection::FileBlockProtocolVersion - 1);
+
+   const U32 bytes = download();
+
+   EXPECT_TRUE(NetConnection::getErrorBuffer().isEmpty()) << NetConnection::getErrorBuffer().c_str();
+   EXPECT_TRUE(checkDownload());
+   EXPECT_GE(bytes, mData.size());
+}
+
+TEST_FIX(NetDownload, Resume_From_Partial_Copy)
+{
+   const U32 fullBytes = download();
+   ASSERT_TRUE(checkDownload());
+   Torque::FS::Remove(sDestFile);
+
+   // The client got the first part before the connection dropped.
+   const U32 partialSize = 40000;
+   writeFile(sPartialFile, mData.address(), partialSize);
+   const U32 crc = CRC::calculateCRC(mData.address(), partialSize, CRC::INITIAL_CRC_VALUE);
+
+   const U32 resumedBytes = download(partialSize, crc);
+
+   EXPECT_TRUE(NetConnection::getErrorBuffer().isEmpty()) << NetConnection::getErrorBuffer().c_str();
+   EXPECT_TRUE(checkDownload());
+   EXPECT_LT(resumedBytes, fullBytes);
+   EXPECT_FALSE(Torque::FS::IsFile(sPartialFile));
+}
+
+TEST_FIX(NetDownload, Resume_Ignores_Mismatched_Copy)
+{
+   // A partial copy of some other version of the file.
+   Vector<U8> stale(mData);
+   stale[100] ^= 0xFF;
+   writeFile(sPartialFile, stale.address(), 40000);
+   const U32 crc = CRC::calculateCRC(stale.address(), 40000, CRC::INITIAL_CRC_VALUE);
+
+   download(40000, crc);
+
+   EXPECT_TRUE(NetConnection::getErrorBuffer().isEmpty()) << NetConnection::getErrorBuffer().c_str();
+   EXPECT_TRUE(checkDownload());
+}
+
+#endif
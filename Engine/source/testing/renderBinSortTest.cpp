@@ -0,0 +1,164 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026 tgemit contributors.
+// See AUTHORS file and git repository for contributor information.
+//
+// SPDX-License-Identifier: MIT
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "renderInstance/renderBinManager.h"
+#include "renderInstance/renderMeshMgr.h"
+#include "renderInstance/renderPassManager.h"
+#include "math/mRandom.h"
+
+typedef RenderBinManager::MainSortElem MainSortElem;
+
+TEST(RenderBinSortTest, RadixSort_Should_Match_Key_Order)
+{
+   MRandomLCG rand( 1234 );
+
+   Vector<MainSortElem> list;
+   Vector<MainSortElem> scratch;
+
+   const U32 count = 5000;
+   list.setSize( count );
+   for ( U32 i=0; i < count; i++ )
+   {
+      // Keep the key range small so we get lots of ties.
+      list[i].inst = (RenderInst*)(uintptr_t)( i + 1 );
+      list[i].key = rand.randI( 0, 16 );
+      list[i].key2 = rand.randI( 0, 64 ) << 20;
+      list[i].sortKey = RenderBinManager::makeSortKey( list[i].key, list[i].key2 );
+   }
+
+   RenderBinManager::radixSort( list, scratch );
+
+   for ( U32 i=1; i < count; i++ )
+   {
+      const MainSortElem &prev = list[i-1];
+      const MainSortElem &curr = list[i];
+
+      // Primary key descending, secondary ascending.
+      ASSERT_GE( prev.key, curr.key );
+      if ( prev.key == curr.key )
+      {
+         ASSERT_LE( prev.key2, curr.key2 );
+
+         // The sort must be stable.
+         if ( prev.key2 == curr.key2 )
+            ASSERT_LT( (uintptr_t)prev.inst, (uintptr_t)curr.inst );
+      }
+   }
+}
+
+TEST(RenderBinSortTest, RadixSort_Should_Handle_Uniform_Keys)
+{
+   Vector<MainSortElem> list;
+   Vector<MainSortElem> scratch;
+
+   list.setSize( 100 );
+   for ( U32 i=0; i < list.size(); i++ )
+   {
+      list[i].inst = (RenderInst*)(uintptr_t)( i + 1 );
+      list[i].key = list[i].key2 = 7;
+      list[i].sortKey = RenderBinManager::makeSortKey( 7, 7 );
+   }
+
+   RenderBinManager::radixSort( list, scratch );
+
+   for ( U32 i=0; i < list.size(); i++ )
+      EXPECT_EQ( (uintptr_t)list[i].inst, i + 1 );
+}
+
+TEST(RenderBinSortTest, IdenticalRunLength_Should_Stop_At_Changes)
+{
+   // Only the pointers are compared so they don't
+   // need to point at anything real.
+   BaseMatInstance *matA = (BaseMatInstance*)(uintptr_t)0x1000;
+   BaseMatInstance *matB = (BaseMatInstance*)(uintptr_t)0x2000;
+   GFXVertexBufferHandleBase *vb = (GFXVertexBufferHandleBase*)(uintptr_t)0x3000;
+   GFXPrimitiveBufferHandle *pb = (GFXPrimitiveBufferHandle*)(uintptr_t)0x4000;
+   LightInfo *light = (LightInfo*)(uintptr_t)0x5000;
+
+   MeshRenderInst insts[10];
+   for ( U32 i=0; i < 10; i++ )
+   {
+      insts[i].clear();
+      insts[i].matInst = matA;
+      insts[i].vertBuff = vb;
+      insts[i].primBuff = pb;
+      insts[i].primBuffIndex = 2;
+   }
+
+   // A different light set, primitive and material.
+   insts[4].lights[0] = light;
+   insts[6].primBuffIndex = 3;
+   insts[7].matInst = matB;
+   insts[8].matInst = matB;
+   insts[9].matInst = matB;
+
+   Vector<MainSortElem> list;
+   list.setSize( 10 );
+   for ( U32 i=0; i < list.size(); i++ )
+      list[i].inst = &insts[i];
+
+   EXPECT_EQ( RenderMeshMgr::getIdenticalRunLength( list, 0 ), 4 );
+   EXPECT_EQ( RenderMeshMgr::getIdenticalRunLength( list, 2 ), 2 );
+   EXPECT_EQ( RenderMeshMgr::getIdenticalRunLength( list, 4 ), 1 );
+   EXPECT_EQ( RenderMeshMgr::getIdenticalRunLength( list, 5 ), 1 );
+   EXPECT_EQ( RenderMeshMgr::getIdenticalRunLength( list, 6 ), 1 );
+
+   // The run ends with the list.
+   EXPECT_EQ( RenderMeshMgr::getIdenticalRunLength( list, 7 ), 3 );
+   EXPECT_EQ( RenderMeshMgr::getIdenticalRunLength( list, 9 ), 1 );
+
+   // Identical meshes get the same key.
+   EXPECT_EQ( RenderMeshMgr::getMeshKey( &insts[0] ), RenderMeshMgr::getMeshKey( &insts[3] ) );
+   EXPECT_LE( RenderMeshMgr::getMeshKey( &insts[6] ), 0xFFFF );
+}
+
+TEST(RenderBinSortTest, IdenticalRunLength_Should_Stop_At_Texture_Changes)
+{
+   BaseMatInstance *mat = (BaseMatInstance*)(uintptr_t)0x1000;
+   GFXVertexBufferHandleBase *vb = (GFXVertexBufferHandleBase*)(uintptr_t)0x3000;
+   GFXPrimitiveBufferHandle *pb = (GFXPrimitiveBufferHandle*)(uintptr_t)0x4000;
+   GFXCubemap *cubemapA = (GFXCubemap*)(uintptr_t)0x6000;
+   GFXCubemap *cubemapB = (GFXCubemap*)(uintptr_t)0x7000;
+   GFXTextureObject *tex = (GFXTextureObject*)(uintptr_t)0x8000;
+
+   // The same mesh over and over with only the textures changing.
+   // An instanced draw only binds the textures of its first instance
+   // so none of these may end up in the same batch.
+   MeshRenderInst insts[9];
+   for ( U32 i=0; i < 9; i++ )
+   {
+      insts[i].clear();
+      insts[i].matInst = mat;
+      insts[i].vertBuff = vb;
+      insts[i].primBuff = pb;
+      insts[i].primBuffIndex = 2;
+      insts[i].cubemap = cubemapA;
+   }
+
+   insts[2].cubemap = cubemapB;
+   insts[3].cubemap = cubemapB;
+   insts[4].lightmap = tex;
+   insts[5].reflectTex = tex;
+   insts[6].miscTex = tex;
+   insts[7].accuTex = tex;
+
+   Vector<MainSortElem> list;
+   list.setSize( 9 );
+   for ( U32 i=0; i < list.size(); i++ )
+      list[i].inst = &insts[i];
+
+   EXPECT_EQ( RenderMeshMgr::getIdenticalRunLength( list, 0 ), 2 );
+   EXPECT_EQ( RenderMeshMgr::getIdenticalRunLength( list, 1 ), 1 );
+   EXPECT_EQ( RenderMeshMgr::getIdenticalRunLength( list, 2 ), 2 );
+
+   for ( U32 i=3; i < 9; i++ )
+      EXPECT_EQ( RenderMeshMgr::getIdenticalRunLength( list, i ), 1 ) << "Instance " << i;
+}
+
+#endif
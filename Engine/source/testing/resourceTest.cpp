@@ -26,7 +26,12 @@
 #include "core/util/fourcc.h"
 #include "console/console.h"
 #include "core/resourceManager.h"
+#include "platform/threads/threadPool.h"
+#include "platform/threads/thread.h"
+#include "platform/platformIntrinsics.h"
 static bool destructorCalled;
+static volatile U32 createCount;
+static U32 postLoadOffMainThreadCount;
 
 struct TestResource
 {
@@ -46,6 +51,11 @@ template<> ResourceBase::Signature  Resource<TestResource>::signature()
 template<> void* Resource<TestResource>::create(const Torque::Path& path)
 {
    TestResource* testRes = new TestResource;
+   dFetchAndAdd(createCount, 1);
+
+   // Give concurrent loaders of the same path a chance to pile up.
+   if (path.getFileName() == String("concurrent"))
+      Platform::sleep(20);
 
    return testRes;
 }
@@ -61,6 +71,9 @@ ResourceRegisterPostLoadSignal< TestResource > TestResource::_smAutoLoad(&TestRe
 
 void TestResource::_onTestLoaded(Resource<TestResource>& test)
 {
+   if (!ThreadManager::isMainThread())
+      postLoadOffMainThreadCount++;
+
    test->values[0] = 1;
    test->values[1] = 1;
    test->values[2] = 1;
@@ -95,3 +108,54 @@ TEST(ResourceManagerTests, All_Resource_Functionality)
    EXPECT_EQ(destructorCalled, true) << "Destructor false should be true";
 }
 
+
+struct LoadTestResourceItem : public ThreadPool::WorkItem
+{
+   Resource<TestResource>& mResult;
+   LoadTestResourceItem(Resource<TestResource>& result) : mResult(result) {}
+
+protected:
+   void execute() override
+   {
+      mResult = ResourceManager::get().load("concurrent");
+   }
+};
+
+TEST(ResourceManagerTests, Concurrent_Loads_Share_One_Create)
+{
+   const U32 numItems = 8;
+   Resource<TestResource> results[numItems];
+
+   createCount = 0;
+   postLoadOffMainThreadCount = 0;
+   const S32 misses = ResourceManager::smMisses;
+
+   ThreadPool* pool = &ThreadPool::GLOBAL();
+   for (U32 i = 0; i < numItems; i++)
+   {
+      ThreadSafeRef<LoadTestResourceItem> item(new LoadTestResourceItem(results[i]));
+      pool->queueWorkItem(item);
+   }
+
+   pool->waitForAllItems();
+
+   EXPECT_EQ(createCount, 1) << "Concurrent loads should share a single create";
+   EXPECT_EQ(ResourceManager::smMisses - misses, 1) << "Only the first load should miss";
+
+   for (U32 i = 0; i < numItems; i++)
+   {
+      EXPECT_TRUE(results[i] != NULL) << "Resource failed to load";
+      EXPECT_EQ((TestResource*)results[i], (TestResource*)results[0]) << "Loads returned different resources";
+   }
+
+   // The post load signal waits for the main loop.
+   EXPECT_EQ(results[0]->values[0], 0) << "Post load signal fired on a loader thread";
+   ThreadPool::processMainThreadWorkItems();
+   EXPECT_EQ(results[0]->values[0], 1) << "Post load signal was not fired";
+   EXPECT_EQ(postLoadOffMainThreadCount, 0) << "Post load signal fired on a loader thread";
+
+   for (U32 i = 0; i < numItems; i++)
+      results[i] = Resource<TestResource>();
+
+   EXPECT_TRUE(ResourceManager::get().find("concurrent").getPath().isEmpty()) << "Unreferenced resource should have been freed";
+}
@@ -0,0 +1,170 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026 tgemit contributors.
+// See AUTHORS file and git repository for contributor information.
+//
+// SPDX-License-Identifier: MIT
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "console/console.h"
+#include "console/torquescript/runtime.h"
+#include "core/stream/fileStream.h"
+#include "core/volume.h"
+#include "platform/threads/threadPool.h"
+#include "platform/platformCPUCount.h"
+
+static const char *sScriptCompileTestFiles[] =
+{
+   "scriptCompileTest/first." TORQUE_SCRIPT_EXTENSION,
+   "scriptCompileTest/second." TORQUE_SCRIPT_EXTENSION,
+   "scriptCompileTest/third." TORQUE_SCRIPT_EXTENSION,
+   "scriptCompileTest/fourth." TORQUE_SCRIPT_EXTENSION,
+};
+
+static const char *sScriptCompileTestScripts[] =
+{
+   "function scriptCompileTestA(%a, %b) { %c = %a + %b; return %c * 2.5; }\n"
+   "function scriptCompileTestB(%list) { for(%i = 0; %i < getWordCount(%list); %i++) %sum += getWord(%list, %i); return %sum; }\n",
+
+   "$ScriptCompileTest::value = \"some text\";\n"
+   "function scriptCompileTestC() { %x = $ScriptCompileTest::value @ \" more\"; return strlen(%x); }\n",
+
+   // Warns about the break, which has to reach the console from the main thread.
+   "function scriptCompileTestD(%v) { if(%v) break; return \"a,b\" + 1; }\n",
+
+   "function scriptCompileTestE(%obj) { %obj.field = 3.25; %obj.call(\"x\", %obj.field); }\n"
+   "function scriptCompileTestF() { switch$(\"b\") { case \"a\": return 1; case \"b\": return 2; } return 0; }\n",
+};
+
+FIXTURE(ScriptCompile)
+{
+public:
+   static const U32 NumFiles = sizeof(sScriptCompileTestFiles) / sizeof(sScriptCompileTestFiles[0]);
+
+   void SetUp() override
+   {
+      for (U32 i = 0; i < NumFiles; i++)
+      {
+         FileStream *stream = FileStream::createAndOpen(sScriptCompileTestFiles[i], Torque::FS::File::Write);
+         ASSERT_TRUE(stream != NULL);
+         stream->write(dStrlen(sScriptCompileTestScripts[i]), sScriptCompileTestScripts[i]);
+         delete stream;
+      }
+   }
+
+   void TearDown() override
+   {
+      for (U32 i = 0; i < NumFiles; i++)
+      {
+         Torque::FS::Remove(sScriptCompileTestFiles[i]);
+         Torque::FS::Remove(getDSOFileName(i));
+      }
+   }
+
+   static String getDSOFileName(U32 i)
+   {
+      return String::ToString("%s.dso", sScriptCompileTestFiles[i]);
+   }
+
+   /// Reads the DSO of the file and removes it.
+   static bool readDSO(U32 i, Vector<U8>& data)
+   {
+      const String dsoFileName = getDSOFileName(i);
+      FileStream *stream = FileStream::createAndOpen(dsoFileName, Torque::FS::File::Read);
+      if (!stream)
+         return false;
+
+      data.setSize(stream->getStreamSize());
+      const bool read = stream->read(data.size(), data.address());
+      delete stream;
+
+      Torque::FS::Remove(dsoFileName);
+      return read;
+   }
+};
+
+TEST_FIX(ScriptCompile, Parallel_Matches_Serial)
+{
+   Vector<U8> serial[NumFiles];
+   for (U32 i = 0; i < NumFiles; i++)
+   {
+      ASSERT_TRUE(TorqueScript::getRuntime()->compile(sScriptCompileTestFiles[i], true));
+      ASSERT_TRUE(readDSO(i, serial[i]));
+   }
+
+   // Compile them a few times so the files land on different threads.
+   for (U32 pass = 0; pass < 3; pass++)
+   {
+      Vector<String> fileNames;
+      for (U32 i = 0; i < NumFiles; i++)
+         fileNames.push_back(sScriptCompileTestFiles[(i + pass) % NumFiles]);
+
+      EXPECT_EQ(TorqueScript::getRuntime()->compileFiles(fileNames, true), NumFiles);
+
+      for (U32 i = 0; i < NumFiles; i++)
+      {
+         Vector<U8> parallel;
+         ASSERT_TRUE(readDSO(i, parallel));
+         ASSERT_EQ(parallel.size(), serial[i].size()) << sScriptCompileTestFiles[i];
+         EXPECT_EQ(dMemcmp(parallel.address(), serial[i].address(), parallel.size()), 0) << sScriptCompileTestFiles[i];
+      }
+   }
+}
+
+TEST_FIX(ScriptCompile, Parallel_Syntax_Error_Reaches_Console)
+{
+   FileStream *stream = FileStream::createAndOpen(sScriptCompileTestFiles[0], Torque::FS::File::Write);
+   ASSERT_TRUE(stream != NULL);
+   const char *script = "function scriptCompileTestBroken( { return; }\n";
+   stream->write(dStrlen(script), script);
+   delete stream;
+
+   Con::setVariable("$ScriptError", "");
+
+   Vector<String> fileNames;
+   for (U32 i = 0; i < NumFiles; i++)
+      fileNames.push_back(sScriptCompileTestFiles[i]);
+
+   EXPECT_EQ(TorqueScript::getRuntime()->compileFiles(fileNames, true), NumFiles - 1);
+
+   // The error was queued on the worker and applied by the main thread.
+   EXPECT_TRUE(dStrstr(Con::getVariable("$ScriptError"), "first." TORQUE_SCRIPT_EXTENSION) != NULL);
+   EXPECT_FALSE(Torque::FS::IsFile(getDSOFileName(0)));
+
+   Con::setVariable("$ScriptError", "");
+}
+
+TEST_FIX(ScriptCompile, Parallel_Ignores_Unrelated_Work)
+{
+   // The slow item takes a worker so we need another for the scripts.
+   U32 numLogical = 0, numCores = 0;
+   CPUInfo::CPUCount(numLogical, numCores);
+   if (getMax(numLogical, numCores) < 2)
+      return;
+
+   struct SlowItem : public ThreadPool::WorkItem
+   {
+   protected:
+      void execute() override { Platform::sleep(3000); }
+   };
+
+   ThreadPool* pool = &ThreadPool::GLOBAL();
+   ThreadSafeRef<SlowItem> slowItem(new SlowItem);
+   pool->queueWorkItem(slowItem);
+
+   Vector<String> fileNames;
+   for (U32 i = 0; i < NumFiles; i++)
+      fileNames.push_back(sScriptCompileTestFiles[i]);
+
+   // The compile only waits on its own items and not the slow one.
+   EXPECT_EQ(TorqueScript::getRuntime()->compileFiles(fileNames, true), NumFiles);
+   EXPECT_FALSE(slowItem->hasExecuted());
+
+   for (U32 i = 0; i < NumFiles; i++)
+      EXPECT_TRUE(Torque::FS::IsFile(getDSOFileName(i))) << sScriptCompileTestFiles[i];
+
+   pool->waitForAllItems();
+}
+
+#endif
@@ -0,0 +1,120 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026 tgemit contributors.
+// See AUTHORS file and git repository for contributor information.
+//
+// SPDX-License-Identifier: MIT
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "gfx/gfxShaderConstMirror.h"
+
+/// A CPU constant buffer as the devices keep them.
+struct ShaderConstMirrorTestBuffer
+{
+   F32 data[64];
+   GFXShaderConstDirtyRange dirty;
+
+   ShaderConstMirrorTestBuffer()
+   {
+      dMemset( data, 0, sizeof( data ) );
+      dirty.add( 0, sizeof( data ) );
+   }
+
+   void set( U32 index, F32 value )
+   {
+      data[index] = value;
+      dirty.add( index * sizeof( F32 ), sizeof( F32 ) );
+   }
+
+   bool upload( GFXShaderConstMirror &mirror, U32 *start, U32 *end )
+   {
+      return mirror.update( this, (const U8*)data, sizeof( data ), dirty, start, end );
+   }
+};
+
+TEST(ShaderConstMirror, Dirty_Range)
+{
+   GFXShaderConstDirtyRange range;
+   EXPECT_TRUE( range.isEmpty() );
+
+   range.add( 64, 16 );
+   range.add( 16, 4 );
+   EXPECT_FALSE( range.isEmpty() );
+   EXPECT_EQ( range.start, 16 );
+   EXPECT_EQ( range.end, 80 );
+
+   range.clear();
+   EXPECT_TRUE( range.isEmpty() );
+}
+
+TEST(ShaderConstMirror, Uploads_Only_Changes)
+{
+   GFXShaderConstMirror mirror;
+   ShaderConstMirrorTestBuffer buffer;
+   U32 start, end;
+
+   // The first upload sends everything.
+   EXPECT_TRUE( mirror.isEmpty() );
+   ASSERT_TRUE( buffer.upload( mirror, &start, &end ) );
+   EXPECT_EQ( start, 0 );
+   EXPECT_EQ( end, sizeof( buffer.data ) );
+   EXPECT_TRUE( buffer.dirty.isEmpty() );
+
+   // Nothing written, nothing sent.
+   EXPECT_FALSE( buffer.upload( mirror, &start, &end ) );
+
+   // Writing the same value is not a change.
+   buffer.set( 5, 0.0f );
+   EXPECT_FALSE( buffer.upload( mirror, &start, &end ) );
+
+   // A change sends its whole register.
+   buffer.set( 5, 1.0f );
+   ASSERT_TRUE( buffer.upload( mirror, &start, &end ) );
+   EXPECT_EQ( start, 16 );
+   EXPECT_EQ( end, 32 );
+
+   // Changes far apart send the span between them, trimmed
+   // of unchanged registers at either end.
+   buffer.set( 4, 0.0f );
+   buffer.set( 9, 2.0f );
+   buffer.set( 20, 3.0f );
+   buffer.set( 63, 0.0f );
+   ASSERT_TRUE( buffer.upload( mirror, &start, &end ) );
+   EXPECT_EQ( start, 32 );
+   EXPECT_EQ( end, 96 );
+}
+
+TEST(ShaderConstMirror, Shared_By_Many_Buffers)
+{
+   GFXShaderConstMirror mirror;
+   ShaderConstMirrorTestBuffer a, b;
+   U32 start, end;
+
+   ASSERT_TRUE( a.upload( mirror, &start, &end ) );
+
+   // Another buffer with the same content uploads nothing
+   // even tho it's all dirty.
+   EXPECT_FALSE( b.upload( mirror, &start, &end ) );
+   EXPECT_TRUE( b.dirty.isEmpty() );
+
+   // A clean buffer still compares everything when
+   // it wasn't the last one uploaded.
+   b.set( 40, 1.0f );
+   ASSERT_TRUE( b.upload( mirror, &start, &end ) );
+   EXPECT_EQ( start, 160 );
+   EXPECT_EQ( end, 176 );
+
+   EXPECT_TRUE( a.dirty.isEmpty() );
+   ASSERT_TRUE( a.upload( mirror, &start, &end ) );
+   EXPECT_EQ( start, 160 );
+   EXPECT_EQ( end, 176 );
+
+   // Forgetting the device content sends it all again.
+   mirror.invalidate();
+   ASSERT_TRUE( a.upload( mirror, &start, &end ) );
+   EXPECT_EQ( start, 0 );
+   EXPECT_EQ( end, sizeof( a.data ) );
+}
+
+#endif
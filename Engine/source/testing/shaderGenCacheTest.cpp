@@ -0,0 +1,69 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026 tgemit contributors.
+// See AUTHORS file and git repository for contributor information.
+//
+// SPDX-License-Identifier: MIT
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "shaderGen/shaderGen.h"
+#include "shaderGen/featureType.h"
+#include "materials/materialFeatureTypes.h"
+#include "gfx/gfxVertexTypes.h"
+#include "core/stream/memStream.h"
+
+TEST(ShaderGenCache, FeatureType_Find)
+{
+   EXPECT_EQ( FeatureType::find( "MFT_DiffuseMap" ), &MFT_DiffuseMap );
+   EXPECT_EQ( FeatureType::find( "MFT_NormalMap" ), &MFT_NormalMap );
+   EXPECT_TRUE( FeatureType::find( "MFT_NoSuchFeature" ) == NULL );
+}
+
+TEST(ShaderGenCache, Entry_RoundTrip)
+{
+   ShaderGenCacheEntry entry;
+   entry.stamp = 0x0123456789ABCDEFULL;
+   entry.featureData.features.addFeature( MFT_VertTransform );
+   entry.featureData.features.addFeature( MFT_DiffuseMap );
+   entry.featureData.features.addFeature( MFT_DetailMap, 1 );
+   entry.featureData.materialFeatures.addFeature( MFT_NormalMap );
+   entry.vertexFormat.copy( *getGFXVertexFormat<GFXVertexPNTT>() );
+   entry.macros.push_back( GFXShaderMacro( "TORQUE_TEST", "2" ) );
+   entry.samplers.push_back( "diffuseMap" );
+   entry.samplers.push_back( "detailMap" );
+   entry.instancingFormat.addElement( "objTrans", GFXDeclType_Float4, 3 );
+
+   MemStream stream( 1024 );
+   ASSERT_TRUE( entry.write( stream ) );
+
+   stream.setPosition( 0 );
+   ShaderGenCacheEntry loaded;
+   ASSERT_TRUE( loaded.read( stream ) );
+
+   EXPECT_EQ( loaded.stamp, entry.stamp );
+   EXPECT_TRUE( loaded.featureData.features == entry.featureData.features );
+   EXPECT_TRUE( loaded.featureData.materialFeatures == entry.featureData.materialFeatures );
+   EXPECT_TRUE( loaded.vertexFormat.getDescription().equal( entry.vertexFormat.getDescription() ) );
+   EXPECT_TRUE( loaded.instancingFormat.getDescription().equal( entry.instancingFormat.getDescription() ) );
+
+   ASSERT_EQ( loaded.macros.size(), 1 );
+   EXPECT_TRUE( loaded.macros[0].name.equal( "TORQUE_TEST" ) );
+   EXPECT_TRUE( loaded.macros[0].value.equal( "2" ) );
+
+   ASSERT_EQ( loaded.samplers.size(), 2 );
+   EXPECT_TRUE( loaded.samplers[1].equal( "detailMap" ) );
+}
+
+TEST(ShaderGenCache, Entry_Rejects_Bad_Data)
+{
+   MemStream stream( 256 );
+   stream.write( 4, "SGCE" );
+   stream.write( (U8)99 );
+
+   stream.setPosition( 0 );
+   ShaderGenCacheEntry entry;
+   EXPECT_FALSE( entry.read( stream ) );
+}
+
+#endif
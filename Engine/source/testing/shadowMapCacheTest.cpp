@@ -0,0 +1,164 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026 tgemit contributors.
+// See AUTHORS file and git repository for contributor information.
+//
+// SPDX-License-Identifier: MIT
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "lighting/shadowMap/singleLightShadowMap.h"
+#include "lighting/lightInfo.h"
+#include "scene/sceneObject.h"
+#include "T3D/objectTypes.h"
+
+/// Lets the tests mark the map as rendered without
+/// a device to render it with.
+class ShadowMapCacheTestMap : public SingleLightShadowMap
+{
+public:
+   ShadowMapCacheTestMap( LightInfo *light ) : SingleLightShadowMap( light ) {}
+
+   void fakeRender( U32 texSize ) { mCache.update( mLight, texSize, 0 ); }
+};
+
+/// A static typed object like a StaticShape or turret.
+class ShadowMapCacheTestObject : public SceneObject
+{
+public:
+   ShadowMapCacheTestObject() { mTypeMask |= StaticObjectType | StaticShapeObjectType; }
+};
+
+FIXTURE(ShadowMapCache)
+{
+public:
+   LightInfo mLight;
+
+   void SetUp() override
+   {
+      mLight.setType( LightInfo::Spot );
+      mLight.setRange( 10.0f );
+      mLight.setOuterConeAngle( 45.0f );
+      mLight.setTransform( MatrixF( EulerF( 0.0f, 0.0f, 0.0f ), Point3F( 100.0f, 0.0f, 10.0f ) ) );
+   }
+};
+
+TEST_FIX(ShadowMapCache, State_Tracks_Light_Changes)
+{
+   ShadowMapCacheState state;
+   EXPECT_TRUE( state.needsUpdate( &mLight, 512, 0 ) );
+
+   state.update( &mLight, 512, 0 );
+   EXPECT_FALSE( state.needsUpdate( &mLight, 512, 0 ) );
+
+   // A resize always needs a new map.
+   EXPECT_TRUE( state.needsUpdate( &mLight, 256, 0 ) );
+
+   // So does any change to the light.
+   LightInfo moved;
+   moved.set( &mLight );
+   moved.setPosition( Point3F( 100.0f, 0.0f, 11.0f ) );
+   EXPECT_TRUE( state.needsUpdate( &moved, 512, 0 ) );
+
+   LightInfo wider;
+   wider.set( &mLight );
+   wider.setOuterConeAngle( 60.0f );
+   EXPECT_TRUE( state.needsUpdate( &wider, 512, 0 ) );
+
+   LightInfo longer;
+   longer.set( &mLight );
+   longer.setRange( 20.0f );
+   EXPECT_TRUE( state.needsUpdate( &longer, 512, 0 ) );
+
+   state.invalidate();
+   EXPECT_FALSE( state.isValid() );
+   EXPECT_TRUE( state.needsUpdate( &mLight, 512, 0 ) );
+}
+
+TEST_FIX(ShadowMapCache, State_Redraws_After_Dynamic_Casters_Leave)
+{
+   ShadowMapCacheState state;
+
+   // While something moves in the light it redraws.
+   state.update( &mLight, 512, 2 );
+   EXPECT_TRUE( state.needsUpdate( &mLight, 512, 2 ) );
+
+   // The frame it leaves we still need to clear its shadow.
+   EXPECT_TRUE( state.needsUpdate( &mLight, 512, 0 ) );
+   state.update( &mLight, 512, 0 );
+
+   // After that it can be reused.
+   EXPECT_FALSE( state.needsUpdate( &mLight, 512, 0 ) );
+}
+
+TEST_FIX(ShadowMapCache, Motion_Weight)
+{
+   ShadowMapCacheState state;
+
+   // Without a map all of it is stale.
+   EXPECT_EQ( state.getMotionWeight( &mLight, 0 ), 1.0f );
+
+   // A few casters stale less than many.
+   state.update( &mLight, 512, 1 );
+   const F32 fewCasters = state.getMotionWeight( &mLight, 1 );
+   const F32 manyCasters = state.getMotionWeight( &mLight, ShadowMapCacheState::FullMotionCasters );
+   EXPECT_GT( fewCasters, 0.0f );
+   EXPECT_LT( fewCasters, manyCasters );
+   EXPECT_EQ( manyCasters, 1.0f );
+   EXPECT_EQ( state.getMotionWeight( &mLight, 100 ), 1.0f );
+
+   // A moving light stales all of it.
+   LightInfo moved;
+   moved.set( &mLight );
+   moved.setPosition( Point3F( 100.0f, 0.0f, 11.0f ) );
+   EXPECT_TRUE( state.hasLightChanged( &moved ) );
+   EXPECT_FALSE( state.hasLightChanged( &mLight ) );
+   EXPECT_EQ( state.getMotionWeight( &moved, 1 ), 1.0f );
+}
+
+TEST(ShadowMapCache, Static_Type_Is_Not_Static_Geometry)
+{
+   // The type mask alone doesn't mean the object
+   // can't animate, so it must be culled every frame.
+   ShadowMapCacheTestObject obj;
+   EXPECT_TRUE( obj.getTypeMask() & StaticObjectType );
+   EXPECT_FALSE( obj.isStaticGeometry() );
+}
+
+TEST_FIX(ShadowMapCache, Light_Bounds)
+{
+   ShadowMapCacheTestMap *lsm = new ShadowMapCacheTestMap( &mLight );
+
+   // A narrow spot is bound by its cone.
+   Box3F bounds = lsm->getLightBounds();
+   EXPECT_TRUE( bounds.isContained( Point3F( 100.0f, 9.9f, 10.0f ) ) );
+   EXPECT_FALSE( bounds.isContained( Point3F( 100.0f, -1.0f, 10.0f ) ) );
+   EXPECT_FALSE( bounds.isContained( Point3F( 100.0f, 5.0f, 19.0f ) ) );
+
+   // A point light by its range.
+   mLight.setType( LightInfo::Point );
+   bounds = lsm->getLightBounds();
+   EXPECT_TRUE( bounds.isContained( Point3F( 100.0f, -9.9f, 10.0f ) ) );
+   EXPECT_FALSE( bounds.isContained( Point3F( 100.0f, 0.0f, 21.0f ) ) );
+
+   delete lsm;
+}
+
+TEST_FIX(ShadowMapCache, Static_Changes_Dirty_Overlapping_Lights)
+{
+   ShadowMapCacheTestMap *lsm = new ShadowMapCacheTestMap( &mLight );
+   lsm->fakeRender( 512 );
+   ASSERT_TRUE( lsm->getCacheState().isValid() );
+
+   // Changes far from the light keep the cache.
+   LightShadowMap::markStaticCastersDirty( Box3F( Point3F( -10.0f, -10.0f, 0.0f ), Point3F( 10.0f, 10.0f, 10.0f ) ) );
+   EXPECT_TRUE( lsm->getCacheState().isValid() );
+
+   // Changes within its bounds drop it.
+   LightShadowMap::markStaticCastersDirty( Box3F( Point3F( 99.0f, 4.0f, 9.0f ), Point3F( 101.0f, 6.0f, 11.0f ) ) );
+   EXPECT_FALSE( lsm->getCacheState().isValid() );
+
+   delete lsm;
+}
+
+#endif
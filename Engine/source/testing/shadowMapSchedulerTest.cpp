@@ -0,0 +1,122 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026 tgemit contributors.
+// See AUTHORS file and git repository for contributor information.
+//
+// SPDX-License-Identifier: MIT
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "lighting/shadowMap/shadowMapPass.h"
+#include "lighting/shadowMap/singleLightShadowMap.h"
+#include "lighting/shadowMap/pssmLightShadowMap.h"
+#include "lighting/lightInfo.h"
+
+/// Lets the tests set the priority without a scene.
+class ShadowMapSchedulerTestMap : public SingleLightShadowMap
+{
+public:
+   ShadowMapSchedulerTestMap( LightInfo *light, F32 priority ) : SingleLightShadowMap( light ) { mLastPriority = priority; }
+};
+
+TEST(ShadowMapScheduler, Waiting_Shadows_Get_A_Turn)
+{
+   LightInfo light;
+   ShadowMapSchedulerTestMap *big = new ShadowMapSchedulerTestMap( &light, 10.0f );
+   ShadowMapSchedulerTestMap *small = new ShadowMapSchedulerTestMap( &light, 1.0f );
+
+   Vector<LightShadowMap*> maps;
+   maps.push_back( small );
+   maps.push_back( big );
+
+   // Emulate a budget of one update per frame and count
+   // how often each one gets it.
+   U32 bigUpdates = 0, smallUpdates = 0;
+   for ( U32 frame = 1; frame <= 110; frame++ )
+   {
+      ShadowMapPass::sortForUpdate( maps, frame );
+      maps[0]->setLastUpdateFrame( frame );
+
+      if ( maps[0] == big )
+         bigUpdates++;
+      else
+         smallUpdates++;
+   }
+
+   // The bigger shadow updates more often but
+   // the small one isn't starved.
+   EXPECT_GT( bigUpdates, smallUpdates * 5 );
+   EXPECT_GE( smallUpdates, 9 );
+
+   delete big;
+   delete small;
+}
+
+TEST(ShadowMapScheduler, Budget)
+{
+   const U32 savedMs = ShadowMapPass::smRenderBudgetMs;
+   const U32 savedDrawCalls = ShadowMapPass::smDrawCallBudget;
+   const U32 savedPolys = ShadowMapPass::smPolyBudget;
+
+   ShadowMapPass::smRenderBudgetMs = 8;
+   ShadowMapPass::smDrawCallBudget = 0;
+   ShadowMapPass::smPolyBudget = 0;
+   EXPECT_FALSE( ShadowMapPass::isOverBudget( 100000, 10000000, 8 ) );
+   EXPECT_TRUE( ShadowMapPass::isOverBudget( 0, 0, 9 ) );
+
+   ShadowMapPass::smDrawCallBudget = 200;
+   EXPECT_FALSE( ShadowMapPass::isOverBudget( 199, 0, 0 ) );
+   EXPECT_TRUE( ShadowMapPass::isOverBudget( 200, 0, 0 ) );
+
+   ShadowMapPass::smPolyBudget = 50000;
+   EXPECT_TRUE( ShadowMapPass::isOverBudget( 10, 60000, 0 ) );
+
+   ShadowMapPass::smRenderBudgetMs = savedMs;
+   ShadowMapPass::smDrawCallBudget = savedDrawCalls;
+   ShadowMapPass::smPolyBudget = savedPolys;
+}
+
+TEST(ShadowMapScheduler, PSSM_Far_Splits_Update_Less)
+{
+   const U32 savedInterval = PSSMLightShadowMap::smMaxSplitUpdateInterval;
+   PSSMLightShadowMap::smMaxSplitUpdateInterval = 4;
+
+   U32 updates[4] = { 0, 0, 0, 0 };
+   for ( U32 frame = 0; frame < 16; frame++ )
+   {
+      for ( U32 split = 0; split < 4; split++ )
+      {
+         if ( PSSMLightShadowMap::isSplitDue( split, frame ) )
+            updates[split]++;
+      }
+
+      // The two farthest splits are staggered.
+      EXPECT_FALSE( PSSMLightShadowMap::isSplitDue( 2, frame ) && PSSMLightShadowMap::isSplitDue( 3, frame ) );
+   }
+
+   EXPECT_EQ( updates[0], 16 );
+   EXPECT_EQ( updates[1], 8 );
+   EXPECT_EQ( updates[2], 4 );
+   EXPECT_EQ( updates[3], 4 );
+
+   // An interval of one updates everything.
+   PSSMLightShadowMap::smMaxSplitUpdateInterval = 1;
+   for ( U32 split = 0; split < 4; split++ )
+      EXPECT_TRUE( PSSMLightShadowMap::isSplitDue( split, 7 ) );
+
+   PSSMLightShadowMap::smMaxSplitUpdateInterval = savedInterval;
+}
+
+TEST(ShadowMapScheduler, PSSM_Split_Coverage)
+{
+   const Box3F rendered( -0.55f, -0.55f, 0.0f, 0.55f, 0.55f, 0.6f );
+
+   EXPECT_TRUE( PSSMLightShadowMap::splitCovers( rendered, Box3F( -0.5f, -0.5f, 0.1f, 0.5f, 0.5f, 0.5f ) ) );
+   EXPECT_TRUE( PSSMLightShadowMap::splitCovers( rendered, Box3F( -0.45f, -0.5f, 0.1f, 0.55f, 0.5f, 0.5f ) ) );
+
+   // Moved too far to the side or deeper into the light.
+   EXPECT_FALSE( PSSMLightShadowMap::splitCovers( rendered, Box3F( -0.4f, -0.5f, 0.1f, 0.6f, 0.5f, 0.5f ) ) );
+   EXPECT_FALSE( PSSMLightShadowMap::splitCovers( rendered, Box3F( -0.5f, -0.5f, 0.1f, 0.5f, 0.5f, 0.7f ) ) );
+}
+
+#endif
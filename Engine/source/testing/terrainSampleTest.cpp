@@ -0,0 +1,353 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026 tgemit contributors.
+// See AUTHORS file and git repository for contributor information.
+//
+// SPDX-License-Identifier: MIT
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "terrain/terrData.h"
+#include "terrain/terrFile.h"
+#include "core/resourceManager.h"
+#include "math/mRandom.h"
+
+/// Exposes the grid square build for the eager reference.
+class TerrainGridTestFile : public TerrainFile
+{
+public:
+   U32 getGridLevels() const { return mGridLevels; }
+
+   void buildGridSquare( U32 level, U32 x, U32 y, TerrainSquare *sq, TerrainSquare *parent ) const
+   {
+      _buildGridSquare( level, x, y, sq, parent, true );
+   }
+};
+
+FIXTURE(TerrainSample)
+{
+public:
+   TerrainBlock *mBlock;
+   TerrainFile *mFile;
+   Vector<Point2F> mPoints;
+
+   void SetUp() override
+   {
+      MRandomLCG rand( 4321 );
+
+      const U32 size = 64;
+      mFile = new TerrainFile;
+      mFile->setSize( size, true );
+
+      for ( U32 y = 0; y < size; y++ )
+      {
+         for ( U32 x = 0; x < size; x++ )
+         {
+            mFile->setHeight( x, y, floatToFixed( 100.0f + rand.randF( 0.0f, 50.0f ) ) );
+            mFile->setLayerIndex( x, y, rand.randI( 0, 3 ) );
+         }
+      }
+
+      // Punch a hole so the empty squares get tested.
+      for ( U32 y = 20; y < 24; y++ )
+         for ( U32 x = 30; x < 34; x++ )
+            mFile->setLayerIndex( x, y, U8_MAX );
+
+      // Rebuild the grid map with the new heights.
+      mFile->setSize( size, false );
+
+      Resource<TerrainFile> res;
+      res.setResource( ResourceManager::get().load( "terrainSampleTest.ter" ), mFile );
+
+      mBlock = new TerrainBlock;
+      mBlock->setFile( res );
+
+      // Include points off the edges of the terrain.
+      mPoints.setSize( 2000 );
+      for ( U32 i = 0; i < mPoints.size(); i++ )
+         mPoints[i].set( rand.randF( -2.0f, size + 2.0f ), rand.randF( -2.0f, size + 2.0f ) );
+   }
+
+   void TearDown() override
+   {
+      delete mBlock;
+   }
+};
+
+TEST_FIX(TerrainSample, HeightBatch_Matches_GetHeight)
+{
+   const U32 count = mPoints.size();
+   Vector<F32> heights;
+   heights.setSize( count );
+   Vector<bool> valid;
+   valid.setSize( count );
+
+   U32 numValid = mBlock->getHeightBatch( mPoints.address(), count, heights.address(), valid.address() );
+
+   U32 expectedValid = 0;
+   for ( U32 i = 0; i < count; i++ )
+   {
+      F32 height;
+      const bool hit = mBlock->getHeight( mPoints[i], &height );
+      EXPECT_EQ( valid[i], hit ) << "Validity mismatch at point " << i;
+      if ( hit )
+      {
+         expectedValid++;
+         EXPECT_FLOAT_EQ( heights[i], height ) << "Height mismatch at point " << i;
+      }
+   }
+
+   EXPECT_EQ( numValid, expectedValid );
+   EXPECT_GT( numValid, 0 );
+   EXPECT_LT( numValid, count );
+}
+
+TEST_FIX(TerrainSample, NormalBatch_Matches_GetNormal)
+{
+   const U32 count = mPoints.size();
+   Vector<Point3F> normals;
+   normals.setSize( count );
+   Vector<bool> valid;
+   valid.setSize( count );
+
+   for ( U32 pass = 0; pass < 2; pass++ )
+   {
+      const bool normalize = pass == 0;
+      mBlock->getNormalBatch( mPoints.address(), count, normals.address(), valid.address(), normalize, true );
+
+      for ( U32 i = 0; i < count; i++ )
+      {
+         Point3F normal;
+         const bool hit = mBlock->getNormal( mPoints[i], &normal, normalize, true );
+         EXPECT_EQ( valid[i], hit ) << "Validity mismatch at point " << i;
+         if ( hit )
+            EXPECT_TRUE( normals[i].equal( normal, 1e-5f ) ) << "Normal mismatch at point " << i;
+      }
+   }
+}
+
+TEST_FIX(TerrainSample, SmoothNormalBatch_Matches_GetSmoothNormal)
+{
+   const U32 count = mPoints.size();
+   Vector<Point3F> normals;
+   normals.setSize( count );
+   Vector<bool> valid;
+   valid.setSize( count );
+
+   mBlock->getSmoothNormalBatch( mPoints.address(), count, normals.address(), valid.address(), true, false );
+
+   for ( U32 i = 0; i < count; i++ )
+   {
+      Point3F normal;
+      const bool hit = mBlock->getSmoothNormal( mPoints[i], &normal, true, false );
+      EXPECT_EQ( valid[i], hit ) << "Validity mismatch at point " << i;
+      if ( hit )
+         EXPECT_TRUE( normals[i].equal( normal, 1e-5f ) ) << "Smooth normal mismatch at point " << i;
+   }
+}
+
+TEST_FIX(TerrainSample, SmoothNormalBatch_Reuses_Scratch)
+{
+   Vector<U64> scratch;
+   Vector<Point3F> normals;
+
+   // Alternate between rows of a grid, which are already in tile
+   // order and skip the sort, and the scattered points to check
+   // nothing stale is left in the scratch.
+   for ( U32 pass = 0; pass < 4; pass++ )
+   {
+      Vector<Point2F> points;
+      if ( pass & 1 )
+         points = mPoints;
+      else
+      {
+         for ( U32 x = 0; x < 64; x++ )
+            points.push_back( Point2F( x + 0.25f, pass * 10.0f + 0.75f ) );
+      }
+
+      normals.setSize( points.size() );
+      mBlock->getSmoothNormalBatch( points.address(), points.size(), normals.address(), NULL, true, false, &scratch );
+
+      for ( U32 i = 0; i < points.size(); i++ )
+      {
+         Point3F normal;
+         if ( mBlock->getSmoothNormal( points[i], &normal, true, false ) )
+            EXPECT_TRUE( normals[i].equal( normal, 1e-5f ) ) << "Pass " << pass << " smooth normal mismatch at point " << i;
+      }
+
+      // Only the scattered points needed sorting.
+      EXPECT_EQ( scratch.size(), pass ? mPoints.size() : 0 );
+   }
+}
+
+TEST_FIX(TerrainSample, NormalHeightMaterialBatch_Matches_GetNormalAndHeight)
+{
+   const U32 count = mPoints.size();
+   Vector<Point3F> normals;
+   normals.setSize( count );
+   Vector<F32> heights;
+   heights.setSize( count );
+   Vector<U8> materials;
+   materials.setSize( count );
+   Vector<bool> valid;
+   valid.setSize( count );
+
+   mBlock->getNormalHeightMaterialBatch( mPoints.address(), count, normals.address(), heights.address(), materials.address(), valid.address() );
+
+   for ( U32 i = 0; i < count; i++ )
+   {
+      Point3F normal;
+      F32 height;
+      const bool hit = mBlock->getNormalAndHeight( mPoints[i], &normal, &height, true );
+      EXPECT_EQ( valid[i], hit ) << "Validity mismatch at point " << i;
+      if ( !hit )
+         continue;
+
+      EXPECT_FLOAT_EQ( heights[i], height ) << "Height mismatch at point " << i;
+      EXPECT_TRUE( normals[i].equal( normal, 1e-5f ) ) << "Normal mismatch at point " << i;
+
+      const S32 xm = S32( mFloor( mPoints[i].x + 0.5f ) );
+      const S32 ym = S32( mFloor( mPoints[i].y + 0.5f ) );
+      EXPECT_EQ( materials[i], mFile->getLayerIndex( xm, ym ) ) << "Material mismatch at point " << i;
+   }
+}
+
+TEST(TerrainSample, GridMap_Matches_Eager_Build)
+{
+   MRandomLCG rand( 8765 );
+
+   // Big enough for several grid tiles sharing parents.
+   const U32 size = 256;
+   TerrainGridTestFile *file = new TerrainGridTestFile;
+   file->setSize( size, true );
+
+   for ( U32 y = 0; y < size; y++ )
+   {
+      for ( U32 x = 0; x < size; x++ )
+      {
+         file->setHeight( x, y, floatToFixed( 100.0f + rand.randF( 0.0f, 50.0f ) ) );
+         file->setLayerIndex( x, y, rand.randI( 0, 3 ) );
+      }
+   }
+
+   // A hole across a tile corner for the empty flags.
+   for ( U32 y = 60; y < 70; y++ )
+      for ( U32 x = 120; x < 132; x++ )
+         file->setLayerIndex( x, y, U8_MAX );
+
+   file->setSize( size, false );
+
+   const U32 levels = file->getGridLevels();
+   ASSERT_GT( levels, (U32)TerrainFile::GridTileLevels );
+
+   // Build every level up front from the top down like
+   // the grid map was built before it had tiles.
+   Vector< Vector<TerrainSquare> > reference;
+   reference.setSize( levels + 1 );
+   for ( S32 level = levels; level >= 0; level-- )
+   {
+      const U32 count = size >> level;
+      reference[level].setSize( count * count );
+
+      for ( U32 y = 0; y < count; y++ )
+      {
+         for ( U32 x = 0; x < count; x++ )
+         {
+            TerrainSquare *parent = NULL;
+            if ( level < levels )
+               parent = &reference[level + 1][ ( x >> 1 ) + ( y >> 1 ) * ( count >> 1 ) ];
+
+            file->buildGridSquare( level, x << level, y << level, &reference[level][ x + y * count ], parent );
+         }
+      }
+   }
+
+   const S32 maxGridTiles = TerrainFile::smMaxGridTiles;
+   TerrainFile::smMaxGridTiles = 3;
+
+   for ( U32 pass = 0; pass < 3; pass++ )
+   {
+      // Visit the tiles in a scattered order so they get
+      // built lazily from every side of their neighbors.
+      for ( U32 i = 0; i < size * size; i++ )
+      {
+         const U32 x = rand.randI( 0, size - 1 );
+         const U32 y = rand.randI( 0, size - 1 );
+         file->findSquare( 0, x, y );
+      }
+
+      for ( U32 level = 0; level <= levels; level++ )
+      {
+         const U32 count = size >> level;
+         for ( U32 y = 0; y < count; y++ )
+         {
+            for ( U32 x = 0; x < count; x++ )
+            {
+               const TerrainSquare &ref = reference[level][ x + y * count ];
+               const TerrainSquare *sq = file->findSquare( level, x << level, y << level );
+               ASSERT_EQ( sq->minHeight, ref.minHeight ) << "Pass " << pass << " level " << level << " at " << x << "," << y;
+               ASSERT_EQ( sq->maxHeight, ref.maxHeight ) << "Pass " << pass << " level " << level << " at " << x << "," << y;
+               ASSERT_EQ( sq->heightDeviance, ref.heightDeviance ) << "Pass " << pass << " level " << level << " at " << x << "," << y;
+               ASSERT_EQ( sq->flags, ref.flags ) << "Pass " << pass << " level " << level << " at " << x << "," << y;
+            }
+         }
+      }
+
+      // Evict all but a few tiles, which are then rebuilt
+      // by the next pass.  Tiles used since the last trim
+      // are kept so it takes two.
+      file->trimGridTiles();
+      file->trimGridTiles();
+      EXPECT_LE( file->getGridTileCount(), 3 ) << "Pass " << pass;
+   }
+
+   TerrainFile::smMaxGridTiles = maxGridTiles;
+   delete file;
+}
+
+TEST_FIX(TerrainSample, GridMap_Bounds_Heights)
+{
+   const U32 size = 64;
+   const U32 levels = 6;
+
+   // The lowest levels are built on demand, so check every
+   // square against the heights and its children.
+   for ( U32 y = 0; y < size; y++ )
+   {
+      for ( U32 x = 0; x < size; x++ )
+      {
+         const TerrainSquare *sq = mFile->findSquare( 0, x, y );
+         const U16 heights[4] = { mFile->getHeight( x, y ), mFile->getHeight( x + 1, y ), 
+                                  mFile->getHeight( x, y + 1 ), mFile->getHeight( x + 1, y + 1 ) };
+         U16 min = heights[0], max = heights[0];
+         for ( U32 i = 1; i < 4; i++ )
+         {
+            min = getMin( min, heights[i] );
+            max = getMax( max, heights[i] );
+         }
+         EXPECT_EQ( sq->minHeight, min ) << "Min height mismatch at " << x << "," << y;
+         EXPECT_EQ( sq->maxHeight, max ) << "Max height mismatch at " << x << "," << y;
+         EXPECT_EQ( ( sq->flags & TerrainSquare::Empty ) != 0, mFile->isEmptyAt( x, y ) ) << "Empty mismatch at " << x << "," << y;
+      }
+   }
+
+   for ( U32 level = 1; level <= levels; level++ )
+   {
+      const U32 half = 1 << ( level - 1 );
+      for ( U32 y = 0; y < size; y += half * 2 )
+      {
+         for ( U32 x = 0; x < size; x += half * 2 )
+         {
+            const TerrainSquare *sq = mFile->findSquare( level, x, y );
+            for ( U32 c = 0; c < 4; c++ )
+            {
+               const TerrainSquare *child = mFile->findSquare( level - 1, x + ( c & 1 ) * half, y + ( c >> 1 ) * half );
+               EXPECT_LE( sq->minHeight, child->minHeight ) << "Level " << level << " at " << x << "," << y;
+               EXPECT_GE( sq->maxHeight, child->maxHeight ) << "Level " << level << " at " << x << "," << y;
+            }
+         }
+      }
+   }
+}
+
+#endif
@@ -0,0 +1,275 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026 tgemit contributors.
+// See AUTHORS file and git repository for contributor information.
+//
+// SPDX-License-Identifier: MIT
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "terrain/terrData.h"
+#include "terrain/terrFile.h"
+#include "terrain/terrCell.h"
+#include "core/resourceManager.h"
+#include "platform/threads/threadPool.h"
+#include "console/console.h"
+#include "math/mRandom.h"
+
+/// Exposes the CPU side of the cell buffer generation so
+/// it can be run without a GFX device.
+class TerrCellBuildTest : public TerrCell
+{
+public:
+   void setup( TerrainBlock *terrain, const Point2I &point )
+   {
+      mTerrain = terrain;
+      mPoint = point;
+      mSize = smMinCellSize;
+      mLevel = 1;
+   }
+
+   void build( TerrVertex *verts, U16 *indices )
+   {
+      _buildVertices( verts );
+      if ( mHasEmpty )
+         _buildIndices( indices );
+   }
+
+   static U32 getVertexCount() { return smVBSize; }
+   static U32 getIndexCount() { return smPBSize; }
+};
+
+FIXTURE(TerrainUpdate)
+{
+public:
+   TerrainBlock *mBlock;
+   TerrainFile *mFile;
+   U32 mSize;
+
+   void SetUp() override
+   {
+      MRandomLCG rand( 8086 );
+
+      mSize = 512;
+      mFile = new TerrainFile;
+      mFile->setSize( mSize, true );
+
+      for ( U32 y = 0; y < mSize; y++ )
+         for ( U32 x = 0; x < mSize; x++ )
+            mFile->setHeight( x, y, floatToFixed( 100.0f + 20.0f * mSin( x * 0.05f ) * mCos( y * 0.03f ) + rand.randF( 0.0f, 1.0f ) ) );
+
+      mFile->setSize( mSize, false );
+
+      Resource<TerrainFile> res;
+      res.setResource( ResourceManager::get().load( "terrainUpdateTest.ter" ), mFile );
+
+      mBlock = new TerrainBlock;
+      mBlock->setFile( res );
+   }
+
+   void TearDown() override
+   {
+      delete mBlock;
+   }
+
+   /// Raises or lowers a round brush of heights, punching a hole in
+   /// the middle now and then, and returns the touched grid rect.
+   void applyBrush( MRandomLCG &rand, Point2I *outMin, Point2I *outMax )
+   {
+      const S32 radius = rand.randI( 2, 12 );
+      const S32 cx = rand.randI( 0, mSize - 1 );
+      const S32 cy = rand.randI( 0, mSize - 1 );
+      const F32 delta = rand.randF( -5.0f, 5.0f );
+      const bool hole = rand.randI( 0, 9 ) == 0;
+
+      outMin->set( getMax( cx - radius, 0 ), getMax( cy - radius, 0 ) );
+      outMax->set( getMin( cx + radius, (S32)mSize - 1 ), getMin( cy + radius, (S32)mSize - 1 ) );
+
+      for ( S32 y = outMin->y; y <= outMax->y; y++ )
+      {
+         for ( S32 x = outMin->x; x <= outMax->x; x++ )
+         {
+            const F32 dist = Point2F( x - cx, y - cy ).len();
+            if ( dist > radius )
+               continue;
+
+            const F32 height = fixedToFloat( mFile->getHeight( x, y ) ) + delta * ( 1.0f - dist / radius );
+            mFile->setHeight( x, y, floatToFixed( mClampF( height, 0.0f, 2000.0f ) ) );
+
+            if ( hole && dist < 2.0f )
+               mFile->setLayerIndex( x, y, U8_MAX );
+         }
+      }
+   }
+};
+
+TEST_FIX(TerrainUpdate, GridUpdate_Matches_Rebuild)
+{
+   MRandomLCG rand( 1234 );
+
+   // Build some of the grid tiles up front so that
+   // edits hit both built and unbuilt tiles.
+   for ( U32 y = 0; y < mSize / 2; y++ )
+      for ( U32 x = 0; x < mSize / 2; x++ )
+         mFile->findSquare( 0, x, y );
+
+   for ( U32 i = 0; i < 200; i++ )
+   {
+      Point2I minPt, maxPt;
+      applyBrush( rand, &minPt, &maxPt );
+      mFile->updateGrid( minPt, maxPt );
+   }
+
+   // A fresh grid map from the final heights.
+   TerrainFile *reference = new TerrainFile;
+   reference->setSize( mSize, true );
+   for ( U32 y = 0; y < mSize; y++ )
+   {
+      for ( U32 x = 0; x < mSize; x++ )
+      {
+         reference->setHeight( x, y, mFile->getHeight( x, y ) );
+         reference->setLayerIndex( x, y, mFile->getLayerIndex( x, y ) );
+      }
+   }
+   reference->setSize( mSize, false );
+
+   for ( U32 level = 0; ( 1U << level ) <= mSize; level++ )
+   {
+      const U32 step = 1 << level;
+      for ( U32 y = 0; y < mSize; y += step )
+      {
+         for ( U32 x = 0; x < mSize; x += step )
+         {
+            const TerrainSquare *sq = mFile->findSquare( level, x, y );
+            const TerrainSquare *expected = reference->findSquare( level, x, y );
+            ASSERT_EQ( sq->minHeight, expected->minHeight ) << "Level " << level << " at " << x << "," << y;
+            ASSERT_EQ( sq->maxHeight, expected->maxHeight ) << "Level " << level << " at " << x << "," << y;
+         }
+      }
+   }
+
+   // The reference isn't owned by a resource.
+   delete reference;
+}
+
+TEST_FIX(TerrainUpdate, Trim_Evicts_Least_Recently_Used_Tiles)
+{
+   const S32 maxGridTiles = TerrainFile::smMaxGridTiles;
+   TerrainFile::smMaxGridTiles = 4;
+
+   const U32 tileSize = 1 << TerrainFile::GridTileLevels;
+   const U32 tileCount = ( mSize / tileSize ) * ( mSize / tileSize );
+
+   // Build every tile.
+   for ( U32 y = 0; y < mSize; y += tileSize )
+      for ( U32 x = 0; x < mSize; x += tileSize )
+         mFile->findSquare( 0, x, y );
+
+   const TerrainSquare *kept = mFile->findSquare( 0, 0, 0 );
+   const TerrainSquare evicted = *mFile->findSquare( 0, mSize - 1, mSize - 1 );
+   EXPECT_EQ( mFile->getGridTileCount(), tileCount );
+
+   // They were all just used so none can go yet.
+   mFile->trimGridTiles();
+   EXPECT_EQ( mFile->getGridTileCount(), tileCount );
+
+   // Only the tiles used since the last trim survive.
+   for ( U32 x = 0; x < 4 * tileSize; x += tileSize )
+      mFile->findSquare( 0, x, 0 );
+
+   mFile->trimGridTiles();
+   EXPECT_EQ( mFile->getGridTileCount(), 4 );
+   EXPECT_EQ( mFile->findSquare( 0, 0, 0 ), kept );
+
+   // An evicted tile is rebuilt the same as before.
+   const TerrainSquare *rebuilt = mFile->findSquare( 0, mSize - 1, mSize - 1 );
+   EXPECT_EQ( rebuilt->minHeight, evicted.minHeight );
+   EXPECT_EQ( rebuilt->maxHeight, evicted.maxHeight );
+   EXPECT_EQ( rebuilt->heightDeviance, evicted.heightDeviance );
+   EXPECT_EQ( rebuilt->flags, evicted.flags );
+
+   // The retired tiles are freed after a few more trims.
+   for ( U32 i = 0; i < TerrainFile::GridTileRetireTrims; i++ )
+      mFile->trimGridTiles();
+
+   TerrainFile::smMaxGridTiles = maxGridTiles;
+}
+
+TEST_FIX(TerrainUpdate, DISABLED_Benchmark_Brush_Edits)
+{
+   MRandomLCG rand( 5678 );
+
+   const U32 numEdits = 100;
+   const U32 cellsPerRow = mSize / 64;
+
+   Vector<TerrCellBuildTest> cells;
+   cells.setSize( cellsPerRow * cellsPerRow );
+   for ( U32 i = 0; i < cells.size(); i++ )
+      cells[i].setup( mBlock, Point2I( ( i % cellsPerRow ) * 64, ( i / cellsPerRow ) * 64 ) );
+
+   // The brush is smaller than a cell so it touches at most four.
+   const U32 maxDirty = 4;
+   Vector<TerrVertex> verts;
+   verts.setSize( maxDirty * TerrCellBuildTest::getVertexCount() );
+   Vector<U16> indices;
+   indices.setSize( maxDirty * TerrCellBuildTest::getIndexCount() );
+
+   // Rebuilds the leaf cells touched by an edit, the
+   // same as TerrCell::updateGrid() does on the client.
+   struct BuildCells
+   {
+      Vector<TerrCellBuildTest> *cells;
+      Vector<U32> *dirty;
+      TerrVertex *verts;
+      U16 *indices;
+
+      void operator()( U32 i )
+      {
+         const U32 cell = (*dirty)[i];
+         (*cells)[cell].build( verts + i * TerrCellBuildTest::getVertexCount(), indices + i * TerrCellBuildTest::getIndexCount() );
+      }
+   };
+
+   Vector<U32> dirty;
+   BuildCells build = { &cells, &dirty, verts.address(), indices.address() };
+
+   U32 gridMs = 0, serialMs = 0, parallelMs = 0, numDirty = 0;
+
+   for ( U32 i = 0; i < numEdits; i++ )
+   {
+      Point2I minPt, maxPt;
+      applyBrush( rand, &minPt, &maxPt );
+
+      U32 start = Platform::getRealMilliseconds();
+      mFile->updateGrid( minPt, maxPt );
+      gridMs += Platform::getRealMilliseconds() - start;
+
+      dirty.clear();
+      for ( U32 c = 0; c < cells.size(); c++ )
+      {
+         const Point2I point( ( c % cellsPerRow ) * 64, ( c / cellsPerRow ) * 64 );
+         const RectI cellRect( point.x - 1, point.y - 1, 64 + 2, 64 + 2 );
+         const RectI gridRect( minPt, maxPt - minPt );
+         if ( cellRect.contains( gridRect ) || cellRect.overlaps( gridRect ) )
+            dirty.push_back( c );
+      }
+      ASSERT_LE( dirty.size(), maxDirty );
+      numDirty += dirty.size();
+
+      start = Platform::getRealMilliseconds();
+      for ( U32 c = 0; c < dirty.size(); c++ )
+         build( c );
+      serialMs += Platform::getRealMilliseconds() - start;
+
+      start = Platform::getRealMilliseconds();
+      ThreadPool::GLOBAL().parallelFor( dirty.size(), build );
+      parallelMs += Platform::getRealMilliseconds() - start;
+   }
+
+   EXPECT_GT( numDirty, 0 );
+
+   Con::printf( "Terrain brush edits: %d edits, %d cells rebuilt, grid update %dms, cell builds serial %dms, parallel %dms",
+      numEdits, numDirty, gridMs, serialMs, parallelMs );
+}
+
+#endif
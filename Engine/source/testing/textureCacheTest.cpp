@@ -0,0 +1,143 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026 tgemit contributors.
+// See AUTHORS file and git repository for contributor information.
+//
+// SPDX-License-Identifier: MIT
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "gfx/gfxDevice.h"
+#include "gfx/gfxTextureManager.h"
+#include "gfx/bitmap/gBitmap.h"
+#include "gfx/bitmap/ddsFile.h"
+#include "core/stream/fileStream.h"
+#include "core/stream/memStream.h"
+#include "core/volume.h"
+
+static const char *sTextureCacheTestSource = "textureCacheTest/source.png";
+static const char *sTextureCacheTestSourceA = "textureCacheTest/a/source.png";
+static const char *sTextureCacheTestSourceB = "textureCacheTest/b/source.png";
+
+FIXTURE(TextureCache)
+{
+public:
+   String mCachePath;
+
+   void SetUp() override
+   {
+      mCachePath = GFXTextureManager::smTextureCachePath;
+      GFXTextureManager::smTextureCachePath = "textureCacheTest/cache";
+   }
+
+   void TearDown() override
+   {
+      const char *sources[] = { sTextureCacheTestSource, sTextureCacheTestSourceA, sTextureCacheTestSourceB };
+      for ( U32 i = 0; i < 3; i++ )
+      {
+         Torque::FS::Remove( GFXTextureManager::getTextureCacheKeyFile( sources[i] ) );
+         Torque::FS::Remove( sources[i] );
+      }
+
+      GFXTextureManager::smTextureCachePath = mCachePath;
+   }
+
+   static void writeSource( const char *text, const char *fileName = sTextureCacheTestSource )
+   {
+      FileStream *stream = FileStream::createAndOpen( fileName, Torque::FS::File::Write );
+      ASSERT_TRUE( stream != NULL );
+      stream->write( dStrlen( text ), text );
+      delete stream;
+   }
+};
+
+TEST_FIX(TextureCache, Key_Follows_Content_And_Profile)
+{
+   // The key only hashes the bytes so they needn't be a real image.
+   writeSource( "some texture data" );
+
+   const Torque::Path cacheFile = TEXMGR->getTextureCacheFile( sTextureCacheTestSource, &GFXNormalMapBC3Profile );
+   ASSERT_FALSE( cacheFile.isEmpty() );
+   EXPECT_EQ( cacheFile.getPath(), String( "textureCacheTest/cache" ) );
+   EXPECT_TRUE( cacheFile.getFileName().find( "source_png_" ) == 0 ) << cacheFile.getFullPath().c_str();
+
+   // The hash is kept for the next run.
+   const Torque::Path keyFile = GFXTextureManager::getTextureCacheKeyFile( sTextureCacheTestSource );
+   EXPECT_EQ( keyFile.getPath(), String( "textureCacheTest/cache" ) );
+   EXPECT_TRUE( Torque::FS::IsFile( keyFile ) );
+
+   // Asking again gives the same file.
+   EXPECT_EQ( TEXMGR->getTextureCacheFile( sTextureCacheTestSource, &GFXNormalMapBC3Profile ), cacheFile );
+
+   // Each profile gets its own file.
+   EXPECT_NE( TEXMGR->getTextureCacheFile( sTextureCacheTestSource, &GFXNormalMapBC5Profile ), cacheFile );
+
+   // Changing the source changes the size and so the hash.
+   writeSource( "some other texture data" );
+   EXPECT_NE( TEXMGR->getTextureCacheFile( sTextureCacheTestSource, &GFXNormalMapBC3Profile ), cacheFile );
+
+   // A missing source has no cache file.
+   Torque::FS::Remove( sTextureCacheTestSource );
+   EXPECT_TRUE( TEXMGR->getTextureCacheFile( sTextureCacheTestSource, &GFXNormalMapBC3Profile ).isEmpty() );
+}
+
+TEST_FIX(TextureCache, Same_Name_In_Other_Folder)
+{
+   // Same size and written in the same second so only the
+   // key file name can tell the two sources apart.
+   writeSource( "texture data a", sTextureCacheTestSourceA );
+   writeSource( "texture data b", sTextureCacheTestSourceB );
+
+   const Torque::Path keyFileA = GFXTextureManager::getTextureCacheKeyFile( sTextureCacheTestSourceA );
+   const Torque::Path keyFileB = GFXTextureManager::getTextureCacheKeyFile( sTextureCacheTestSourceB );
+   EXPECT_NE( keyFileA, keyFileB );
+
+   const Torque::Path cacheFileA = TEXMGR->getTextureCacheFile( sTextureCacheTestSourceA, &GFXNormalMapBC3Profile );
+   const Torque::Path cacheFileB = TEXMGR->getTextureCacheFile( sTextureCacheTestSourceB, &GFXNormalMapBC3Profile );
+   ASSERT_FALSE( cacheFileA.isEmpty() );
+   ASSERT_FALSE( cacheFileB.isEmpty() );
+   EXPECT_NE( cacheFileA, cacheFileB );
+
+   EXPECT_TRUE( Torque::FS::IsFile( keyFileA ) );
+   EXPECT_TRUE( Torque::FS::IsFile( keyFileB ) );
+}
+
+TEST(TextureCache, Trailer_Round_Trip)
+{
+   GBitmap bmp( 8, 8, true, GFXFormatR8G8B8A8 );
+   bmp.fill( ColorI( 10, 20, 30, 128 ) );
+
+   DDSFile *dds = DDSFile::createDDSFileFromGBitmap( &bmp );
+   ASSERT_TRUE( dds != NULL );
+
+   MemStream stream( 4096 );
+   ASSERT_TRUE( dds->write( stream ) );
+   ASSERT_TRUE( GFXTextureManager::writeTextureCacheTrailer( stream, true ) );
+   delete dds;
+
+   bool hasTransparency = false;
+   ASSERT_TRUE( GFXTextureManager::readTextureCacheTrailer( stream, &hasTransparency ) );
+   EXPECT_TRUE( hasTransparency );
+
+   // The DDS still reads with the trailer on the end.
+   stream.setPosition( 0 );
+   DDSFile loaded;
+   ASSERT_TRUE( loaded.read( stream, 0 ) );
+   EXPECT_EQ( loaded.getWidth(), 8 );
+   EXPECT_EQ( loaded.getHeight(), 8 );
+   EXPECT_EQ( loaded.getMipLevels(), bmp.getNumMipLevels() );
+
+   // A plain DDS without the trailer is rejected.
+   MemStream plain( 4096 );
+   dds = DDSFile::createDDSFileFromGBitmap( &bmp );
+   ASSERT_TRUE( dds->write( plain ) );
+   delete dds;
+   EXPECT_FALSE( GFXTextureManager::readTextureCacheTrailer( plain, &hasTransparency ) );
+
+   // So is one too short to hold it.
+   MemStream tiny( 16 );
+   tiny.write( U8( 0 ) );
+   EXPECT_FALSE( GFXTextureManager::readTextureCacheTrailer( tiny, &hasTransparency ) );
+}
+
+#endif
@@ -116,3 +116,29 @@ TEST_FIX(ThreadPool, Synchronous)
 
    EXPECT_EQ(true, item->hasExecuted());
 }
+
+TEST_FIX(ThreadPool, ParallelFor)
+{
+   struct Increment
+   {
+      Vector<U32>* results;
+      void operator()(U32 index) { (*results)[index]++; }
+   };
+
+   const U32 numItems = 1000;
+   Vector<U32> results(__FILE__, __LINE__);
+   results.setSize(numItems);
+   for (U32 i = 0; i < numItems; i++)
+      results[i] = 0;
+
+   // Every index is visited exactly once and all of them
+   // are done by the time parallelFor() returns.
+   Increment func = { &results };
+   ThreadPool::GLOBAL().parallelFor(numItems, func);
+
+   for (U32 i = 0; i < numItems; i++)
+      EXPECT_EQ(results[i], 1) << "index " << i << " not processed once";
+
+   // Nothing to do shouldn't queue or wait on anything.
+   ThreadPool::GLOBAL().parallelFor(0, func);
+}
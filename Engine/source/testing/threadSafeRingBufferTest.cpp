@@ -0,0 +1,116 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026 tgemit contributors.
+// See AUTHORS file and git repository for contributor information.
+//
+// SPDX-License-Identifier: MIT
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "platform/threads/threadSafeRingBuffer.h"
+#include "platform/threads/thread.h"
+
+FIXTURE(ThreadSafeRingBuffer)
+{
+public:
+   struct Packet
+   {
+      U32 mIndex;
+      U8 mData[64];
+   };
+
+   typedef ThreadSafeRingBuffer<Packet, 256> Ring;
+
+   static const U32 NumPackets = 20000;
+
+   struct ProducerThread : public Thread
+   {
+      Ring& mRing;
+      ProducerThread(Ring& ring)
+         : mRing(ring) {}
+
+      virtual void run(void*)
+      {
+         U32 index = 0;
+         while (index < NumPackets)
+         {
+            // Write in small batches like the network thread does.
+            const U32 count = getMin(mRing.getWriteCount(), getMin(NumPackets - index, 8U));
+            for (U32 i = 0; i < count; i++)
+            {
+               Packet& packet = mRing.getWriteSlot(i);
+               packet.mIndex = index + i;
+               dMemset(packet.mData, U8(index + i), sizeof(packet.mData));
+            }
+
+            mRing.commitWrite(count);
+            index += count;
+         }
+      }
+   };
+};
+
+TEST_FIX(ThreadSafeRingBuffer, Basic)
+{
+   Ring ring;
+   EXPECT_EQ(ring.getReadCount(), 0U);
+   EXPECT_EQ(ring.getWriteCount(), Ring::Size);
+
+   // Go around the ring a few times so the indices wrap.
+   for (U32 pass = 0; pass < 5; pass++)
+   {
+      const U32 count = Ring::Size - pass;
+      for (U32 i = 0; i < count; i++)
+         ring.getWriteSlot(i).mIndex = pass * 1000 + i;
+
+      ring.commitWrite(count);
+      EXPECT_EQ(ring.getReadCount(), count);
+      EXPECT_EQ(ring.getWriteCount(), Ring::Size - count);
+
+      for (U32 i = 0; i < count; i++)
+         EXPECT_EQ(ring.getReadSlot(i).mIndex, pass * 1000 + i);
+
+      ring.commitRead(count);
+      EXPECT_EQ(ring.getReadCount(), 0U);
+   }
+
+   ring.commitWrite(3);
+   ring.clear();
+   EXPECT_EQ(ring.getReadCount(), 0U);
+   EXPECT_EQ(ring.getWriteCount(), Ring::Size);
+}
+
+TEST_FIX(ThreadSafeRingBuffer, Concurrent)
+{
+   Ring ring;
+   ProducerThread producer(ring);
+   producer.start();
+
+   const U32 endTime = Platform::getRealMilliseconds() + 30000;
+
+   U32 index = 0;
+   while (index < NumPackets)
+   {
+      const U32 count = ring.getReadCount();
+      if (count == 0)
+      {
+         ASSERT_LT(Platform::getRealMilliseconds(), endTime) << "consumer timed out";
+         continue;
+      }
+
+      for (U32 i = 0; i < count; i++)
+      {
+         const Packet& packet = ring.getReadSlot(i);
+         ASSERT_EQ(packet.mIndex, index + i) << "packet out of order";
+         ASSERT_EQ(packet.mData[0], U8(index + i));
+         ASSERT_EQ(packet.mData[sizeof(packet.mData) - 1], U8(index + i));
+      }
+
+      ring.commitRead(count);
+      index += count;
+   }
+
+   producer.join();
+}
+
+#endif
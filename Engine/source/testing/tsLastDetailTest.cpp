@@ -0,0 +1,133 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2026 tgemit contributors.
+// See AUTHORS file and git repository for contributor information.
+//
+// SPDX-License-Identifier: MIT
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "ts/tsLastDetail.h"
+#include "ts/tsShape.h"
+#include "core/stream/fileStream.h"
+#include "core/volume.h"
+
+static const char *sTSLastDetailTestShape = "tsLastDetailTest/shape.dts";
+static const char *sTSLastDetailTestDiffuse = "tsLastDetailTest/shape.dts_imposter.dds";
+static const char *sTSLastDetailTestKey = "tsLastDetailTest/shape.dts_imposter.key";
+
+/// Exposes the imposter cache checks to the tests.
+class TSLastDetailTestObject : public TSLastDetail
+{
+public:
+   TSLastDetailTestObject( TSShape *shape, S32 dim )
+      : TSLastDetail( shape, sTSLastDetailTestShape, 4, 0, 0.0f, false, 0, dim )
+   {
+   }
+
+   U64 getCacheKey() const { return _getCacheKey( sTSLastDetailTestShape ); }
+   bool isCacheValid( U64 cacheKey ) const { return _isCacheValid( sTSLastDetailTestShape, cacheKey ); }
+   void writeCacheKey( U64 cacheKey ) const { _writeCacheKey( cacheKey ); }
+   String getCacheKeyPath() const { return _getCacheKeyPath(); }
+};
+
+FIXTURE(TSLastDetail)
+{
+public:
+   TSShape *mShape;
+
+   void SetUp() override
+   {
+      mShape = new TSShape;
+      writeFile( sTSLastDetailTestShape, "some shape data" );
+   }
+
+   void TearDown() override
+   {
+      delete mShape;
+      Torque::FS::Remove( sTSLastDetailTestShape );
+      Torque::FS::Remove( sTSLastDetailTestDiffuse );
+      Torque::FS::Remove( sTSLastDetailTestKey );
+   }
+
+   static void writeFile( const char *fileName, const char *text )
+   {
+      FileStream *stream = FileStream::createAndOpen( fileName, Torque::FS::File::Write );
+      ASSERT_TRUE( stream != NULL );
+      stream->write( dStrlen( text ), text );
+      delete stream;
+   }
+};
+
+TEST_FIX(TSLastDetail, Cache_Key_Round_Trip)
+{
+   TSLastDetailTestObject lastDetail( mShape, 64 );
+   EXPECT_EQ( lastDetail.getCacheKeyPath(), String( sTSLastDetailTestKey ) );
+
+   // Without images there is nothing to be valid.
+   const U64 key = lastDetail.getCacheKey();
+   EXPECT_FALSE( lastDetail.isCacheValid( key ) );
+
+   // The check only looks for the file so it needn't be an image.
+   writeFile( sTSLastDetailTestDiffuse, "some image data" );
+   lastDetail.writeCacheKey( key );
+   EXPECT_TRUE( Torque::FS::IsFile( sTSLastDetailTestKey ) );
+   EXPECT_TRUE( lastDetail.isCacheValid( key ) );
+   EXPECT_EQ( lastDetail.getCacheKey(), key );
+
+   // The settings are part of the key.
+   TSLastDetailTestObject biggerDetail( mShape, 128 );
+   EXPECT_NE( biggerDetail.getCacheKey(), key );
+   EXPECT_FALSE( biggerDetail.isCacheValid( biggerDetail.getCacheKey() ) );
+
+   // And so is the shape, whatever its file time.
+   writeFile( sTSLastDetailTestShape, "some other shape data" );
+   const U64 newKey = lastDetail.getCacheKey();
+   EXPECT_NE( newKey, key );
+   EXPECT_FALSE( lastDetail.isCacheValid( newKey ) );
+}
+
+TEST_FIX(TSLastDetail, Cache_Without_Key_Uses_File_Times)
+{
+   TSLastDetailTestObject lastDetail( mShape, 64 );
+   const U64 key = lastDetail.getCacheKey();
+
+   // File times only have a resolution of a second.
+   Platform::sleep( 1100 );
+   writeFile( sTSLastDetailTestDiffuse, "some image data" );
+   ASSERT_FALSE( Torque::FS::IsFile( sTSLastDetailTestKey ) );
+
+   // Images newer than the shape are taken as is.
+   EXPECT_TRUE( lastDetail.isCacheValid( key ) );
+   EXPECT_TRUE( lastDetail.isCacheValid( key + 1 ) );
+
+   // Until the shape is saved again.
+   Platform::sleep( 1100 );
+   writeFile( sTSLastDetailTestShape, "some other shape data" );
+   EXPECT_FALSE( lastDetail.isCacheValid( lastDetail.getCacheKey() ) );
+}
+
+TEST_FIX(TSLastDetail, Delete_Removes_Pending_Bake)
+{
+   const bool bakeAsync = TSLastDetail::smBakeAsync;
+   TSLastDetail::smBakeAsync = true;
+
+   const U32 pendingBakes = TSLastDetail::getNumPendingBakes();
+
+   // Without cached images the update queues a bake.
+   TSLastDetailTestObject *lastDetail = new TSLastDetailTestObject( mShape, 64 );
+   lastDetail->update();
+   EXPECT_TRUE( lastDetail->isBakePending() );
+   EXPECT_EQ( TSLastDetail::getNumPendingBakes(), pendingBakes + 1 );
+
+   // Updating again doesn't queue it twice.
+   lastDetail->update();
+   EXPECT_EQ( TSLastDetail::getNumPendingBakes(), pendingBakes + 1 );
+
+   delete lastDetail;
+   EXPECT_EQ( TSLastDetail::getNumPendingBakes(), pendingBakes );
+
+   TSLastDetail::smBakeAsync = bakeAsync;
+}
+
+#endif
@@ -35,6 +35,8 @@
 #include "gfx/gfxTextureManager.h"
 #include "math/mRandom.h"
 #include "core/stream/fileStream.h"
+#include "core/util/hashFunction.h"
+#include "core/util/journal/process.h"
 #include "util/imposterCapture.h"
 #include "materials/materialManager.h"
 #include "materials/materialFeatureTypes.h"
@@ -55,14 +57,39 @@ GFXImplementVertexFormat( ImposterState )
 
 Vector<TSLastDetail*> TSLastDetail::smLastDetails;
 
+Vector<TSLastDetail*> TSLastDetail::smBakeQueue;
+
 bool TSLastDetail::smCanShadow = true;
 
+bool TSLastDetail::smBakeAsync = true;
+
+S32 TSLastDetail::smBakeTimeBudget = 8;
+
+
+/// Bakes queued imposters each main loop iteration outside of rendering.
+static void _processImposterBakeQueue()
+{
+   TSLastDetail::processBakeQueue( getMax( TSLastDetail::smBakeTimeBudget, 0 ) );
+}
 
 AFTER_MODULE_INIT( Sim )
 {
    Con::addVariable( "$pref::imposter::canShadow", TypeBool, &TSLastDetail::smCanShadow,
       "User preference which toggles shadows from imposters.  Defaults to true.\n"
       "@ingroup Rendering\n" );
+
+   Con::addVariable( "$pref::imposter::bakeAsync", TypeBool, &TSLastDetail::smBakeAsync,
+      "If true imposters missing from the cache are baked over the following "
+      "frames and shapes render their smallest mesh detail till then.  If false "
+      "they are baked when the shape loads.  Defaults to true.\n"
+      "@ingroup Rendering\n" );
+
+   Con::addVariable( "$pref::imposter::bakeTimeBudget", TypeS32, &TSLastDetail::smBakeTimeBudget,
+      "The milliseconds per frame spent baking queued imposters.  At least one "
+      "imposter is baked each frame.  Defaults to 8.\n"
+      "@ingroup Rendering\n" );
+
+   Process::notify( &_processImposterBakeQueue );
 }
 
 
@@ -92,6 +119,9 @@ TSLastDetail::TSLastDetail(   TSShape *shape,
    mMaterial = NULL;
    mMatInstance = NULL;
 
+   mBakePending = false;
+   mCacheKey = 0;
+
    // Store this in the static list.
    smLastDetails.push_back( this );  
 }
@@ -124,6 +154,9 @@ TSLastDetail::TSLastDetail(TSShape* shape,
    mMaterial = NULL;
    mMatInstance = NULL;
 
+   mBakePending = false;
+   mCacheKey = 0;
+
    // Store this in the static list.
    smLastDetails.push_back(this);
 }
@@ -137,6 +170,9 @@ TSLastDetail::~TSLastDetail()
    // Remove ourselves from the list.
    Vector<TSLastDetail*>::iterator iter = T3D::find( smLastDetails.begin(), smLastDetails.end(), this );
    smLastDetails.erase( iter );
+
+   if ( mBakePending )
+      smBakeQueue.remove( this );
 }
 
 void TSLastDetail::render( const TSRenderState &rdata, F32 alpha )
@@ -221,19 +257,66 @@ void TSLastDetail::update( bool forceUpdate )
       }
    }
 
-   // Do we need to update the imposter?
-   const String diffuseMapPath = _getDiffuseMapPath();
-   bool isFile = Platform::isFile(diffuseMapPath.c_str());
-   if (  forceUpdate || !isFile || Platform::compareModifiedTimes( diffuseMapPath, shapeFile ) <= 0 )
-      _update();
+   // Settle the dimensions before they go into the cache key.
+   _validateDim();
+
+   // Do we need to update the imposter?  The cache is keyed on the
+   // shape content so that it survives checkouts and copies which
+   // don't preserve the file times.
+   mCacheKey = _getCacheKey( shapeFile );
+   if ( forceUpdate || !_isCacheValid( shapeFile, mCacheKey ) )
+   {
+      if ( smBakeAsync && !forceUpdate )
+      {
+         // Shapes render their smallest mesh
+         // detail until the bake is done.
+         if ( !mBakePending )
+         {
+            mBakePending = true;
+            smBakeQueue.push_back( this );
+         }
+         return;
+      }
+
+      _bake();
+      return;
+   }
+
+   // Key caches from before keys were saved.
+   if ( !Platform::isFile( _getCacheKeyPath() ) )
+      _writeCacheKey( mCacheKey );
+
+   _initMaterial();
+}
+
+void TSLastDetail::_bake()
+{
+   PROFILE_SCOPE( TSLastDetail_bake );
+
+   if ( mBakePending )
+   {
+      smBakeQueue.remove( this );
+      mBakePending = false;
 
-   // If the time check fails now then the update must have not worked.
-   if ( Platform::compareModifiedTimes( diffuseMapPath, shapeFile ) < 0 )
+      // Flush the old images which may have been
+      // queued for deletion since update().
+      TEXMGR->cleanupCache();
+   }
+
+   if ( !_update() )
    {
       Con::errorf( "TSLastDetail::update - Failed to create imposters for '%s'!", mCachePath.c_str() );
       return;
    }
 
+   _writeCacheKey( mCacheKey );
+   _initMaterial();
+}
+
+void TSLastDetail::_initMaterial()
+{
+   const String diffuseMapPath = _getDiffuseMapPath();
+
    // Figure out what our vertex format will be.
    //
    // If we're on SM 3.0 we can do multiple vertex streams
@@ -336,7 +419,7 @@ void TSLastDetail::_validateDim()
    }
 }
 
-void TSLastDetail::_update()
+bool TSLastDetail::_update()
 {
    // We're gonna render... make sure we can.
    bool sceneBegun = GFX->canCurrentlyRender();
@@ -523,17 +606,23 @@ void TSLastDetail::_update()
    ImageUtil::ddsCompress( ddsNormals, GFXFormatBC3 );
 
    // Finally save the imposters to disk.
+   bool saved = true;
    FileStream fs;
    if ( fs.open( _getDiffuseMapPath(), Torque::FS::File::Write ) )
    {
       ddsDest->write( fs );
       fs.close();
    }
+   else
+      saved = false;
+
    if ( fs.open( _getNormalMapPath(), Torque::FS::File::Write ) )
    {
       ddsNormals->write( fs );
       fs.close();
    }
+   else
+      saved = false;
 
    delete ddsDest;
    delete ddsNormals;
@@ -541,6 +630,67 @@ void TSLastDetail::_update()
    // If we did a begin then end it now.
    if ( !sceneBegun )
       GFX->endScene();
+
+   return saved;
+}
+
+U64 TSLastDetail::_getCacheKey( const String &shapeFile ) const
+{
+   // Bump this when the baked images change.
+   static const U32 smCacheVersion = 1;
+
+   U32 settings[7] = { smCacheVersion, mNumEquatorSteps, mNumPolarSteps, mIncludePoles, (U32)mDl, (U32)mDim, 0 };
+   dMemcpy( &settings[6], &mPolarAngle, sizeof( F32 ) );
+   U64 key = Torque::hash64( (const U8*)settings, sizeof( settings ), 0 );
+
+   void *data = NULL;
+   U32 size = 0;
+   if ( Torque::FS::ReadFile( shapeFile, data, size ) )
+   {
+      key = Torque::hash64( (const U8*)data, size, key );
+      delete [] (char*)data;
+   }
+
+   return key;
+}
+
+bool TSLastDetail::_isCacheValid( const String &shapeFile, U64 cacheKey ) const
+{
+   const String diffuseMapPath = _getDiffuseMapPath();
+   if ( !Platform::isFile( diffuseMapPath ) )
+      return false;
+
+   FileStream fs;
+   if ( fs.open( _getCacheKeyPath(), Torque::FS::File::Read ) )
+   {
+      U32 hi = 0, lo = 0;
+      fs.read( &hi );
+      fs.read( &lo );
+      return ( ( (U64)hi << 32 ) | lo ) == cacheKey;
+   }
+
+   // We've no key so fall back to the file times.
+   return Platform::compareModifiedTimes( diffuseMapPath, shapeFile ) > 0;
+}
+
+void TSLastDetail::_writeCacheKey( U64 cacheKey ) const
+{
+   FileStream fs;
+   if ( !fs.open( _getCacheKeyPath(), Torque::FS::File::Write ) )
+   {
+      Con::errorf( "TSLastDetail::_writeCacheKey - Failed to write '%s'!", _getCacheKeyPath().c_str() );
+      return;
+   }
+
+   fs.write( (U32)( cacheKey >> 32 ) );
+   fs.write( (U32)cacheKey );
+}
+
+String TSLastDetail::_getCacheKeyPath() const
+{
+   Torque::Path path( _getDiffuseMapPath() );
+   path.setExtension( "key" );
+   return path.getFullPath();
 }
 
 void TSLastDetail::deleteImposterCacheTextures()
@@ -552,6 +702,9 @@ void TSLastDetail::deleteImposterCacheTextures()
    const String normalMap = _getNormalMapPath();
    if ( normalMap.length() )
       dFileDelete( normalMap );
+
+   if ( diffuseMap.length() )
+      dFileDelete( _getCacheKeyPath() );
 }
 
 void TSLastDetail::updateImposterImages( bool forceUpdate )
@@ -574,9 +727,36 @@ void TSLastDetail::updateImposterImages( bool forceUpdate )
       GFX->endScene();
 }
 
+void TSLastDetail::processBakeQueue( U32 budgetMs )
+{
+   if ( smBakeQueue.empty() || !GFXDevice::devicePresent() )
+      return;
+
+   PROFILE_SCOPE( TSLastDetail_processBakeQueue );
+
+   // Each bake takes itself off the queue even if it fails.
+   const U32 startTime = Platform::getRealMilliseconds();
+   do
+   {
+      smBakeQueue.first()->_bake();
+   }
+   while ( !smBakeQueue.empty() && Platform::getRealMilliseconds() - startTime < budgetMs );
+
+   Con::setIntVariable( "$TSLastDetail::pendingBakes", smBakeQueue.size() );
+}
+
+void TSLastDetail::bakeImposterImages()
+{
+   processBakeQueue( U32_MAX );
+}
+
 DefineEngineFunction( tsUpdateImposterImages, void, (bool forceUpdate), (false), "tsUpdateImposterImages( bool forceupdate )")
 {
    TSLastDetail::updateImposterImages(forceUpdate);
 }
 
-
+DefineEngineFunction( tsBakeImposterImages, void, (), , "tsBakeImposterImages()\n"
+   "Bakes all the imposters waiting in the queue now instead of over the following frames." )
+{
+   TSLastDetail::bakeImposterImages();
+}
@@ -137,15 +137,47 @@ protected:
    /// The material instance used to render this imposter.
    BaseMatInstance *mMatInstance;
 
+   /// Is true while the imposter images are queued for baking.
+   bool mBakePending;
+
+   /// The cache key of the queued bake.
+   /// @see _getCacheKey
+   U64 mCacheKey;
+
    /// This is a global list of all the TSLastDetail
    /// objects in the system.
    static Vector<TSLastDetail*> smLastDetails;
 
+   /// The imposters waiting to be baked in order of request.
+   static Vector<TSLastDetail*> smBakeQueue;
+
    /// The maximum texture size for a billboard texture.
    static const U32 smMaxTexSize = 2048;
 
    /// This update actually regenerates the imposter images.
-   void _update();
+   /// @return Returns false if the images could not be saved.
+   bool _update();
+
+   /// Renders the imposter images, saves the cache key
+   /// and sets up the material.
+   void _bake();
+
+   /// Sets up the material and UVs from the cached imposter images.
+   void _initMaterial();
+
+   /// Returns a hash of the shape file content and the imposter
+   /// settings which identifies the cached images.
+   U64 _getCacheKey( const String &shapeFile ) const;
+
+   /// Returns true if the cached images match the key.  Caches
+   /// from before keys were saved are checked by file time.
+   bool _isCacheValid( const String &shapeFile, U64 cacheKey ) const;
+
+   /// Saves the key of the cached images.
+   void _writeCacheKey( U64 cacheKey ) const;
+
+   /// Helper which returns the path of the cache key file.
+   String _getCacheKeyPath() const;
 
    ///
    void _validateDim();
@@ -182,21 +214,47 @@ public:
    /// Global preference for rendering imposters to shadows.
    static bool smCanShadow;
 
+   /// If true imposters missing from the cache are queued and
+   /// baked over the following frames instead of on load.
+   static bool smBakeAsync;
+
+   /// The milliseconds per frame spent baking queued imposters.
+   /// At least one imposter is baked each frame.
+   static S32 smBakeTimeBudget;
+
    /// Calls update on all TSLastDetail objects in the system.
    /// @see update()
    static void updateImposterImages( bool forceUpdate = false );
 
+   /// Bakes queued imposters until the time budget in
+   /// milliseconds is used up.
+   static void processBakeQueue( U32 budgetMs );
+
+   /// Bakes all queued imposters now.  Use it as a batch step
+   /// when building a level or behind a loading screen.
+   static void bakeImposterImages();
+
+   /// Returns the number of imposters waiting to be baked.
+   static U32 getNumPendingBakes() { return smBakeQueue.size(); }
+
    /// Loads the imposter images by reading them from the disk
    /// or generating them if the TSShape is more recient than the
    /// cached imposter textures.
    ///
    /// This should not be called from within any rendering code.
    ///
+   /// When smBakeAsync is set the images are queued for baking
+   /// unless forceUpdate is set.  Until then isBakePending() is
+   /// true and shape instances render their smallest mesh detail.
+   ///
    /// @param forceUpdate  If true the disk cache is invalidated and
    ///                     new imposter images are rendered.
    ///
    void update( bool forceUpdate = false );
 
+   /// Returns true while the imposter images are waiting to be baked.
+   bool isBakePending() const { return mBakePending; }
+
 
    /// Internal function called from TSShapeInstance to 
    /// submit an imposter render instance.
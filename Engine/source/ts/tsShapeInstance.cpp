@@ -608,6 +608,8 @@ void TSShapeInstance::setCurrentDetail( S32 dl, F32 intraDL )
          mCurrentIntraDetailLevel = 1.0f;
       }
    }
+
+   _skipPendingImposter();
 }
 
 S32 TSShapeInstance::setDetailFromPosAndScale(  const SceneRenderState *state,
@@ -632,7 +634,7 @@ S32 TSShapeInstance::setDetailFromDistance( const SceneRenderState *state, F32 s
    if ( scaledDistance <= 0.0f )
    {
       mShape->mDetailLevelLookup[0].get( mCurrentDetailLevel, mCurrentIntraDetailLevel );
-      return mCurrentDetailLevel;
+      return _skipPendingImposter();
    }
 
    // The pixel scale is used the linearly scale the lod
@@ -697,7 +699,7 @@ S32 TSShapeInstance::setDetailFromDistance( const SceneRenderState *state, F32 s
       }
    }
 
-   return mCurrentDetailLevel;
+   return _skipPendingImposter();
 }
 
 S32 TSShapeInstance::setDetailFromScreenError( F32 errorTolerance )
@@ -729,7 +731,7 @@ S32 TSShapeInstance::setDetailFromScreenError( F32 errorTolerance )
       // draw last detail
       mCurrentDetailLevel = mShape->mSmallestVisibleDL;
       mCurrentIntraDetailLevel = 0.0f;
-      return mCurrentDetailLevel;
+      return _skipPendingImposter();
    }
 
    // this function is a little odd
@@ -749,7 +751,7 @@ S32 TSShapeInstance::setDetailFromScreenError( F32 errorTolerance )
          // intraDL = 0 corresponds to the next lower (higher number) detail
          mCurrentDetailLevel = i;
          mCurrentIntraDetailLevel = 1.0f - (errorTolerance - err0) / (prevErr - err0);
-         return mCurrentDetailLevel;
+         return _skipPendingImposter();
       }
       prevErr = err0;
    }
@@ -757,6 +759,27 @@ S32 TSShapeInstance::setDetailFromScreenError( F32 errorTolerance )
    // get here if we are drawing at DL==0
    mCurrentDetailLevel = 0;
    mCurrentIntraDetailLevel = 1.0f;
+   return _skipPendingImposter();
+}
+
+S32 TSShapeInstance::_skipPendingImposter()
+{
+   const S32 dl = mCurrentDetailLevel;
+   if (  dl < 0 ||
+         mShape->details[dl].subShapeNum >= 0 ||
+         dl >= mShape->billboardDetails.size() ||
+         !mShape->billboardDetails[dl] ||
+         !mShape->billboardDetails[dl]->isBakePending() )
+      return mCurrentDetailLevel;
+
+   // Use the next larger mesh detail or
+   // nothing if the shape only has imposters.
+   S32 meshDL = dl - 1;
+   while ( meshDL >= 0 && mShape->details[meshDL].subShapeNum < 0 )
+      meshDL--;
+
+   mCurrentDetailLevel = meshDL;
+   mCurrentIntraDetailLevel = 1.0f;
    return mCurrentDetailLevel;
 }
 
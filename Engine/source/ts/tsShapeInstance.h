@@ -571,6 +571,15 @@ protected:
    /// Sets the current detail level using the legacy screen error metric.
    S32 setDetailFromScreenError( F32 errorTOL );
 
+protected:
+
+   /// Moves the current detail to the smallest mesh detail
+   /// while the selected imposter is waiting to be baked.
+   /// @see TSLastDetail::isBakePending
+   S32 _skipPendingImposter();
+
+public:
+
    enum
    {
       TransformDirty =  BIT(0),